@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for CAN identifier ranges and compiled
+//            acceptance filter entries.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4.Bal.Can
+{
+  using System;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   <c>CanIdRange</c> describes a contiguous range of CAN message
+  ///   identifiers (see <c>ICanControl2.AddFilterIds</c>).
+  /// </summary>
+  //*****************************************************************************
+  public struct CanIdRange
+  {
+    private uint m_dwFirst;  // first identifier of the range
+    private uint m_dwLast;   // last identifier of the range
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Ctor - create a range which contains a single identifier
+    /// </summary>
+    /// <param name="identifier">the identifier</param>
+    //*****************************************************************************
+    public CanIdRange(uint identifier)
+    {
+      m_dwFirst = identifier;
+      m_dwLast  = identifier;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Ctor - create a CanIdRange object
+    /// </summary>
+    /// <param name="first">first identifier of the range</param>
+    /// <param name="last">last identifier of the range (inclusive)</param>
+    //*****************************************************************************
+    public CanIdRange(uint first, uint last)
+    {
+      m_dwFirst = first;
+      m_dwLast  = last;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the first identifier of the range.
+    /// </summary>
+    //*****************************************************************************
+    public uint First
+    {
+      get { return m_dwFirst; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the last identifier of the range (inclusive).
+    /// </summary>
+    //*****************************************************************************
+    public uint Last
+    {
+      get { return m_dwLast; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method returns a String that represents the range.
+    /// </summary>
+    /// <returns>
+    ///   A String that represents the range.
+    /// </returns>
+    //*****************************************************************************
+    public override string ToString()
+    {
+      return String.Format("0x{0:X}..0x{1:X}", m_dwFirst, m_dwLast);
+    }
+  };
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   <c>CanFilterEntry</c> describes a code/mask pair of an acceptance
+  ///   filter in the format of <c>ICanControl2.AddFilterIds</c>, i.e.
+  ///   identifier bits start at bit 1 and bit 0 is the RTR bit.
+  /// </summary>
+  //*****************************************************************************
+  public struct CanFilterEntry
+  {
+    private uint m_dwCode;   // acceptance code inclusive RTR bit
+    private uint m_dwMask;   // relevant bits of the acceptance code
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Ctor - create a CanFilterEntry object
+    /// </summary>
+    /// <param name="code">acceptance code inclusive RTR bit</param>
+    /// <param name="mask">relevant bits of the acceptance code</param>
+    //*****************************************************************************
+    public CanFilterEntry(uint code, uint mask)
+    {
+      m_dwCode = code;
+      m_dwMask = mask;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the acceptance code inclusive RTR bit.
+    /// </summary>
+    //*****************************************************************************
+    public uint Code
+    {
+      get { return m_dwCode; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the mask that specifies the relevant bits within <c>Code</c>.
+    /// </summary>
+    //*****************************************************************************
+    public uint Mask
+    {
+      get { return m_dwMask; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Determines whether the entry accepts the specified identifier.
+    /// </summary>
+    /// <param name="identifier">The message identifier.</param>
+    /// <param name="remoteTransmission">The RTR bit of the message.</param>
+    /// <returns>
+    ///   true if the identifier passes the entry.
+    /// </returns>
+    //*****************************************************************************
+    public bool Accepts(uint identifier, bool remoteTransmission)
+    {
+      uint code = (identifier << 1) | (remoteTransmission ? 1u : 0u);
+      return ((code ^ m_dwCode) & m_dwMask) == 0;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method returns a String that represents the filter entry.
+    /// </summary>
+    /// <returns>
+    ///   A String that represents the filter entry.
+    /// </returns>
+    //*****************************************************************************
+    public override string ToString()
+    {
+      return String.Format("code 0x{0:X8} mask 0x{1:X8}", m_dwCode, m_dwMask);
+    }
+  };
+
+}
@@ -71,6 +71,27 @@ namespace Ixxat.Vci4.Bal
     //*****************************************************************************
     BalResourceCollection Resources { get; }
 
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets whether the bus sockets of the BAL object are pooled.
+    ///   Each socket object (i.e. ICanControl or ICanChannel) opens a basic
+    ///   socket of its port (ICanSocket, ICanSocket2 or ILinSocket) and reads
+    ///   the capabilities from it. With pooling this basic socket is opened
+    ///   once per port and shared by reference counting, so opening and
+    ///   closing sockets repeatedly does not reopen it. The pooled sockets
+    ///   are kept open until pooling is disabled or the BAL object is
+    ///   disposed. The default is false.
+    /// </summary>
+    /// <remarks>
+    ///   Controls, channels, schedulers and monitors are never shared,
+    ///   each call of <c>OpenSocket</c> still returns a new socket object.
+    /// </remarks>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    bool SocketPooling { get; set; }
+
     //*****************************************************************************
     /// <summary>
     ///   This method opens the specified bus socket.
@@ -125,6 +146,45 @@ namespace Ixxat.Vci4.Bal
     //*****************************************************************************
     IBalResource OpenSocket( byte  portNumber
                            , Type  socketType );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method opens the specified bus socket. Unlike
+    ///   <c>OpenSocket(byte, Type)</c> the socket class is resolved only once
+    ///   per socket type and the result needs no cast.
+    /// </summary>
+    /// <typeparam name="T">
+    ///   Type of the bus socket to open, i.e. <c>ICanChannel2</c>. The
+    ///   supported socket types are the same as for
+    ///   <c>OpenSocket(byte, Type)</c>.
+    /// </typeparam>
+    /// <param name="portNumber">
+    ///   Number of the bus socket to open. This parameter must be within the 
+    ///   range of 0 to <c>Resources.Count</c> - 1.
+    /// </param>
+    /// <returns>
+    ///   The opened bus socket object. When no longer needed the returned
+    ///   socket object has to be disposed using the IDisposable interface.
+    /// </returns>
+    /// <example>
+    ///   <code>
+    ///   ICanChannel2 channel = bal.OpenSocket&lt;ICanChannel2&gt;(0);
+    ///   </code>
+    /// </example>
+    /// <exception cref="VciException">
+    ///   Opening socket failed.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   The specified port number is out of range.
+    /// </exception>
+    /// <exception cref="NotImplementedException">
+    ///   There's no implementation for the socket type <typeparamref name="T"/>.
+    /// </exception>
+    //*****************************************************************************
+    T OpenSocket<T>( byte portNumber ) where T : IBalResource;
   };
 
 
@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the bit rate detection service which detects
+//            the bit rate of several CAN lines concurrently.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4.Bal.Can
+{
+  using System;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   <c>CanBitrateDetection</c> describes the result of the bit rate
+  ///   detection of a single CAN controller (see <c>ICanBitrateDetector</c>).
+  /// </summary>
+  //*****************************************************************************
+  public struct CanBitrateDetection
+  {
+    private Object?      m_pHwId;     // unique hardware id of the device
+    private byte         m_bPort;     // port number of the controller
+    private int          m_iIndex;    // index within the bit rate table
+    private CanFdBitrate m_sBitrate;  // detected bit rate
+    private int          m_iError;    // error code of the detection
+    private TimeSpan     m_tsTime;    // duration of the detection
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Ctor - create a CanBitrateDetection object
+    /// </summary>
+    /// <param name="hardwareId">unique hardware id of the device</param>
+    /// <param name="portNumber">port number of the controller</param>
+    /// <param name="index">index within the bit rate table or -1</param>
+    /// <param name="bitrate">detected bit rate</param>
+    /// <param name="errorCode">error code of the detection</param>
+    /// <param name="duration">duration of the detection</param>
+    //*****************************************************************************
+    public CanBitrateDetection(Object? hardwareId, byte portNumber, int index,
+                               CanFdBitrate bitrate, int errorCode,
+                               TimeSpan duration)
+    {
+      m_pHwId    = hardwareId;
+      m_bPort    = portNumber;
+      m_iIndex   = index;
+      m_sBitrate = bitrate;
+      m_iError   = errorCode;
+      m_tsTime   = duration;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the unique hardware id of the device
+    ///   (see <c>IVciDevice.UniqueHardwareId</c>).
+    /// </summary>
+    //*****************************************************************************
+    public Object? HardwareId
+    {
+      get { return m_pHwId; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the port number of the CAN controller.
+    /// </summary>
+    //*****************************************************************************
+    public byte PortNumber
+    {
+      get { return m_bPort; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the index of the detected entry within the bit rate table
+    ///   passed to <c>ICanBitrateDetector.Detect</c> or -1 if no bit rate
+    ///   was detected.
+    /// </summary>
+    //*****************************************************************************
+    public int Index
+    {
+      get { return m_iIndex; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the detected bit rate. The value is only valid if
+    ///   <c>Index</c> is not negative.
+    /// </summary>
+    //*****************************************************************************
+    public CanFdBitrate Bitrate
+    {
+      get { return m_sBitrate; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the error code of the detection or 0 if the detection
+    ///   succeeded. VCI_E_TIMEOUT indicates that no traffic was observed.
+    /// </summary>
+    //*****************************************************************************
+    public int ErrorCode
+    {
+      get { return m_iError; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the time the detection took for this controller.
+    /// </summary>
+    //*****************************************************************************
+    public TimeSpan Duration
+    {
+      get { return m_tsTime; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method returns a String that represents the detection result.
+    /// </summary>
+    /// <returns>
+    ///   A String that represents the detection result.
+    /// </returns>
+    //*****************************************************************************
+    public override string ToString()
+    {
+      return String.Format("{0} port {1}: index {2}, error 0x{3:X8}, {4}",
+                           m_pHwId, m_bPort, m_iIndex, m_iError, m_tsTime);
+    }
+  };
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface is used to detect the bit rate of several CAN lines
+  ///   concurrently. Each registered controller is tested on its own
+  ///   thread, so the total execution time is bound by the slowest
+  ///   controller instead of the sum of all controllers.
+  ///   The entries of the bit rate table are tested in the order of their
+  ///   prior likelihood: the bit rate last detected on the same controller
+  ///   (identified by <c>IVciDevice.UniqueHardwareId</c> and the port
+  ///   number) first, then the bit rates detected most often by the
+  ///   process, then the remaining entries in table order.
+  ///   The returned indices always refer to the table passed by the caller.
+  /// </summary>
+  /// <example>
+  ///   <code>
+  ///   ICanBitrateDetector detector = VciServer.Instance().CreateBitrateDetector();
+  ///   detector.AddController(device1, 0);
+  ///   detector.AddController(device2, 0);
+  ///   detector.AddController(device2, 1);
+  ///
+  ///   foreach (CanBitrateDetection result in detector.Detect(
+  ///              CanOperatingModes.Standard, CanExtendedOperatingModes.FastDataRate,
+  ///              100, table))
+  ///   {
+  ///     if (result.Index >= 0)
+  ///     {
+  ///       ...
+  ///     }
+  ///   }
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public interface ICanBitrateDetector
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the maximum number of controllers tested at the same
+    ///   time. The default value is 8.
+    /// </summary>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   The value is less than 1.
+    /// </exception>
+    //*****************************************************************************
+    int  MaxParallel                            { get;
+                                                  set; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of registered controllers.
+    /// </summary>
+    //*****************************************************************************
+    int  ControllerCount                        { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Registers a CAN controller for the detection. The controller is
+    ///   opened by <c>Detect</c> and closed again before it returns.
+    /// </summary>
+    /// <param name="device">
+    ///   The device the controller belongs to. The device is not disposed
+    ///   by the detector.
+    /// </param>
+    /// <param name="portNumber">
+    ///   Port number of the controller.
+    /// </param>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter device was a null reference.
+    /// </exception>
+    //*****************************************************************************
+    void AddController(IVciDevice device, byte portNumber);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Detects the bit rate of all registered controllers concurrently.
+    /// </summary>
+    /// <param name="operatingMode">
+    ///   Operating mode of the CAN controllers
+    /// </param>
+    /// <param name="extendedMode">
+    ///   Extended operating mode of the CAN controllers
+    /// </param>
+    /// <param name="timeout">
+    ///   Timeout in milliseconds to wait between two successive receive messages.
+    /// </param>
+    /// <param name="bitrateTable">
+    ///   One-dimensional array of initialized CanFdBitrate objects
+    ///   which contains possible values for the bit timing register
+    ///   to be tested.
+    /// </param>
+    /// <returns>
+    ///   One result per registered controller in registration order.
+    ///   Errors of single controllers are reported by
+    ///   <c>CanBitrateDetection.ErrorCode</c> and do not affect the
+    ///   detection of the other controllers.
+    /// </returns>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter bitrateTable was a null reference.
+    /// </exception>
+    //*****************************************************************************
+    CanBitrateDetection[] Detect( CanOperatingModes         operatingMode
+                                , CanExtendedOperatingModes extendedMode
+                                , UInt16                    timeout
+                                , CanFdBitrate[]            bitrateTable );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Discards the bit rates detected so far by all detectors of the
+    ///   process, i.e. the likelihood ordering starts from scratch.
+    /// </summary>
+    //*****************************************************************************
+    void ClearCache();
+  };
+
+}
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the automatic bus-off recovery of CAN lines.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4.Bal.Can
+{
+  using System;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface represents the automatic bus-off recovery of a CAN
+  ///   line (see <c>ICanControl2.CreateBusOffRecovery</c>).
+  ///   The recovery receives the status messages of the controller through
+  ///   a private message channel. When a status message signals bus off,
+  ///   it resets the line, initializes it with the parameters of the last
+  ///   successful <c>ICanControl2.InitLine</c> call, registers the filter
+  ///   entries and acceptance filters again and restarts the line.
+  ///   Failed attempts are repeated with an exponentially growing delay.
+  /// </summary>
+  /// <remarks>
+  ///   The recovery uses the control socket it was created from. The
+  ///   application should not reconfigure the line while the recovery is
+  ///   running. All statistics are measured with the host clock.
+  /// </remarks>
+  /// <example>
+  ///   <code>
+  ///   ICanControl2 control = ...
+  ///   control.InitLine(...);
+  ///   control.StartLine();
+  ///
+  ///   ICanBusOffRecovery recovery = control.CreateBusOffRecovery();
+  ///   recovery.InitialDelay        = TimeSpan.FromMilliseconds(10);
+  ///   recovery.MaximumDelay        = TimeSpan.FromSeconds(2);
+  ///   recovery.MaxRetriesPerMinute = 30;
+  ///   recovery.Start();
+  ///
+  ///   // ...
+  ///
+  ///   Console.WriteLine("{0} bus off, total downtime {1}",
+  ///     recovery.BusOffCount, recovery.TotalDowntime);
+  ///
+  ///   recovery.Dispose();
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public interface ICanBusOffRecovery : IDisposable
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the delay between the detection of the bus off state
+    ///   and the first recovery attempt. The delay is doubled after each
+    ///   failed attempt. The default value is 10 milliseconds.
+    /// </summary>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   The delay is less than 1 millisecond or exceeds
+    ///   <c>Int32.MaxValue</c> milliseconds.
+    /// </exception>
+    //*****************************************************************************
+    TimeSpan InitialDelay                        { get; set; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the upper limit of the delay between two recovery
+    ///   attempts. The default value is 2 seconds.
+    /// </summary>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   The delay is less than 1 millisecond or exceeds
+    ///   <c>Int32.MaxValue</c> milliseconds.
+    /// </exception>
+    //*****************************************************************************
+    TimeSpan MaximumDelay                        { get; set; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the maximum number of recovery attempts within any
+    ///   period of one minute. 0 means no limit, which is the default.
+    /// </summary>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   The value is negative.
+    /// </exception>
+    //*****************************************************************************
+    int MaxRetriesPerMinute                      { get; set; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets a value indicating whether the recovery thread is running.
+    /// </summary>
+    //*****************************************************************************
+    bool IsRunning                               { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets a value indicating whether the line is in bus off state and
+    ///   waits for recovery.
+    /// </summary>
+    //*****************************************************************************
+    bool IsBusOff                                { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of detected bus off states.
+    /// </summary>
+    //*****************************************************************************
+    long BusOffCount                             { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of recovery attempts.
+    /// </summary>
+    //*****************************************************************************
+    long AttemptCount                            { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of bus off states the line recovered from.
+    /// </summary>
+    //*****************************************************************************
+    long RecoveryCount                           { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the time from the detection of the last recovered bus off
+    ///   state until the line was running again.
+    /// </summary>
+    //*****************************************************************************
+    TimeSpan LastDowntime                        { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the longest downtime of all recovered bus off states.
+    /// </summary>
+    //*****************************************************************************
+    TimeSpan MaximumDowntime                     { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the sum of the downtimes of all recovered bus off states.
+    /// </summary>
+    //*****************************************************************************
+    TimeSpan TotalDowntime                       { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Resets all counters and downtimes to 0.
+    /// </summary>
+    //*****************************************************************************
+    void ResetStatistics();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Starts the recovery thread. If the line is already in bus off
+    ///   state, the recovery starts immediately.
+    /// </summary>
+    /// <exception cref="InvalidOperationException">
+    ///   The line was not initialized by <c>ICanControl2.InitLine</c>.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    void Start();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Stops the recovery thread. A pending recovery is cancelled.
+    /// </summary>
+    //*****************************************************************************
+    void Stop();
+  };
+
+}
@@ -0,0 +1,358 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for groups of CAN channels which are brought up
+//            concurrently.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4.Bal.Can
+{
+  using System;
+  using System.Threading;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   <c>CanChannelGroupTiming</c> describes the duration of the startup
+  ///   stages of a channel group (see <c>ICanChannelGroup</c>).
+  /// </summary>
+  //*****************************************************************************
+  public struct CanChannelGroupTiming
+  {
+    private TimeSpan m_tsOpen;     // duration of the open stage
+    private TimeSpan m_tsInit;     // duration of the initialize stage
+    private TimeSpan m_tsActivate; // duration of the activate stage
+    private TimeSpan m_tsSkew;     // spread of the activation times
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Ctor - create a CanChannelGroupTiming object
+    /// </summary>
+    /// <param name="open">duration of the open stage</param>
+    /// <param name="initialize">duration of the initialize stage</param>
+    /// <param name="activate">duration of the activate stage</param>
+    /// <param name="activationSkew">spread of the activation times</param>
+    //*****************************************************************************
+    public CanChannelGroupTiming(TimeSpan open, TimeSpan initialize,
+                                 TimeSpan activate, TimeSpan activationSkew)
+    {
+      m_tsOpen     = open;
+      m_tsInit     = initialize;
+      m_tsActivate = activate;
+      m_tsSkew     = activationSkew;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the time taken to open the sockets of all channels.
+    /// </summary>
+    //*****************************************************************************
+    public TimeSpan Open
+    {
+      get { return m_tsOpen; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the time taken to initialize all channels including the
+    ///   creation of their message readers and writers.
+    /// </summary>
+    //*****************************************************************************
+    public TimeSpan Initialize
+    {
+      get { return m_tsInit; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the time from the release of the activation until the last
+    ///   channel is active.
+    /// </summary>
+    //*****************************************************************************
+    public TimeSpan Activate
+    {
+      get { return m_tsActivate; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the time between the first and the last channel becoming
+    ///   active.
+    /// </summary>
+    //*****************************************************************************
+    public TimeSpan ActivationSkew
+    {
+      get { return m_tsSkew; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method returns a String that represents the timing.
+    /// </summary>
+    /// <returns>
+    ///   A String that represents the timing.
+    /// </returns>
+    //*****************************************************************************
+    public override string ToString()
+    {
+      return String.Format("open {0}, initialize {1}, activate {2}, skew {3}",
+                           m_tsOpen, m_tsInit, m_tsActivate, m_tsSkew);
+    }
+  };
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface represents a group of CAN channels on one or more bus
+  ///   access layers which are opened, initialized and activated together.
+  ///   Opening and initializing runs on several worker threads, so the
+  ///   startup time is bound by the slowest channel instead of the sum of
+  ///   all channels. For the activation every channel gets its own thread
+  ///   which is parked in front of <c>ICanChannel2.Activate</c> and all
+  ///   threads are released at once to keep the skew between the channels
+  ///   small.
+  ///   The received messages of all channels are available through a
+  ///   single merged read and messages are routed to a channel by its
+  ///   index within the group.
+  /// </summary>
+  /// <example>
+  ///   <code>
+  ///   ICanChannelGroup group = VciServer.Instance().CreateChannelGroup();
+  ///   group.AddChannel(bal1, 0);
+  ///   group.AddChannel(bal2, 0);
+  ///   group.AddChannel(bal2, 1);
+  ///
+  ///   group.Open(1024, 128, 1, CanFilterModes.Pass, false);
+  ///   group.Activate();
+  ///   Console.WriteLine(group.Timing);
+  ///
+  ///   ICanMessage2[] messages;
+  ///   int[]          channels;
+  ///   int count = group.ReadMessages(out messages, out channels);
+  ///   ...
+  ///   group.SendMessage(2, message);
+  ///   group.Dispose();
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public interface ICanChannelGroup : IDisposable
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the maximum number of channels opened and initialized
+    ///   at the same time. The default value is 8. The activation always
+    ///   uses one thread per channel.
+    /// </summary>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   The value is less than 1.
+    /// </exception>
+    //*****************************************************************************
+    int  MaxParallel                            { get;
+                                                  set; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of channels of the group.
+    /// </summary>
+    //*****************************************************************************
+    int  ChannelCount                           { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the duration of the startup stages run so far.
+    /// </summary>
+    //*****************************************************************************
+    CanChannelGroupTiming Timing                { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Adds a channel to the group. The index of the channel within the
+    ///   group is its position in the order of the calls.
+    /// </summary>
+    /// <param name="bal">
+    ///   The bus access layer the channel belongs to. The bus access layer
+    ///   is not disposed by the group.
+    /// </param>
+    /// <param name="portNumber">
+    ///   Port number of the channel.
+    /// </param>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter bal was a null reference.
+    /// </exception>
+    /// <exception cref="InvalidOperationException">
+    ///   The group is already open.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    void AddChannel(IBalObject bal, byte portNumber);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets a channel of the group.
+    /// </summary>
+    /// <param name="index">
+    ///   Index of the channel within the group.
+    /// </param>
+    /// <returns>
+    ///   The channel. The channel is owned by the group and must not be
+    ///   disposed by the caller.
+    /// </returns>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   Parameter index is out of range.
+    /// </exception>
+    /// <exception cref="InvalidOperationException">
+    ///   The group is not open.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    ICanChannel2 GetChannel(int index);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Opens and initializes all channels of the group concurrently
+    ///   (see <c>ICanChannel2.Initialize</c>).
+    /// </summary>
+    /// <param name="receiveFifoSize">
+    ///   Size of the receive buffer of each channel.
+    /// </param>
+    /// <param name="transmitFifoSize">
+    ///   Size of the transmit buffer of each channel.
+    /// </param>
+    /// <param name="filterSize">
+    ///   Size of the filter of each channel.
+    /// </param>
+    /// <param name="filterMode">
+    ///   Initial filter mode of each channel.
+    /// </param>
+    /// <param name="exclusive">
+    ///   If this parameter is set to true the channels take exclusive
+    ///   access to their controllers.
+    /// </param>
+    /// <exception cref="AggregateException">
+    ///   At least one channel failed. The inner exceptions are the errors
+    ///   of the failed channels, ordered by channel index.
+    /// </exception>
+    /// <exception cref="InvalidOperationException">
+    ///   The group is already open.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    /// <remarks>
+    ///   If one of the channels fails, all channels are closed again.
+    /// </remarks>
+    //*****************************************************************************
+    void Open( ushort         receiveFifoSize
+             , ushort         transmitFifoSize
+             , uint           filterSize
+             , CanFilterModes filterMode
+             , bool           exclusive );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Activates all channels of the group at nearly the same time.
+    /// </summary>
+    /// <exception cref="AggregateException">
+    ///   At least one channel failed. The inner exceptions are the errors
+    ///   of the failed channels, ordered by channel index.
+    /// </exception>
+    /// <exception cref="InvalidOperationException">
+    ///   The group is not open.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    /// <remarks>
+    ///   If one of the channels fails, the channels which were activated
+    ///   are deactivated again.
+    /// </remarks>
+    //*****************************************************************************
+    void Activate();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Deactivates all channels of the group.
+    /// </summary>
+    /// <exception cref="InvalidOperationException">
+    ///   The group is not open.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    void Deactivate();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Assigns an event to the receive buffers of all channels. The event
+    ///   is set as soon as one of the channels received messages
+    ///   (see <c>ICanMessageReader.AssignEvent</c>).
+    /// </summary>
+    /// <param name="fifoEvent">
+    ///   The event to assign.
+    /// </param>
+    /// <exception cref="InvalidOperationException">
+    ///   The group is not open.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    void AssignEvent(AutoResetEvent fifoEvent);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Reads the messages available in the receive buffers of all
+    ///   channels. The messages of a single channel keep their order.
+    /// </summary>
+    /// <param name="messages">
+    ///   Returns the received messages.
+    /// </param>
+    /// <param name="channels">
+    ///   Returns the index of the receiving channel for each message.
+    /// </param>
+    /// <returns>
+    ///   Number of received messages.
+    /// </returns>
+    /// <exception cref="InvalidOperationException">
+    ///   The group is not open.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    int ReadMessages(out ICanMessage2[] messages, out int[] channels);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Places a message into the transmit buffer of a channel.
+    /// </summary>
+    /// <param name="channel">
+    ///   Index of the transmitting channel within the group.
+    /// </param>
+    /// <param name="message">
+    ///   The message to transmit.
+    /// </param>
+    /// <returns>
+    ///   true if the message was placed into the transmit buffer,
+    ///   false if the buffer is full.
+    /// </returns>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   Parameter channel is out of range.
+    /// </exception>
+    /// <exception cref="InvalidOperationException">
+    ///   The group is not open.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    bool SendMessage(int channel, ICanMessage2 message);
+  };
+
+}
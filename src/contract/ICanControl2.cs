@@ -226,6 +226,48 @@ namespace Ixxat.Vci4.Bal.Can
     //*****************************************************************************
     void  StopLine    ( );
 
+    //*****************************************************************************
+    /// <summary>
+    ///   Resets the CAN line like <c>ResetLine</c>, but reports a failure
+    ///   through the return value instead of a <c>VciException</c>.
+    /// </summary>
+    /// <returns>
+    ///   The result of the operation, see <c>VciResult</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    VciResult TryResetLine( );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Starts the CAN line like <c>StartLine</c>, but reports a failure
+    ///   through the return value instead of a <c>VciException</c>.
+    /// </summary>
+    /// <returns>
+    ///   The result of the operation, see <c>VciResult</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    VciResult TryStartLine( );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Stops the CAN line like <c>StopLine</c>, but reports a failure
+    ///   through the return value instead of a <c>VciException</c>.
+    /// </summary>
+    /// <returns>
+    ///   The result of the operation, see <c>VciResult</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    VciResult TryStopLine ( );
+
     //*****************************************************************************
     /// <summary>
     ///   This method sets the global acceptance filter. The global acceptance
@@ -387,6 +429,212 @@ namespace Ixxat.Vci4.Bal.Can
     /// </exception>
     //*****************************************************************************
     void  RemFilterIds( CanFilter select, uint   code, uint   mask );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method compiles the specified identifier ranges to the smallest
+    ///   possible set of code/mask pairs and registers them at the specified
+    ///   filter list. The method can only be called if the CAN controller
+    ///   is in 'init' mode.
+    /// </summary>
+    /// <param name="select">
+    ///   Filter selection. This parameter can be either <c>CanFilter.Std</c>
+    ///   to select the 11-bit filter list, or <c>CanFilter.Ext</c> to
+    ///   select the 29-bit filter list.
+    /// </param>
+    /// <param name="ranges">
+    ///   Identifier ranges to accept. Ranges may overlap.
+    /// </param>
+    /// <param name="maxEntries">
+    ///   Maximum number of filter entries to use, usually the free space
+    ///   of the filter list.
+    /// </param>
+    /// <returns>
+    ///   The registered code/mask pairs.
+    /// </returns>
+    /// <remarks>
+    ///   The identifiers are covered exactly as long as the budget allows.
+    ///   Otherwise neighbouring entries are merged, each time choosing the
+    ///   merge which passes the fewest unrequested identifiers, until the
+    ///   budget is met. Data and remote frames are accepted.
+    ///   If registering an entry fails, the entries registered so far are
+    ///   removed again.
+    /// </remarks>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter ranges was a null reference.
+    /// </exception>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   A range exceeds the identifier space of the filter selection or
+    ///   <paramref name="maxEntries"/> is less than 1.
+    /// </exception>
+    /// <exception cref="VciException">
+    ///   Registering filter Ids failed.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    CanFilterEntry[] AddFilterIds( CanFilter    select
+                                 , CanIdRange[] ranges
+                                 , int          maxEntries );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method computes the tightest single code/mask pair which
+    ///   accepts all specified identifier ranges and sets it as global
+    ///   acceptance filter (see <c>SetAccFilter</c>).
+    /// </summary>
+    /// <param name="select">
+    ///   Filter selection. This parameter can be either <c>CanFilter.Std</c>
+    ///   to select the 11-bit acceptance filter, or <c>CanFilter.Ext</c> to
+    ///   select the 29-bit acceptance filter.
+    /// </param>
+    /// <param name="ranges">
+    ///   Identifier ranges to accept. An empty array rejects all IDs.
+    /// </param>
+    /// <returns>
+    ///   The code/mask pair set as acceptance filter.
+    /// </returns>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter ranges was a null reference.
+    /// </exception>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   A range exceeds the identifier space of the filter selection.
+    /// </exception>
+    /// <exception cref="VciException">
+    ///   Setting acceptance filter failed.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    CanFilterEntry SetAccFilter  ( CanFilter    select
+                                 , CanIdRange[] ranges );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method returns the code/mask pairs currently registered at the
+    ///   specified filter list by <c>AddFilterIds</c> and <c>SetFilterIds</c>.
+    /// </summary>
+    /// <param name="select">
+    ///   Filter selection. This parameter can be either <c>CanFilter.Std</c>
+    ///   to select the 11-bit filter list, or <c>CanFilter.Ext</c> to
+    ///   select the 29-bit filter list.
+    /// </param>
+    /// <returns>
+    ///   Copy of the shadow filter table, ordered by code and mask.
+    /// </returns>
+    /// <remarks>
+    ///   The table is maintained by the socket and reflects all successful
+    ///   add and remove calls since the last <c>InitLine</c> or
+    ///   <c>ResetLine</c>. Filter changes made by other applications are
+    ///   not visible.
+    /// </remarks>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   Invalid filter selection.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    CanFilterEntry[] GetFilterIds( CanFilter select );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method replaces the content of the specified filter list with
+    ///   the specified code/mask pairs. Only the difference to the current
+    ///   content is transferred to the controller. The method can only be
+    ///   called if the CAN controller is in 'init' mode.
+    /// </summary>
+    /// <param name="select">
+    ///   Filter selection. This parameter can be either <c>CanFilter.Std</c>
+    ///   to select the 11-bit filter list, or <c>CanFilter.Ext</c> to
+    ///   select the 29-bit filter list.
+    /// </param>
+    /// <param name="entries">
+    ///   Code/mask pairs the filter list shall contain afterwards.
+    /// </param>
+    /// <returns>
+    ///   Number of add and remove requests sent to the controller.
+    /// </returns>
+    /// <remarks>
+    ///   Entries are removed before new entries are added. Kept entries
+    ///   which share identifiers with a removed entry are registered again.
+    ///   If a request fails, the filter table reflects the requests
+    ///   executed so far.
+    /// </remarks>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter entries was a null reference.
+    /// </exception>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   Invalid filter selection.
+    /// </exception>
+    /// <exception cref="VciException">
+    ///   Updating filter Ids failed.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    int SetFilterIds( CanFilter        select
+                    , CanFilterEntry[] entries );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method compiles the specified identifier ranges (see
+    ///   <c>AddFilterIds</c>) and replaces the content of the specified
+    ///   filter list with the result (see <c>SetFilterIds</c>).
+    /// </summary>
+    /// <param name="select">
+    ///   Filter selection. This parameter can be either <c>CanFilter.Std</c>
+    ///   to select the 11-bit filter list, or <c>CanFilter.Ext</c> to
+    ///   select the 29-bit filter list.
+    /// </param>
+    /// <param name="ranges">
+    ///   Identifier ranges to accept.
+    /// </param>
+    /// <param name="maxEntries">
+    ///   Maximum number of filter entries to use.
+    /// </param>
+    /// <returns>
+    ///   The code/mask pairs the filter list contains afterwards.
+    /// </returns>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter ranges was a null reference.
+    /// </exception>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   A range exceeds the identifier space of the filter selection or
+    ///   <paramref name="maxEntries"/> is less than 1.
+    /// </exception>
+    /// <exception cref="VciException">
+    ///   Updating filter Ids failed.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    CanFilterEntry[] SetFilterIds( CanFilter    select
+                                 , CanIdRange[] ranges
+                                 , int          maxEntries );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Creates an automatic bus-off recovery for the CAN line of this
+    ///   control socket. The recovery is stopped after creation.
+    /// </summary>
+    /// <returns>
+    ///   A reference to the new bus-off recovery.
+    ///   When no longer needed the recovery object has to be
+    ///   disposed using the IDisposable interface.
+    /// </returns>
+    /// <exception cref="VciException">
+    ///   Creating the status message channel failed.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    ICanBusOffRecovery CreateBusOffRecovery();
   };
 
 
@@ -0,0 +1,312 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the cyclic message jitter and phase analyzer.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4.Bal.Can
+{
+  using System;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   <c>CanCyclicStatistics</c> holds the timing statistics of a single
+  ///   periodic message observed by a cyclic message analyzer
+  ///   (see <c>ICanCyclicAnalyzer</c>).
+  /// </summary>
+  //*****************************************************************************
+  public struct CanCyclicStatistics
+  {
+    private uint     m_dwId;       // message identifier
+    private bool     m_fExtended;  // extended frame format
+    private TimeSpan m_tsExpected; // expected cycle time
+    private long     m_qwFrames;   // number of observed frames
+    private long     m_qwMissed;   // number of missed cycles
+    private double   m_dMean;      // mean period in seconds
+    private double   m_dMin;       // minimum period in seconds
+    private double   m_dMax;       // maximum period in seconds
+    private double   m_dStdDev;    // standard deviation of the period in seconds
+    private double   m_dMaxDev;    // maximum deviation from the expected period in seconds
+    private double   m_dDrift;     // accumulated phase drift in seconds
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Ctor - create a CanCyclicStatistics object
+    /// </summary>
+    /// <param name="identifier">message identifier</param>
+    /// <param name="extended">extended frame format</param>
+    /// <param name="expected">expected cycle time</param>
+    /// <param name="frames">number of observed frames</param>
+    /// <param name="missed">number of missed cycles</param>
+    /// <param name="mean">mean period in seconds</param>
+    /// <param name="min">minimum period in seconds</param>
+    /// <param name="max">maximum period in seconds</param>
+    /// <param name="stddev">standard deviation of the period in seconds</param>
+    /// <param name="maxdev">maximum deviation from the expected period in seconds</param>
+    /// <param name="drift">accumulated phase drift in seconds</param>
+    //*****************************************************************************
+    public CanCyclicStatistics(uint identifier, bool extended, TimeSpan expected,
+                               long frames, long missed,
+                               double mean, double min, double max,
+                               double stddev, double maxdev, double drift)
+    {
+      m_dwId       = identifier;
+      m_fExtended  = extended;
+      m_tsExpected = expected;
+      m_qwFrames   = frames;
+      m_qwMissed   = missed;
+      m_dMean      = mean;
+      m_dMin       = min;
+      m_dMax       = max;
+      m_dStdDev    = stddev;
+      m_dMaxDev    = maxdev;
+      m_dDrift     = drift;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the identifier of the message.
+    /// </summary>
+    //*****************************************************************************
+    public uint Identifier
+    {
+      get { return m_dwId; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets a value indicating whether the message uses the extended
+    ///   frame format.
+    /// </summary>
+    //*****************************************************************************
+    public bool ExtendedFrameFormat
+    {
+      get { return m_fExtended; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the cycle time configured at the scheduler.
+    /// </summary>
+    //*****************************************************************************
+    public TimeSpan ExpectedPeriod
+    {
+      get { return m_tsExpected; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of observed frames.
+    /// </summary>
+    //*****************************************************************************
+    public long FrameCount
+    {
+      get { return m_qwFrames; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of cycles without a frame. An interval of n expected
+    ///   periods (rounded) between two frames counts as n-1 missed cycles.
+    /// </summary>
+    //*****************************************************************************
+    public long MissedCycles
+    {
+      get { return m_qwMissed; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the mean period in seconds. Intervals containing missed
+    ///   cycles are not part of the period statistics.
+    /// </summary>
+    //*****************************************************************************
+    public double MeanPeriod
+    {
+      get { return m_dMean; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the minimum period in seconds.
+    /// </summary>
+    //*****************************************************************************
+    public double MinimumPeriod
+    {
+      get { return m_dMin; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the maximum period in seconds.
+    /// </summary>
+    //*****************************************************************************
+    public double MaximumPeriod
+    {
+      get { return m_dMax; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the jitter, i.e. the standard deviation of the period in seconds.
+    /// </summary>
+    //*****************************************************************************
+    public double Jitter
+    {
+      get { return m_dStdDev; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the maximum absolute deviation of a period from the expected
+    ///   period in seconds.
+    /// </summary>
+    //*****************************************************************************
+    public double MaximumDeviation
+    {
+      get { return m_dMaxDev; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the phase drift in seconds, i.e. the time between the first and
+    ///   the last observed frame minus the number of elapsed cycles multiplied
+    ///   by the expected period. A positive value means the message is
+    ///   transmitted slower than configured.
+    /// </summary>
+    //*****************************************************************************
+    public double PhaseDrift
+    {
+      get { return m_dDrift; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method returns a String that represents the statistics.
+    /// </summary>
+    /// <returns>
+    ///   A String that represents the statistics.
+    /// </returns>
+    //*****************************************************************************
+    public override string ToString()
+    {
+      return String.Format("ID {0:X}{1}: {2} frames, {3} missed, period {4:F6}s (min {5:F6}s, max {6:F6}s), jitter {7:F6}s, drift {8:F6}s",
+                           m_dwId, m_fExtended ? "x" : "", m_qwFrames, m_qwMissed,
+                           m_dMean, m_dMin, m_dMax, m_dStdDev, m_dDrift);
+    }
+  };
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface is used to verify the timing of periodic messages.
+  ///   The analyzer matches received frames against the cyclic transmit
+  ///   messages of a scheduler and computes period, jitter and missed
+  ///   cycles per message with constant memory.
+  ///   The frames can be the self reception echo of the transmitting channel
+  ///   or frames received by a second channel monitoring the bus.
+  /// </summary>
+  /// <example>
+  ///   <code>
+  ///   ICanScheduler2 scheduler = ...
+  ///   ICanMessageReader reader = ...
+  ///
+  ///   // start the cyclic messages first, the analyzer takes over
+  ///   // all messages currently registered at the scheduler
+  ///   ICanCyclicAnalyzer analyzer = scheduler.CreateAnalyzer();
+  ///
+  ///   while (running)
+  ///   {
+  ///     rxEvent.WaitOne(100);
+  ///     analyzer.Process(reader);
+  ///   }
+  ///
+  ///   foreach (CanCyclicStatistics stat in analyzer.GetStatistics())
+  ///   {
+  ///     Console.WriteLine(stat);
+  ///   }
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public interface ICanCyclicAnalyzer
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of messages analyzed.
+    /// </summary>
+    //*****************************************************************************
+    int MessageCount                             { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Adds a cyclic transmit message to the set of analyzed messages.
+    /// </summary>
+    /// <param name="message">
+    ///   The cyclic transmit message. Identifier, frame format and
+    ///   <c>CycleTicks</c> are taken from the message.
+    /// </param>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter message was a null reference.
+    /// </exception>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   <c>CycleTicks</c> of the message is 0.
+    /// </exception>
+    /// <exception cref="IndexOutOfRangeException">
+    ///   The maximum number of analyzed messages is reached.
+    /// </exception>
+    //*****************************************************************************
+    void AddMessage(ICanCyclicTXMsg2 message);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Processes a single received frame. Frames which do not belong to
+    ///   an analyzed message are ignored.
+    /// </summary>
+    /// <param name="message">
+    ///   The received frame.
+    /// </param>
+    //*****************************************************************************
+    void Process(ICanMessage2 message);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Reads all frames currently available in the receive FIFO of the
+    ///   specified reader and processes them. The frames are removed from
+    ///   the FIFO without creating managed message objects.
+    /// </summary>
+    /// <param name="reader">
+    ///   The message reader to read from.
+    /// </param>
+    /// <returns>
+    ///   The number of frames read.
+    /// </returns>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter reader was a null reference.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   The reader is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    int Process(ICanMessageReader reader);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the current statistics of all analyzed messages.
+    /// </summary>
+    /// <returns>
+    ///   Array with one entry per analyzed message.
+    /// </returns>
+    //*****************************************************************************
+    CanCyclicStatistics[] GetStatistics();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Resets the statistics of all analyzed messages.
+    /// </summary>
+    //*****************************************************************************
+    void Reset();
+  };
+
+}
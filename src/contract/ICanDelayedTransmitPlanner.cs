@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the planner of delayed CAN transmissions.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4.Bal.Can
+{
+  using System;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface represents a planner for time accurate transmission
+  ///   sequences (see <c>ICanChannel2.CreateDelayedTransmitPlanner</c>).
+  ///   The planner takes messages with absolute target times, converts the
+  ///   gaps between them into ticks of the delayed transmission timer and
+  ///   places the messages in batches into the transmit buffer of the
+  ///   channel. The controller transmits the messages with its own timer,
+  ///   so the timing does not depend on the host.
+  /// </summary>
+  /// <remarks>
+  ///   A gap longer than <c>ICanSocket2.MaxDelayedTXTicks</c> is split into
+  ///   several delays, each carried by a copy of <c>GapMessage</c>. If no
+  ///   gap message is set, the delay is clamped to the maximum and all
+  ///   following messages are transmitted earlier by the missing time.
+  ///   The target times are converted without accumulating rounding errors.
+  /// </remarks>
+  /// <example>
+  ///   <code>
+  ///   ICanChannel2 channel = ...
+  ///   ICanDelayedTransmitPlanner planner = channel.CreateDelayedTransmitPlanner();
+  ///
+  ///   planner.Add(messages, targetTimes);
+  ///   while (planner.PendingCount > 0)
+  ///   {
+  ///     if (0 == planner.Write())
+  ///       Thread.Sleep(1);   // or wait for the event of the message writer
+  ///   }
+  ///
+  ///   planner.Dispose();
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public interface ICanDelayedTransmitPlanner : IDisposable
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the message transmitted to bridge gaps longer than
+    ///   <c>ICanSocket2.MaxDelayedTXTicks</c>. The message is copied when
+    ///   set. The default is a null reference, which clamps long gaps.
+    /// </summary>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    ICanMessage2? GapMessage                     { get; set; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of planned entries not yet placed into the
+    ///   transmit buffer. Inserted gap messages are included.
+    /// </summary>
+    //*****************************************************************************
+    int PendingCount                             { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of entries placed into the transmit buffer.
+    /// </summary>
+    //*****************************************************************************
+    long TransmitCount                           { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of inserted gap messages.
+    /// </summary>
+    //*****************************************************************************
+    long GapCount                                { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of delays that were clamped to
+    ///   <c>ICanSocket2.MaxDelayedTXTicks</c>.
+    /// </summary>
+    //*****************************************************************************
+    long ClampedCount                            { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Appends a message to the plan.
+    /// </summary>
+    /// <param name="message">
+    ///   Message to transmit. The message is copied, its time stamp is
+    ///   replaced by the computed delay.
+    /// </param>
+    /// <param name="time">
+    ///   Target time of the message relative to the start of the plan.
+    ///   The time must not be less than the time of the previous message.
+    /// </param>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter message was a null reference.
+    /// </exception>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   The target time is negative or less than the previous one.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    void Add( ICanMessage2 message
+            , TimeSpan     time );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Appends several messages to the plan.
+    /// </summary>
+    /// <param name="messages">
+    ///   Messages to transmit.
+    /// </param>
+    /// <param name="times">
+    ///   Target times of the messages relative to the start of the plan,
+    ///   in ascending order.
+    /// </param>
+    /// <exception cref="ArgumentNullException">
+    ///   One of the arrays or messages was a null reference.
+    /// </exception>
+    /// <exception cref="ArgumentException">
+    ///   The arrays differ in length.
+    /// </exception>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   A target time is negative or less than the previous one.
+    ///   The messages before the failing one remain planned.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    void Add( ICanMessage2[] messages
+            , TimeSpan[]     times );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Places as many pending entries as possible into the transmit
+    ///   buffer and returns without waiting.
+    /// </summary>
+    /// <returns>
+    ///   Number of entries placed into the transmit buffer.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    int Write();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Discards all pending entries and starts a new plan. The target
+    ///   times of subsequent messages are relative to the new start.
+    /// </summary>
+    //*****************************************************************************
+    void Clear();
+  };
+
+}
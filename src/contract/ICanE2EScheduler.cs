@@ -0,0 +1,284 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the host driven E2E protected CAN scheduler.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4.Bal.Can
+{
+  using System;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   Enumeration of the end-to-end protection schemes supported by the
+  ///   E2E scheduler (see <c>ICanE2EScheduler</c>).
+  /// </summary>
+  //*****************************************************************************
+  public enum CanE2EProfile : int
+  {
+    /// <summary>
+    ///   The message is transmitted unchanged. Neither counter nor CRC
+    ///   is updated.
+    /// </summary>
+    None         = 0x00,
+    /// <summary>
+    ///   4-bit alive counter at <c>CanE2EConfig.CounterOffset</c> (0..15) and
+    ///   CRC-8/SAE-J1850 (polynomial 0x1D, start value 0xFF, final XOR 0xFF)
+    ///   over all data bytes except the CRC byte at
+    ///   <c>CanE2EConfig.CrcOffset</c>.
+    /// </summary>
+    Crc8SaeJ1850 = 0x01,
+    /// <summary>
+    ///   AUTOSAR E2E profile 1 (data ID mode "both"). 4-bit counter
+    ///   (0..14) at <c>CanE2EConfig.CounterOffset</c> and CRC-8/SAE-J1850
+    ///   over the data ID (low byte, high byte) followed by all data bytes
+    ///   except the CRC byte at <c>CanE2EConfig.CrcOffset</c>.
+    /// </summary>
+    Profile1     = 0x02,
+    /// <summary>
+    ///   AUTOSAR E2E profile 2. CRC at data byte 0, 4-bit counter (0..15)
+    ///   in the low nibble of data byte 1. The CRC-8H2F (polynomial 0x2F)
+    ///   is calculated over data bytes 1..n-1 followed by the entry of
+    ///   <c>CanE2EConfig.DataIdList</c> selected by the counter.
+    /// </summary>
+    Profile2     = 0x03
+  };
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   Protection parameters of a message registered at the E2E scheduler.
+  /// </summary>
+  //*****************************************************************************
+  public struct CanE2EConfig
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the protection scheme.
+    /// </summary>
+    //*****************************************************************************
+    public CanE2EProfile Profile;
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the bit offset of the 4-bit counter within the data
+    ///   field. The value must be a multiple of 4. Ignored by
+    ///   <c>CanE2EProfile.Profile2</c>.
+    /// </summary>
+    //*****************************************************************************
+    public ushort        CounterOffset;
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the bit offset of the CRC byte within the data field.
+    ///   The value must be a multiple of 8. Ignored by
+    ///   <c>CanE2EProfile.Profile2</c>.
+    /// </summary>
+    //*****************************************************************************
+    public ushort        CrcOffset;
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the 16-bit data ID used by <c>CanE2EProfile.Profile1</c>.
+    /// </summary>
+    //*****************************************************************************
+    public ushort        DataId;
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the list of 16 data IDs used by
+    ///   <c>CanE2EProfile.Profile2</c>.
+    /// </summary>
+    //*****************************************************************************
+    public byte[]?       DataIdList;
+  };
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface represents a message registered at an E2E scheduler.
+  /// </summary>
+  //*****************************************************************************
+  public interface ICanE2EMessage
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the cycle time of the message.
+    /// </summary>
+    //*****************************************************************************
+    TimeSpan     CycleTime                       { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the protection parameters of the message.
+    /// </summary>
+    //*****************************************************************************
+    CanE2EConfig Config                          { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the counter value of the last transmitted frame.
+    /// </summary>
+    //*****************************************************************************
+    byte         Counter                         { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of frames of this message placed into the
+    ///   transmit FIFO.
+    /// </summary>
+    //*****************************************************************************
+    long         TransmitCount                   { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of cycles of this message that could not be
+    ///   transmitted because the transmit FIFO was full or the scheduler
+    ///   was late by more than one cycle.
+    /// </summary>
+    //*****************************************************************************
+    long         MissedCount                     { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Updates the payload of the message. The counter and CRC bytes
+    ///   are overwritten by the scheduler on every transmission.
+    /// </summary>
+    /// <param name="data">
+    ///   New payload. At most <c>DataLength</c> bytes are used.
+    /// </param>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter data was a null reference.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   The message was removed from the scheduler.
+    /// </exception>
+    //*****************************************************************************
+    void         SetData(byte[] data);
+  };
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface is used to transmit periodic CAN messages whose
+  ///   alive counter and CRC are recomputed for every transmission.
+  ///   Unlike <c>ICanScheduler2</c>, which only supports the increment modes
+  ///   of <c>CanCyclicTXIncMode</c>, the E2E scheduler is driven by a
+  ///   host thread that places the protected frames into the
+  ///   transmit FIFO of the CAN channel it was created from.
+  /// </summary>
+  /// <example>
+  ///   <code>
+  ///   ICanChannel2 channel = ...
+  ///   channel.Initialize(1024, 1024, 0, CanFilterModes.Pass, false);
+  ///   channel.Activate();
+  ///
+  ///   ICanE2EScheduler e2e = channel.CreateE2EScheduler();
+  ///
+  ///   CanE2EConfig config = new CanE2EConfig();
+  ///   config.Profile       = CanE2EProfile.Profile1;
+  ///   config.CrcOffset     = 0;
+  ///   config.CounterOffset = 8;
+  ///   config.DataId        = 0x123;
+  ///
+  ///   IMessageFactory factory = VciServer.Instance().MsgFactory;
+  ///   ICanMessage2 message = (ICanMessage2)factory.CreateMsg(typeof(ICanMessage2));
+  ///   message.Identifier = 0x100;
+  ///   message.DataLength = 8;
+  ///
+  ///   ICanE2EMessage entry = e2e.AddMessage(message, TimeSpan.FromMilliseconds(10), config);
+  ///   e2e.Start();
+  ///
+  ///   // ...
+  ///
+  ///   e2e.Dispose();
+  ///   channel.Dispose();
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public interface ICanE2EScheduler : IDisposable
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets a value indicating whether the scheduler thread is running.
+    /// </summary>
+    //*****************************************************************************
+    bool IsRunning                               { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the total number of frames placed into the transmit FIFO.
+    /// </summary>
+    //*****************************************************************************
+    long TransmitCount                           { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Adds a periodic message to the scheduler.
+    /// </summary>
+    /// <param name="message">
+    ///   Template of the message. Identifier, frame format, data length and
+    ///   initial payload are taken from the template.
+    /// </param>
+    /// <param name="cycleTime">
+    ///   Cycle time of the message. Must be at least 100 microseconds.
+    /// </param>
+    /// <param name="config">
+    ///   Protection parameters of the message.
+    /// </param>
+    /// <returns>
+    ///   Reference to the registered message.
+    /// </returns>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter message was a null reference.
+    /// </exception>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   The cycle time or an offset in <paramref name="config"/> is out of range.
+    /// </exception>
+    /// <exception cref="ArgumentException">
+    ///   <c>DataIdList</c> does not contain 16 entries for
+    ///   <c>CanE2EProfile.Profile2</c>.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    ICanE2EMessage AddMessage(ICanMessage2 message,
+                              TimeSpan     cycleTime,
+                              CanE2EConfig config);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Removes a message from the scheduler.
+    /// </summary>
+    /// <param name="message">
+    ///   The message to remove.
+    /// </param>
+    /// <returns>
+    ///   true if the message was registered at this scheduler, otherwise false.
+    /// </returns>
+    //*****************************************************************************
+    bool RemoveMessage(ICanE2EMessage message);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Starts the scheduler thread. All registered messages are
+    ///   transmitted for the first time immediately.
+    /// </summary>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    void Start();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Stops the scheduler thread. Counters keep their current values.
+    /// </summary>
+    //*****************************************************************************
+    void Stop();
+  };
+
+}
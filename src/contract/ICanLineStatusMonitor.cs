@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the CAN line status monitor.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4.Bal.Can
+{
+  using System;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   Enumeration of flag values that are used to signalize which parts of
+  ///   the CAN line status have changed (see <c>ICanLineStatusMonitor</c>).
+  /// </summary>
+  //*****************************************************************************
+  [Flags]
+  public enum CanLineStatusChanges : int
+  {
+    /// <summary>
+    ///   Nothing changed
+    /// </summary>
+    None             = 0x00,
+    /// <summary>
+    ///   Operating mode or extended operating mode changed
+    /// </summary>
+    OperatingMode    = 0x01,
+    /// <summary>
+    ///   Controller entered or left the init mode (<c>CanCtrlStatus.InInit</c>)
+    /// </summary>
+    InitMode         = 0x02,
+    /// <summary>
+    ///   Error warning limit exceeded or recovered (<c>CanCtrlStatus.ErrLimit</c>)
+    /// </summary>
+    WarningLevel     = 0x04,
+    /// <summary>
+    ///   Controller entered or left the bus off state (<c>CanCtrlStatus.BusOff</c>)
+    /// </summary>
+    BusOff           = 0x08,
+    /// <summary>
+    ///   Data overrun occurred or was cleared (<c>CanCtrlStatus.Overrun</c>)
+    /// </summary>
+    Overrun          = 0x10,
+    /// <summary>
+    ///   Bus coupling error occurred or was cleared (<c>CanCtrlStatus.BusCErr</c>)
+    /// </summary>
+    BusCouplingError = 0x20,
+    /// <summary>
+    ///   Bus load crossed one of the thresholds in
+    ///   <c>ICanLineStatusMonitor.BusLoadThresholds</c>
+    /// </summary>
+    BusLoad          = 0x40
+  };
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   Provides data for the <c>ICanLineStatusMonitor.LineStatusChanged</c>
+  ///   event.
+  /// </summary>
+  //*****************************************************************************
+  public class CanLineStatusChangedEventArgs : EventArgs
+  {
+    private CanLineStatus2       m_sPrevious; // line status of the previous sample
+    private CanLineStatus2       m_sCurrent;  // line status of the current sample
+    private CanLineStatusChanges m_eChanges;  // changed parts of the line status
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Constructor for new event data.
+    /// </summary>
+    /// <param name="previous">
+    ///   Line status of the previous sample.
+    /// </param>
+    /// <param name="current">
+    ///   Line status of the current sample.
+    /// </param>
+    /// <param name="changes">
+    ///   Changed parts of the line status.
+    /// </param>
+    //*****************************************************************************
+    public CanLineStatusChangedEventArgs( CanLineStatus2       previous
+                                        , CanLineStatus2       current
+                                        , CanLineStatusChanges changes )
+    {
+      m_sPrevious = previous;
+      m_sCurrent  = current;
+      m_eChanges  = changes;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the line status of the previous sample.
+    /// </summary>
+    //*****************************************************************************
+    public CanLineStatus2 Previous
+    {
+      get { return( m_sPrevious ); }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the line status of the current sample.
+    /// </summary>
+    //*****************************************************************************
+    public CanLineStatus2 Current
+    {
+      get { return( m_sCurrent ); }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the changed parts of the line status.
+    /// </summary>
+    //*****************************************************************************
+    public CanLineStatusChanges Changes
+    {
+      get { return( m_eChanges ); }
+    }
+  };
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface represents a CAN socket which samples the line status
+  ///   on a background thread and raises <c>LineStatusChanged</c> only if
+  ///   the status has changed. Unchanged samples are compared within the
+  ///   native status structure and don't create any managed objects.
+  /// </summary>
+  /// <remarks>
+  ///   The VCI doesn't report the error passive state of the controller.
+  ///   The nearest condition, the exceeded error warning limit, is reported
+  ///   as <c>CanLineStatusChanges.WarningLevel</c>.
+  ///   The event is raised on the monitor thread. Handlers should return
+  ///   quickly and must not throw exceptions.
+  /// </remarks>
+  /// <example>
+  ///   <code>
+  ///   ICanLineStatusMonitor monitor = (ICanLineStatusMonitor)
+  ///     bal.OpenSocket(0, typeof(ICanLineStatusMonitor));
+  ///
+  ///   monitor.SampleInterval    = TimeSpan.FromMilliseconds(20);
+  ///   monitor.BusLoadThresholds = new byte[] { 50, 80 };
+  ///   monitor.LineStatusChanged += OnLineStatusChanged;
+  ///   monitor.Start();
+  ///
+  ///   // ...
+  ///
+  ///   CanLineStatus2 status = monitor.CachedLineStatus;
+  ///
+  ///   monitor.Dispose();
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public interface ICanLineStatusMonitor : ICanSocket2
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the interval between two samples of the line status.
+    ///   The default value is 20 milliseconds. A new value is applied
+    ///   immediately.
+    /// </summary>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   The interval is less than 1 millisecond or exceeds
+    ///   <c>Int32.MaxValue</c> milliseconds.
+    /// </exception>
+    //*****************************************************************************
+    TimeSpan SampleInterval                      { get; set; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the bus load thresholds in percent (0..100). A change
+    ///   is reported if the bus load moves from one side of a threshold to
+    ///   the other. The monitor keeps a sorted copy of the values.
+    ///   By default the list is empty and bus load changes are not reported.
+    /// </summary>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   A threshold exceeds 100.
+    /// </exception>
+    //*****************************************************************************
+    byte[] BusLoadThresholds                     { get; set; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the line status of the most recent sample without calling
+    ///   the driver.
+    /// </summary>
+    /// <exception cref="InvalidOperationException">
+    ///   The monitor was never started.
+    /// </exception>
+    //*****************************************************************************
+    CanLineStatus2 CachedLineStatus              { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets a value indicating whether the monitor thread is running.
+    /// </summary>
+    //*****************************************************************************
+    bool IsRunning                               { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the total number of successful samples.
+    /// </summary>
+    //*****************************************************************************
+    long SampleCount                             { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Occurs when a sample differs from the previous sample in one of the
+    ///   parts listed in <c>CanLineStatusChanges</c>.
+    /// </summary>
+    //*****************************************************************************
+    event EventHandler<CanLineStatusChangedEventArgs>? LineStatusChanged;
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Takes the first sample and starts the monitor thread. If the
+    ///   monitor was started before, the first sample is compared with the
+    ///   last cached sample.
+    /// </summary>
+    /// <exception cref="VciException">
+    ///   Getting CAN line status failed.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    void Start();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Stops the monitor thread. The cached line status is kept.
+    /// </summary>
+    //*****************************************************************************
+    void Stop();
+  };
+
+}
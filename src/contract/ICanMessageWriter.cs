@@ -113,6 +113,52 @@ namespace Ixxat.Vci4.Bal.Can
     //*****************************************************************************
     void Unlock();
 
+    //*****************************************************************************
+    /// <summary>
+    ///   Sets the threshold for the trigger event like <c>Threshold</c>,
+    ///   but reports a failure through the return value instead of a
+    ///   <c>VciException</c>.
+    /// </summary>
+    /// <param name="threshold">
+    ///   Threshold for the event trigger.
+    /// </param>
+    /// <returns>
+    ///   The result of the operation, see <c>VciResult</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    VciResult TrySetThreshold(ushort threshold);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Locks the access to the FIFO like <c>Lock</c>, but reports a
+    ///   failure through the return value instead of a <c>VciException</c>.
+    /// </summary>
+    /// <returns>
+    ///   The result of the operation, see <c>VciResult</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    VciResult TryLock();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Releases the access to the FIFO like <c>Unlock</c>, but reports a
+    ///   failure through the return value instead of a <c>VciException</c>.
+    /// </summary>
+    /// <returns>
+    ///   The result of the operation, see <c>VciResult</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    VciResult TryUnlock();
+
     //*****************************************************************************
     /// <summary>
     ///   This method assigns an event object to the message writer. The event
@@ -187,6 +187,34 @@ namespace Ixxat.Vci4.Bal.Can
     //*****************************************************************************
     void Resume      ( );
 
+    //*****************************************************************************
+    /// <summary>
+    ///   Suspends the scheduler like <c>Suspend</c>, but reports a failure
+    ///   through the return value instead of a <c>VciException</c>.
+    /// </summary>
+    /// <returns>
+    ///   The result of the operation, see <c>VciResult</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    VciResult TrySuspend  ( );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Resumes the scheduler like <c>Resume</c>, but reports a failure
+    ///   through the return value instead of a <c>VciException</c>.
+    /// </summary>
+    /// <returns>
+    ///   The result of the operation, see <c>VciResult</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    VciResult TryResume   ( );
+
     //*****************************************************************************
     /// <summary>
     ///   This method suspends execution of the scheduler and removes all
@@ -238,6 +266,45 @@ namespace Ixxat.Vci4.Bal.Can
     /// </remarks>
     //*****************************************************************************
     ICanCyclicTXMsg2 AddMessage( );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method creates an analyzer which verifies the timing of the
+    ///   cyclic transmit messages currently registered at the scheduler.
+    ///   The cycle ticks of the messages are converted using
+    ///   <c>CyclicMessageTimerClockFrequency</c> and
+    ///   <c>CyclicMessageTimerDivisor</c>, received timestamps using
+    ///   <c>TimeStampCounterClockFrequency</c> and
+    ///   <c>TimeStampCounterDivisor</c>.
+    /// </summary>
+    /// <returns>
+    ///   Reference to the analyzer.
+    /// </returns>
+    /// <remarks>
+    ///   Messages added to the scheduler after the analyzer was created can
+    ///   be added to the analyzer by <c>ICanCyclicAnalyzer.AddMessage</c>.
+    /// </remarks>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    ICanCyclicAnalyzer CreateAnalyzer( );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method creates an analyzer which detects periodic messages
+    ///   within a trace and derives cyclic transmit messages for this
+    ///   scheduler. Cycle times are rounded to ticks of the cyclic message
+    ///   timer within <c>MaxCyclicMessageTicks</c>.
+    /// </summary>
+    /// <returns>
+    ///   Reference to the trace analyzer.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    ICanTraceAnalyzer CreateTraceAnalyzer( );
   };
 
   //*****************************************************************************
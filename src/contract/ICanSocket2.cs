@@ -219,6 +219,17 @@ public interface ICanSocket2 : IBalResource
   //*****************************************************************************
   uint             MaxDelayedTXTicks             { get; }
 
+  //*****************************************************************************
+  /// <summary>
+  ///   Gets the converter for the timer ticks of the CAN controller.
+  ///   All calls return the same converter object.
+  /// </summary>
+  /// <exception cref="ObjectDisposedException">
+  ///   Object is already disposed.
+  /// </exception>
+  //*****************************************************************************
+  ICanTimeConverter TimeConverter                { get; }
+
   //*****************************************************************************
   /// <summary>
   ///   Gets the current status of the CAN line.
@@ -422,6 +433,105 @@ public interface ICanSocket2 : IBalResource
   /// </exception>
   //*****************************************************************************
   bool             Supports64BitTimeStamps       { get; }
+
+  //*****************************************************************************
+  /// <summary>
+  ///   Calculates the bit timing for the specified arbitration bit rate
+  ///   from the can clock frequency and the arbitration bit timing ranges
+  ///   of the controller.
+  /// </summary>
+  /// <param name="bitrate">
+  ///   Requested bit rate in bit/s.
+  /// </param>
+  /// <param name="samplePoint">
+  ///   Requested sample point as fraction of the bit time (e.g. 0.875) or
+  ///   0 to use the sample point recommended by CiA 601-3.
+  /// </param>
+  /// <returns>
+  ///   Bit timing value in <c>CanBitrateMode.Raw</c> mode.
+  /// </returns>
+  /// <remarks>
+  ///   All valid prescalers are enumerated. The timing with the smallest
+  ///   bit rate deviation is selected, ties are resolved by the smallest
+  ///   sample point deviation and then by the smallest prescaler.
+  ///   The re-synchronisation jump width is set to the maximum allowed
+  ///   value. Bit rate deviations above 0.5% are not accepted.
+  /// </remarks>
+  /// <exception cref="ArgumentOutOfRangeException">
+  ///   No valid bit timing exists for the requested values.
+  /// </exception>
+  /// <exception cref="ObjectDisposedException">
+  ///   Object is already disposed.
+  /// </exception>
+  //*****************************************************************************
+  CanBitrate2 CalculateArbitrationBitrate( uint   bitrate
+                                         , double samplePoint );
+
+  //*****************************************************************************
+  /// <summary>
+  ///   Calculates the bit timing for the specified fast data bit rate
+  ///   from the can clock frequency and the fast data bit timing ranges
+  ///   of the controller.
+  /// </summary>
+  /// <param name="bitrate">
+  ///   Requested bit rate in bit/s.
+  /// </param>
+  /// <param name="samplePoint">
+  ///   Requested sample point as fraction of the bit time (e.g. 0.75) or
+  ///   0 to use the sample point recommended by CiA 601-3.
+  /// </param>
+  /// <returns>
+  ///   Bit timing value in <c>CanBitrateMode.Raw</c> mode. For bit rates
+  ///   above 1 Mbit/s the transmitter delay offset is set to the sample
+  ///   point.
+  /// </returns>
+  /// <exception cref="ArgumentOutOfRangeException">
+  ///   No valid bit timing exists for the requested values.
+  /// </exception>
+  /// <exception cref="ObjectDisposedException">
+  ///   Object is already disposed.
+  /// </exception>
+  //*****************************************************************************
+  CanBitrate2 CalculateFastDataBitrate   ( uint   bitrate
+                                         , double samplePoint );
+
+  //*****************************************************************************
+  /// <summary>
+  ///   Calculates the bit timing of both phases of a CAN FD bit rate.
+  /// </summary>
+  /// <param name="arbitrationBitrate">
+  ///   Requested arbitration bit rate in bit/s.
+  /// </param>
+  /// <param name="arbitrationSamplePoint">
+  ///   Requested arbitration sample point or 0 (see
+  ///   <c>CalculateArbitrationBitrate</c>).
+  /// </param>
+  /// <param name="fastDataBitrate">
+  ///   Requested fast data bit rate in bit/s.
+  /// </param>
+  /// <param name="fastDataSamplePoint">
+  ///   Requested fast data sample point or 0 (see
+  ///   <c>CalculateFastDataBitrate</c>).
+  /// </param>
+  /// <returns>
+  ///   Bit timing values of both phases.
+  /// </returns>
+  /// <remarks>
+  ///   Both phases are scored together. Timings with the same prescaler
+  ///   for both phases are preferred as recommended by CiA 601-3, even at
+  ///   the cost of a sample point deviation of up to 1%.
+  /// </remarks>
+  /// <exception cref="ArgumentOutOfRangeException">
+  ///   No valid bit timing exists for the requested values.
+  /// </exception>
+  /// <exception cref="ObjectDisposedException">
+  ///   Object is already disposed.
+  /// </exception>
+  //*****************************************************************************
+  CanFdBitrate CalculateBitrate          ( uint   arbitrationBitrate
+                                         , double arbitrationSamplePoint
+                                         , uint   fastDataBitrate
+                                         , double fastDataSamplePoint );
 };
 
 
@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the software filter of the CAN message reader.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4.Bal.Can
+{
+  using System;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface represents the host side exact match filter of a CAN
+  ///   message reader (see <c>ICanMessageReader.SoftwareFilter</c>).
+  ///   If enabled, received data frames whose identifier is not contained
+  ///   in the filter are dropped within the native read path, before any
+  ///   message object is created.
+  /// </summary>
+  /// <remarks>
+  ///   Use the software filter if the required set of identifiers exceeds
+  ///   the size of the hardware filter list or if the controller does not
+  ///   support exact message filtering. In this case the hardware filter
+  ///   is usually set to pass all messages.
+  ///   Only data frames are filtered. Info, error, status and other
+  ///   message types always pass. 11-bit identifiers are kept in a bitmap,
+  ///   29-bit identifiers in a hash set which is guarded by a bloom filter.
+  ///   All members are thread safe.
+  /// </remarks>
+  /// <example>
+  ///   <code>
+  ///   ICanMessageReader reader = channel.GetMessageReader();
+  ///
+  ///   reader.SoftwareFilter.Add(CanFilter.Std, new CanIdRange(0x100, 0x1FF));
+  ///   reader.SoftwareFilter.Add(CanFilter.Ext, 0x18FEF100);
+  ///   reader.SoftwareFilter.Enabled = true;
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public interface ICanSoftwareFilter
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets a value indicating whether the filter is applied.
+    ///   The filter is disabled by default.
+    /// </summary>
+    //*****************************************************************************
+    bool Enabled { get; set; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of 11-bit identifiers contained in the filter.
+    /// </summary>
+    //*****************************************************************************
+    int StdCount { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of 29-bit identifiers contained in the filter.
+    /// </summary>
+    //*****************************************************************************
+    int ExtCount { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of messages which passed the enabled filter.
+    /// </summary>
+    //*****************************************************************************
+    long PassedCount { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of messages dropped by the enabled filter.
+    /// </summary>
+    //*****************************************************************************
+    long DroppedCount { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Adds the specified identifier to the filter.
+    /// </summary>
+    /// <param name="select">
+    ///   Identifier type, either <c>CanFilter.Std</c> or <c>CanFilter.Ext</c>.
+    /// </param>
+    /// <param name="identifier">
+    ///   Identifier to add.
+    /// </param>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   Invalid filter selection or identifier.
+    /// </exception>
+    /// <exception cref="OutOfMemoryException">
+    ///   The 29-bit identifier set could not be enlarged.
+    /// </exception>
+    //*****************************************************************************
+    void Add( CanFilter select, uint identifier );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Adds all identifiers of the specified range to the filter.
+    /// </summary>
+    /// <param name="select">
+    ///   Identifier type, either <c>CanFilter.Std</c> or <c>CanFilter.Ext</c>.
+    /// </param>
+    /// <param name="range">
+    ///   Identifiers to add. For 29-bit identifiers the range is limited
+    ///   to 65536 identifiers, wider ranges should be covered by the
+    ///   hardware filter.
+    /// </param>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   Invalid filter selection or range.
+    /// </exception>
+    /// <exception cref="OutOfMemoryException">
+    ///   The 29-bit identifier set could not be enlarged.
+    /// </exception>
+    //*****************************************************************************
+    void Add( CanFilter select, CanIdRange range );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Removes the specified identifier from the filter.
+    /// </summary>
+    /// <param name="select">
+    ///   Identifier type, either <c>CanFilter.Std</c> or <c>CanFilter.Ext</c>.
+    /// </param>
+    /// <param name="identifier">
+    ///   Identifier to remove.
+    /// </param>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   Invalid filter selection or identifier.
+    /// </exception>
+    //*****************************************************************************
+    void Remove( CanFilter select, uint identifier );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Determines whether the filter contains the specified identifier.
+    /// </summary>
+    /// <param name="select">
+    ///   Identifier type, either <c>CanFilter.Std</c> or <c>CanFilter.Ext</c>.
+    /// </param>
+    /// <param name="identifier">
+    ///   Identifier to look up.
+    /// </param>
+    /// <returns>
+    ///   true if messages with the identifier pass the filter.
+    /// </returns>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   Invalid filter selection.
+    /// </exception>
+    //*****************************************************************************
+    bool Contains( CanFilter select, uint identifier );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Removes all identifiers from the filter. An enabled, empty filter
+    ///   drops all data frames.
+    /// </summary>
+    //*****************************************************************************
+    void Clear();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Resets <c>PassedCount</c> and <c>DroppedCount</c> to 0.
+    /// </summary>
+    //*****************************************************************************
+    void ResetCounters();
+  };
+
+
+}
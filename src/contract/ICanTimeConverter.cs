@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the conversion of CAN timer ticks.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4.Bal.Can
+{
+  using System;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface converts the ticks of the timers of a CAN controller
+  ///   into time values and back (see <c>ICanSocket2.TimeConverter</c>).
+  ///   The converter covers the time stamp counter of received messages,
+  ///   the timer of the delayed transmission and the timer of the cyclic
+  ///   message scheduler.
+  /// </summary>
+  /// <remarks>
+  ///   The tick periods are computed once from the clock frequencies and
+  ///   divisors of the controller and stored as fixed-point values with a
+  ///   64-bit fraction, so a conversion needs no floating-point operation
+  ///   and no division. Results are truncated to whole nanoseconds or
+  ///   ticks and are exact for all practical values. The methods
+  ///   are thread-safe and remain usable after the socket was disposed.
+  /// </remarks>
+  /// <example>
+  ///   <code>
+  ///   ICanSocket2       socket    = ...
+  ///   ICanTimeConverter converter = socket.TimeConverter;
+  ///
+  ///   ICanMessage2 message = ...
+  ///   TimeSpan     time    = converter.TimeStampToTimeSpan(message.TimeStamp);
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public interface ICanTimeConverter
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Converts a time stamp of a received message into nanoseconds.
+    /// </summary>
+    /// <param name="timeStamp">
+    ///   Time stamp in ticks of the time stamp counter.
+    /// </param>
+    /// <returns>
+    ///   Time stamp in nanoseconds.
+    /// </returns>
+    /// <exception cref="NotSupportedException">
+    ///   The controller has no time stamp counter.
+    /// </exception>
+    //*****************************************************************************
+    ulong TimeStampToNanoseconds( ulong timeStamp );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Converts a time stamp of a received message into a time span.
+    /// </summary>
+    /// <param name="timeStamp">
+    ///   Time stamp in ticks of the time stamp counter.
+    /// </param>
+    /// <returns>
+    ///   Time stamp as time span, truncated to 100 nanoseconds.
+    /// </returns>
+    /// <exception cref="NotSupportedException">
+    ///   The controller has no time stamp counter.
+    /// </exception>
+    //*****************************************************************************
+    TimeSpan TimeStampToTimeSpan( ulong timeStamp );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Converts an array of time stamps into nanoseconds.
+    /// </summary>
+    /// <param name="timeStamps">
+    ///   Time stamps in ticks of the time stamp counter.
+    /// </param>
+    /// <param name="nanoseconds">
+    ///   Receives the converted time stamps. The array must be at least
+    ///   as long as <paramref name="timeStamps"/>. The same array may be
+    ///   passed for both parameters.
+    /// </param>
+    /// <exception cref="ArgumentNullException">
+    ///   One of the arrays is a null reference.
+    /// </exception>
+    /// <exception cref="ArgumentException">
+    ///   <paramref name="nanoseconds"/> is too short.
+    /// </exception>
+    /// <exception cref="NotSupportedException">
+    ///   The controller has no time stamp counter.
+    /// </exception>
+    //*****************************************************************************
+    void TimeStampToNanoseconds( ulong[] timeStamps
+                               , ulong[] nanoseconds );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Converts an array of time stamps into time spans.
+    /// </summary>
+    /// <param name="timeStamps">
+    ///   Time stamps in ticks of the time stamp counter.
+    /// </param>
+    /// <param name="timeSpans">
+    ///   Receives the converted time stamps. The array must be at least
+    ///   as long as <paramref name="timeStamps"/>.
+    /// </param>
+    /// <exception cref="ArgumentNullException">
+    ///   One of the arrays is a null reference.
+    /// </exception>
+    /// <exception cref="ArgumentException">
+    ///   <paramref name="timeSpans"/> is too short.
+    /// </exception>
+    /// <exception cref="NotSupportedException">
+    ///   The controller has no time stamp counter.
+    /// </exception>
+    //*****************************************************************************
+    void TimeStampToTimeSpan( ulong[]    timeStamps
+                            , TimeSpan[] timeSpans );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Converts ticks of the delayed transmission timer into nanoseconds.
+    /// </summary>
+    /// <param name="ticks">
+    ///   Number of ticks of the delayed transmission timer.
+    /// </param>
+    /// <returns>
+    ///   Delay in nanoseconds.
+    /// </returns>
+    /// <exception cref="NotSupportedException">
+    ///   The controller does not support delayed transmission.
+    /// </exception>
+    //*****************************************************************************
+    ulong DelayedTXTicksToNanoseconds( ulong ticks );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Converts a delay in nanoseconds into ticks of the delayed
+    ///   transmission timer.
+    /// </summary>
+    /// <param name="nanoseconds">
+    ///   Delay in nanoseconds.
+    /// </param>
+    /// <returns>
+    ///   Number of ticks of the delayed transmission timer. The value is
+    ///   not limited to <c>ICanSocket2.MaxDelayedTXTicks</c>.
+    /// </returns>
+    /// <exception cref="NotSupportedException">
+    ///   The controller does not support delayed transmission.
+    /// </exception>
+    //*****************************************************************************
+    ulong NanosecondsToDelayedTXTicks( ulong nanoseconds );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Converts ticks of the cyclic message scheduler into nanoseconds.
+    /// </summary>
+    /// <param name="ticks">
+    ///   Number of ticks of the cyclic message scheduler.
+    /// </param>
+    /// <returns>
+    ///   Time in nanoseconds.
+    /// </returns>
+    /// <exception cref="NotSupportedException">
+    ///   The controller has no cyclic message scheduler.
+    /// </exception>
+    //*****************************************************************************
+    ulong CyclicTicksToNanoseconds( ulong ticks );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Converts a time in nanoseconds into ticks of the cyclic message
+    ///   scheduler.
+    /// </summary>
+    /// <param name="nanoseconds">
+    ///   Time in nanoseconds.
+    /// </param>
+    /// <returns>
+    ///   Number of ticks of the cyclic message scheduler.
+    /// </returns>
+    /// <exception cref="NotSupportedException">
+    ///   The controller has no cyclic message scheduler.
+    /// </exception>
+    //*****************************************************************************
+    ulong NanosecondsToCyclicTicks( ulong nanoseconds );
+  };
+
+}
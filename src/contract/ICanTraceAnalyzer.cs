@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the trace analyzer which derives a cyclic
+//            scheduler setup from recorded CAN traffic.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4.Bal.Can
+{
+  using System;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   <c>CanPeriodicFrame</c> describes a periodic message detected by a
+  ///   trace analyzer (see <c>ICanTraceAnalyzer</c>).
+  /// </summary>
+  //*****************************************************************************
+  public struct CanPeriodicFrame
+  {
+    private uint     m_dwId;       // message identifier
+    private bool     m_fExtended;  // extended frame format
+    private long     m_qwFrames;   // number of observed frames
+    private TimeSpan m_tsPeriod;   // estimated cycle time
+    private double   m_dDisp;      // relative dispersion of the intervals
+    private ushort   m_wTicks;     // cycle time in scheduler ticks
+    private bool     m_fClamped;   // cycle time exceeds the scheduler range
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Ctor - create a CanPeriodicFrame object
+    /// </summary>
+    /// <param name="identifier">message identifier</param>
+    /// <param name="extended">extended frame format</param>
+    /// <param name="frames">number of observed frames</param>
+    /// <param name="period">estimated cycle time</param>
+    /// <param name="dispersion">relative dispersion of the intervals</param>
+    /// <param name="ticks">cycle time in scheduler ticks</param>
+    /// <param name="clamped">cycle time exceeds the scheduler range</param>
+    //*****************************************************************************
+    public CanPeriodicFrame(uint identifier, bool extended, long frames,
+                            TimeSpan period, double dispersion,
+                            ushort ticks, bool clamped)
+    {
+      m_dwId      = identifier;
+      m_fExtended = extended;
+      m_qwFrames  = frames;
+      m_tsPeriod  = period;
+      m_dDisp     = dispersion;
+      m_wTicks    = ticks;
+      m_fClamped  = clamped;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the identifier of the message.
+    /// </summary>
+    //*****************************************************************************
+    public uint Identifier
+    {
+      get { return m_dwId; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets a value indicating whether the message uses the extended
+    ///   frame format.
+    /// </summary>
+    //*****************************************************************************
+    public bool ExtendedFrameFormat
+    {
+      get { return m_fExtended; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of observed frames.
+    /// </summary>
+    //*****************************************************************************
+    public long FrameCount
+    {
+      get { return m_qwFrames; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the estimated cycle time, i.e. the median of the observed
+    ///   intervals refined by the mean of all intervals close to the median.
+    /// </summary>
+    //*****************************************************************************
+    public TimeSpan Period
+    {
+      get { return m_tsPeriod; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the median absolute deviation of the intervals relative to
+    ///   the period. Small values indicate a strictly periodic message.
+    /// </summary>
+    //*****************************************************************************
+    public double Dispersion
+    {
+      get { return m_dDisp; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the cycle time in ticks of the cyclic message timer
+    ///   (see <c>ICanCyclicTXMsg2.CycleTicks</c>).
+    /// </summary>
+    //*****************************************************************************
+    public ushort CycleTicks
+    {
+      get { return m_wTicks; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets a value indicating whether the cycle time was clamped to the
+    ///   range of the cyclic message timer.
+    /// </summary>
+    //*****************************************************************************
+    public bool IsClamped
+    {
+      get { return m_fClamped; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method returns a String that represents the periodic frame.
+    /// </summary>
+    /// <returns>
+    ///   A String that represents the periodic frame.
+    /// </returns>
+    //*****************************************************************************
+    public override string ToString()
+    {
+      return String.Format("ID {0:X}{1}: period {2} ({3} ticks{4}), {5} frames, dispersion {6:P1}",
+                           m_dwId, m_fExtended ? "x" : "", m_tsPeriod, m_wTicks,
+                           m_fClamped ? ", clamped" : "", m_qwFrames, m_dDisp);
+    }
+  };
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface is used to derive a cyclic scheduler setup from
+  ///   recorded or live CAN traffic. The analyzer detects periodic
+  ///   identifiers and estimates their cycle times robustly using the
+  ///   median and the median absolute deviation of the last intervals,
+  ///   so single late or lost frames do not affect the result.
+  /// </summary>
+  /// <example>
+  ///   <code>
+  ///   ICanScheduler2 scheduler = ...
+  ///   ICanTraceAnalyzer analyzer = scheduler.CreateTraceAnalyzer();
+  ///
+  ///   foreach (ICanMessage2 frame in trace)
+  ///   {
+  ///     analyzer.Process(frame);
+  ///   }
+  ///
+  ///   // register and start the rest-bus simulation
+  ///   foreach (ICanCyclicTXMsg2 message in analyzer.CreateMessages())
+  ///   {
+  ///     message.Start(0);
+  ///   }
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public interface ICanTraceAnalyzer
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the minimum number of frames of an identifier before it
+    ///   is considered periodic. The default value is 5.
+    /// </summary>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   The value is less than 3.
+    /// </exception>
+    //*****************************************************************************
+    int    MinimumFrames                         { get;
+                                                   set; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the maximum relative dispersion (see
+    ///   <c>CanPeriodicFrame.Dispersion</c>) of a periodic identifier.
+    ///   The default value is 0.1.
+    /// </summary>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   The value is not positive.
+    /// </exception>
+    //*****************************************************************************
+    double MaximumDispersion                     { get;
+                                                   set; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Processes a single frame of the trace. Only data frames are
+    ///   considered. The frames must be passed in chronological order.
+    /// </summary>
+    /// <param name="message">
+    ///   The frame to process.
+    /// </param>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter message was a null reference.
+    /// </exception>
+    //*****************************************************************************
+    void Process(ICanMessage2 message);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Reads all frames currently available in the receive FIFO of the
+    ///   specified reader and processes them.
+    /// </summary>
+    /// <param name="reader">
+    ///   The message reader to read from.
+    /// </param>
+    /// <returns>
+    ///   The number of frames read.
+    /// </returns>
+    /// <exception cref="ArgumentNullException">
+    ///   Parameter reader was a null reference.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   The reader is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    int Process(ICanMessageReader reader);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the periodic messages detected so far, ordered by identifier.
+    /// </summary>
+    /// <returns>
+    ///   Array of detected periodic messages.
+    /// </returns>
+    //*****************************************************************************
+    CanPeriodicFrame[] GetPeriodicFrames();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Creates one cyclic transmit message per detected periodic message.
+    ///   Identifier, frame format, data length and the payload of the last
+    ///   observed frame are taken over, the cycle time is rounded to the
+    ///   nearest valid number of ticks.
+    /// </summary>
+    /// <returns>
+    ///   Array of cyclic transmit messages of the scheduler the analyzer
+    ///   was created from. The messages are registered at the scheduler
+    ///   by <c>ICanCyclicTXMsg2.Start</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   The scheduler is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    ICanCyclicTXMsg2[] CreateMessages();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Discards all collected data.
+    /// </summary>
+    //*****************************************************************************
+    void Reset();
+  };
+
+}
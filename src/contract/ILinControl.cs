@@ -152,6 +152,71 @@ namespace Ixxat.Vci4.Bal.Lin
     //*****************************************************************************
     void  WriteMessage(bool        send, 
                        ILinMessage message);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Resets the LIN line like <c>ResetLine</c>, but reports a failure
+    ///   through the return value instead of a <c>VciException</c>.
+    /// </summary>
+    /// <returns>
+    ///   The result of the operation, see <c>VciResult</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    VciResult TryResetLine( );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Starts the LIN line like <c>StartLine</c>, but reports a failure
+    ///   through the return value instead of a <c>VciException</c>.
+    /// </summary>
+    /// <returns>
+    ///   The result of the operation, see <c>VciResult</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    VciResult TryStartLine( );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Stops the LIN line like <c>StopLine</c>, but reports a failure
+    ///   through the return value instead of a <c>VciException</c>.
+    /// </summary>
+    /// <returns>
+    ///   The result of the operation, see <c>VciResult</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    VciResult TryStopLine ( );
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Writes a message like <c>WriteMessage</c>, but reports a failure
+    ///   of the LIN controller through the return value instead of a
+    ///   <c>VciException</c>.
+    /// </summary>
+    /// <param name="send">
+    ///   true to force sending the message directly or false to enter the message
+    ///   into the controller's response table.
+    /// </param>
+    /// <param name="message">
+    ///   The message to be transmitted.
+    /// </param>
+    /// <returns>
+    ///   The result of the operation, see <c>VciResult</c>.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    VciResult TryWriteMessage(bool        send,
+                              ILinMessage message);
   };
 
 
@@ -0,0 +1,314 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the time ordered merge of several message
+//            readers.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4.Bal
+{
+  using System;
+  using System.Threading;
+  using Ixxat.Vci4.Bal.Can;
+  using Ixxat.Vci4.Bal.Lin;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   <c>MergedMessage</c> is a single element of the stream produced by
+  ///   <c>IMessageMerger</c>. It carries a bus independent header and the
+  ///   original message.
+  /// </summary>
+  //*****************************************************************************
+  public struct MergedMessage
+  {
+    private int        m_iSource;   // index of the source
+    private VciBusType m_eBusType;  // bus type of the source
+    private ulong      m_qwTime;    // time stamp in nanoseconds
+    private uint       m_dwId;      // CAN identifier or LIN protected id
+    private byte       m_bLength;   // number of data bytes
+    private Object?    m_pMsg;      // original message
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Ctor - create a MergedMessage object
+    /// </summary>
+    /// <param name="source">index of the source</param>
+    /// <param name="busType">bus type of the source</param>
+    /// <param name="timeStamp">time stamp in nanoseconds</param>
+    /// <param name="identifier">CAN identifier or LIN protected id</param>
+    /// <param name="dataLength">number of data bytes</param>
+    /// <param name="message">original message</param>
+    //*****************************************************************************
+    public MergedMessage(int source, VciBusType busType, ulong timeStamp,
+                         uint identifier, byte dataLength, Object? message)
+    {
+      m_iSource  = source;
+      m_eBusType = busType;
+      m_qwTime   = timeStamp;
+      m_dwId     = identifier;
+      m_bLength  = dataLength;
+      m_pMsg     = message;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the index of the source as returned by
+    ///   <c>IMessageMerger.AddSource</c>.
+    /// </summary>
+    //*****************************************************************************
+    public int Source
+    {
+      get { return m_iSource; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the bus type of the source.
+    /// </summary>
+    //*****************************************************************************
+    public VciBusType BusType
+    {
+      get { return m_eBusType; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the time stamp of the message in nanoseconds. The 32-bit
+    ///   time stamp of the message is extended by counting the overruns
+    ///   of the time stamp counter.
+    /// </summary>
+    //*****************************************************************************
+    public ulong TimeStamp
+    {
+      get { return m_qwTime; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the CAN identifier or the LIN protected identifier.
+    /// </summary>
+    //*****************************************************************************
+    public uint Identifier
+    {
+      get { return m_dwId; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of data bytes.
+    /// </summary>
+    //*****************************************************************************
+    public byte DataLength
+    {
+      get { return m_bLength; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the original CAN message or a null reference if the source
+    ///   is no CAN source.
+    /// </summary>
+    //*****************************************************************************
+    public ICanMessage2? CanMessage
+    {
+      get { return m_pMsg as ICanMessage2; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the original LIN message or a null reference if the source
+    ///   is no LIN source.
+    /// </summary>
+    //*****************************************************************************
+    public ILinMessage? LinMessage
+    {
+      get { return m_pMsg as ILinMessage; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method returns a String that represents the message.
+    /// </summary>
+    /// <returns>
+    ///   A String that represents the message.
+    /// </returns>
+    //*****************************************************************************
+    public override string ToString()
+    {
+      return String.Format("{0} {1} {2} ns: id 0x{3:X}, {4} bytes",
+                           m_iSource, m_eBusType, m_qwTime, m_dwId, m_bLength);
+    }
+  };
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface merges the messages of several CAN and LIN message
+  ///   readers into a single stream ordered by time stamp. The messages
+  ///   of each source are buffered separately and merged by a min-heap
+  ///   over the oldest buffered message of each source.
+  ///   A message is released as soon as every source has buffered a
+  ///   message, or as soon as a message at least <c>ReorderWindow</c>
+  ///   younger was received from any source. Sources which are silent
+  ///   thus delay the stream by at most the reorder window.
+  /// </summary>
+  /// <remarks>
+  ///   The time stamps of all sources are compared in nanoseconds. Sources
+  ///   should share a common time base, i.e. the controllers should be
+  ///   started at the same time (see <c>ICanChannelGroup</c>).
+  ///   The members of this interface are not thread safe.
+  /// </remarks>
+  /// <example>
+  ///   <code>
+  ///   IMessageMerger merger = VciServer.Instance().CreateMessageMerger();
+  ///   merger.AddSource(canReader1, canChannel1);
+  ///   merger.AddSource(canReader2, canChannel2);
+  ///   merger.AddSource(linReader, linMonitor);
+  ///   merger.AssignEvent(rxEvent);
+  ///
+  ///   MergedMessage[] messages;
+  ///   while (rxEvent.WaitOne(100))
+  ///   {
+  ///     merger.ReadMessages(out messages);
+  ///     ...
+  ///   }
+  ///   merger.Flush(out messages);
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public interface IMessageMerger : IDisposable
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets or sets the reorder window. The default value is 10 ms.
+    /// </summary>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   The value is negative.
+    /// </exception>
+    //*****************************************************************************
+    TimeSpan ReorderWindow                      { get;
+                                                  set; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of registered sources.
+    /// </summary>
+    //*****************************************************************************
+    int      SourceCount                        { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of buffered messages not yet released.
+    /// </summary>
+    //*****************************************************************************
+    int      PendingCount                       { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of messages which were received after a younger
+    ///   message was already released, i.e. which arrived outside of the
+    ///   reorder window. These messages are released out of order.
+    /// </summary>
+    //*****************************************************************************
+    long     LateCount                          { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Registers a CAN message reader.
+    /// </summary>
+    /// <param name="reader">
+    ///   The message reader. The reader is not disposed by the merger.
+    /// </param>
+    /// <param name="socket">
+    ///   The socket the reader belongs to. Its <c>TimeConverter</c>
+    ///   is used to convert the time stamps.
+    /// </param>
+    /// <returns>
+    ///   Index of the source.
+    /// </returns>
+    /// <exception cref="ArgumentNullException">
+    ///   One of the parameters was a null reference.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    int AddSource(ICanMessageReader reader, ICanSocket2 socket);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Registers a LIN message reader.
+    /// </summary>
+    /// <param name="reader">
+    ///   The message reader. The reader is not disposed by the merger.
+    /// </param>
+    /// <param name="socket">
+    ///   The socket the reader belongs to. Its <c>ClockFrequency</c> and
+    ///   <c>TimeStampCounterDivisor</c> are used to convert the time stamps.
+    /// </param>
+    /// <returns>
+    ///   Index of the source.
+    /// </returns>
+    /// <exception cref="ArgumentNullException">
+    ///   One of the parameters was a null reference.
+    /// </exception>
+    /// <exception cref="ArgumentException">
+    ///   The socket reports no time stamp clock.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    int AddSource(ILinMessageReader reader, ILinSocket socket);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Assigns an event to the readers of all registered sources.
+    /// </summary>
+    /// <param name="fifoEvent">
+    ///   The event to assign.
+    /// </param>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    void AssignEvent(AutoResetEvent fifoEvent);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Reads the available messages of all sources and returns the
+    ///   messages which are released by the merge.
+    /// </summary>
+    /// <param name="messages">
+    ///   Returns the released messages in time stamp order.
+    /// </param>
+    /// <returns>
+    ///   Number of released messages.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    int ReadMessages(out MergedMessage[] messages);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Reads the available messages of all sources and returns all
+    ///   buffered messages regardless of the reorder window.
+    /// </summary>
+    /// <param name="messages">
+    ///   Returns the buffered messages in time stamp order.
+    /// </param>
+    /// <returns>
+    ///   Number of returned messages.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    int Flush(out MergedMessage[] messages);
+  };
+
+}
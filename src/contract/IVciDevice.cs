@@ -8,6 +8,7 @@
 namespace Ixxat.Vci4 
 {
   using System;
+  using System.Collections.Generic;
   using System.ComponentModel;
 
   //*****************************************************************************
@@ -155,6 +156,26 @@ namespace Ixxat.Vci4
     //*****************************************************************************
     IVciCtrlInfo[] Equipment { get; }
 
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets a read-only list of the fieldbus controllers of the device.
+    ///   The device capabilities are read on the first access only and
+    ///   cached until the device object is disposed, so this property can
+    ///   be polled without driver calls or allocations.
+    /// </summary>
+    /// <returns>
+    ///   The retrieved list contains a <c>VciCtrlInfo</c> for each 
+    ///   existing fieldbus controller.
+    /// </returns>
+    /// <exception cref="VciException">
+    ///   Reading the device capabilities failed.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    IList<IVciCtrlInfo> Controllers { get; }
+
     //*****************************************************************************
     /// <summary>
     ///   This method is called to open the Bus Access Layer.
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the live VCI device inventory.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4
+{
+  using System;
+  using System.Collections.Generic;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   Provides the device of the <c>IVciDeviceInventory.Added</c> and
+  ///   <c>IVciDeviceInventory.Removed</c> events.
+  /// </summary>
+  //*****************************************************************************
+  public class VciDeviceEventArgs : EventArgs
+  {
+    private IVciDevice m_pDevice;  // added or removed device
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Ctor - create a VciDeviceEventArgs object
+    /// </summary>
+    /// <param name="device">added or removed device</param>
+    //*****************************************************************************
+    public VciDeviceEventArgs(IVciDevice device)
+    {
+      m_pDevice = device;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the added or removed device.
+    /// </summary>
+    //*****************************************************************************
+    public IVciDevice Device
+    {
+      get { return m_pDevice; }
+    }
+  };
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   This interface represents a live inventory of the installed VCI
+  ///   devices. The inventory subscribes to the change event of the device
+  ///   list once and rescans the devices only when the list changed. The
+  ///   result of a rescan is compared with the previous one by
+  ///   <c>IVciDevice.VciObjectId</c> and <c>IVciDevice.UniqueHardwareId</c>,
+  ///   unchanged devices keep their device object.
+  ///   The current state is kept in an immutable snapshot which is replaced
+  ///   as a whole, so reading the inventory never blocks. Each snapshot
+  ///   indexes the devices by object id and by normalized hardware id, so
+  ///   both lookups are done without enumerating the devices.
+  ///   When no longer needed the inventory has to be disposed using the
+  ///   IDisposable interface.
+  /// </summary>
+  /// <remarks>
+  ///   The device objects are owned by the inventory and must not be
+  ///   disposed by the caller. A removed device is disposed after the
+  ///   <c>Removed</c> event returned, also if the caller still holds it
+  ///   from <c>Devices</c> or <c>FindDevice</c>. From then on its members
+  ///   throw <c>ObjectDisposedException</c>. Disposing the inventory
+  ///   disposes all of its devices.
+  ///   The events are raised on a worker thread of the inventory, or on
+  ///   the calling thread of <c>Rescan</c>, after the new snapshot was
+  ///   published and without holding any lock of the inventory. Events
+  ///   of concurrent rescans may therefore interleave.
+  /// </remarks>
+  /// <example>
+  ///   <code>
+  ///   IVciDeviceInventory inventory = deviceManager.GetDeviceInventory();
+  ///   inventory.Added   += (s, e) => Console.WriteLine("+ " + e.Device);
+  ///   inventory.Removed += (s, e) => Console.WriteLine("- " + e.Device);
+  ///
+  ///   IVciDevice? device = inventory.FindDevice(objectId);
+  ///   IVciDevice? usb    = inventory.FindDeviceByHardwareId("HW123456");
+  ///   ...
+  ///   inventory.Dispose();
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public interface IVciDeviceInventory : IDisposable
+  {
+    //*****************************************************************************
+    /// <summary>
+    ///   Occurs after a device was added to the inventory.
+    /// </summary>
+    //*****************************************************************************
+    event EventHandler<VciDeviceEventArgs>? Added;
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Occurs after a device was removed from the inventory. The device
+    ///   is disposed when the event handlers returned.
+    /// </summary>
+    //*****************************************************************************
+    event EventHandler<VciDeviceEventArgs>? Removed;
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the devices of the current snapshot. The returned list is
+    ///   read-only and does not change when the inventory is updated.
+    /// </summary>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    IList<IVciDevice> Devices                   { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the number of rescans done since the inventory was created.
+    ///   The value changes whenever a new snapshot is published.
+    /// </summary>
+    //*****************************************************************************
+    long ScanCount                              { get; }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Searches the current snapshot for a device.
+    /// </summary>
+    /// <param name="vciObjectId">
+    ///   VCI object id of the device (see <c>IVciDevice.VciObjectId</c>).
+    /// </param>
+    /// <returns>
+    ///   The device or a null reference if the device is not installed.
+    /// </returns>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    IVciDevice? FindDevice(long vciObjectId);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Searches the current snapshot for a device by its hardware id.
+    ///   GUIDs and strings which parse as GUID match the GUID hardware ids,
+    ///   other strings are compared case insensitive and without leading or
+    ///   trailing blanks.
+    /// </summary>
+    /// <param name="hardwareId">
+    ///   Hardware id of the device (see <c>IVciDevice.UniqueHardwareId</c>)
+    ///   as <c>Guid</c> or <c>string</c>.
+    /// </param>
+    /// <returns>
+    ///   The device or a null reference if the device is not installed.
+    /// </returns>
+    /// <exception cref="ArgumentNullException">
+    ///   hardwareId is a null reference.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    IVciDevice? FindDeviceByHardwareId(object hardwareId);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Rescans the devices immediately in the calling thread. The events
+    ///   for the changes found are raised before the method returns.
+    /// </summary>
+    /// <exception cref="VciException">
+    ///   Enumerating the devices failed.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    void Rescan();
+  };
+
+}
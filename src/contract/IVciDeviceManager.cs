@@ -55,6 +55,24 @@ namespace Ixxat.Vci4
     /// </exception>
     //*****************************************************************************
     IVciDeviceList GetDeviceList();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Creates a live inventory of the installed VCI devices which is
+    ///   updated whenever devices are added or removed.
+    /// </summary>
+    /// <returns>
+    ///   The device inventory. The inventory remains valid after the
+    ///   device manager is disposed.
+    /// </returns>
+    /// <exception cref="VciException">
+    ///   Thrown if creation of the inventory failed.
+    /// </exception>
+    /// <exception cref="ObjectDisposedException">
+    ///   Object is already disposed.
+    /// </exception>
+    //*****************************************************************************
+    IVciDeviceInventory GetDeviceInventory();
   };
 
 
@@ -62,6 +62,18 @@ namespace Ixxat.Vci4
     //*****************************************************************************
     IMessageFactory MsgFactory { get; }
 
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the steps of the server initialization in the order they ran,
+    ///   together with the time taken by each step. The trace is recorded
+    ///   once, when the server singleton is created.
+    /// </summary>
+    /// <returns>
+    ///   A copy of the startup trace.
+    /// </returns>
+    //*****************************************************************************
+    VciStartupStep[] StartupTrace { get; }
+
     //*****************************************************************************
     /// <summary>
     /// Get VCI error message
@@ -70,6 +82,73 @@ namespace Ixxat.Vci4
     /// <returns>Error string</returns>
     //*****************************************************************************
     string GetErrorMsg(int errorCode);
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Creates a service which detects the bit rate of several CAN
+    ///   controllers concurrently.
+    /// </summary>
+    /// <returns>
+    ///   A new bit rate detector. The detected bit rates are cached per
+    ///   controller and shared by all detectors of the process.
+    /// </returns>
+    //*****************************************************************************
+    Ixxat.Vci4.Bal.Can.ICanBitrateDetector CreateBitrateDetector();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Creates a group of CAN channels which are opened, initialized and
+    ///   activated together.
+    /// </summary>
+    /// <returns>
+    ///   A new, empty channel group.
+    /// </returns>
+    //*****************************************************************************
+    Ixxat.Vci4.Bal.Can.ICanChannelGroup CreateChannelGroup();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Creates a merger which combines the messages of several CAN and
+    ///   LIN message readers into a single stream ordered by time stamp.
+    /// </summary>
+    /// <returns>
+    ///   A new message merger without sources.
+    /// </returns>
+    //*****************************************************************************
+    Ixxat.Vci4.Bal.IMessageMerger CreateMessageMerger();
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Opens the native devices, the bus access layers and the requested
+    ///   sockets of several devices concurrently. At most
+    ///   <paramref name="maxParallel"/> devices are processed at the same
+    ///   time. A failure of one device does not affect the others, it is
+    ///   reported by <c>VciWarmUpResult.Error</c>.
+    /// </summary>
+    /// <param name="devices">
+    ///   Devices to warm up.
+    /// </param>
+    /// <param name="socketTypes">
+    ///   Socket types to open on every bus port, e.g.
+    ///   <c>typeof(ICanControl2)</c>, or a null reference to open the bus
+    ///   access layers only. Types which do not fit the bus type of a port
+    ///   are skipped for that port.
+    /// </param>
+    /// <param name="maxParallel">
+    ///   Maximum number of devices processed at the same time.
+    /// </param>
+    /// <returns>
+    ///   One result per device in the order of <paramref name="devices"/>.
+    ///   The caller owns the opened objects.
+    /// </returns>
+    /// <exception cref="ArgumentNullException">
+    ///   devices is a null reference.
+    /// </exception>
+    /// <exception cref="ArgumentOutOfRangeException">
+    ///   maxParallel is less than 1.
+    /// </exception>
+    //*****************************************************************************
+    VciWarmUpResult[] WarmUp(IVciDevice[] devices, Type[]? socketTypes, int maxParallel);
   };
 
 
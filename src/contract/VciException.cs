@@ -14,11 +14,23 @@ namespace Ixxat.Vci4
   //*****************************************************************************
   /// <summary>
   ///   This class implements the basic VCI exception object.
+  ///   Exceptions created from an error code format their message on the
+  ///   first read of <c>Message</c> only, so exceptions which are caught
+  ///   and dropped do not pay for the formatting.
   /// </summary>
   //*****************************************************************************
   [Serializable]
   public class VciException : Exception
   {
+    //--------------------------------------------------------------------
+    // member variables
+    //--------------------------------------------------------------------
+
+    [NonSerialized]
+    private IVciServer? m_pServer;   // formats the message, null once formatted
+    private string?     m_sAppend;   // text appended to the formatted message
+    private string?     m_sMessage;  // formatted message or null
+
     //--------------------------------------------------------------------
     // properties
     //--------------------------------------------------------------------
@@ -30,9 +42,9 @@ namespace Ixxat.Vci4
     /// <param name="server">Server instance to get error string from</param>
     //*****************************************************************************
     public VciException(IVciServer server)
-      : base(server.GetErrorMsg(Marshal.GetHRForLastWin32Error()))
     {
       this.HResult = Marshal.GetHRForLastWin32Error();
+      m_pServer    = server;
     }
 
     //*****************************************************************************
@@ -43,9 +55,9 @@ namespace Ixxat.Vci4
     /// <param name="errorCode">Error code</param>
     //*****************************************************************************
     public VciException(IVciServer server, int errorCode)
-      : base(server.GetErrorMsg(errorCode))
     {
       this.HResult = errorCode;
+      m_pServer    = server;
     }
 
     //*****************************************************************************
@@ -71,9 +83,10 @@ namespace Ixxat.Vci4
     public VciException(IVciServer server
                        , string msgappend 
                        , int    errorCode)
-      : base(server.GetErrorMsg(errorCode) + msgappend)
     {
       this.HResult = errorCode;
+      m_pServer    = server;
+      m_sAppend    = msgappend;
     }
 
     //*****************************************************************************
@@ -88,6 +101,83 @@ namespace Ixxat.Vci4
       : base(message, innerException)
     {
     }
+
+#pragma warning disable SYSLIB0051 // legacy serialization is still supported
+    //*****************************************************************************
+    /// <summary>
+    /// create a VCI exception from serialized data
+    /// </summary>
+    /// <param name="info">Serialized object data</param>
+    /// <param name="context">Source of the serialized data</param>
+    //*****************************************************************************
+    protected VciException( SerializationInfo info
+                          , StreamingContext  context)
+      : base(info, context)
+    {
+      m_sMessage = info.GetString("VciMessage");
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Sets the SerializationInfo with information about the exception.
+    ///   The message is formatted before, because the VCI server which
+    ///   formats it is not serialized.
+    /// </summary>
+    /// <param name="info">Receives the serialized object data</param>
+    /// <param name="context">Destination of the serialized data</param>
+    //*****************************************************************************
+#if NET8_0_OR_GREATER
+    [Obsolete("This API supports obsolete formatter-based serialization.", DiagnosticId = "SYSLIB0051")]
+#endif
+    public override void GetObjectData( SerializationInfo info
+                                      , StreamingContext  context)
+    {
+      if (null == info)
+      {
+        throw new ArgumentNullException("info");
+      }
+
+      info.AddValue("VciMessage", this.Message);
+      base.GetObjectData(info, context);
+    }
+#pragma warning restore SYSLIB0051
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the message that describes the exception. For exceptions
+    ///   created from an error code the message is formatted by the VCI
+    ///   server on the first call.
+    /// </summary>
+    //*****************************************************************************
+    public override string Message
+    {
+      get
+      {
+        if (null == m_sMessage)
+        {
+          IVciServer? server = m_pServer;
+          if (null == server)
+          {
+            return base.Message;
+          }
+
+          string message;
+          try
+          {
+            message = server.GetErrorMsg(this.HResult);
+          }
+          catch (VciException)
+          {
+            // the error text cannot be formatted without the VCI
+            message = String.Format("VCI error 0x{0:X8}", this.HResult);
+          }
+
+          m_sMessage = message + m_sAppend;
+          m_pServer  = null;
+        }
+        return m_sMessage;
+      }
+    }
   };
 
 
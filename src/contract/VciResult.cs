@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the result of exception-free VCI operations.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4
+{
+  using System;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   <c>VciResult</c> holds the error code returned by the <c>Try</c>
+  ///   methods, e.g. <c>ICanControl2.TryStartLine</c>. Other than the
+  ///   methods which throw a <c>VciException</c>, these methods report
+  ///   failures without allocating, which keeps error handling in tight
+  ///   loops cheap.
+  /// </summary>
+  /// <example>
+  ///   <code>
+  ///   VciResult result = control.TryStartLine();
+  ///   if (!result.Succeeded)
+  ///   {
+  ///     // retry later or report result.HResult
+  ///   }
+  ///   </code>
+  /// </example>
+  //*****************************************************************************
+  public struct VciResult
+  {
+    private int m_iHResult;  // error code, see VciError
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Ctor - create a VciResult object
+    /// </summary>
+    /// <param name="hresult">error code, see <c>VciError</c></param>
+    //*****************************************************************************
+    public VciResult(int hresult)
+    {
+      m_iHResult = hresult;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the error code of the operation (see <c>VciError</c>).
+    /// </summary>
+    //*****************************************************************************
+    public int HResult
+    {
+      get { return m_iHResult; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets a value indicating whether the operation succeeded.
+    /// </summary>
+    //*****************************************************************************
+    public bool Succeeded
+    {
+      get { return (int) VciError.VCI_OK == m_iHResult; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Creates the exception the throwing counterpart of the operation
+    ///   would have thrown.
+    /// </summary>
+    /// <param name="server">Server instance to get error string from</param>
+    /// <returns>
+    ///   A new VciException for the error code.
+    /// </returns>
+    //*****************************************************************************
+    public VciException ToException(IVciServer server)
+    {
+      return new VciException(server, m_iHResult);
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method returns a String that represents the result.
+    /// </summary>
+    /// <returns>
+    ///   A String that represents the result.
+    /// </returns>
+    //*****************************************************************************
+    public override string ToString()
+    {
+      return String.Format("0x{0:X8}", m_iHResult);
+    }
+  };
+
+}
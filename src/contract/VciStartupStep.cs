@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the steps of the VCI server startup trace.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4
+{
+  using System;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   <c>VciStartupStep</c> describes one step of the VCI server
+  ///   initialization and the time taken by it (see
+  ///   <c>IVciServer.StartupTrace</c>).
+  /// </summary>
+  //*****************************************************************************
+  public struct VciStartupStep
+  {
+    private string   m_sName;     // name of the step
+    private TimeSpan m_tsTime;    // duration of the step
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Ctor - create a VciStartupStep object
+    /// </summary>
+    /// <param name="name">name of the step</param>
+    /// <param name="duration">duration of the step</param>
+    //*****************************************************************************
+    public VciStartupStep(string name, TimeSpan duration)
+    {
+      m_sName  = name;
+      m_tsTime = duration;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the name of the step, e.g. "LoadLibrary" or "VciInitialize".
+    /// </summary>
+    //*****************************************************************************
+    public string Name
+    {
+      get { return m_sName; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the time taken by the step.
+    /// </summary>
+    //*****************************************************************************
+    public TimeSpan Duration
+    {
+      get { return m_tsTime; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method returns a String that represents the step.
+    /// </summary>
+    /// <returns>
+    ///   A String that represents the step.
+    /// </returns>
+    //*****************************************************************************
+    public override string ToString()
+    {
+      return String.Format("{0} {1}", m_sName, m_tsTime);
+    }
+  };
+
+}
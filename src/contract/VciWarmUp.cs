@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the result of a device warm-up.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+namespace Ixxat.Vci4
+{
+  using System;
+  using Ixxat.Vci4.Bal;
+
+
+  //*****************************************************************************
+  /// <summary>
+  ///   <c>VciWarmUpResult</c> describes the objects opened for one device
+  ///   by <c>IVciServer.WarmUp</c> and the time taken by each step.
+  /// </summary>
+  /// <remarks>
+  ///   The bus access layer and the sockets are owned by the caller and
+  ///   have to be disposed when no longer needed.
+  /// </remarks>
+  //*****************************************************************************
+  public struct VciWarmUpResult
+  {
+    private IVciDevice     m_pDevice;   // warmed up device
+    private IBalObject?    m_pBal;      // opened bus access layer
+    private IBalResource[] m_aSockets;  // opened sockets
+    private TimeSpan       m_tsDevice;  // duration of the device open
+    private TimeSpan       m_tsBal;     // duration of the BAL open
+    private TimeSpan       m_tsSockets; // duration of the socket opens
+    private Exception?     m_pError;    // error of the failed step
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Ctor - create a VciWarmUpResult object
+    /// </summary>
+    /// <param name="device">warmed up device</param>
+    /// <param name="bal">opened bus access layer or null</param>
+    /// <param name="sockets">opened sockets</param>
+    /// <param name="deviceTime">duration of the device open</param>
+    /// <param name="balTime">duration of the BAL open</param>
+    /// <param name="socketTime">duration of the socket opens</param>
+    /// <param name="error">error of the failed step or null</param>
+    //*****************************************************************************
+    public VciWarmUpResult(IVciDevice device, IBalObject? bal, IBalResource[] sockets,
+                           TimeSpan deviceTime, TimeSpan balTime, TimeSpan socketTime,
+                           Exception? error)
+    {
+      m_pDevice   = device;
+      m_pBal      = bal;
+      m_aSockets  = sockets;
+      m_tsDevice  = deviceTime;
+      m_tsBal     = balTime;
+      m_tsSockets = socketTime;
+      m_pError    = error;
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the device.
+    /// </summary>
+    //*****************************************************************************
+    public IVciDevice Device
+    {
+      get { return m_pDevice; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the opened bus access layer or a null reference if the
+    ///   warm-up of the device failed.
+    /// </summary>
+    //*****************************************************************************
+    public IBalObject? Bal
+    {
+      get { return m_pBal; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the opened sockets. For each bus port of the BAL the array
+    ///   contains one socket per requested socket type which fits the bus
+    ///   type of the port, in the order port by port.
+    /// </summary>
+    //*****************************************************************************
+    public IBalResource[] Sockets
+    {
+      get { return m_aSockets; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the time taken to open the native device and to read its
+    ///   capabilities.
+    /// </summary>
+    //*****************************************************************************
+    public TimeSpan DeviceTime
+    {
+      get { return m_tsDevice; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the time taken to open the bus access layer.
+    /// </summary>
+    //*****************************************************************************
+    public TimeSpan BalTime
+    {
+      get { return m_tsBal; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the time taken to open all sockets of the device.
+    /// </summary>
+    //*****************************************************************************
+    public TimeSpan SocketTime
+    {
+      get { return m_tsSockets; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the error of the failed step or a null reference if the
+    ///   warm-up succeeded. The objects opened before the failure are
+    ///   already disposed.
+    /// </summary>
+    //*****************************************************************************
+    public Exception? Error
+    {
+      get { return m_pError; }
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   This method returns a String that represents the result.
+    /// </summary>
+    /// <returns>
+    ///   A String that represents the result.
+    /// </returns>
+    //*****************************************************************************
+    public override string ToString()
+    {
+      return String.Format("{0}: device {1}, bal {2}, sockets {3} ({4}){5}",
+                           m_pDevice, m_tsDevice, m_tsBal, m_tsSockets,
+                           m_aSockets.Length,
+                           (null != m_pError) ? ", " + m_pError.Message : "");
+    }
+  };
+
+}
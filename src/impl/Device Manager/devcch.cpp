@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the process wide cache of native VCI objects.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "devcch.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4;
+using namespace System::Threading;
+
+
+//*****************************************************************************
+/// <summary>
+///   Gets the native device manager. The manager is requested from the
+///   VCI on the first call only.
+/// </summary>
+/// <param name="ppDevMan">
+///   Receives the native device manager. The caller has to release the
+///   returned interface.
+/// </param>
+/// <returns>
+///   VCI_OK on success, otherwise the error code of the VCI.
+/// </returns>
+//*****************************************************************************
+HRESULT VciDeviceCache::GetDeviceManager(::IVciDeviceManager** ppDevMan)
+{
+  HRESULT hResult = VCI_OK;
+
+  *ppDevMan = nullptr;
+
+  Monitor::Enter(ms_pLock);
+  try
+  {
+    if (nullptr == ms_pDevMan)
+    {
+      ::IVciDeviceManager* pDevMan = nullptr;
+
+      hResult = E_NOTIMPL;
+      if (VciGetDeviceManagerFunc)
+      {
+        hResult = VciGetDeviceManagerFunc(&pDevMan);
+      }
+
+      if (hResult == VCI_OK)
+      {
+        ms_pDevMan = pDevMan;
+      }
+    }
+
+    if (nullptr != ms_pDevMan)
+    {
+      ms_pDevMan->AddRef();
+      *ppDevMan = ms_pDevMan;
+    }
+  }
+  finally
+  {
+    Monitor::Exit(ms_pLock);
+  }
+
+  return( hResult );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Opens the native device object with the specified VCI object id or
+///   returns the already opened one. Each successful call has to be
+///   balanced by a call to <c>CloseDevice</c>.
+/// </summary>
+/// <param name="qwObjectId">
+///   VCI object id of the device.
+/// </param>
+/// <param name="ppDevObj">
+///   Receives the native device object. The caller has to release the
+///   returned interface.
+/// </param>
+/// <returns>
+///   VCI_OK on success, otherwise the error code of the VCI.
+/// </returns>
+//*****************************************************************************
+HRESULT VciDeviceCache::OpenDevice(Int64 qwObjectId, ::IVciDevice** ppDevObj)
+{
+  HRESULT              hResult = VCI_OK;
+  VciDeviceCacheEntry^ pEntry;
+
+  *ppDevObj = nullptr;
+
+  Monitor::Enter(ms_pLock);
+  try
+  {
+    if (!ms_pDevices->TryGetValue(qwObjectId, pEntry))
+    {
+      ::IVciDeviceManager* pDevMan = nullptr;
+      ::IVciDevice*        pDevObj = nullptr;
+      VCIID                sObjId;
+
+      sObjId.AsInt64 = qwObjectId;
+
+      hResult = GetDeviceManager(&pDevMan);
+      if (hResult == VCI_OK)
+      {
+        hResult = pDevMan->OpenDevice(sObjId, &pDevObj);
+        pDevMan->Release();
+      }
+
+      if (hResult == VCI_OK)
+      {
+        pEntry = gcnew VciDeviceCacheEntry();
+        pEntry->pDevObj = pDevObj;
+        pEntry->iUsers  = 0;
+        ms_pDevices->Add(qwObjectId, pEntry);
+      }
+    }
+
+    if (hResult == VCI_OK)
+    {
+      pEntry->iUsers++;
+      pEntry->pDevObj->AddRef();
+      *ppDevObj = pEntry->pDevObj;
+    }
+  }
+  finally
+  {
+    Monitor::Exit(ms_pLock);
+  }
+
+  return( hResult );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Releases one use of the native device object with the specified
+///   VCI object id. The native device object is released when it is no
+///   longer used.
+/// </summary>
+/// <param name="qwObjectId">
+///   VCI object id of the device.
+/// </param>
+//*****************************************************************************
+void VciDeviceCache::CloseDevice(Int64 qwObjectId)
+{
+  VciDeviceCacheEntry^ pEntry;
+
+  Monitor::Enter(ms_pLock);
+  try
+  {
+    if (ms_pDevices->TryGetValue(qwObjectId, pEntry) && (0 == --pEntry->iUsers))
+    {
+      ms_pDevices->Remove(qwObjectId);
+      pEntry->pDevObj->Release();
+      pEntry->pDevObj = nullptr;
+    }
+  }
+  finally
+  {
+    Monitor::Exit(ms_pLock);
+  }
+}
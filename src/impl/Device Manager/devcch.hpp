@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the process wide cache of native VCI objects.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+
+using namespace System::Collections::Generic;
+
+//*****************************************************************************
+/// <summary>
+///   Opened native device object and the number of VCI device objects
+///   which use it.
+/// </summary>
+//*****************************************************************************
+private ref class VciDeviceCacheEntry
+{
+  internal:
+    ::IVciDevice* pDevObj;  // native device object, holds one reference
+    int           iUsers;   // number of VciDevice objects using pDevObj
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   Process wide cache of the native device manager and of the opened
+///   native device objects. The native device manager is requested once
+///   and kept for the lifetime of the process. Native device objects are
+///   shared by all VCI device objects with the same VCI object id and
+///   released when the last of them is disposed.
+///   All methods are thread-safe.
+/// </summary>
+//*****************************************************************************
+private ref class VciDeviceCache abstract sealed
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    static Object^                                ms_pLock    = gcnew Object();
+    static ::IVciDeviceManager*                   ms_pDevMan  = nullptr;
+    static Dictionary<Int64, VciDeviceCacheEntry^>^ ms_pDevices =
+      gcnew Dictionary<Int64, VciDeviceCacheEntry^>();
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  internal:
+    static HRESULT GetDeviceManager ( ::IVciDeviceManager** ppDevMan );
+    static HRESULT OpenDevice       ( Int64 qwObjectId, ::IVciDevice** ppDevObj );
+    static void    CloseDevice      ( Int64 qwObjectId );
+};
+
+
+} // end of namespace Vci4
+} // end of namespace Ixxat
@@ -32,6 +32,7 @@ VciDeviceList::VciDeviceList(::IVciDeviceManager * pDeviceManager)
 
   m_pEnuDev = nullptr;
   m_pDevMan = nullptr;
+  m_iLent   = 0;
 
   if (nullptr != pDeviceManager)
   {
@@ -78,6 +79,17 @@ VciDeviceList::~VciDeviceList()
   }
 }
 
+//*****************************************************************************
+/// <summary>
+///   Called by an enumerator which borrowed the native enumerator of the
+///   list when it is disposed.
+/// </summary>
+//*****************************************************************************
+void VciDeviceList::GiveBack(void)
+{
+  Interlocked::Exchange(m_iLent, 0);
+}
+
 //*****************************************************************************
 /// <summary>
 ///   This method assigns an event object to the list. The event is
@@ -185,16 +197,26 @@ Collections::IEnumerator^ VciDeviceList::GetEnumerator()
 
   if (nullptr != m_pDevMan)
   {
-    // To support providing several separate enumerator instances 
-    // we have to get a new native enumerator here !!
-    hResult = m_pDevMan->EnumDevices(&pNewEnu);
-    if (VCI_OK == hResult)
+    if (0 == Interlocked::CompareExchange(m_iLent, 1, 0))
     {
-      pResult = gcnew VciDeviceEnumerator(pNewEnu);
+      // the native enumerator of the list is unused, lend it
+      m_pEnuDev->Reset();
+      pResult = gcnew VciDeviceEnumerator(m_pEnuDev, this);
     }
     else
     {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      // To support providing several separate enumerator instances 
+      // we have to get a new native enumerator here !!
+      hResult = m_pDevMan->EnumDevices(&pNewEnu);
+      if (VCI_OK == hResult)
+      {
+        pResult = gcnew VciDeviceEnumerator(pNewEnu, nullptr);
+        pNewEnu->Release();
+      }
+      else
+      {
+        throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      }
     }
   }
   else
@@ -217,10 +239,18 @@ Collections::IEnumerator^ VciDeviceList::GetEnumerator()
 /// <param name="pEnuDev">
 ///   Pointer to the native device enumerator interface
 ///</param>
+/// <param name="pOwner">
+///   The list which lent its native enumerator or null if the native
+///   enumerator belongs to this enumerator only.
+///</param>
 //*****************************************************************************
-VciDeviceEnumerator::VciDeviceEnumerator(::IVciEnumDevice* pEnuDev)
+VciDeviceEnumerator::VciDeviceEnumerator( ::IVciEnumDevice* pEnuDev
+                                        , VciDeviceList^    pOwner )
 {
   m_pEnuDev = pEnuDev;
+  m_pOwner  = pOwner;
+  m_pInfos  = nullptr;
+  m_iPos    = -1;
   m_pCurDev = nullptr;
 
   if (nullptr != m_pEnuDev)
@@ -244,12 +274,24 @@ VciDeviceEnumerator::VciDeviceEnumerator(::IVciEnumDevice* pEnuDev)
 VciDeviceEnumerator::~VciDeviceEnumerator()
 {
   m_pCurDev = nullptr;
-  
+
+  if (nullptr != m_pInfos)
+  {
+    m_pInfos->Release();
+    m_pInfos = nullptr;
+  }
+
   if (nullptr != m_pEnuDev)
   {
     m_pEnuDev->Release();
     m_pEnuDev = nullptr;
   }
+
+  if (nullptr != m_pOwner)
+  {
+    m_pOwner->GiveBack();
+    m_pOwner = nullptr;
+  }
 }
 
 //*****************************************************************************
@@ -318,6 +360,9 @@ Object^ VciDeviceEnumerator::Current::get(void)
 ///   No guarantee exists that each iteration through the list of VCI devices
 ///   enumerates the same set of VCI devices or enumerates the VCI devices in
 ///   the same order.
+///
+///   The first call fetches the information of all devices in blocks into
+///   one native array. The returned device objects are views on this array.
 /// </remarks>
 /// <exception cref="ObjectDisposedException">
 ///   Object is already disposed.
@@ -325,15 +370,23 @@ Object^ VciDeviceEnumerator::Current::get(void)
 //*****************************************************************************
 bool VciDeviceEnumerator::MoveNext()
 {
-  VCIDEVICEINFO DevInfo;
-
   m_pCurDev = nullptr;
   
   if (nullptr != m_pEnuDev)
   {
-    if (m_pEnuDev->Next(1, &DevInfo, nullptr) == VCI_OK)
+    if (nullptr == m_pInfos)
+    {
+      m_pInfos = gcnew VciDeviceInfoArray(m_pEnuDev);
+      m_iPos   = -1;
+    }
+
+    if (m_iPos + 1 < m_pInfos->Count)
+    {
+      m_pCurDev = gcnew VciDevice(m_pInfos, ++m_iPos);
+    }
+    else
     {
-      m_pCurDev = gcnew VciDevice(DevInfo);
+      m_iPos = m_pInfos->Count;
     }
   }
   else
@@ -365,6 +418,14 @@ void VciDeviceEnumerator::Reset()
   if (nullptr != m_pEnuDev)
   {
     m_pEnuDev->Reset();
+
+    // the next MoveNext takes a new snapshot, devices handed out
+    // so far keep the old one alive
+    if (nullptr != m_pInfos)
+    {
+      m_pInfos->Release();
+      m_pInfos = nullptr;
+    }
   }
   else
   {
@@ -33,6 +33,7 @@ private ref class VciDeviceList : public IVciDeviceList
   private:
     ::IVciDeviceManager * m_pDevMan; // native IVciDeviceManager interface
     ::IVciEnumDevice    * m_pEnuDev; // native IVciEnumDevice interface
+    int                   m_iLent;   // 1 while m_pEnuDev is used by an enumerator
 
   //--------------------------------------------------------------------
   // member functions
@@ -41,6 +42,8 @@ private ref class VciDeviceList : public IVciDeviceList
     VciDeviceList ( ::IVciDeviceManager * pDeviceManager );
     ~VciDeviceList( );
 
+    void GiveBack ( void );
+
   public:
     virtual void AssignEvent( AutoResetEvent^   changeEvent );
     virtual void AssignEvent( ManualResetEvent^ changeEvent );
@@ -64,14 +67,18 @@ private ref class VciDeviceEnumerator : public Collections::IEnumerator
   // member variables
   //--------------------------------------------------------------------
   private:
-    ::IVciEnumDevice* m_pEnuDev; // IVciEnumDevice interface
-    IVciDevice^       m_pCurDev; // current device object
+    ::IVciEnumDevice*   m_pEnuDev; // IVciEnumDevice interface
+    VciDeviceList^      m_pOwner;  // list which lent m_pEnuDev or null
+    VciDeviceInfoArray^ m_pInfos;  // snapshot of the device infos or null
+    int                 m_iPos;    // index of the current device in m_pInfos
+    IVciDevice^         m_pCurDev; // current device object
 
   //--------------------------------------------------------------------
   // member functions
   //--------------------------------------------------------------------
   internal:
-    VciDeviceEnumerator( ::IVciEnumDevice* pEnuDev );
+    VciDeviceEnumerator( ::IVciEnumDevice* pEnuDev
+                       , VciDeviceList^    pOwner );
     ~VciDeviceEnumerator();
 
   //--------------------------------------------------------------------
@@ -0,0 +1,450 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the live VCI device inventory.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "devinv.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4;
+
+
+/*##########################################################################*/
+/*### Methods for VciDeviceSnapshot class                                ###*/
+/*##########################################################################*/
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for inventory snapshots.
+/// </summary>
+/// <param name="pList">
+///   The devices of the snapshot in enumeration order.
+///</param>
+//*****************************************************************************
+VciDeviceSnapshot::VciDeviceSnapshot(List<IVciDevice^>^ pList)
+{
+  pDevices = gcnew ReadOnlyCollection<IVciDevice^>(pList->ToArray());
+  pById    = gcnew Dictionary<Int64, IVciDevice^>(pList->Count);
+  pByHwId  = gcnew Dictionary<String^, IVciDevice^>(pList->Count);
+
+  for (int i = 0; i < pList->Count; i++)
+  {
+    pById[pList[i]->VciObjectId] = pList[i];
+
+    // the device object decodes its hardware id only once, kept devices
+    // are not decoded again and new ones are decoded here once
+    String^ pKey = NormalizeHardwareId(pList[i]->UniqueHardwareId);
+    if ((nullptr != pKey) && !pByHwId->ContainsKey(pKey))
+    {
+      pByHwId->Add(pKey, pList[i]);
+    }
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts a hardware id into the key of the hardware id index.
+///   GUIDs and strings which parse as GUID are mapped to the "D" format,
+///   all other strings are trimmed and converted to upper case.
+/// </summary>
+/// <param name="pHwId">
+///   Hardware id as returned by <c>IVciDevice.UniqueHardwareId</c> or
+///   a string given by the user.
+///</param>
+/// <returns>
+///   The normalized key or a null reference if pHwId is null or empty.
+/// </returns>
+//*****************************************************************************
+String^ VciDeviceSnapshot::NormalizeHardwareId(Object^ pHwId)
+{
+  if (nullptr == pHwId)
+  {
+    return( nullptr );
+  }
+
+  if (Guid::typeid == pHwId->GetType())
+  {
+    return( safe_cast<Guid>(pHwId).ToString("D") );
+  }
+
+  String^ pStr = pHwId->ToString()->Trim();
+  Guid    sGuid;
+
+  if (0 == pStr->Length)
+  {
+    return( nullptr );
+  }
+
+  if (Guid::TryParse(pStr, sGuid))
+  {
+    return( sGuid.ToString("D") );
+  }
+
+  return( pStr->ToUpperInvariant() );
+}
+
+
+/*##########################################################################*/
+/*### Methods for VciDeviceInventory class                               ###*/
+/*##########################################################################*/
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for device inventories. The constructor subscribes to
+///   the change event of the list, takes the first snapshot and starts
+///   the worker thread.
+/// </summary>
+/// <param name="pList">
+///   The device list to observe. The inventory takes ownership of the list.
+///</param>
+/// <exception cref="VciException">
+///   Assigning the change event or enumerating the devices failed.
+/// </exception>
+//*****************************************************************************
+VciDeviceInventory::VciDeviceInventory(VciDeviceList^ pList)
+{
+  m_pList     = pList;
+  m_pChange   = gcnew AutoResetEvent(false);
+  m_pStop     = gcnew ManualResetEvent(false);
+  m_pScanLock = gcnew Object();
+  m_pSnap     = gcnew VciDeviceSnapshot(gcnew List<IVciDevice^>());
+  m_qwScans   = 0;
+
+  try
+  {
+    // subscribe first, so changes during the first scan are not lost
+    m_pList->AssignEvent(m_pChange);
+    Scan(false);
+  }
+  catch (Exception^)
+  {
+    Cleanup();
+    throw;
+  }
+
+  m_pThread = gcnew Thread(gcnew ThreadStart(this, &VciDeviceInventory::Watch));
+  m_pThread->Name         = "VCI device inventory";
+  m_pThread->IsBackground = true;
+  m_pThread->Start();
+}
+
+//*****************************************************************************
+/// <summary>
+///   Destructor for device inventories.
+/// </summary>
+//*****************************************************************************
+VciDeviceInventory::~VciDeviceInventory()
+{
+  Cleanup();
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method stops the worker thread and releases the device list
+///   and all device objects.
+/// </summary>
+//*****************************************************************************
+void VciDeviceInventory::Cleanup(void)
+{
+  bool fJoined = true;
+
+  if (nullptr != m_pThread)
+  {
+    m_pStop->Set();
+
+    // the inventory may be disposed by an event handler
+    if (Thread::CurrentThread != m_pThread)
+    {
+      m_pThread->Join();
+    }
+    else
+    {
+      fJoined = false;
+    }
+    m_pThread = nullptr;
+  }
+
+  Monitor::Enter(m_pScanLock);
+  try
+  {
+    delete m_pList;
+    m_pList = nullptr;
+
+    VciDeviceSnapshot^ pSnap = Interlocked::Exchange<VciDeviceSnapshot^>(m_pSnap, nullptr);
+    if (nullptr != pSnap)
+    {
+      for (int i = 0; i < pSnap->pDevices->Count; i++)
+      {
+        delete pSnap->pDevices[i];
+      }
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pScanLock);
+  }
+
+  if (fJoined)
+  {
+    delete m_pChange;
+    delete m_pStop;
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the current snapshot.
+/// </summary>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciDeviceSnapshot^ VciDeviceInventory::CheckSnap(void)
+{
+  VciDeviceSnapshot^ pSnap = m_pSnap;
+
+  if (nullptr == pSnap)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  return( pSnap );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Worker thread procedure. Rescans the devices whenever the device
+///   list signals a change.
+/// </summary>
+//*****************************************************************************
+void VciDeviceInventory::Watch(void)
+{
+  array<WaitHandle^>^ aWait = { m_pStop, m_pChange };
+
+  while (1 == WaitHandle::WaitAny(aWait))
+  {
+    try
+    {
+      Scan(true);
+    }
+    catch (Exception^)
+    {
+      // keep the previous snapshot, the next change retries
+    }
+  }
+
+  // if an event handler disposed the inventory, Cleanup ran on this
+  // thread and could not release the events
+  if (nullptr == m_pThread)
+  {
+    delete m_pChange;
+    delete m_pStop;
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Enumerates the devices, compares them with the current snapshot and
+///   publishes a new snapshot. Devices with unchanged object id and
+///   hardware id keep their device object.
+///   The events are raised after the scan lock was released, so event
+///   handlers may wait for other threads which rescan or dispose the
+///   inventory.
+/// </summary>
+/// <param name="fNotify">
+///   true to raise the Added and Removed events.
+/// </param>
+//*****************************************************************************
+void VciDeviceInventory::Scan(bool fNotify)
+{
+  List<IVciDevice^>^ pAdded   = gcnew List<IVciDevice^>();
+  List<IVciDevice^>^ pRemoved = gcnew List<IVciDevice^>();
+
+  Monitor::Enter(m_pScanLock);
+  try
+  {
+    if (nullptr == m_pList)
+    {
+      return;
+    }
+
+    VciDeviceSnapshot^        pOld     = m_pSnap;
+    List<IVciDevice^>^        pDevices = gcnew List<IVciDevice^>();
+    Collections::IEnumerator^ pEnum    = m_pList->GetEnumerator();
+
+    try
+    {
+      while (pEnum->MoveNext())
+      {
+        IVciDevice^ pDev = safe_cast<IVciDevice^>(pEnum->Current);
+        IVciDevice^ pPrev;
+
+        // the raw ids are compared, so the new device object which is
+        // dropped again does not decode its hardware id
+        if (pOld->pById->TryGetValue(pDev->VciObjectId, pPrev) &&
+            safe_cast<VciDevice^>(pPrev)->IsSameHardware(safe_cast<VciDevice^>(pDev)))
+        {
+          delete pDev;
+          pDev = pPrev;
+        }
+        else
+        {
+          pAdded->Add(pDev);
+        }
+
+        pDevices->Add(pDev);
+      }
+    }
+    catch (Exception^)
+    {
+      for (int i = 0; i < pAdded->Count; i++)
+      {
+        delete pAdded[i];
+      }
+      throw;
+    }
+    finally
+    {
+      delete pEnum;
+    }
+
+    VciDeviceSnapshot^ pNew = gcnew VciDeviceSnapshot(pDevices);
+
+    for (int i = 0; i < pOld->pDevices->Count; i++)
+    {
+      IVciDevice^ pDev = pOld->pDevices[i];
+      IVciDevice^ pCur;
+
+      if (!pNew->pById->TryGetValue(pDev->VciObjectId, pCur) || (pCur != pDev))
+      {
+        pRemoved->Add(pDev);
+      }
+    }
+
+    Interlocked::Exchange<VciDeviceSnapshot^>(m_pSnap, pNew);
+    Interlocked::Increment(m_qwScans);
+  }
+  finally
+  {
+    Monitor::Exit(m_pScanLock);
+  }
+
+  // removed devices are no longer reachable through the inventory, but
+  // may still be used by callers which got them from an older snapshot;
+  // as documented they become invalid after the Removed event.
+  // An event handler may dispose the inventory, which disposes the added
+  // devices with the snapshot, so no events are raised after that.
+  for (int i = 0; i < pRemoved->Count; i++)
+  {
+    try
+    {
+      if (fNotify && (nullptr != m_pSnap))
+      {
+        Removed(this, gcnew VciDeviceEventArgs(pRemoved[i]));
+      }
+    }
+    finally
+    {
+      delete pRemoved[i];
+    }
+  }
+
+  if (fNotify)
+  {
+    for (int i = 0; (i < pAdded->Count) && (nullptr != m_pSnap); i++)
+    {
+      Added(this, gcnew VciDeviceEventArgs(pAdded[i]));
+    }
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the devices of the current snapshot.
+/// </summary>
+//*****************************************************************************
+IList<IVciDevice^>^ VciDeviceInventory::Devices::get(void)
+{
+  return( CheckSnap()->pDevices );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of scans done since the inventory was created.
+/// </summary>
+//*****************************************************************************
+Int64 VciDeviceInventory::ScanCount::get(void)
+{
+  return( Interlocked::Read(m_qwScans) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Searches the current snapshot for a device.
+/// </summary>
+/// <param name="vciObjectId">
+///   VCI object id of the device.
+/// </param>
+/// <returns>
+///   The device or a null reference if the device is not installed.
+/// </returns>
+//*****************************************************************************
+IVciDevice^ VciDeviceInventory::FindDevice(Int64 vciObjectId)
+{
+  IVciDevice^ pDev;
+
+  if (CheckSnap()->pById->TryGetValue(vciObjectId, pDev))
+  {
+    return( pDev );
+  }
+
+  return( nullptr );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Searches the current snapshot for a device by its hardware id.
+/// </summary>
+/// <param name="hardwareId">
+///   Hardware id of the device, either a GUID or a string. Strings are
+///   compared case insensitive and without leading or trailing blanks.
+/// </param>
+/// <returns>
+///   The device or a null reference if the device is not installed.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   hardwareId is a null reference.
+/// </exception>
+//*****************************************************************************
+IVciDevice^ VciDeviceInventory::FindDeviceByHardwareId(Object^ hardwareId)
+{
+  IVciDevice^ pDev;
+
+  if (nullptr == hardwareId)
+  {
+    throw gcnew ArgumentNullException("hardwareId");
+  }
+
+  VciDeviceSnapshot^ pSnap = CheckSnap();
+  String^            pKey  = VciDeviceSnapshot::NormalizeHardwareId(hardwareId);
+
+  if ((nullptr != pKey) && pSnap->pByHwId->TryGetValue(pKey, pDev))
+  {
+    return( pDev );
+  }
+
+  return( nullptr );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Rescans the devices immediately in the calling thread.
+/// </summary>
+//*****************************************************************************
+void VciDeviceInventory::Rescan(void)
+{
+  CheckSnap();
+  Scan(true);
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the live VCI device inventory.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+#include "devenu.hpp"
+
+
+namespace Ixxat {
+  namespace Vci4 {
+
+using namespace System::Collections::Generic;
+using namespace System::Collections::ObjectModel;
+using namespace System::Threading;
+
+//*****************************************************************************
+/// <summary>
+///   Immutable state of the inventory after a scan. A snapshot is never
+///   changed after it was published.
+/// </summary>
+//*****************************************************************************
+private ref class VciDeviceSnapshot
+{
+  internal:
+    ReadOnlyCollection<IVciDevice^>^  pDevices; // devices in enumeration order
+    Dictionary<Int64, IVciDevice^>^   pById;    // devices by VCI object id
+    Dictionary<String^, IVciDevice^>^ pByHwId;  // devices by normalized hardware id
+
+    VciDeviceSnapshot ( List<IVciDevice^>^ pList );
+
+    static String^ NormalizeHardwareId ( Object^ pHwId );
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   This class implements the live VCI device inventory.
+/// </summary>
+//*****************************************************************************
+private ref class VciDeviceInventory : public IVciDeviceInventory
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    VciDeviceList^     m_pList;     // observed device list
+    AutoResetEvent^    m_pChange;   // change event of m_pList
+    ManualResetEvent^  m_pStop;     // stops the worker thread
+    Thread^            m_pThread;   // rescans on changes
+    Object^            m_pScanLock; // serializes the scans
+    VciDeviceSnapshot^ m_pSnap;     // current snapshot
+    Int64              m_qwScans;   // number of scans
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    void               Cleanup    ( void );
+    VciDeviceSnapshot^ CheckSnap  ( void );
+    void               Watch      ( void );
+    void               Scan       ( bool fNotify );
+
+  internal:
+    VciDeviceInventory  ( VciDeviceList^ pList );
+    ~VciDeviceInventory ( );
+
+  //--------------------------------------------------------------------
+  // IVciDeviceInventory implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual event EventHandler<VciDeviceEventArgs^>^ Added;
+    virtual event EventHandler<VciDeviceEventArgs^>^ Removed;
+
+    virtual property IList<IVciDevice^>^ Devices   { IList<IVciDevice^>^ get(void); };
+    virtual property Int64               ScanCount { Int64               get(void); };
+
+    virtual IVciDevice^ FindDevice             ( Int64 vciObjectId );
+    virtual IVciDevice^ FindDeviceByHardwareId ( Object^ hardwareId );
+    virtual void        Rescan                 ( void );
+};
+
+
+} // end of namespace Vci4
+} // end of namespace Ixxat
@@ -12,7 +12,8 @@ using namespace Ixxat::Vci4;
 
 //*****************************************************************************
 /// <summary>
-///   Constructor for VCI device manager objects.
+///   Constructor for VCI device manager objects. The native device
+///   manager is shared with all other device manager objects.
 /// </summary>
 //*****************************************************************************
 VciDeviceManager::VciDeviceManager()
@@ -20,10 +21,7 @@ VciDeviceManager::VciDeviceManager()
   HRESULT     hResult = E_NOTIMPL;
   ::IVciDeviceManager* pDevMan = nullptr;
  
-  if (VciGetDeviceManagerFunc)
-  {
-    hResult = VciGetDeviceManagerFunc(&pDevMan);
-  }
+  hResult = VciDeviceCache::GetDeviceManager(&pDevMan);
 
   m_pDevMan = pDevMan;
 
@@ -73,3 +71,27 @@ IVciDeviceList^ VciDeviceManager::GetDeviceList()
   return( gcnew VciDeviceList(m_pDevMan) );
 }
 
+//*****************************************************************************
+/// <summary>
+///   Creates a live inventory of the installed VCI devices.
+/// </summary>
+/// <returns>
+///   The device inventory.
+/// </returns>
+/// <exception cref="VciException">
+///   Thrown if creation of the inventory failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+IVciDeviceInventory^ VciDeviceManager::GetDeviceInventory()
+{
+  if (nullptr == m_pDevMan)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  return( gcnew VciDeviceInventory(gcnew VciDeviceList(m_pDevMan)) );
+}
+
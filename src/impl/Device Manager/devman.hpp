@@ -8,7 +8,9 @@
 #pragma once
 
 #include <vcisdk.h>
+#include "devcch.hpp"
 #include "devenu.hpp"
+#include "devinv.hpp"
 
 
 namespace Ixxat {
@@ -38,7 +40,8 @@ private ref class VciDeviceManager : public IVciDeviceManager
   // IVciDeviceManager implementation
   //--------------------------------------------------------------------
   public:
-    virtual IVciDeviceList^ GetDeviceList(void);
+    virtual IVciDeviceList^      GetDeviceList(void);
+    virtual IVciDeviceInventory^ GetDeviceInventory(void);
 };
 
 } // end of namespace Vci4
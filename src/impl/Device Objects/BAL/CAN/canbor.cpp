@@ -0,0 +1,547 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the automatic bus-off recovery of CAN lines.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "canbor.hpp"
+#include "canctl2.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+using namespace System::Diagnostics;
+
+#pragma warning(disable:4669) // 'type cast' : unsafe conversion
+
+
+// size of the receive FIFO of the status channel
+#define BOR_RX_FIFO_SIZE      64
+
+// default delays in milliseconds
+#define BOR_DEFAULT_INIT      10
+#define BOR_DEFAULT_MAX       2000
+
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for bus-off recovery objects. Creates a shared message
+///   channel whose data frames are locked, so that it only receives the
+///   status and info messages of the controller.
+/// </summary>
+/// <param name="pControl">
+///   Control socket of the CAN line.
+/// </param>
+/// <param name="pSocket">
+///   Native socket of the CAN line. The recovery takes over the reference.
+///   This parameter must not be NULL.
+/// </param>
+/// <exception cref="VciException">
+///   Creating the status message channel failed.
+/// </exception>
+//*****************************************************************************
+CanBusOffRecovery::CanBusOffRecovery( CanControl2^   pControl
+                                    , ::ICanSocket2* pSocket )
+{
+  HRESULT hResult;
+
+  m_pControl   = pControl;
+  m_pSocket    = pSocket;
+  m_pRxEvent   = gcnew AutoResetEvent(false);
+  m_pWake      = gcnew AutoResetEvent(false);
+  m_pAttempts  = gcnew Queue<Int64>();
+  m_iInitDelay = BOR_DEFAULT_INIT;
+  m_iMaxDelay  = BOR_DEFAULT_MAX;
+
+  ::ICanChannel2* pCanChn;
+  hResult = m_pSocket->CreateChannel(FALSE, &pCanChn);
+  if (VCI_OK == hResult)
+  {
+    m_pCanChn = pCanChn;
+    hResult   = m_pCanChn->Initialize(BOR_RX_FIFO_SIZE, 1, 0, CAN_FILTER_LOCK);
+  }
+
+  if (VCI_OK == hResult)
+  {
+    PFIFOREADER pRxFifo;
+    hResult = m_pCanChn->GetReader(&pRxFifo);
+    if (VCI_OK == hResult)
+    {
+      m_pRxFifo = pRxFifo;
+      hResult   = m_pRxFifo->AssignEvent((HANDLE) m_pRxEvent->Handle);
+    }
+  }
+
+  if (VCI_OK == hResult)
+  {
+    hResult = m_pCanChn->Activate();
+  }
+
+  if (VCI_OK != hResult)
+  {
+    Cleanup();
+    throw gcnew VciException(VciServerImpl::Instance(), hResult);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Destructor for bus-off recovery objects.
+/// </summary>
+//*****************************************************************************
+CanBusOffRecovery::~CanBusOffRecovery()
+{
+  Cleanup();
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method performs tasks associated with freeing, releasing, or
+///   resetting unmanaged resources.
+/// </summary>
+//*****************************************************************************
+void CanBusOffRecovery::Cleanup(void)
+{
+  Stop();
+
+  if (nullptr != m_pRxFifo)
+  {
+    m_pRxFifo->Release();
+    m_pRxFifo = nullptr;
+  }
+
+  if (nullptr != m_pCanChn)
+  {
+    m_pCanChn->Deactivate();
+    m_pCanChn->Release();
+    m_pCanChn = nullptr;
+  }
+
+  if (nullptr != m_pSocket)
+  {
+    m_pSocket->Release();
+    m_pSocket = nullptr;
+  }
+
+  if (nullptr != m_pControl)
+  {
+    m_pControl->RemoveRecovery(this);
+    m_pControl = nullptr;
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Removes all messages from the receive FIFO of the status channel.
+/// </summary>
+/// <returns>
+///   1 if the last status message signals bus off, 0 if it doesn't and
+///   -1 if no status message was received.
+/// </returns>
+//*****************************************************************************
+int CanBusOffRecovery::ReadStatus(void)
+{
+  int      iState = -1;
+  PCANMSG2 pCanMsg;
+  UINT16   wCount;
+
+  while ((m_pRxFifo->AcquireRead((PVOID*) &pCanMsg, &wCount) == VCI_OK) && (wCount > 0))
+  {
+    for (UINT16 i = 0; i < wCount; i++)
+    {
+      if (CAN_MSGTYPE_STATUS == pCanMsg[i].uMsgInfo.Bytes.bType)
+      {
+        iState = (0 != (pCanMsg[i].abData[0] & CAN_STATUS_BUSOFF)) ? 1 : 0;
+      }
+    }
+    m_pRxFifo->ReleaseRead(wCount);
+  }
+
+  return( iState );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the state of the line from the current line status.
+/// </summary>
+/// <returns>
+///   1 if the controller is in bus off state, 0 if it is running and -1
+///   if it is in init mode or the line status is not available.
+/// </returns>
+//*****************************************************************************
+int CanBusOffRecovery::LineState(void)
+{
+  CANLINESTATUS2 sStatus;
+
+  if (m_pSocket->GetLineStatus(&sStatus) != VCI_OK)
+  {
+    return( -1 );
+  }
+
+  if (0 != (sStatus.dwStatus & CAN_STATUS_BUSOFF))
+  {
+    return( 1 );
+  }
+
+  return( (0 != (sStatus.dwStatus & CAN_STATUS_ININIT)) ? -1 : 0 );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Applies the retry rate limit. Timestamps older than one minute are
+///   discarded.
+/// </summary>
+/// <param name="qwNow">
+///   Current stopwatch timestamp.
+/// </param>
+/// <param name="pqwDue">
+///   Due time of the next attempt. Moved to the end of the limit window
+///   if the limit is reached.
+/// </param>
+/// <returns>
+///   true if an attempt is allowed now.
+/// </returns>
+//*****************************************************************************
+bool CanBusOffRecovery::AllowRetry( INT64  qwNow
+                                  , INT64* pqwDue )
+{
+  INT64 qwMinute = Stopwatch::Frequency * 60;
+
+  while ((m_pAttempts->Count > 0) && (qwNow - m_pAttempts->Peek() >= qwMinute))
+  {
+    m_pAttempts->Dequeue();
+  }
+
+  INT64 qwOldest = (m_pAttempts->Count > 0) ? m_pAttempts->Peek() : 0;
+  if (!BorAllowRetry(m_pAttempts->Count, qwOldest, m_iMaxPerMin, qwMinute, pqwDue))
+  {
+    return( false );
+  }
+
+  m_pAttempts->Enqueue(qwNow);
+  return( true );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Records the end of a bus off state.
+/// </summary>
+/// <param name="qwDownSince">
+///   Stopwatch timestamp of the bus off detection.
+/// </param>
+//*****************************************************************************
+void CanBusOffRecovery::Recovered( INT64 qwDownSince )
+{
+  Int64 qwDown = Stopwatch::GetTimestamp() - qwDownSince;
+
+  m_fBusOff = false;
+  Interlocked::Exchange(m_qwLastDown, qwDown);
+  Interlocked::Add(m_qwTotalDown, qwDown);
+  if (qwDown > Interlocked::Read(m_qwMaxDown))
+  {
+    Interlocked::Exchange(m_qwMaxDown, qwDown);
+  }
+  Interlocked::Increment(m_qwRecovered);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts stopwatch ticks to a time span.
+/// </summary>
+//*****************************************************************************
+TimeSpan CanBusOffRecovery::ToTimeSpan( Int64 qwTicks )
+{
+  return( TimeSpan::FromTicks((Int64) ((double) qwTicks * TimeSpan::TicksPerSecond / Stopwatch::Frequency)) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts a retry delay to milliseconds.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   The delay is less than 1 millisecond or exceeds
+///   <c>Int32.MaxValue</c> milliseconds.
+/// </exception>
+//*****************************************************************************
+int CanBusOffRecovery::ToDelay( TimeSpan delay )
+{
+  if ((delay.TotalMilliseconds < 1) || (delay.TotalMilliseconds > Int32::MaxValue))
+  {
+    throw gcnew ArgumentOutOfRangeException("value");
+  }
+
+  return( (int) delay.TotalMilliseconds );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets or sets the delay of the first recovery attempt.
+/// </summary>
+//*****************************************************************************
+TimeSpan CanBusOffRecovery::InitialDelay::get(void)
+{
+  return( TimeSpan::FromMilliseconds(m_iInitDelay) );
+}
+
+void CanBusOffRecovery::InitialDelay::set(TimeSpan delay)
+{
+  m_iInitDelay = ToDelay(delay);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets or sets the upper limit of the retry delay.
+/// </summary>
+//*****************************************************************************
+TimeSpan CanBusOffRecovery::MaximumDelay::get(void)
+{
+  return( TimeSpan::FromMilliseconds(m_iMaxDelay) );
+}
+
+void CanBusOffRecovery::MaximumDelay::set(TimeSpan delay)
+{
+  m_iMaxDelay = ToDelay(delay);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets or sets the maximum number of attempts within one minute.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   The value is negative.
+/// </exception>
+//*****************************************************************************
+int CanBusOffRecovery::MaxRetriesPerMinute::get(void)
+{
+  return( m_iMaxPerMin );
+}
+
+void CanBusOffRecovery::MaxRetriesPerMinute::set(int count)
+{
+  if (count < 0)
+  {
+    throw gcnew ArgumentOutOfRangeException("value");
+  }
+
+  m_iMaxPerMin = count;
+  m_pWake->Set();
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets a value indicating whether the recovery thread is running.
+/// </summary>
+//*****************************************************************************
+bool CanBusOffRecovery::IsRunning::get(void)
+{
+  return( nullptr != m_pThread );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets a value indicating whether the line waits for recovery.
+/// </summary>
+//*****************************************************************************
+bool CanBusOffRecovery::IsBusOff::get(void)
+{
+  return( m_fBusOff );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of detected bus off states.
+/// </summary>
+//*****************************************************************************
+Int64 CanBusOffRecovery::BusOffCount::get(void)
+{
+  return( Interlocked::Read(m_qwBusOffs) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of recovery attempts.
+/// </summary>
+//*****************************************************************************
+Int64 CanBusOffRecovery::AttemptCount::get(void)
+{
+  return( Interlocked::Read(m_qwAttempts) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of recovered bus off states.
+/// </summary>
+//*****************************************************************************
+Int64 CanBusOffRecovery::RecoveryCount::get(void)
+{
+  return( Interlocked::Read(m_qwRecovered) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the downtime of the last recovered bus off state.
+/// </summary>
+//*****************************************************************************
+TimeSpan CanBusOffRecovery::LastDowntime::get(void)
+{
+  return( ToTimeSpan(Interlocked::Read(m_qwLastDown)) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the longest downtime.
+/// </summary>
+//*****************************************************************************
+TimeSpan CanBusOffRecovery::MaximumDowntime::get(void)
+{
+  return( ToTimeSpan(Interlocked::Read(m_qwMaxDown)) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the sum of all downtimes.
+/// </summary>
+//*****************************************************************************
+TimeSpan CanBusOffRecovery::TotalDowntime::get(void)
+{
+  return( ToTimeSpan(Interlocked::Read(m_qwTotalDown)) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Resets all counters and downtimes.
+/// </summary>
+//*****************************************************************************
+void CanBusOffRecovery::ResetStatistics(void)
+{
+  Interlocked::Exchange(m_qwBusOffs,   (Int64) 0);
+  Interlocked::Exchange(m_qwAttempts,  (Int64) 0);
+  Interlocked::Exchange(m_qwRecovered, (Int64) 0);
+  Interlocked::Exchange(m_qwLastDown,  (Int64) 0);
+  Interlocked::Exchange(m_qwMaxDown,   (Int64) 0);
+  Interlocked::Exchange(m_qwTotalDown, (Int64) 0);
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method starts the recovery thread.
+/// </summary>
+/// <exception cref="InvalidOperationException">
+///   The line was not initialized by InitLine.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+void CanBusOffRecovery::Start(void)
+{
+  if (nullptr == m_pControl)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  if (!m_pControl->IsLineInitialized)
+  {
+    throw gcnew InvalidOperationException();
+  }
+
+  if (nullptr == m_pThread)
+  {
+    m_fRun    = true;
+    m_pThread = gcnew Thread(gcnew ThreadStart(this, &CanBusOffRecovery::ThreadProc));
+    m_pThread->Name         = "VCI bus-off recovery";
+    m_pThread->IsBackground = true;
+    m_pThread->Priority     = ThreadPriority::AboveNormal;
+    m_pThread->Start();
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method stops the recovery thread.
+/// </summary>
+//*****************************************************************************
+void CanBusOffRecovery::Stop(void)
+{
+  // the control socket stops its recoveries on dispose, which can race
+  // with a call from the application
+  Thread^ pThread = Interlocked::Exchange<Thread^>(m_pThread, nullptr);
+
+  if (nullptr != pThread)
+  {
+    m_fRun = false;
+    m_pWake->Set();
+    pThread->Join();
+    m_fBusOff = false;
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Recovery thread. Waits for status messages while the line is up.
+///   After bus off, attempts are made at the due time, which starts at
+///   <c>InitialDelay</c> and doubles after each failed attempt up to
+///   <c>MaximumDelay</c>. A status message without bus off ends the
+///   bus off state as well, e.g. if the controller recovered by itself.
+/// </summary>
+//*****************************************************************************
+void CanBusOffRecovery::ThreadProc(void)
+{
+  array<WaitHandle^>^ aWait = gcnew array<WaitHandle^> { m_pRxEvent, m_pWake };
+  INT64 qwFreq  = Stopwatch::Frequency;
+  INT64 qwSince = 0;
+  INT64 qwDue   = 0;
+  INT64 qwDelay = 0;
+
+  // the line might already be off
+  int iState = (1 == LineState()) ? 1 : -1;
+  ReadStatus();
+
+  while (m_fRun)
+  {
+    INT64 qwNow = Stopwatch::GetTimestamp();
+
+    if ((1 == iState) && !m_fBusOff)
+    {
+      m_fBusOff = true;
+      Interlocked::Increment(m_qwBusOffs);
+      qwSince = qwNow;
+      qwDelay = m_iInitDelay;
+      qwDue   = qwNow + qwDelay * qwFreq / 1000;
+    }
+    else if ((0 == iState) && m_fBusOff)
+    {
+      Recovered(qwSince);
+    }
+
+    if (m_fBusOff && (qwNow >= qwDue) && AllowRetry(qwNow, &qwDue))
+    {
+      Interlocked::Increment(m_qwAttempts);
+
+      // discard status messages which precede the attempt
+      ReadStatus();
+
+      if ((VCI_OK == m_pControl->Recover()) && (0 == LineState()))
+      {
+        Recovered(qwSince);
+      }
+      else
+      {
+        qwDelay = BorNextDelay(qwDelay, m_iInitDelay, m_iMaxDelay);
+        qwDue   = Stopwatch::GetTimestamp() + qwDelay * qwFreq / 1000;
+      }
+    }
+
+    int iWait = Timeout::Infinite;
+    if (m_fBusOff)
+    {
+      INT64 qwWait = (qwDue - Stopwatch::GetTimestamp()) * 1000 / qwFreq;
+      iWait = (int) Math::Max((INT64) 0, Math::Min(qwWait + 1, (INT64) Int32::MaxValue));
+    }
+
+    WaitHandle::WaitAny(aWait, iWait, false);
+    iState = ReadStatus();
+  }
+}
+
+#pragma warning(default:4669) // 'type cast' : unsafe conversion
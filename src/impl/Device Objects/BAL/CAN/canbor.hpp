@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the automatic bus-off recovery of CAN lines.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+using namespace System::Threading;
+using namespace System::Collections::Generic;
+
+
+// forward decls
+ref class CanControl2;
+
+
+//*****************************************************************************
+/// <summary>
+///   Calculates the retry delay after a failed attempt. The delay doubles
+///   up to the maximum delay, but never drops below the initial delay.
+/// </summary>
+/// <param name="qwDelay">
+///   Delay of the failed attempt in milliseconds.
+/// </param>
+/// <param name="iInit">
+///   Initial delay in milliseconds.
+/// </param>
+/// <param name="iMax">
+///   Maximum delay in milliseconds.
+/// </param>
+/// <returns>
+///   Delay of the next attempt in milliseconds.
+/// </returns>
+//*****************************************************************************
+constexpr INT64 BorNextDelay( INT64 qwDelay, int iInit, int iMax )
+{
+  INT64 qwMax = (iMax > iInit) ? iMax : iInit;
+  return( (qwDelay * 2 < qwMax) ? qwDelay * 2 : qwMax );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Decides whether the retry rate limit allows an attempt.
+/// </summary>
+/// <param name="iCount">
+///   Number of attempts within the current limit window.
+/// </param>
+/// <param name="qwOldest">
+///   Timestamp of the oldest attempt within the limit window.
+/// </param>
+/// <param name="iMaxPerWindow">
+///   Maximum number of attempts within the limit window, 0 = any.
+/// </param>
+/// <param name="qwWindow">
+///   Length of the limit window.
+/// </param>
+/// <param name="pqwDue">
+///   Due time of the next attempt. Moved to the end of the limit window
+///   if the limit is reached.
+/// </param>
+/// <returns>
+///   true if an attempt is allowed now.
+/// </returns>
+//*****************************************************************************
+constexpr bool BorAllowRetry( int    iCount
+                            , INT64  qwOldest
+                            , int    iMaxPerWindow
+                            , INT64  qwWindow
+                            , INT64* pqwDue )
+{
+  if ((0 != iMaxPerWindow) && (iCount >= iMaxPerWindow))
+  {
+    *pqwDue = qwOldest + qwWindow;
+    return( false );
+  }
+
+  return( true );
+}
+
+
+//*****************************************************************************
+/// <summary>
+///   This class implements the automatic bus-off recovery. A thread waits
+///   for status messages on a private, shared message channel and
+///   re-initializes the line through the owning control socket.
+/// </summary>
+//*****************************************************************************
+private ref class CanBusOffRecovery : public ICanBusOffRecovery
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    CanControl2^          m_pControl;     // control socket of the line
+    ::ICanSocket2*        m_pSocket;      // native socket, polls the line status
+    ::ICanChannel2*       m_pCanChn;      // channel receiving status messages
+    PFIFOREADER           m_pRxFifo;      // receive FIFO of m_pCanChn
+    AutoResetEvent^       m_pRxEvent;     // signaled by m_pRxFifo
+    AutoResetEvent^       m_pWake;        // wakes up the recovery thread
+    Thread^               m_pThread;      // recovery thread
+    volatile bool         m_fRun;         // recovery thread shall run
+    volatile bool         m_fBusOff;      // bus off detected, not recovered
+    int                   m_iInitDelay;   // first retry delay in milliseconds
+    int                   m_iMaxDelay;    // maximum retry delay in milliseconds
+    int                   m_iMaxPerMin;   // maximum attempts per minute, 0 = any
+    Queue<Int64>^         m_pAttempts;    // timestamps of the recent attempts
+    Int64                 m_qwBusOffs;    // number of bus off states
+    Int64                 m_qwAttempts;   // number of recovery attempts
+    Int64                 m_qwRecovered;  // number of recovered bus off states
+    Int64                 m_qwLastDown;   // last downtime in stopwatch ticks
+    Int64                 m_qwMaxDown;    // maximum downtime in stopwatch ticks
+    Int64                 m_qwTotalDown;  // total downtime in stopwatch ticks
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    void            Cleanup     ( void );
+    void            ThreadProc  ( void );
+    int             ReadStatus  ( void );
+    int             LineState   ( void );
+    bool            AllowRetry  ( INT64  qwNow
+                                , INT64* pqwDue );
+    void            Recovered   ( INT64  qwDownSince );
+    static TimeSpan ToTimeSpan  ( Int64  qwTicks );
+    static int      ToDelay     ( TimeSpan delay );
+
+  internal:
+    CanBusOffRecovery  ( CanControl2^   pControl
+                       , ::ICanSocket2* pSocket );
+    ~CanBusOffRecovery ( );
+
+  //--------------------------------------------------------------------
+  // ICanBusOffRecovery implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual property TimeSpan InitialDelay        { TimeSpan get(void);
+                                                    void     set(TimeSpan delay); };
+    virtual property TimeSpan MaximumDelay        { TimeSpan get(void);
+                                                    void     set(TimeSpan delay); };
+    virtual property int      MaxRetriesPerMinute { int      get(void);
+                                                    void     set(int count); };
+    virtual property bool     IsRunning           { bool     get(void); };
+    virtual property bool     IsBusOff            { bool     get(void); };
+    virtual property Int64    BusOffCount         { Int64    get(void); };
+    virtual property Int64    AttemptCount        { Int64    get(void); };
+    virtual property Int64    RecoveryCount       { Int64    get(void); };
+    virtual property TimeSpan LastDowntime        { TimeSpan get(void); };
+    virtual property TimeSpan MaximumDowntime     { TimeSpan get(void); };
+    virtual property TimeSpan TotalDowntime       { TimeSpan get(void); };
+
+    virtual void ResetStatistics( void );
+    virtual void Start          ( void );
+    virtual void Stop           ( void );
+};
+
+
+//*****************************************************************************
+// compile time checks of the retry schedule
+//*****************************************************************************
+namespace BorSelfTest {
+
+  // delay after the given number of failed attempts
+  constexpr INT64 Delay( int iInit, int iMax, int iFailed )
+  {
+    INT64 qwDelay = iInit;
+    for (int i = 0; i < iFailed; i++)
+    {
+      qwDelay = BorNextDelay(qwDelay, iInit, iMax);
+    }
+    return( qwDelay );
+  }
+
+  // time of the given attempt (counted from 0) if each attempt fails and
+  // the next one is due one tick later, as AllowRetry applies the limit
+  constexpr INT64 Attempt( int iMaxPerWindow, INT64 qwWindow, int iAttempt )
+  {
+    INT64 aqwDone[16] = {};
+    int   iDone = 0;
+    int   iHead = 0;
+    INT64 qwNow = 0;
+
+    for (;;)
+    {
+      while ((iDone > iHead) && (qwNow - aqwDone[iHead] >= qwWindow))
+      {
+        iHead++;
+      }
+
+      INT64 qwDue = qwNow + 1;
+      if (BorAllowRetry(iDone - iHead, aqwDone[iHead], iMaxPerWindow, qwWindow, &qwDue))
+      {
+        if (iDone == iAttempt)
+        {
+          return( qwNow );
+        }
+        aqwDone[iDone++] = qwNow;
+      }
+      qwNow = qwDue;
+    }
+  }
+
+  // default schedule: 10 ms doubling up to 2000 ms
+  static_assert(Delay(10, 2000, 0)  ==   10, "bus-off recovery self test");
+  static_assert(Delay(10, 2000, 1)  ==   20, "bus-off recovery self test");
+  static_assert(Delay(10, 2000, 7)  == 1280, "bus-off recovery self test");
+  static_assert(Delay(10, 2000, 8)  == 2000, "bus-off recovery self test");
+  static_assert(Delay(10, 2000, 30) == 2000, "bus-off recovery self test");
+
+  // a maximum below the initial delay keeps the initial delay
+  static_assert(Delay(500, 100, 3)  ==  500, "bus-off recovery self test");
+
+  // 3 attempts per 60 ticks: the 4th waits for the 1st to leave the window
+  static_assert(Attempt(3, 60, 2) ==   2, "bus-off recovery self test");
+  static_assert(Attempt(3, 60, 3) ==  60, "bus-off recovery self test");
+  static_assert(Attempt(3, 60, 5) ==  62, "bus-off recovery self test");
+  static_assert(Attempt(3, 60, 6) == 120, "bus-off recovery self test");
+
+  // 0 = no limit
+  static_assert(Attempt(0, 60, 10) ==  10, "bus-off recovery self test");
+
+} // end of namespace BorSelfTest
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
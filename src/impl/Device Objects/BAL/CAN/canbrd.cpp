@@ -0,0 +1,486 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the bit rate detection service which detects
+//            the bit rate of several CAN lines concurrently.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "canbrd.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+using namespace System::Diagnostics;
+using namespace System::Threading;
+
+#pragma warning(disable:4669) // 'type cast' : unsafe conversion
+
+
+//*****************************************************************************
+/// <summary>
+///   Worker thread procedure. Each worker picks the next untested
+///   controller until all controllers are done.
+/// </summary>
+//*****************************************************************************
+void CanBitrateJob::Run(void)
+{
+  int iCtl;
+
+  while ((iCtl = Interlocked::Increment(iNext) - 1) < aResult->Length)
+  {
+    aResult[iCtl] = pOwner->DetectOne(this, iCtl);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for bit rate detector objects.
+/// </summary>
+//*****************************************************************************
+CanBitrateDetector::CanBitrateDetector(void)
+{
+  m_pDevices = gcnew List<IVciDevice^>();
+  m_pPorts   = gcnew List<Byte>();
+  m_iMaxPar  = BRD_MAX_PARALLEL;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the maximum number of controllers tested at the same time.
+/// </summary>
+//*****************************************************************************
+int CanBitrateDetector::MaxParallel::get(void)
+{
+  return( m_iMaxPar );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Sets the maximum number of controllers tested at the same time.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   The value is less than 1.
+/// </exception>
+//*****************************************************************************
+void CanBitrateDetector::MaxParallel::set(int value)
+{
+  if (value < 1)
+  {
+    throw gcnew ArgumentOutOfRangeException("value");
+  }
+
+  m_iMaxPar = value;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of registered controllers.
+/// </summary>
+//*****************************************************************************
+int CanBitrateDetector::ControllerCount::get(void)
+{
+  return( m_pDevices->Count );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Registers a CAN controller for the detection.
+/// </summary>
+/// <param name="device">
+///   The device the controller belongs to.
+/// </param>
+/// <param name="portNumber">
+///   Port number of the controller.
+/// </param>
+/// <exception cref="ArgumentNullException">
+///   Parameter device was a null reference.
+/// </exception>
+//*****************************************************************************
+void CanBitrateDetector::AddController( IVciDevice^ device
+                                      , Byte        portNumber )
+{
+  if (nullptr == device)
+  {
+    throw gcnew ArgumentNullException("device");
+  }
+
+  m_pDevices->Add(device);
+  m_pPorts->Add(portNumber);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Detects the bit rate of all registered controllers concurrently.
+/// </summary>
+/// <param name="operatingMode">
+///   Operating mode of the CAN controllers
+/// </param>
+/// <param name="extendedMode">
+///   Extended operating mode of the CAN controllers
+/// </param>
+/// <param name="timeout">
+///   Timeout in milliseconds to wait between two successive receive messages.
+/// </param>
+/// <param name="bitrateTable">
+///   Bit rate table to be tested.
+/// </param>
+/// <returns>
+///   One result per registered controller in registration order.
+/// </returns>
+/// <remarks>
+///   The BAL of each device is opened once in the calling thread and
+///   shared by all controllers of the device.
+/// </remarks>
+/// <exception cref="ArgumentNullException">
+///   Parameter bitrateTable was a null reference.
+/// </exception>
+//*****************************************************************************
+array<CanBitrateDetection>^ CanBitrateDetector::Detect
+                                    ( CanOperatingModes         operatingMode
+                                    , CanExtendedOperatingModes extendedMode
+                                    , UInt16                    timeout
+                                    , array<CanFdBitrate>^      bitrateTable )
+{
+  if (nullptr == bitrateTable)
+  {
+    throw gcnew ArgumentNullException("bitrateTable");
+  }
+
+  int            iCount = m_pDevices->Count;
+  CanBitrateJob^ pJob   = gcnew CanBitrateJob();
+
+  pJob->pOwner   = this;
+  pJob->eMode    = operatingMode;
+  pJob->eExtMode = extendedMode;
+  pJob->wTimeout = timeout;
+  pJob->aTable   = bitrateTable;
+  pJob->aBal     = gcnew array<IBalObject^>(iCount);
+  pJob->aHwId    = gcnew array<Object^>(iCount);
+  pJob->aPort    = gcnew array<Byte>(iCount);
+  pJob->aResult  = gcnew array<CanBitrateDetection>(iCount);
+  pJob->iNext    = 0;
+
+  try
+  {
+    for (int i = 0; i < iCount; i++)
+    {
+      IVciDevice^ pDevice = m_pDevices[i];
+
+      pJob->aPort[i] = m_pPorts[i];
+
+      // share the BAL of controllers on the same device
+      int iPrev = m_pDevices->IndexOf(pDevice);
+      if (iPrev < i)
+      {
+        pJob->aBal[i]    = pJob->aBal[iPrev];
+        pJob->aHwId[i]   = pJob->aHwId[iPrev];
+        pJob->aResult[i] = CanBitrateDetection(pJob->aHwId[i], m_pPorts[i], -1,
+                                               CanFdBitrate(),
+                                               pJob->aResult[iPrev].ErrorCode,
+                                               TimeSpan::Zero);
+        continue;
+      }
+
+      try
+      {
+        pJob->aHwId[i] = pDevice->UniqueHardwareId;
+        pJob->aBal[i]  = pDevice->OpenBusAccessLayer();
+      }
+      catch (Exception^ e)
+      {
+        // reported by DetectOne for this controller
+        pJob->aResult[i] = CanBitrateDetection(pJob->aHwId[i], m_pPorts[i], -1,
+                                               CanFdBitrate(), e->HResult,
+                                               TimeSpan::Zero);
+      }
+    }
+
+    int iThreads = Math::Min(m_iMaxPar, iCount);
+
+    if (iThreads <= 1)
+    {
+      pJob->Run();
+    }
+    else
+    {
+      array<Thread^>^ aThreads = gcnew array<Thread^>(iThreads);
+
+      for (int i = 0; i < iThreads; i++)
+      {
+        aThreads[i] = gcnew Thread(gcnew ThreadStart(pJob, &CanBitrateJob::Run));
+        aThreads[i]->Name         = "VCI bit rate detection";
+        aThreads[i]->IsBackground = true;
+        aThreads[i]->Start();
+      }
+
+      for (int i = 0; i < iThreads; i++)
+      {
+        aThreads[i]->Join();
+      }
+    }
+  }
+  finally
+  {
+    for (int i = 0; i < iCount; i++)
+    {
+      if ((nullptr != pJob->aBal[i]) && (m_pDevices->IndexOf(m_pDevices[i]) == i))
+      {
+        delete pJob->aBal[i];
+      }
+    }
+  }
+
+  return( pJob->aResult );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Detects the bit rate of a single controller. The method is called
+///   by the worker threads and reports all errors by the result.
+/// </summary>
+/// <param name="pJob">
+///   The running detection job.
+/// </param>
+/// <param name="iCtl">
+///   Index of the controller within the job.
+/// </param>
+/// <returns>
+///   The detection result of the controller.
+/// </returns>
+//*****************************************************************************
+CanBitrateDetection CanBitrateDetector::DetectOne( CanBitrateJob^ pJob
+                                                 , int            iCtl )
+{
+  IBalObject^ pBal = pJob->aBal[iCtl];
+
+  if (nullptr == pBal)
+  {
+    // opening the BAL already failed
+    return( pJob->aResult[iCtl] );
+  }
+
+  String^              pKey     = MakeKey(pJob->aHwId[iCtl], pJob->aPort[iCtl]);
+  array<int>^          aOrder   = Order(pKey, pJob->aTable);
+  array<CanFdBitrate>^ aOrdered = gcnew array<CanFdBitrate>(aOrder->Length);
+  Stopwatch^           pWatch   = Stopwatch::StartNew();
+  ICanControl2^        pCtl     = nullptr;
+  int                  iIndex   = -1;
+  int                  iError   = VCI_OK;
+
+  for (int i = 0; i < aOrder->Length; i++)
+  {
+    aOrdered[i] = pJob->aTable[aOrder[i]];
+  }
+
+  try
+  {
+    pCtl = dynamic_cast<ICanControl2^>(
+             pBal->OpenSocket(pJob->aPort[iCtl], ICanControl2::typeid));
+
+    if (nullptr != pCtl)
+    {
+      iIndex = pCtl->DetectBaud(pJob->eMode, pJob->eExtMode,
+                                pJob->wTimeout, aOrdered);
+    }
+    else
+    {
+      iError = E_NOINTERFACE;
+    }
+  }
+  catch (Exception^ e)
+  {
+    iError = e->HResult;
+  }
+  finally
+  {
+    delete pCtl;
+  }
+
+  pWatch->Stop();
+
+  if (iIndex >= 0)
+  {
+    // map back to the table of the caller
+    iIndex = aOrder[iIndex];
+    Remember(pKey, pJob->aTable[iIndex]);
+
+    return( CanBitrateDetection(pJob->aHwId[iCtl], pJob->aPort[iCtl], iIndex,
+                                pJob->aTable[iIndex], VCI_OK, pWatch->Elapsed) );
+  }
+
+  return( CanBitrateDetection(pJob->aHwId[iCtl], pJob->aPort[iCtl], -1,
+                              CanFdBitrate(), iError, pWatch->Elapsed) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Determines the order in which the table entries are tested for a
+///   controller: the bit rate last detected on the controller first,
+///   then the bit rates detected most often, then the remaining entries
+///   in table order.
+/// </summary>
+/// <param name="pKey">
+///   Cache key of the controller.
+/// </param>
+/// <param name="aTable">
+///   Bit rate table of the caller.
+/// </param>
+/// <returns>
+///   Permutation of the table indices.
+/// </returns>
+//*****************************************************************************
+array<int>^ CanBitrateDetector::Order( String^              pKey
+                                     , array<CanFdBitrate>^ aTable )
+{
+  int                  iLength = aTable->Length;
+  array<int>^          aOrder  = gcnew array<int>(iLength);
+  array<bool>^         aUsed   = gcnew array<bool>(iLength);
+  int                  iFill   = 0;
+  array<CanFdBitrate>^ aPrior;
+  array<int>^          aCounts;
+  CanFdBitrate         sLast;
+  bool                 fLast;
+
+  Monitor::Enter(ms_pSync);
+  try
+  {
+    fLast   = ms_pLast->TryGetValue(pKey, sLast);
+    aPrior  = ms_pRates->ToArray();
+    aCounts = ms_pCounts->ToArray();
+  }
+  finally
+  {
+    Monitor::Exit(ms_pSync);
+  }
+
+  // most frequent bit rates first
+  for (int i = 0; i < aCounts->Length; i++)
+  {
+    aCounts[i] = -aCounts[i];
+  }
+  Array::Sort(aCounts, aPrior);
+
+  for (int p = -1; p < aPrior->Length; p++)
+  {
+    if ((p < 0) && !fLast)
+    {
+      continue;
+    }
+
+    CanFdBitrate sRate = (p < 0) ? sLast : aPrior[p];
+
+    for (int i = 0; i < iLength; i++)
+    {
+      if (!aUsed[i] && IsEqual(aTable[i], sRate))
+      {
+        aUsed[i]        = true;
+        aOrder[iFill++] = i;
+        break;
+      }
+    }
+  }
+
+  for (int i = 0; i < iLength; i++)
+  {
+    if (!aUsed[i])
+    {
+      aOrder[iFill++] = i;
+    }
+  }
+
+  return( aOrder );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Records a detected bit rate in the history shared by all detectors.
+/// </summary>
+/// <param name="pKey">
+///   Cache key of the controller.
+/// </param>
+/// <param name="sBitrate">
+///   The detected bit rate.
+/// </param>
+//*****************************************************************************
+void CanBitrateDetector::Remember( String^      pKey
+                                 , CanFdBitrate sBitrate )
+{
+  Monitor::Enter(ms_pSync);
+  try
+  {
+    ms_pLast[pKey] = sBitrate;
+
+    for (int i = 0; i < ms_pRates->Count; i++)
+    {
+      if (IsEqual(ms_pRates[i], sBitrate))
+      {
+        ms_pCounts[i] = ms_pCounts[i] + 1;
+        return;
+      }
+    }
+
+    ms_pRates->Add(sBitrate);
+    ms_pCounts->Add(1);
+  }
+  finally
+  {
+    Monitor::Exit(ms_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Discards the detection history shared by all detectors.
+/// </summary>
+//*****************************************************************************
+void CanBitrateDetector::ClearCache(void)
+{
+  Monitor::Enter(ms_pSync);
+  try
+  {
+    ms_pLast->Clear();
+    ms_pRates->Clear();
+    ms_pCounts->Clear();
+  }
+  finally
+  {
+    Monitor::Exit(ms_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Builds the cache key of a controller.
+/// </summary>
+/// <param name="pHwId">
+///   Unique hardware id of the device.
+/// </param>
+/// <param name="bPort">
+///   Port number of the controller.
+/// </param>
+/// <returns>
+///   The cache key.
+/// </returns>
+//*****************************************************************************
+String^ CanBitrateDetector::MakeKey( Object^ pHwId
+                                   , Byte    bPort )
+{
+  return( String::Format("{0}/{1}", pHwId, bPort) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Compares two bit rates.
+/// </summary>
+/// <returns>
+///   true if both the standard and the fast bit rate are equal.
+/// </returns>
+//*****************************************************************************
+bool CanBitrateDetector::IsEqual( CanFdBitrate sLeft
+                                , CanFdBitrate sRight )
+{
+  return( sLeft.StdBitrate.Equals(sRight.StdBitrate) &&
+          sLeft.FastBitrate.Equals(sRight.FastBitrate) );
+}
+
+#pragma warning(default:4669)
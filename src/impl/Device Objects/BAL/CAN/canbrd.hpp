@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the bit rate detection service which detects
+//            the bit rate of several CAN lines concurrently.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+using namespace System::Collections::Generic;
+
+
+// default number of controllers tested at the same time
+#define BRD_MAX_PARALLEL      8
+
+
+// forward decls
+ref class CanBitrateDetector;
+
+
+//*****************************************************************************
+/// <summary>
+///   State of a single call to CanBitrateDetector::Detect which is shared
+///   by the worker threads.
+/// </summary>
+//*****************************************************************************
+private ref class CanBitrateJob
+{
+  internal:
+    CanBitrateDetector^          pOwner;    // detector which runs the job
+    CanOperatingModes            eMode;     // operating mode
+    CanExtendedOperatingModes    eExtMode;  // extended operating mode
+    UInt16                       wTimeout;  // timeout per chunk in ms
+    array<CanFdBitrate>^         aTable;    // bit rate table of the caller
+    array<IBalObject^>^          aBal;      // BAL per controller
+    array<Object^>^              aHwId;     // hardware id per controller
+    array<Byte>^                 aPort;     // port number per controller
+    array<CanBitrateDetection>^  aResult;   // result per controller
+    int                          iNext;     // next controller to test
+
+    void Run ( void );
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   This class implements the bit rate detection service.
+/// </summary>
+//*****************************************************************************
+private ref class CanBitrateDetector : public ICanBitrateDetector
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    // detection history shared by all detectors of the process
+    static Dictionary<String^, CanFdBitrate>^ ms_pLast   = gcnew Dictionary<String^, CanFdBitrate>();
+    static List<CanFdBitrate>^                ms_pRates  = gcnew List<CanFdBitrate>();
+    static List<int>^                         ms_pCounts = gcnew List<int>();
+    static Object^                            ms_pSync   = gcnew Object();
+
+    List<IVciDevice^>^ m_pDevices; // registered devices
+    List<Byte>^        m_pPorts;   // registered port numbers
+    int                m_iMaxPar;  // maximum number of worker threads
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    array<int>^         Order      ( String^              pKey
+                                   , array<CanFdBitrate>^ aTable );
+    void                Remember   ( String^              pKey
+                                   , CanFdBitrate         sBitrate );
+
+    static String^      MakeKey    ( Object^              pHwId
+                                   , Byte                 bPort );
+    static bool         IsEqual    ( CanFdBitrate         sLeft
+                                   , CanFdBitrate         sRight );
+
+  internal:
+    CanBitrateDetector ( void );
+
+    CanBitrateDetection DetectOne  ( CanBitrateJob^ pJob
+                                   , int            iCtl );
+
+  //--------------------------------------------------------------------
+  // ICanBitrateDetector implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual property int MaxParallel     { int  get(void);
+                                           void set(int value); };
+    virtual property int ControllerCount { int  get(void); };
+
+    virtual void AddController ( IVciDevice^ device
+                               , Byte        portNumber );
+
+    virtual array<CanBitrateDetection>^ Detect
+                               ( CanOperatingModes         operatingMode
+                               , CanExtendedOperatingModes extendedMode
+                               , UInt16                    timeout
+                               , array<CanFdBitrate>^      bitrateTable );
+
+    virtual void ClearCache    ( void );
+};
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
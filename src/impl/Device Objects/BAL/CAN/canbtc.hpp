@@ -0,0 +1,441 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Native bit timing calculator for CAN and CAN FD controllers.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+
+// maximum accepted deviation of the bit rate in ppm
+#define BTC_MAX_ERROR_PPM     5000
+
+// score penalty for different prescalers of the arbitration and the data
+// phase, corresponds to a sample point deviation of 1%
+#define BTC_BRP_PENALTY       (100 * BTC_WEIGHT_SP)
+
+// weights of the score components
+#define BTC_WEIGHT_PPM        10000
+#define BTC_WEIGHT_SP         16
+
+// minimum data bit rate which uses transmitter delay compensation
+#define BTC_TDC_MIN_BITRATE   1000000
+
+
+//*****************************************************************************
+/// <summary>
+///   Valid ranges of the bit timing parameters of a controller phase.
+///   The values correspond to the sSdrRangeMin/Max and sFdrRangeMin/Max
+///   members of the CANCAPABILITIES2 structure.
+/// </summary>
+//*****************************************************************************
+struct BTCRANGE
+{
+  UINT32 dwBrpMin;   // minimum prescaler
+  UINT32 dwBrpMax;   // maximum prescaler
+  UINT16 wTs1Min;    // minimum length of time segment 1 in quanta
+  UINT16 wTs1Max;    // maximum length of time segment 1 in quanta
+  UINT16 wTs2Min;    // minimum length of time segment 2 in quanta
+  UINT16 wTs2Max;    // maximum length of time segment 2 in quanta
+  UINT16 wSjwMax;    // maximum re-synchronisation jump width in quanta
+  UINT16 wTdoMax;    // maximum transmitter delay offset in clock cycles
+};
+
+//*****************************************************************************
+/// <summary>
+///   Bit timing of a controller phase calculated by BtcSolve.
+/// </summary>
+//*****************************************************************************
+struct BTCRESULT
+{
+  UINT32 dwBrp;      // prescaler
+  UINT16 wTs1;       // length of time segment 1 in quanta
+  UINT16 wTs2;       // length of time segment 2 in quanta
+  UINT16 wSjw;       // re-synchronisation jump width in quanta
+  UINT16 wTdo;       // transmitter delay offset in clock cycles (0 = disabled)
+  UINT32 dwErrPpm;   // deviation of the bit rate in ppm
+  UINT32 dwErrSp;    // deviation of the sample point in 0.01%
+  UINT64 qwScore;    // score of the timing, lower is better
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   Default sample points depending on the bit rate as recommended by
+///   CiA 601-3. The table is evaluated at compile time.
+/// </summary>
+//*****************************************************************************
+struct BTCSPENTRY
+{
+  UINT32 dwBitrate;  // upper limit of the bit rate
+  UINT16 wSpArb;     // sample point of the arbitration phase in 0.01%
+  UINT16 wSpData;    // sample point of the data phase in 0.01%
+};
+
+constexpr BTCSPENTRY g_asBtcSamplePoints[] =
+{
+  {    500000, 8750, 8000 },
+  {    800000, 8000, 8000 },
+  {   2000000, 7500, 8000 },
+  {   5000000, 7500, 7500 },
+  { 0xFFFFFFFF, 7500, 7000 },
+};
+
+//*****************************************************************************
+/// <summary>
+///   Gets the default sample point for the specified bit rate.
+/// </summary>
+/// <param name="dwBitrate">
+///   Bit rate in bit/s.
+/// </param>
+/// <param name="fData">
+///   true for the data phase, false for the arbitration phase.
+/// </param>
+/// <returns>
+///   The sample point in 0.01%.
+/// </returns>
+//*****************************************************************************
+constexpr UINT16 BtcDefaultSamplePoint( UINT32 dwBitrate
+                                      , bool   fData )
+{
+  for (const BTCSPENTRY& e : g_asBtcSamplePoints)
+  {
+    if (dwBitrate <= e.dwBitrate)
+    {
+      return( fData ? e.wSpData : e.wSpArb );
+    }
+  }
+  return( 7500 );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Calculates the best bit timing for a fixed prescaler.
+/// </summary>
+/// <param name="dwClock">
+///   Clock frequency of the controller in Hz.
+/// </param>
+/// <param name="dwBrp">
+///   Prescaler to use.
+/// </param>
+/// <param name="rRange">
+///   Valid ranges of the timing parameters.
+/// </param>
+/// <param name="dwBitrate">
+///   Requested bit rate in bit/s.
+/// </param>
+/// <param name="wSp">
+///   Requested sample point in 0.01%.
+/// </param>
+/// <param name="fData">
+///   true for the data phase, false for the arbitration phase.
+/// </param>
+/// <param name="rResult">
+///   Receives the bit timing.
+/// </param>
+/// <returns>
+///   true if a valid timing exists for the prescaler.
+/// </returns>
+//*****************************************************************************
+constexpr bool BtcSolveBrp( UINT32          dwClock
+                          , UINT32          dwBrp
+                          , const BTCRANGE& rRange
+                          , UINT32          dwBitrate
+                          , UINT16          wSp
+                          , bool            fData
+                          , BTCRESULT&      rResult )
+{
+  UINT64 qwDiv = (UINT64) dwBrp * dwBitrate;
+  UINT64 qwTq  = (dwClock + qwDiv / 2) / qwDiv;
+
+  // the bit time consists of the sync segment, TS1 and TS2
+  if ((qwTq < 1u + rRange.wTs1Min + rRange.wTs2Min) ||
+      (qwTq > 1u + rRange.wTs1Max + rRange.wTs2Max))
+  {
+    return( false );
+  }
+
+  UINT64 qwReal = qwDiv * qwTq;
+  UINT64 qwDiff = (qwReal > dwClock) ? (qwReal - dwClock) : (dwClock - qwReal);
+  UINT64 qwPpm  = qwDiff * 1000000 / qwReal;
+
+  if (qwPpm > BTC_MAX_ERROR_PPM)
+  {
+    return( false );
+  }
+
+  // place the sample point at the end of TS1
+  INT64 iTs1 = (INT64) ((wSp * qwTq + 5000) / 10000) - 1;
+  INT64 iTs2 = (INT64) qwTq - 1 - iTs1;
+
+  if (iTs2 > rRange.wTs2Max)
+  {
+    iTs2 = rRange.wTs2Max;
+    iTs1 = (INT64) qwTq - 1 - iTs2;
+  }
+  else if (iTs2 < rRange.wTs2Min)
+  {
+    iTs2 = rRange.wTs2Min;
+    iTs1 = (INT64) qwTq - 1 - iTs2;
+  }
+
+  if ((iTs1 < rRange.wTs1Min) || (iTs1 > rRange.wTs1Max))
+  {
+    return( false );
+  }
+
+  INT64 iSpPos = (1 + iTs1) * 10000;
+  INT64 iSpReq = (INT64) wSp * (INT64) qwTq;
+  INT64 iSpErr = ((iSpPos > iSpReq) ? (iSpPos - iSpReq) : (iSpReq - iSpPos)) / (INT64) qwTq;
+
+  // the widest jump width gives the best oscillator tolerance
+  INT64 iSjw = (iTs1 < iTs2) ? iTs1 : iTs2;
+  if (iSjw > rRange.wSjwMax)
+  {
+    iSjw = rRange.wSjwMax;
+  }
+
+  // the secondary sample point of the transmitter delay compensation
+  // is placed at the sample point, the offset is counted in clock cycles
+  INT64 iTdo = 0;
+  if (fData && (rRange.wTdoMax > 0) && (dwBitrate > BTC_TDC_MIN_BITRATE))
+  {
+    iTdo = (INT64) dwBrp * (1 + iTs1);
+    if (iTdo > rRange.wTdoMax)
+    {
+      iTdo = rRange.wTdoMax;
+    }
+  }
+
+  rResult.dwBrp    = dwBrp;
+  rResult.wTs1     = (UINT16) iTs1;
+  rResult.wTs2     = (UINT16) iTs2;
+  rResult.wSjw     = (UINT16) iSjw;
+  rResult.wTdo     = (UINT16) iTdo;
+  rResult.dwErrPpm = (UINT32) qwPpm;
+  rResult.dwErrSp  = (UINT32) iSpErr;
+
+  // exact bit rate first, then the sample point, then the finest resolution
+  rResult.qwScore  = qwPpm * BTC_WEIGHT_PPM + (UINT64) iSpErr * BTC_WEIGHT_SP + dwBrp;
+
+  return( true );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Calculates the best bit timing of a single phase by enumerating all
+///   valid prescalers.
+/// </summary>
+/// <param name="dwClock">
+///   Clock frequency of the controller in Hz.
+/// </param>
+/// <param name="rRange">
+///   Valid ranges of the timing parameters.
+/// </param>
+/// <param name="dwBitrate">
+///   Requested bit rate in bit/s.
+/// </param>
+/// <param name="wSp">
+///   Requested sample point in 0.01%.
+/// </param>
+/// <param name="fData">
+///   true for the data phase, false for the arbitration phase.
+/// </param>
+/// <param name="rResult">
+///   Receives the best bit timing.
+/// </param>
+/// <returns>
+///   true if a valid timing exists.
+/// </returns>
+//*****************************************************************************
+constexpr bool BtcSolve( UINT32          dwClock
+                       , const BTCRANGE& rRange
+                       , UINT32          dwBitrate
+                       , UINT16          wSp
+                       , bool            fData
+                       , BTCRESULT&      rResult )
+{
+  bool fFound = false;
+
+  if ((0 == dwClock) || (0 == dwBitrate))
+  {
+    return( false );
+  }
+
+  for (UINT32 dwBrp = rRange.dwBrpMin; dwBrp <= rRange.dwBrpMax; dwBrp++)
+  {
+    BTCRESULT sCand = {};
+
+    if ((UINT64) dwBrp * dwBitrate > dwClock)
+    {
+      break;
+    }
+
+    if (BtcSolveBrp(dwClock, dwBrp, rRange, dwBitrate, wSp, fData, sCand) &&
+        (!fFound || (sCand.qwScore < rResult.qwScore)))
+    {
+      rResult = sCand;
+      fFound  = true;
+    }
+  }
+
+  return( fFound );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Calculates the best bit timing for both phases of a CAN FD
+///   controller. Equal prescalers for both phases are preferred as
+///   recommended by CiA 601-3.
+/// </summary>
+/// <param name="dwClock">
+///   Clock frequency of the controller in Hz.
+/// </param>
+/// <param name="rArbRange">
+///   Valid ranges of the arbitration phase.
+/// </param>
+/// <param name="dwArbBitrate">
+///   Requested arbitration bit rate in bit/s.
+/// </param>
+/// <param name="wArbSp">
+///   Requested arbitration sample point in 0.01%.
+/// </param>
+/// <param name="rDataRange">
+///   Valid ranges of the data phase.
+/// </param>
+/// <param name="dwDataBitrate">
+///   Requested data bit rate in bit/s.
+/// </param>
+/// <param name="wDataSp">
+///   Requested data sample point in 0.01%.
+/// </param>
+/// <param name="rArb">
+///   Receives the arbitration bit timing.
+/// </param>
+/// <param name="rData">
+///   Receives the data bit timing.
+/// </param>
+/// <returns>
+///   true if valid timings exist for both phases.
+/// </returns>
+/// <remarks>
+///   The best pair is either the best timing of each phase (plus the
+///   prescaler penalty if the prescalers differ) or the best pair with
+///   a common prescaler, so a single pass over the prescalers suffices.
+/// </remarks>
+//*****************************************************************************
+constexpr bool BtcSolveFd( UINT32          dwClock
+                         , const BTCRANGE& rArbRange
+                         , UINT32          dwArbBitrate
+                         , UINT16          wArbSp
+                         , const BTCRANGE& rDataRange
+                         , UINT32          dwDataBitrate
+                         , UINT16          wDataSp
+                         , BTCRESULT&      rArb
+                         , BTCRESULT&      rData )
+{
+  if (!BtcSolve(dwClock, rArbRange, dwArbBitrate, wArbSp, false, rArb) ||
+      !BtcSolve(dwClock, rDataRange, dwDataBitrate, wDataSp, true, rData))
+  {
+    return( false );
+  }
+
+  UINT64 qwBest = rArb.qwScore + rData.qwScore;
+  if (rArb.dwBrp != rData.dwBrp)
+  {
+    qwBest += BTC_BRP_PENALTY;
+  }
+
+  UINT32 dwLow  = (rArbRange.dwBrpMin > rDataRange.dwBrpMin) ? rArbRange.dwBrpMin : rDataRange.dwBrpMin;
+  UINT32 dwHigh = (rArbRange.dwBrpMax < rDataRange.dwBrpMax) ? rArbRange.dwBrpMax : rDataRange.dwBrpMax;
+
+  for (UINT32 dwBrp = dwLow; dwBrp <= dwHigh; dwBrp++)
+  {
+    BTCRESULT sArb  = {};
+    BTCRESULT sData = {};
+
+    if ((UINT64) dwBrp * dwDataBitrate > dwClock)
+    {
+      break;
+    }
+
+    if (BtcSolveBrp(dwClock, dwBrp, rArbRange, dwArbBitrate, wArbSp, false, sArb) &&
+        BtcSolveBrp(dwClock, dwBrp, rDataRange, dwDataBitrate, wDataSp, true, sData) &&
+        (sArb.qwScore + sData.qwScore < qwBest))
+    {
+      qwBest = sArb.qwScore + sData.qwScore;
+      rArb   = sArb;
+      rData  = sData;
+    }
+  }
+
+  return( true );
+}
+
+
+// compile time checks of the solver against well-known timings
+namespace BtcSelfTest {
+
+  constexpr BTCRANGE g_sArb  = { 1, 1024, 1, 256, 1, 128, 128, 0 };
+  constexpr BTCRANGE g_sData = { 1, 32, 1, 32, 1, 16, 16, 64 };
+  constexpr BTCRANGE g_sTs16 = { 1, 32, 1, 16, 1, 16, 16, 64 };
+
+  constexpr BTCRESULT Arb( UINT32 dwClock, UINT32 dwBitrate )
+  {
+    BTCRESULT r = {};
+    BtcSolve(dwClock, g_sArb, dwBitrate, BtcDefaultSamplePoint(dwBitrate, false), false, r);
+    return( r );
+  }
+
+  constexpr BTCRESULT FdData( UINT32 dwClock, UINT32 dwArb, UINT32 dwData
+                            , const BTCRANGE& rData = g_sData )
+  {
+    BTCRESULT a = {};
+    BTCRESULT d = {};
+    BtcSolveFd(dwClock, g_sArb, dwArb, BtcDefaultSamplePoint(dwArb, false),
+               rData, dwData, BtcDefaultSamplePoint(dwData, true), a, d);
+    return( d );
+  }
+
+  // 80 MHz, 500 kbit/s, 87.5%: 160 quanta at prescaler 1
+  static_assert(Arb(80000000, 500000).dwBrp == 1,   "BTC self test");
+  static_assert(Arb(80000000, 500000).wTs1  == 139, "BTC self test");
+  static_assert(Arb(80000000, 500000).wTs2  == 20,  "BTC self test");
+  static_assert(Arb(80000000, 500000).dwErrPpm == 0, "BTC self test");
+
+  // 80 MHz, 500 kbit/s / 2 Mbit/s: common prescaler 1, 80% data sample point
+  static_assert(FdData(80000000, 500000, 2000000).dwBrp == 1,  "BTC self test");
+  static_assert(FdData(80000000, 500000, 2000000).wTs1  == 31, "BTC self test");
+  static_assert(FdData(80000000, 500000, 2000000).wTs2  == 8,  "BTC self test");
+  static_assert(FdData(80000000, 500000, 2000000).wTdo  == 32, "BTC self test");
+
+  // 40 MHz, 1 Mbit/s / 8 Mbit/s: data phase limited to 5 quanta
+  static_assert(FdData(40000000, 1000000, 8000000).dwBrp == 1, "BTC self test");
+  static_assert(FdData(40000000, 1000000, 8000000).wTs1  == 3, "BTC self test");
+  static_assert(FdData(40000000, 1000000, 8000000).wTs2  == 1, "BTC self test");
+
+  // 80 MHz, 500 kbit/s / 2 Mbit/s with time segment 1 limited to 16 quanta:
+  // prescaler 2 and TDO = 2 * (1 + 15) clock cycles as the preset
+  // CanBitrate2.IFI2000KBit
+  static_assert(FdData(80000000, 500000, 2000000, g_sTs16).dwBrp == 2,  "BTC self test");
+  static_assert(FdData(80000000, 500000, 2000000, g_sTs16).wTs1  == 15, "BTC self test");
+  static_assert(FdData(80000000, 500000, 2000000, g_sTs16).wTs2  == 4,  "BTC self test");
+  static_assert(FdData(80000000, 500000, 2000000, g_sTs16).wSjw  == 4,  "BTC self test");
+  static_assert(FdData(80000000, 500000, 2000000, g_sTs16).wTdo  == 32, "BTC self test");
+
+} // end of namespace BtcSelfTest
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the process wide cache of CAN capabilities.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "cancaps.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+using namespace System::Threading;
+
+#pragma warning(disable:4669) // 'type cast' : unsafe conversion
+
+
+//*****************************************************************************
+/// <summary>
+///   Gets the capabilities of the specified CAN controller. On the first
+///   request for a controller the capabilities are read from the socket
+///   and added to the cache.
+/// </summary>
+/// <param name="deviceId">
+///   Unique hardware id of the device.
+/// </param>
+/// <param name="portNumber">
+///   Port number of the CAN controller.
+/// </param>
+/// <param name="pSocket">
+///   Native socket of the controller. Only used on a cache miss.
+///   This parameter must not be NULL.
+/// </param>
+/// <param name="ppCaps">
+///   Receives the shared snapshot. The snapshot must not be modified
+///   or released.
+/// </param>
+/// <returns>
+///   VCI_OK if succeeded, otherwise the error code of GetCapabilities.
+/// </returns>
+/// <exception cref="InsufficientMemoryException">
+///   Memory allocation failed.
+/// </exception>
+//*****************************************************************************
+HRESULT CanCapabilityCache::Get( Guid                      deviceId
+                               , Byte                      portNumber
+                               , ::ICanSocket2*            pSocket
+                               , const CANCAPABILITIES2**  ppCaps )
+{
+  Tuple<Guid, Byte>^ pKey = gcnew Tuple<Guid, Byte>(deviceId, portNumber);
+  IntPtr             pEntry;
+  HRESULT            hResult = VCI_OK;
+
+  Monitor::Enter(ms_pCache);
+  try
+  {
+    if (!ms_pCache->TryGetValue(pKey, pEntry))
+    {
+      PCANCAPABILITIES2 psCaps = new CANCAPABILITIES2;
+      if (nullptr == psCaps)
+      {
+        throw gcnew InsufficientMemoryException();
+      }
+
+      hResult = pSocket->GetCapabilities(psCaps);
+      if (hResult == VCI_OK)
+      {
+        pEntry = IntPtr(psCaps);
+        ms_pCache->Add(pKey, pEntry);
+      }
+      else
+      {
+        delete psCaps;
+      }
+    }
+  }
+  finally
+  {
+    Monitor::Exit(ms_pCache);
+  }
+
+  if (hResult == VCI_OK)
+  {
+    *ppCaps = (const CANCAPABILITIES2*) pEntry.ToPointer();
+  }
+
+  return( hResult );
+}
+
+#pragma warning(default:4669) // 'type cast' : unsafe conversion
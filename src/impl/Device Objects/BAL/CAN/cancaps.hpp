@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the process wide cache of CAN capabilities.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+using namespace System::Collections::Generic;
+
+
+//*****************************************************************************
+/// <summary>
+///   This class caches the capabilities of the CAN controllers per device
+///   and port number. All CAN sockets opened on the same controller share
+///   one immutable native snapshot, so the capabilities are requested from
+///   the driver only once.
+/// </summary>
+/// <remarks>
+///   The snapshots are never released. Their number is limited by the
+///   number of CAN controllers seen by the process. The devices are
+///   identified by their unique hardware id, which unlike the VCI object
+///   id is not reused for another device.
+/// </remarks>
+//*****************************************************************************
+private ref class CanCapabilityCache abstract sealed
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    static Dictionary<Tuple<Guid, Byte>^, IntPtr>^ ms_pCache =
+      gcnew Dictionary<Tuple<Guid, Byte>^, IntPtr>();
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  internal:
+    static HRESULT Get ( Guid                       deviceId
+                       , Byte                       portNumber
+                       , ::ICanSocket2*             pSocket
+                       , const CANCAPABILITIES2**   ppCaps );
+};
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
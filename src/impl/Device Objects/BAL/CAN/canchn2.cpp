@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "canchn2.hpp"
+#include "canfltc.hpp"
 #include "vcinet.hpp"
 
 using namespace Ixxat::Vci4::Bal::Can;
@@ -21,6 +22,9 @@ using namespace Ixxat::Vci4::Bal::Can;
 ///   Pointer to the native BAL object interface.
 ///   This parameter must not be NULL.
 /// </param>
+/// <param name="deviceId">
+///   Unique hardware id of the device.
+/// </param>
 /// <param name="bPortNo">
 ///   Port number of the bus socket to open.
 /// </param>
@@ -29,11 +33,13 @@ using namespace Ixxat::Vci4::Bal::Can;
 ///</param>
 //*****************************************************************************
 CanChannel2::CanChannel2( ::IBalObject* pBalObj
+                      , Guid          deviceId
                       , Byte          bPortNo
                       , Byte          busTypeIndex)
-          : CanSocket2(pBalObj, bPortNo, busTypeIndex)
+          : CanSocket2(pBalObj, deviceId, bPortNo, busTypeIndex)
 {
   m_pCanChn = NULL;
+  m_pFilter = gcnew CanFilterTable();
 
   // FxCop: "Do not make initializations,
   // that have already been done by the runtime."
@@ -169,6 +175,8 @@ void CanChannel2::Initialize( UInt16 receiveFifoSize
     {
       throw gcnew VciException(VciServerImpl::Instance(), hResult);
     }
+
+    m_pFilter->Clear();
   }
   else
   {
@@ -195,20 +203,34 @@ void CanChannel2::Initialize( UInt16 receiveFifoSize
 //*****************************************************************************
 void CanChannel2::Activate(void)
 {
-  HRESULT hResult;
+  VciResult sResult = TryActivate();
 
-  if (nullptr != m_pCanChn)
+  if (!sResult.Succeeded)
   {
-    hResult = m_pCanChn->Activate();
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Activates the CAN channel like <c>Activate</c>, but reports a
+///   failure through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanChannel2::TryActivate(void)
+{
+  if (nullptr == m_pCanChn)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pCanChn->Activate()) );
 }
 
 //*****************************************************************************
@@ -228,20 +250,34 @@ void CanChannel2::Activate(void)
 //*****************************************************************************
 void CanChannel2::Deactivate(void)
 {
-  HRESULT hResult;
+  VciResult sResult = TryDeactivate();
 
-  if (nullptr != m_pCanChn)
+  if (!sResult.Succeeded)
   {
-    hResult = m_pCanChn->Deactivate();
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Deactivates the CAN channel like <c>Deactivate</c>, but reports a
+///   failure through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanChannel2::TryDeactivate(void)
+{
+  if (nullptr == m_pCanChn)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pCanChn->Deactivate()) );
 }
 
 //*****************************************************************************
@@ -362,6 +398,71 @@ ICanMessageWriter^ CanChannel2::GetMessageWriter()
   return( pWriter );
 }
 
+//*****************************************************************************
+/// <summary>
+///   This method creates a host driven E2E scheduler which places periodic
+///   frames with recomputed counter and CRC into the transmit FIFO of
+///   this channel.
+/// </summary>
+/// <returns>
+///   A reference to the E2E scheduler.
+/// </returns>
+/// <exception cref="VciException">
+///   Getting the transmit FIFO failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed or not initialized, yet.
+/// </exception>
+//*****************************************************************************
+ICanE2EScheduler^ CanChannel2::CreateE2EScheduler()
+{
+  CanE2EScheduler^ pScheduler = nullptr;
+
+  if (nullptr != m_pCanChn)
+  {
+    pScheduler = gcnew CanE2EScheduler(m_pCanChn);
+  }
+  else
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  return( pScheduler );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method creates a planner which places messages with absolute
+///   target times into the transmit FIFO of this channel.
+/// </summary>
+/// <returns>
+///   A reference to the planner.
+/// </returns>
+/// <exception cref="NotSupportedException">
+///   The controller does not support delayed transmission.
+/// </exception>
+/// <exception cref="VciException">
+///   Getting the transmit FIFO failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed or not initialized, yet.
+/// </exception>
+//*****************************************************************************
+ICanDelayedTransmitPlanner^ CanChannel2::CreateDelayedTransmitPlanner()
+{
+  if (nullptr == m_pCanChn)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  if (!SupportsDelayedTransmission || (0 == MaxDelayedTXTicks))
+  {
+    throw gcnew NotSupportedException();
+  }
+
+  return( gcnew CanDelayedTransmitPlanner(m_pCanChn, TimeConverter, MaxDelayedTXTicks) );
+}
+
 //*****************************************************************************
 /// <summary>
 ///   This method returns the set filter mode for the given selection.
@@ -579,6 +680,8 @@ void CanChannel2::AddFilterIds(CanFilter bSelect,
     {
       throw gcnew VciException(VciServerImpl::Instance(), hResult);
     }
+
+    m_pFilter->Add(bSelect, dwCode, dwMask);
   }
   else
   {
@@ -641,6 +744,8 @@ void CanChannel2::RemFilterIds(CanFilter bSelect,
     {
       throw gcnew VciException(VciServerImpl::Instance(), hResult);
     }
+
+    m_pFilter->Remove(bSelect, dwCode, dwMask);
   }
   else
   {
@@ -648,4 +753,273 @@ void CanChannel2::RemFilterIds(CanFilter bSelect,
   }
 }
 
+//*****************************************************************************
+/// <summary>
+///   This method compiles the specified identifier ranges to the smallest
+///   possible set of code/mask pairs and registers them at the specified
+///   filter list.
+/// </summary>
+/// <param name="bSelect">
+///   Filter selection.
+/// </param>
+/// <param name="ranges">
+///   Identifier ranges to accept.
+/// </param>
+/// <param name="maxEntries">
+///   Maximum number of filter entries to use.
+/// </param>
+/// <returns>
+///   The registered code/mask pairs.
+/// </returns>
+/// <remarks>
+///   If registering an entry fails, the entries registered so far are
+///   removed again.
+/// </remarks>
+/// <exception cref="ArgumentNullException">
+///   Parameter ranges was a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   A range is invalid or maxEntries is less than 1.
+/// </exception>
+/// <exception cref="VciException">
+///   Registering filter Ids failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+array<CanFilterEntry>^ CanChannel2::AddFilterIds( CanFilter          bSelect
+                                                , array<CanIdRange>^ ranges
+                                                , int                maxEntries )
+{
+  HRESULT hResult = VCI_OK;
+  int     iEntry;
+
+  if (nullptr == m_pCanChn)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  array<CanFilterEntry>^ aEntries = CanFilterCompiler::Compile(bSelect, ranges, maxEntries);
+
+  for (iEntry = 0; iEntry < aEntries->Length; iEntry++)
+  {
+    hResult = m_pCanChn->AddFilterIds((UINT8) bSelect, aEntries[iEntry].Code, aEntries[iEntry].Mask);
+    if (hResult != VCI_OK)
+    {
+      break;
+    }
+    m_pFilter->Add(bSelect, aEntries[iEntry].Code, aEntries[iEntry].Mask);
+  }
+
+  if (hResult != VCI_OK)
+  {
+    while (iEntry-- > 0)
+    {
+      if (VCI_OK == m_pCanChn->RemFilterIds((UINT8) bSelect, aEntries[iEntry].Code, aEntries[iEntry].Mask))
+      {
+        m_pFilter->Remove(bSelect, aEntries[iEntry].Code, aEntries[iEntry].Mask);
+      }
+    }
+    throw gcnew VciException(VciServerImpl::Instance(), hResult);
+  }
+
+  return( aEntries );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method computes the tightest single code/mask pair which
+///   accepts all specified identifier ranges and sets it as global
+///   acceptance filter.
+/// </summary>
+/// <param name="bSelect">
+///   Filter selection.
+/// </param>
+/// <param name="ranges">
+///   Identifier ranges to accept. An empty array rejects all IDs.
+/// </param>
+/// <returns>
+///   The code/mask pair set as acceptance filter.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   Parameter ranges was a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   A range is invalid.
+/// </exception>
+/// <exception cref="VciException">
+///   Setting acceptance filter failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+CanFilterEntry CanChannel2::SetAccFilter( CanFilter          bSelect
+                                        , array<CanIdRange>^ ranges )
+{
+  HRESULT hResult;
+
+  if (nullptr == m_pCanChn)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  array<CanFilterEntry>^ aEntries = CanFilterCompiler::Compile(bSelect, ranges, 1);
+
+  CanFilterEntry sEntry = (aEntries->Length > 0)
+                        ? aEntries[0]
+                        : CanFilterEntry(CAN_ACC_CODE_NONE, CAN_ACC_MASK_NONE);
+
+  hResult = m_pCanChn->SetAccFilter((UINT8) bSelect, sEntry.Code, sEntry.Mask);
+  if (hResult != VCI_OK)
+  {
+    throw gcnew VciException(VciServerImpl::Instance(), hResult);
+  }
+
+  return( sEntry );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method returns the code/mask pairs currently registered at the
+///   specified filter list.
+/// </summary>
+/// <param name="bSelect">
+///   Filter selection.
+/// </param>
+/// <returns>
+///   Copy of the shadow filter table, ordered by code and mask.
+/// </returns>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Invalid filter selection.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+array<CanFilterEntry>^ CanChannel2::GetFilterIds( CanFilter bSelect )
+{
+  if (nullptr == m_pCanChn)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  return( m_pFilter->GetEntries(bSelect) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method replaces the content of the specified filter list with
+///   the specified code/mask pairs. Only the difference to the shadow
+///   filter table is transferred to the controller.
+/// </summary>
+/// <param name="bSelect">
+///   Filter selection.
+/// </param>
+/// <param name="entries">
+///   Code/mask pairs the filter list shall contain afterwards.
+/// </param>
+/// <returns>
+///   Number of add and remove requests sent to the controller.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   Parameter entries was a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Invalid filter selection.
+/// </exception>
+/// <exception cref="VciException">
+///   Updating filter Ids failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+int CanChannel2::SetFilterIds( CanFilter              bSelect
+                             , array<CanFilterEntry>^ entries )
+{
+  HRESULT hResult;
+
+  if (nullptr == m_pCanChn)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  List<CanFilterEntry>^ pRemove = gcnew List<CanFilterEntry>();
+  List<CanFilterEntry>^ pAdd    = gcnew List<CanFilterEntry>();
+
+  m_pFilter->Diff(bSelect, entries, pRemove, pAdd);
+
+  // the table is updated after each request, so it stays in sync with
+  // the controller even if a request fails
+  for each (CanFilterEntry sEntry in pRemove)
+  {
+    hResult = m_pCanChn->RemFilterIds((UINT8) bSelect, sEntry.Code, sEntry.Mask);
+    if (hResult != VCI_OK)
+    {
+      throw gcnew VciException(VciServerImpl::Instance(), hResult);
+    }
+    m_pFilter->Remove(bSelect, sEntry.Code, sEntry.Mask);
+  }
+
+  for each (CanFilterEntry sEntry in pAdd)
+  {
+    hResult = m_pCanChn->AddFilterIds((UINT8) bSelect, sEntry.Code, sEntry.Mask);
+    if (hResult != VCI_OK)
+    {
+      throw gcnew VciException(VciServerImpl::Instance(), hResult);
+    }
+    m_pFilter->Add(bSelect, sEntry.Code, sEntry.Mask);
+  }
+
+  return( pRemove->Count + pAdd->Count );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method compiles the specified identifier ranges and replaces
+///   the content of the specified filter list with the result.
+/// </summary>
+/// <param name="bSelect">
+///   Filter selection.
+/// </param>
+/// <param name="ranges">
+///   Identifier ranges to accept.
+/// </param>
+/// <param name="maxEntries">
+///   Maximum number of filter entries to use.
+/// </param>
+/// <returns>
+///   The code/mask pairs the filter list contains afterwards.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   Parameter ranges was a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   A range is invalid or maxEntries is less than 1.
+/// </exception>
+/// <exception cref="VciException">
+///   Updating filter Ids failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+array<CanFilterEntry>^ CanChannel2::SetFilterIds( CanFilter          bSelect
+                                                , array<CanIdRange>^ ranges
+                                                , int                maxEntries )
+{
+  if (nullptr == m_pCanChn)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  array<CanFilterEntry>^ aEntries = CanFilterCompiler::Compile(bSelect, ranges, maxEntries);
+
+  SetFilterIds(bSelect, aEntries);
+
+  return( aEntries );
+}
+
 #pragma warning(default:4669) // 'type cast' : unsafe conversion
@@ -11,6 +11,9 @@
 #include "cansoc2.hpp"
 #include "canmsgrd.hpp"
 #include "canmsgwr.hpp"
+#include "cane2e.hpp"
+#include "candtxp.hpp"
+#include "canfltt.hpp"
 
 
 namespace Ixxat {
@@ -33,6 +36,7 @@ private ref class CanChannel2 : public CanSocket2
   private:
     ::ICanChannel2* m_pCanChn; // pointer to the native channel object
     bool            m_fExOpen; // channel is opened in exclusive mode
+    CanFilterTable^ m_pFilter; // shadow copy of the filter lists
 
 
   //--------------------------------------------------------------------
@@ -44,6 +48,7 @@ private ref class CanChannel2 : public CanSocket2
 
   internal:
     CanChannel2  ( ::IBalObject* pBalObj
+                , Guid          deviceId
                 , Byte          bPortNo 
                 , Byte          busTypeIndex);
     ~CanChannel2 ( );
@@ -58,6 +63,8 @@ private ref class CanChannel2 : public CanSocket2
 
     virtual ICanMessageReader^ GetMessageReader(void);
     virtual ICanMessageWriter^ GetMessageWriter(void);
+    virtual ICanE2EScheduler^  CreateE2EScheduler(void);
+    virtual ICanDelayedTransmitPlanner^ CreateDelayedTransmitPlanner(void);
 
     virtual void Initialize( UInt16 receiveFifoSize
                            , UInt16 transmitFifoSize
@@ -66,6 +73,8 @@ private ref class CanChannel2 : public CanSocket2
                            , bool   exclusive );
     virtual void Activate  ( void );
     virtual void Deactivate( void );
+    virtual VciResult TryActivate  ( void );
+    virtual VciResult TryDeactivate( void );
 
     virtual UINT8 GetFilterMode(CanFilter bSelect);
 
@@ -83,6 +92,22 @@ private ref class CanChannel2 : public CanSocket2
     virtual void RemFilterIds(CanFilter bSelect,
                               UINT32 dwCode,
                               UINT32 dwMask);
+
+    virtual array<CanFilterEntry>^ AddFilterIds(CanFilter          bSelect,
+                                                array<CanIdRange>^ ranges,
+                                                int                maxEntries);
+
+    virtual CanFilterEntry SetAccFilter(CanFilter          bSelect,
+                                        array<CanIdRange>^ ranges);
+
+    virtual array<CanFilterEntry>^ GetFilterIds(CanFilter bSelect);
+
+    virtual int SetFilterIds(CanFilter              bSelect,
+                             array<CanFilterEntry>^ entries);
+
+    virtual array<CanFilterEntry>^ SetFilterIds(CanFilter          bSelect,
+                                                array<CanIdRange>^ ranges,
+                                                int                maxEntries);
 };
 
 
@@ -167,6 +167,7 @@ int CanControl::DetectBaud( UInt16             timeout
   CANBTRTABLE sBtrTab;
   int         iLength;
   int         iLowIdx;
+  int         iChunk;
   int         iResult = -1;
 
   if (nullptr == m_pCanCtl)
@@ -202,6 +203,7 @@ int CanControl::DetectBaud( UInt16             timeout
       sBtrTab.abBtr1[i] = bitrateTable[iLowIdx+i].Btr1;
     }
 
+    iChunk   = iLowIdx;
     iLength -= sBtrTab.bCount;
     iLowIdx += sBtrTab.bCount;
 
@@ -209,7 +211,8 @@ int CanControl::DetectBaud( UInt16             timeout
 
     if (hResult == VCI_OK)
     {
-      iResult = sBtrTab.bIndex;
+      // bIndex is relative to the transferred chunk
+      iResult = iChunk + sBtrTab.bIndex;
       break;
     }
   }
@@ -6,6 +6,8 @@
 //----------------------------------------------------------------------------
 
 #include "canctl2.hpp"
+#include "canfltc.hpp"
+#include "canbor.hpp"
 #include "vcinet.hpp"
 
 using namespace System::Text;
@@ -19,6 +21,9 @@ using namespace Ixxat::Vci4::Bal::Can;
 ///   Pointer to the native BAL object interface. 
 ///   This parameter must not be NULL.
 /// </param>
+/// <param name="deviceId">
+///   Unique hardware id of the device.
+/// </param>
 /// <param name="portNumber">
 ///   Port number of the bus socket to open.
 /// </param>
@@ -33,14 +38,19 @@ using namespace Ixxat::Vci4::Bal::Can;
 /// </exception>
 //*****************************************************************************
 CanControl2::CanControl2(::IBalObject*  pBalObj
+                      , Guid          deviceId
                       , Byte          portNumber
                       , Byte          busTypeIndex)
-          : CanSocket2(pBalObj, portNumber, busTypeIndex)
+          : CanSocket2(pBalObj, deviceId, portNumber, busTypeIndex)
 {
   HRESULT         hResult;
   ::ICanControl2*  pCanCtl;
 
-  m_pCanCtl = nullptr;
+  m_pSync       = gcnew Object();
+  m_pRecoveries = gcnew List<CanBusOffRecovery^>();
+  m_pCanCtl     = nullptr;
+  m_pFilter     = gcnew CanFilterTable();
+  m_psInit      = new CANINITLINE2;
 
   if (nullptr != pBalObj)
   {
@@ -73,6 +83,13 @@ CanControl2::CanControl2(::IBalObject*  pBalObj
 CanControl2::~CanControl2()
 {
   Cleanup();
+
+  // m_psInit lives as long as the object, Cleanup is also called by InitNew
+  if (nullptr != m_psInit)
+  {
+    delete m_psInit;
+    m_psInit = nullptr;
+  }
 }
 
 //*****************************************************************************
@@ -110,15 +127,162 @@ HRESULT CanControl2::InitNew(::ICanControl2* pCanCtl)
 //*****************************************************************************
 /// <summary>
 ///   This method performs tasks associated with freeing, releasing, or
-///   resetting unmanaged resources.
+///   resetting unmanaged resources. The bus-off recoveries created from
+///   this object are stopped before the native control is released.
 /// </summary>
 //*****************************************************************************
 void CanControl2::Cleanup(void)
 {
-  if (nullptr != m_pCanCtl)
+  ::ICanControl2*             pCanCtl;
+  array<CanBusOffRecovery^>^ aRecoveries;
+
+  // detach the native object first, so that neither the recovery threads
+  // nor new calls can use it after the lock is released
+  Monitor::Enter(m_pSync);
+  try
   {
-    m_pCanCtl->Release();
+    pCanCtl   = m_pCanCtl;
     m_pCanCtl = nullptr;
+    m_fInit   = false;
+
+    aRecoveries = m_pRecoveries->ToArray();
+    m_pRecoveries->Clear();
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+
+  // joining must not hold the lock, the recovery thread may wait for it
+  for each (CanBusOffRecovery^ pRecovery in aRecoveries)
+  {
+    pRecovery->Stop();
+  }
+
+  if (nullptr != pCanCtl)
+  {
+    pCanCtl->Release();
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Removes a disposed bus-off recovery from the list of recoveries
+///   which are stopped by <c>Cleanup</c>.
+/// </summary>
+/// <param name="pRecovery">
+///   The bus-off recovery to remove.
+/// </param>
+//*****************************************************************************
+void CanControl2::RemoveRecovery( CanBusOffRecovery^ pRecovery )
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    m_pRecoveries->Remove(pRecovery);
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets a value indicating whether InitLine succeeded at least once.
+/// </summary>
+//*****************************************************************************
+bool CanControl2::IsLineInitialized::get(void)
+{
+  return( m_fInit );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method recovers the line from bus off. It resets the line,
+///   initializes it with the parameters of the last successful InitLine,
+///   restores the filter lists and acceptance filters from the shadow
+///   table and starts the line. Used by the bus-off recovery thread,
+///   so the method doesn't throw. The whole sequence runs under the lock
+///   of the control, so that it doesn't interleave with calls from the
+///   application.
+/// </summary>
+/// <returns>
+///   VCI_OK if succeeded, otherwise a VCI error code.
+/// </returns>
+//*****************************************************************************
+HRESULT CanControl2::Recover(void)
+{
+  HRESULT hResult;
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if ((nullptr == m_pCanCtl) || !m_fInit)
+    {
+      return( VCI_E_UNEXPECTED );
+    }
+
+    array<CanFilterEntry>^ aStd = m_pFilter->GetEntries(CanFilter::Std);
+    array<CanFilterEntry>^ aExt = m_pFilter->GetEntries(CanFilter::Ext);
+    CanFilterEntry sStdAcc;
+    CanFilterEntry sExtAcc;
+    bool fStdAcc = m_pFilter->GetAcc(CanFilter::Std, sStdAcc);
+    bool fExtAcc = m_pFilter->GetAcc(CanFilter::Ext, sExtAcc);
+
+    hResult = m_pCanCtl->ResetLine();
+    if (hResult == VCI_OK)
+    {
+      m_pFilter->Clear();
+      hResult = m_pCanCtl->InitLine(m_psInit);
+    }
+
+    if ((hResult == VCI_OK) && fStdAcc)
+    {
+      hResult = m_pCanCtl->SetAccFilter((UINT8) CanFilter::Std, sStdAcc.Code, sStdAcc.Mask);
+      if (hResult == VCI_OK)
+      {
+        m_pFilter->SetAcc(CanFilter::Std, sStdAcc.Code, sStdAcc.Mask);
+      }
+    }
+
+    if ((hResult == VCI_OK) && fExtAcc)
+    {
+      hResult = m_pCanCtl->SetAccFilter((UINT8) CanFilter::Ext, sExtAcc.Code, sExtAcc.Mask);
+      if (hResult == VCI_OK)
+      {
+        m_pFilter->SetAcc(CanFilter::Ext, sExtAcc.Code, sExtAcc.Mask);
+      }
+    }
+
+    for (int i = 0; (hResult == VCI_OK) && (i < aStd->Length); i++)
+    {
+      hResult = m_pCanCtl->AddFilterIds((UINT8) CanFilter::Std, aStd[i].Code, aStd[i].Mask);
+      if (hResult == VCI_OK)
+      {
+        m_pFilter->Add(CanFilter::Std, aStd[i].Code, aStd[i].Mask);
+      }
+    }
+
+    for (int i = 0; (hResult == VCI_OK) && (i < aExt->Length); i++)
+    {
+      hResult = m_pCanCtl->AddFilterIds((UINT8) CanFilter::Ext, aExt[i].Code, aExt[i].Mask);
+      if (hResult == VCI_OK)
+      {
+        m_pFilter->Add(CanFilter::Ext, aExt[i].Code, aExt[i].Mask);
+      }
+    }
+
+    if (hResult == VCI_OK)
+    {
+      hResult = m_pCanCtl->StartLine();
+    }
+
+    return( hResult );
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
   }
 }
 
@@ -175,68 +339,79 @@ int CanControl2::DetectBaud( CanOperatingModes         operatingMode
   CANBTPTABLE sBtpTab;
   int         iLength;
   int         iLowIdx;
+  int         iChunk;
   int         iResult = -1;
 
-  if (nullptr == m_pCanCtl)
-  {
-    throw gcnew ObjectDisposedException(this->GetType()->FullName);
-  }
-
-  if (nullptr != bitrateTable)
-  {
-    iLength = bitrateTable->GetLength(0);
-    iLowIdx = bitrateTable->GetLowerBound(0);
-  }
-  else
+  Monitor::Enter(m_pSync);
+  try
   {
-    iLength = 0;
-    iLowIdx = 0;
-  }
+    if (nullptr == m_pCanCtl)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
 
-  while (iLength > 0)
-  {
-    if (iLength <= CAN_BTP_TABEL_SIZE)
-      sBtpTab.bCount = (UINT8) iLength;
+    if (nullptr != bitrateTable)
+    {
+      iLength = bitrateTable->GetLength(0);
+      iLowIdx = bitrateTable->GetLowerBound(0);
+    }
     else
-      sBtpTab.bCount = CAN_BTP_TABEL_SIZE;
-
-    sBtpTab.bIndex = 0xFF;
+    {
+      iLength = 0;
+      iLowIdx = 0;
+    }
 
-    for (UINT8 i = 0; i < sBtpTab.bCount; i++)
+    while (iLength > 0)
     {
-      sBtpTab.asBTP[i].sSdr.dwMode = (UINT32) bitrateTable[iLowIdx+i].StdBitrate.Mode;
-      sBtpTab.asBTP[i].sSdr.dwBPS = bitrateTable[iLowIdx+i].StdBitrate.Prescaler;
-      sBtpTab.asBTP[i].sSdr.wTS1 = bitrateTable[iLowIdx+i].StdBitrate.TimeSegment1;
-      sBtpTab.asBTP[i].sSdr.wTS2 = bitrateTable[iLowIdx+i].StdBitrate.TimeSegment2;
-      sBtpTab.asBTP[i].sSdr.wSJW = bitrateTable[iLowIdx+i].StdBitrate.Sjw;
-      sBtpTab.asBTP[i].sSdr.wTDO = bitrateTable[iLowIdx+i].StdBitrate.TransmitterDelay;
+      if (iLength <= CAN_BTP_TABEL_SIZE)
+        sBtpTab.bCount = (UINT8) iLength;
+      else
+        sBtpTab.bCount = CAN_BTP_TABEL_SIZE;
 
-      sBtpTab.asBTP[i].sFdr.dwMode = (UINT32) bitrateTable[iLowIdx+i].FastBitrate.Mode;
-      sBtpTab.asBTP[i].sFdr.dwBPS = bitrateTable[iLowIdx+i].FastBitrate.Prescaler;
-      sBtpTab.asBTP[i].sFdr.wTS1 = bitrateTable[iLowIdx+i].FastBitrate.TimeSegment1;
-      sBtpTab.asBTP[i].sFdr.wTS2 = bitrateTable[iLowIdx+i].FastBitrate.TimeSegment2;
-      sBtpTab.asBTP[i].sFdr.wSJW = bitrateTable[iLowIdx+i].FastBitrate.Sjw;
-      sBtpTab.asBTP[i].sFdr.wTDO = bitrateTable[iLowIdx+i].FastBitrate.TransmitterDelay;
-    }
+      sBtpTab.bIndex = 0xFF;
 
-    iLength -= sBtpTab.bCount;
-    iLowIdx += sBtpTab.bCount;
+      for (UINT8 i = 0; i < sBtpTab.bCount; i++)
+      {
+        sBtpTab.asBTP[i].sSdr.dwMode = (UINT32) bitrateTable[iLowIdx+i].StdBitrate.Mode;
+        sBtpTab.asBTP[i].sSdr.dwBPS = bitrateTable[iLowIdx+i].StdBitrate.Prescaler;
+        sBtpTab.asBTP[i].sSdr.wTS1 = bitrateTable[iLowIdx+i].StdBitrate.TimeSegment1;
+        sBtpTab.asBTP[i].sSdr.wTS2 = bitrateTable[iLowIdx+i].StdBitrate.TimeSegment2;
+        sBtpTab.asBTP[i].sSdr.wSJW = bitrateTable[iLowIdx+i].StdBitrate.Sjw;
+        sBtpTab.asBTP[i].sSdr.wTDO = bitrateTable[iLowIdx+i].StdBitrate.TransmitterDelay;
 
-    hResult = m_pCanCtl->DetectBaud((UINT8) operatingMode, (UINT8) extendedMode, timeout, &sBtpTab);
+        sBtpTab.asBTP[i].sFdr.dwMode = (UINT32) bitrateTable[iLowIdx+i].FastBitrate.Mode;
+        sBtpTab.asBTP[i].sFdr.dwBPS = bitrateTable[iLowIdx+i].FastBitrate.Prescaler;
+        sBtpTab.asBTP[i].sFdr.wTS1 = bitrateTable[iLowIdx+i].FastBitrate.TimeSegment1;
+        sBtpTab.asBTP[i].sFdr.wTS2 = bitrateTable[iLowIdx+i].FastBitrate.TimeSegment2;
+        sBtpTab.asBTP[i].sFdr.wSJW = bitrateTable[iLowIdx+i].FastBitrate.Sjw;
+        sBtpTab.asBTP[i].sFdr.wTDO = bitrateTable[iLowIdx+i].FastBitrate.TransmitterDelay;
+      }
 
-    if (hResult == VCI_OK)
+      iChunk   = iLowIdx;
+      iLength -= sBtpTab.bCount;
+      iLowIdx += sBtpTab.bCount;
+
+      hResult = m_pCanCtl->DetectBaud((UINT8) operatingMode, (UINT8) extendedMode, timeout, &sBtpTab);
+
+      if (hResult == VCI_OK)
+      {
+        // bIndex is relative to the transferred chunk
+        iResult = iChunk + sBtpTab.bIndex;
+        break;
+      }
+    }
+
+    if (hResult != VCI_OK)
     {
-      iResult = sBtpTab.bIndex;
-      break;
+      throw gcnew VciException(VciServerImpl::Instance(), hResult);
     }
-  }
 
-  if (hResult != VCI_OK)
+    return( iResult );
+  }
+  finally
   {
-    throw gcnew VciException(VciServerImpl::Instance(), hResult);
+    Monitor::Exit(m_pSync);
   }
-
-  return( iResult );
 }
 
 //*****************************************************************************
@@ -318,53 +493,65 @@ void CanControl2::InitLine( CanOperatingModes operatingMode
                           , CanBitrate2 bitrate
                           , CanBitrate2 extendedBitrate)
 {
-  HRESULT     hResult;
-  CANINITLINE2 InitPara;
-
-  if (nullptr != m_pCanCtl)
-  {
-    InitPara.bOpMode   = (UINT8) operatingMode;
-    InitPara.bExMode   = (UINT8) extendedMode;
-
-    InitPara.bSFMode   = (UINT8) filterModeStd;
-    InitPara.dwSFIds   = cntIdsStd;
-    InitPara.bEFMode   = (UINT8) filterModeExt;
-    InitPara.dwEFIds   = cntIdsExt;
-    
-    InitPara.sBtpSdr.dwMode = (UInt32)bitrate.Mode;
-    InitPara.sBtpSdr.dwBPS = bitrate.Prescaler;
-    InitPara.sBtpSdr.wTS1 = bitrate.TimeSegment1;
-    InitPara.sBtpSdr.wTS2 = bitrate.TimeSegment2;
-    InitPara.sBtpSdr.wSJW = bitrate.Sjw;
-    InitPara.sBtpSdr.wTDO = bitrate.TransmitterDelay;
-    
-    InitPara.sBtpFdr.dwMode = (UInt32)extendedBitrate.Mode;
-    InitPara.sBtpFdr.dwBPS = extendedBitrate.Prescaler;
-    InitPara.sBtpFdr.wTS1 = extendedBitrate.TimeSegment1;
-    InitPara.sBtpFdr.wTS2 = extendedBitrate.TimeSegment2;
-    InitPara.sBtpFdr.wSJW = extendedBitrate.Sjw;
-    InitPara.sBtpFdr.wTDO = extendedBitrate.TransmitterDelay;    
-
-    hResult = m_pCanCtl->InitLine(&InitPara);
-    if (hResult != VCI_OK)
+  Monitor::Enter(m_pSync);
+  try
+  {
+    HRESULT     hResult;
+    CANINITLINE2 InitPara;
+
+    if (nullptr != m_pCanCtl)
     {
-      StringBuilder^ builder = gcnew StringBuilder();
+      InitPara.bOpMode   = (UINT8) operatingMode;
+      InitPara.bExMode   = (UINT8) extendedMode;
+
+      InitPara.bSFMode   = (UINT8) filterModeStd;
+      InitPara.dwSFIds   = cntIdsStd;
+      InitPara.bEFMode   = (UINT8) filterModeExt;
+      InitPara.dwEFIds   = cntIdsExt;
+      
+      InitPara.sBtpSdr.dwMode = (UInt32)bitrate.Mode;
+      InitPara.sBtpSdr.dwBPS = bitrate.Prescaler;
+      InitPara.sBtpSdr.wTS1 = bitrate.TimeSegment1;
+      InitPara.sBtpSdr.wTS2 = bitrate.TimeSegment2;
+      InitPara.sBtpSdr.wSJW = bitrate.Sjw;
+      InitPara.sBtpSdr.wTDO = bitrate.TransmitterDelay;
+      
+      InitPara.sBtpFdr.dwMode = (UInt32)extendedBitrate.Mode;
+      InitPara.sBtpFdr.dwBPS = extendedBitrate.Prescaler;
+      InitPara.sBtpFdr.wTS1 = extendedBitrate.TimeSegment1;
+      InitPara.sBtpFdr.wTS2 = extendedBitrate.TimeSegment2;
+      InitPara.sBtpFdr.wSJW = extendedBitrate.Sjw;
+      InitPara.sBtpFdr.wTDO = extendedBitrate.TransmitterDelay;    
+
+      hResult = m_pCanCtl->InitLine(&InitPara);
+      if (hResult != VCI_OK)
+      {
+        StringBuilder^ builder = gcnew StringBuilder();
 
-      builder->AppendFormat("\nInitPara = {{ bOpMode={0}, bExMode={1}, bSFMode={2}, bEFMode={3}, dwSFIds={4}, dwEFIds={5},", 
-        InitPara.bOpMode, InitPara.bExMode, InitPara.bSFMode, InitPara.bEFMode, InitPara.dwSFIds, InitPara.dwEFIds);
+        builder->AppendFormat("\nInitPara = {{ bOpMode={0}, bExMode={1}, bSFMode={2}, bEFMode={3}, dwSFIds={4}, dwEFIds={5},", 
+          InitPara.bOpMode, InitPara.bExMode, InitPara.bSFMode, InitPara.bEFMode, InitPara.dwSFIds, InitPara.dwEFIds);
 
-      builder->AppendFormat("\n  sBtpSdr = {{ dwMode={0}, dwBPS={1}, wTS1={2}, wTS2={3}, wSJW={4}, wTDO={5} }},", 
-        InitPara.sBtpSdr.dwMode, InitPara.sBtpSdr.dwBPS, InitPara.sBtpSdr.wTS1, InitPara.sBtpSdr.wTS2, InitPara.sBtpSdr.wSJW, InitPara.sBtpSdr.wTDO);
-        
-      builder->AppendFormat("\n  sBtpFdr = {{ dwMode={0}, dwBPS={1}, wTS1={2}, wTS2={3}, wSJW={4}, wTDO={5} }}\n}}", 
-        InitPara.sBtpFdr.dwMode, InitPara.sBtpFdr.dwBPS, InitPara.sBtpFdr.wTS1, InitPara.sBtpFdr.wTS2, InitPara.sBtpFdr.wSJW, InitPara.sBtpFdr.wTDO);
+        builder->AppendFormat("\n  sBtpSdr = {{ dwMode={0}, dwBPS={1}, wTS1={2}, wTS2={3}, wSJW={4}, wTDO={5} }},", 
+          InitPara.sBtpSdr.dwMode, InitPara.sBtpSdr.dwBPS, InitPara.sBtpSdr.wTS1, InitPara.sBtpSdr.wTS2, InitPara.sBtpSdr.wSJW, InitPara.sBtpSdr.wTDO);
+          
+        builder->AppendFormat("\n  sBtpFdr = {{ dwMode={0}, dwBPS={1}, wTS1={2}, wTS2={3}, wSJW={4}, wTDO={5} }}\n}}", 
+          InitPara.sBtpFdr.dwMode, InitPara.sBtpFdr.dwBPS, InitPara.sBtpFdr.wTS1, InitPara.sBtpFdr.wTS2, InitPara.sBtpFdr.wSJW, InitPara.sBtpFdr.wTDO);
 
-      throw gcnew VciException(VciServerImpl::Instance(), builder->ToString(), hResult);
+        throw gcnew VciException(VciServerImpl::Instance(), builder->ToString(), hResult);
+      }
+
+      m_pFilter->Clear();
+      *m_psInit = InitPara;
+      m_fInit   = true;
+    }
+    else
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
     }
   }
-  else
+  finally
   {
-    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    Monitor::Exit(m_pSync);
   }
 }
 
@@ -384,19 +571,48 @@ void CanControl2::InitLine( CanOperatingModes operatingMode
 //*****************************************************************************
 void CanControl2::ResetLine(void)
 {
-  HRESULT hResult;
+  VciResult sResult = TryResetLine();
 
-  if (nullptr != m_pCanCtl)
+  if (!sResult.Succeeded)
   {
-    hResult = m_pCanCtl->ResetLine();
-    if (hResult != VCI_OK)
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Resets the CAN line like <c>ResetLine</c>, but reports a failure
+///   through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanControl2::TryResetLine(void)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pCanCtl)
     {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    HRESULT hResult = m_pCanCtl->ResetLine();
+
+    if (hResult == VCI_OK)
+    {
+      m_pFilter->Clear();
     }
+
+    return( VciResult(hResult) );
   }
-  else
+  finally
   {
-    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    Monitor::Exit(m_pSync);
   }
 }
 
@@ -415,19 +631,41 @@ void CanControl2::ResetLine(void)
 //*****************************************************************************
 void CanControl2::StartLine(void)
 {
-  HRESULT hResult;
+  VciResult sResult = TryStartLine();
 
-  if (nullptr != m_pCanCtl)
+  if (!sResult.Succeeded)
   {
-    hResult = m_pCanCtl->StartLine();
-    if (hResult != VCI_OK)
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Starts the CAN line like <c>StartLine</c>, but reports a failure
+///   through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanControl2::TryStartLine(void)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pCanCtl)
     {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
     }
+
+    return( VciResult(m_pCanCtl->StartLine()) );
   }
-  else
+  finally
   {
-    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    Monitor::Exit(m_pSync);
   }
 }
 
@@ -448,19 +686,41 @@ void CanControl2::StartLine(void)
 //*****************************************************************************
 void CanControl2::StopLine(void)
 {
-  HRESULT hResult;
+  VciResult sResult = TryStopLine();
 
-  if (nullptr != m_pCanCtl)
+  if (!sResult.Succeeded)
   {
-    hResult = m_pCanCtl->StopLine();
-    if (hResult != VCI_OK)
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Stops the CAN line like <c>StopLine</c>, but reports a failure
+///   through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanControl2::TryStopLine(void)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pCanCtl)
     {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
     }
+
+    return( VciResult(m_pCanCtl->StopLine()) );
   }
-  else
+  finally
   {
-    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    Monitor::Exit(m_pSync);
   }
 }
 
@@ -541,17 +801,27 @@ void CanControl2::SetAccFilter( CanFilter  select
 {
   HRESULT hResult;
 
-  if (nullptr != m_pCanCtl)
+  Monitor::Enter(m_pSync);
+  try
   {
-    hResult = m_pCanCtl->SetAccFilter((UINT8) select, code, mask);
-    if (hResult != VCI_OK)
+    if (nullptr != m_pCanCtl)
     {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      hResult = m_pCanCtl->SetAccFilter((UINT8) select, code, mask);
+      if (hResult != VCI_OK)
+      {
+        throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      }
+
+      m_pFilter->SetAcc(select, code, mask);
+    }
+    else
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
     }
   }
-  else
+  finally
   {
-    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    Monitor::Exit(m_pSync);
   }
 }
 
@@ -604,17 +874,27 @@ void CanControl2::AddFilterIds( CanFilter  select
 {
   HRESULT hResult;
 
-  if (nullptr != m_pCanCtl)
+  Monitor::Enter(m_pSync);
+  try
   {
-    hResult = m_pCanCtl->AddFilterIds((UINT8) select, code, mask);
-    if (hResult != VCI_OK)
+    if (nullptr != m_pCanCtl)
     {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      hResult = m_pCanCtl->AddFilterIds((UINT8) select, code, mask);
+      if (hResult != VCI_OK)
+      {
+        throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      }
+
+      m_pFilter->Add(select, code, mask);
+    }
+    else
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
     }
   }
-  else
+  finally
   {
-    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    Monitor::Exit(m_pSync);
   }
 }
 
@@ -666,16 +946,380 @@ void CanControl2::RemFilterIds( CanFilter  select
 {
   HRESULT hResult;
 
-  if (nullptr != m_pCanCtl)
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr != m_pCanCtl)
+    {
+      hResult = m_pCanCtl->RemFilterIds((UINT8) select, code, mask);
+      if (hResult != VCI_OK)
+      {
+        throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      }
+
+      m_pFilter->Remove(select, code, mask);
+    }
+    else
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method compiles the specified identifier ranges to the smallest
+///   possible set of code/mask pairs and registers them at the specified
+///   filter list.
+/// </summary>
+/// <param name="select">
+///   Filter selection.
+/// </param>
+/// <param name="ranges">
+///   Identifier ranges to accept.
+/// </param>
+/// <param name="maxEntries">
+///   Maximum number of filter entries to use.
+/// </param>
+/// <returns>
+///   The registered code/mask pairs.
+/// </returns>
+/// <remarks>
+///   If registering an entry fails, the entries registered so far are
+///   removed again.
+/// </remarks>
+/// <exception cref="ArgumentNullException">
+///   Parameter ranges was a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   A range is invalid or maxEntries is less than 1.
+/// </exception>
+/// <exception cref="VciException">
+///   Registering filter Ids failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+array<CanFilterEntry>^ CanControl2::AddFilterIds( CanFilter          select
+                                                , array<CanIdRange>^ ranges
+                                                , int                maxEntries )
+{
+  HRESULT hResult = VCI_OK;
+  int     iEntry;
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pCanCtl)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    array<CanFilterEntry>^ aEntries = CanFilterCompiler::Compile(select, ranges, maxEntries);
+
+    for (iEntry = 0; iEntry < aEntries->Length; iEntry++)
+    {
+      hResult = m_pCanCtl->AddFilterIds((UINT8) select, aEntries[iEntry].Code, aEntries[iEntry].Mask);
+      if (hResult != VCI_OK)
+      {
+        break;
+      }
+      m_pFilter->Add(select, aEntries[iEntry].Code, aEntries[iEntry].Mask);
+    }
+
+    if (hResult != VCI_OK)
+    {
+      while (iEntry-- > 0)
+      {
+        if (VCI_OK == m_pCanCtl->RemFilterIds((UINT8) select, aEntries[iEntry].Code, aEntries[iEntry].Mask))
+        {
+          m_pFilter->Remove(select, aEntries[iEntry].Code, aEntries[iEntry].Mask);
+        }
+      }
+      throw gcnew VciException(VciServerImpl::Instance(), hResult);
+    }
+
+    return( aEntries );
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method computes the tightest single code/mask pair which
+///   accepts all specified identifier ranges and sets it as global
+///   acceptance filter.
+/// </summary>
+/// <param name="select">
+///   Filter selection.
+/// </param>
+/// <param name="ranges">
+///   Identifier ranges to accept. An empty array rejects all IDs.
+/// </param>
+/// <returns>
+///   The code/mask pair set as acceptance filter.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   Parameter ranges was a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   A range is invalid.
+/// </exception>
+/// <exception cref="VciException">
+///   Setting acceptance filter failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+CanFilterEntry CanControl2::SetAccFilter( CanFilter          select
+                                        , array<CanIdRange>^ ranges )
+{
+  HRESULT hResult;
+
+  Monitor::Enter(m_pSync);
+  try
   {
-    hResult = m_pCanCtl->RemFilterIds((UINT8) select, code, mask);
+    if (nullptr == m_pCanCtl)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    array<CanFilterEntry>^ aEntries = CanFilterCompiler::Compile(select, ranges, 1);
+
+    CanFilterEntry sEntry = (aEntries->Length > 0)
+                          ? aEntries[0]
+                          : CanFilterEntry(CAN_ACC_CODE_NONE, CAN_ACC_MASK_NONE);
+
+    hResult = m_pCanCtl->SetAccFilter((UINT8) select, sEntry.Code, sEntry.Mask);
     if (hResult != VCI_OK)
     {
       throw gcnew VciException(VciServerImpl::Instance(), hResult);
     }
+
+    m_pFilter->SetAcc(select, sEntry.Code, sEntry.Mask);
+
+    return( sEntry );
   }
-  else
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method returns the code/mask pairs currently registered at the
+///   specified filter list.
+/// </summary>
+/// <param name="select">
+///   Filter selection.
+/// </param>
+/// <returns>
+///   Copy of the shadow filter table, ordered by code and mask.
+/// </returns>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Invalid filter selection.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+array<CanFilterEntry>^ CanControl2::GetFilterIds( CanFilter select )
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pCanCtl)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    return( m_pFilter->GetEntries(select) );
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method replaces the content of the specified filter list with
+///   the specified code/mask pairs. Only the difference to the shadow
+///   filter table is transferred to the controller.
+/// </summary>
+/// <param name="select">
+///   Filter selection.
+/// </param>
+/// <param name="entries">
+///   Code/mask pairs the filter list shall contain afterwards.
+/// </param>
+/// <returns>
+///   Number of add and remove requests sent to the controller.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   Parameter entries was a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Invalid filter selection.
+/// </exception>
+/// <exception cref="VciException">
+///   Updating filter Ids failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+int CanControl2::SetFilterIds( CanFilter              select
+                             , array<CanFilterEntry>^ entries )
+{
+  HRESULT hResult;
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pCanCtl)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    List<CanFilterEntry>^ pRemove = gcnew List<CanFilterEntry>();
+    List<CanFilterEntry>^ pAdd    = gcnew List<CanFilterEntry>();
+
+    m_pFilter->Diff(select, entries, pRemove, pAdd);
+
+    // the table is updated after each request, so it stays in sync with
+    // the controller even if a request fails
+    for each (CanFilterEntry sEntry in pRemove)
+    {
+      hResult = m_pCanCtl->RemFilterIds((UINT8) select, sEntry.Code, sEntry.Mask);
+      if (hResult != VCI_OK)
+      {
+        throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      }
+      m_pFilter->Remove(select, sEntry.Code, sEntry.Mask);
+    }
+
+    for each (CanFilterEntry sEntry in pAdd)
+    {
+      hResult = m_pCanCtl->AddFilterIds((UINT8) select, sEntry.Code, sEntry.Mask);
+      if (hResult != VCI_OK)
+      {
+        throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      }
+      m_pFilter->Add(select, sEntry.Code, sEntry.Mask);
+    }
+
+    return( pRemove->Count + pAdd->Count );
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method compiles the specified identifier ranges and replaces
+///   the content of the specified filter list with the result.
+/// </summary>
+/// <param name="select">
+///   Filter selection.
+/// </param>
+/// <param name="ranges">
+///   Identifier ranges to accept.
+/// </param>
+/// <param name="maxEntries">
+///   Maximum number of filter entries to use.
+/// </param>
+/// <returns>
+///   The code/mask pairs the filter list contains afterwards.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   Parameter ranges was a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   A range is invalid or maxEntries is less than 1.
+/// </exception>
+/// <exception cref="VciException">
+///   Updating filter Ids failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+array<CanFilterEntry>^ CanControl2::SetFilterIds( CanFilter          select
+                                                , array<CanIdRange>^ ranges
+                                                , int                maxEntries )
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pCanCtl)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    array<CanFilterEntry>^ aEntries = CanFilterCompiler::Compile(select, ranges, maxEntries);
+
+    SetFilterIds(select, aEntries);
+
+    return( aEntries );
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method creates an automatic bus-off recovery for the CAN line
+///   of this control socket.
+/// </summary>
+/// <returns>
+///   A reference to the bus-off recovery.
+/// </returns>
+/// <exception cref="VciException">
+///   Creating the status message channel failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+ICanBusOffRecovery^ CanControl2::CreateBusOffRecovery()
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    ::ICanSocket2* pSocket = nullptr;
+
+    if (nullptr != m_pCanCtl)
+    {
+      pSocket = GetNativeSocket();
+    }
+
+    if (nullptr == pSocket)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    // the recovery takes over the reference of pSocket
+    CanBusOffRecovery^ pRecovery = gcnew CanBusOffRecovery(this, pSocket);
+    m_pRecoveries->Add(pRecovery);
+    return( pRecovery );
+  }
+  finally
   {
-    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    Monitor::Exit(m_pSync);
   }
 }
@@ -10,6 +10,7 @@
 #include <vcisdk.h>
 #include "cansoc2.hpp"
 #include "canchn2.hpp"
+#include "canfltt.hpp"
 
 
 namespace Ixxat {
@@ -18,6 +19,10 @@ namespace Ixxat {
       namespace Can {
 
 
+// forward decls
+ref class CanBusOffRecovery;
+
+
 //*****************************************************************************
 /// <summary>
 ///   This class implements a CAN control socket.
@@ -30,7 +35,12 @@ private ref class CanControl2 : public CanSocket2
   // member variables
   //--------------------------------------------------------------------
   private:
+    Object^         m_pSync;   // guards m_pCanCtl, m_pFilter and m_psInit
     ::ICanControl2* m_pCanCtl; // pointer to the native control object
+    CanFilterTable^ m_pFilter; // shadow copy of the filter lists
+    PCANINITLINE2   m_psInit;  // parameters of the last successful InitLine
+    bool            m_fInit;   // m_psInit is valid
+    List<CanBusOffRecovery^>^ m_pRecoveries; // recoveries created from this object
 
 
   //--------------------------------------------------------------------
@@ -42,10 +52,16 @@ private ref class CanControl2 : public CanSocket2
 
   internal:
     CanControl2      ( ::IBalObject* pBalObj
+                    , Guid          deviceId
                     , Byte          portNumber 
                     , Byte          busTypeIndex);
     ~CanControl2     ( );
 
+    HRESULT Recover  ( void );
+    void RemoveRecovery ( CanBusOffRecovery^ pRecovery );
+
+    property bool IsLineInitialized { bool get(void); };
+
 
   //--------------------------------------------------------------------
   // ICanSocket implementation
@@ -66,9 +82,27 @@ private ref class CanControl2 : public CanSocket2
     virtual void  ResetLine   ( void );
     virtual void  StartLine   ( void );
     virtual void  StopLine    ( void );
+    virtual VciResult TryResetLine ( void );
+    virtual VciResult TryStartLine ( void );
+    virtual VciResult TryStopLine  ( void );
     virtual void  SetAccFilter( CanFilter select, UInt32 code, UInt32 mask );
     virtual void  AddFilterIds( CanFilter select, UInt32 code, UInt32 mask );
     virtual void  RemFilterIds( CanFilter select, UInt32 code, UInt32 mask );
+
+    virtual array<CanFilterEntry>^ AddFilterIds( CanFilter          select
+                                               , array<CanIdRange>^ ranges
+                                               , int                maxEntries );
+    virtual CanFilterEntry         SetAccFilter( CanFilter          select
+                                               , array<CanIdRange>^ ranges );
+
+    virtual array<CanFilterEntry>^ GetFilterIds( CanFilter          select );
+    virtual int                    SetFilterIds( CanFilter              select
+                                               , array<CanFilterEntry>^ entries );
+    virtual array<CanFilterEntry>^ SetFilterIds( CanFilter          select
+                                               , array<CanIdRange>^ ranges
+                                               , int                maxEntries );
+
+    virtual ICanBusOffRecovery^    CreateBusOffRecovery( void );
 };
 
 
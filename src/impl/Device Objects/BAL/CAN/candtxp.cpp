@@ -0,0 +1,467 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the planner of delayed CAN transmissions.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "candtxp.hpp"
+#include "canmsgwr.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+using namespace System::Threading;
+
+#pragma warning(disable:4669) // 'type cast' : unsafe conversion
+
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for delayed transmission planner objects.
+/// </summary>
+/// <param name="pCanChn">
+///   Pointer to the native CAN channel the messages are transmitted on.
+///   This parameter must not be NULL.
+/// </param>
+/// <param name="pTimeCnv">
+///   Tick converter of the channel.
+/// </param>
+/// <param name="dwMaxTicks">
+///   Maximum delay of the delayed transmission in ticks.
+/// </param>
+/// <exception cref="VciException">
+///   Getting the transmit FIFO failed.
+/// </exception>
+//*****************************************************************************
+CanDelayedTransmitPlanner::CanDelayedTransmitPlanner( ::ICanChannel2*    pCanChn
+                                                    , ICanTimeConverter^ pTimeCnv
+                                                    , UInt32             dwMaxTicks )
+{
+  PFIFOWRITER pTxFifo;
+
+  HRESULT hResult = pCanChn->GetWriter(&pTxFifo);
+  if (VCI_OK != hResult)
+  {
+    throw gcnew VciException(VciServerImpl::Instance(), hResult);
+  }
+
+  m_pTxFifo    = pTxFifo;
+  m_pTimeCnv   = pTimeCnv;
+  m_dwMaxTicks = dwMaxTicks;
+  m_pSync      = gcnew Object();
+  m_aPlan      = gcnew array<mgdCANMSG2>(DTX_INIT_ENTRIES);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Destructor for delayed transmission planner objects.
+/// </summary>
+//*****************************************************************************
+CanDelayedTransmitPlanner::~CanDelayedTransmitPlanner()
+{
+  Cleanup();
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method performs tasks associated with freeing, releasing, or
+///   resetting unmanaged resources.
+/// </summary>
+//*****************************************************************************
+void CanDelayedTransmitPlanner::Cleanup(void)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    m_iHead = 0;
+    m_iTail = 0;
+
+    if (nullptr != m_pTxFifo)
+    {
+      m_pTxFifo->Release();
+      m_pTxFifo = nullptr;
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Appends an entry to the plan. The caller must hold the plan lock.
+/// </summary>
+/// <param name="sMsg">
+///   Message to append.
+/// </param>
+/// <param name="dwDelay">
+///   Delay of the message in ticks.
+/// </param>
+//*****************************************************************************
+void CanDelayedTransmitPlanner::Append( mgdCANMSG2 sMsg
+                                      , UInt32     dwDelay )
+{
+  if (m_iTail == m_aPlan->Length)
+  {
+    if (m_iHead > 0)
+    {
+      // move the pending entries to the front
+      Array::Copy(m_aPlan, m_iHead, m_aPlan, 0, m_iTail - m_iHead);
+      m_iTail -= m_iHead;
+      m_iHead  = 0;
+    }
+    else
+    {
+      Array::Resize(m_aPlan, m_aPlan->Length * 2);
+    }
+  }
+
+  pin_ptr<mgdCANMSG2> pMsg = &sMsg;
+  ((PCANMSG2) pMsg)->dwTime = dwDelay;
+
+  m_aPlan[m_iTail++] = sMsg;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts the target time of a message into a delay and appends the
+///   message to the plan. The caller must hold the plan lock.
+/// </summary>
+/// <param name="message">
+///   Message to transmit.
+/// </param>
+/// <param name="time">
+///   Target time of the message relative to the start of the plan.
+/// </param>
+//*****************************************************************************
+void CanDelayedTransmitPlanner::Plan( ICanMessage2^ message
+                                    , TimeSpan      time )
+{
+  if (nullptr == message)
+  {
+    throw gcnew ArgumentNullException("message");
+  }
+
+  if (time.Ticks < m_qwLastTime)
+  {
+    throw gcnew ArgumentOutOfRangeException("time");
+  }
+
+  mgdCANMSG2 sMsg = ConvertToCANMSG2(message);
+
+  // The delay is derived from absolute tick values, so the truncation
+  // of the individual conversions does not accumulate.
+  UInt64 qwTicks = m_pTimeCnv->NanosecondsToDelayedTXTicks((UInt64) time.Ticks * 100);
+  UInt64 qwDelay = qwTicks - m_qwLastTicks;
+
+  if (qwDelay > m_dwMaxTicks)
+  {
+    if (nullptr != m_pGapMsg)
+    {
+      while (qwDelay > m_dwMaxTicks)
+      {
+        Append(m_sGapMsg, m_dwMaxTicks);
+        qwDelay -= m_dwMaxTicks;
+        Interlocked::Increment(m_qwGaps);
+      }
+    }
+    else
+    {
+      qwDelay = m_dwMaxTicks;
+      Interlocked::Increment(m_qwClamped);
+    }
+  }
+
+  Append(sMsg, (UInt32) qwDelay);
+
+  m_qwLastTime  = time.Ticks;
+  m_qwLastTicks = qwTicks;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the message transmitted to bridge long gaps.
+/// </summary>
+/// <returns>
+///   The gap message or a null reference.
+/// </returns>
+//*****************************************************************************
+ICanMessage2^ CanDelayedTransmitPlanner::GapMessage::get()
+{
+  return( m_pGapMsg );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Sets the message transmitted to bridge long gaps.
+/// </summary>
+/// <param name="value">
+///   The gap message or a null reference to clamp long gaps.
+/// </param>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+void CanDelayedTransmitPlanner::GapMessage::set(ICanMessage2^ value)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pTxFifo)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    if (nullptr != value)
+    {
+      m_sGapMsg = ConvertToCANMSG2(value);
+    }
+    m_pGapMsg = value;
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of planned entries not yet placed into the
+///   transmit FIFO.
+/// </summary>
+/// <returns>
+///   Number of pending entries.
+/// </returns>
+//*****************************************************************************
+int CanDelayedTransmitPlanner::PendingCount::get()
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    return( m_iTail - m_iHead );
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of entries placed into the transmit FIFO.
+/// </summary>
+/// <returns>
+///   Number of transmitted entries.
+/// </returns>
+//*****************************************************************************
+Int64 CanDelayedTransmitPlanner::TransmitCount::get()
+{
+  return( Interlocked::Read(m_qwTxCount) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of inserted gap messages.
+/// </summary>
+/// <returns>
+///   Number of gap messages.
+/// </returns>
+//*****************************************************************************
+Int64 CanDelayedTransmitPlanner::GapCount::get()
+{
+  return( Interlocked::Read(m_qwGaps) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of clamped delays.
+/// </summary>
+/// <returns>
+///   Number of clamped delays.
+/// </returns>
+//*****************************************************************************
+Int64 CanDelayedTransmitPlanner::ClampedCount::get()
+{
+  return( Interlocked::Read(m_qwClamped) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Appends a message to the plan.
+/// </summary>
+/// <param name="message">
+///   Message to transmit.
+/// </param>
+/// <param name="time">
+///   Target time of the message relative to the start of the plan.
+/// </param>
+/// <exception cref="ArgumentNullException">
+///   Parameter message was a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   The target time is negative or less than the previous one.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+void CanDelayedTransmitPlanner::Add( ICanMessage2^ message
+                                   , TimeSpan      time )
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pTxFifo)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    Plan(message, time);
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Appends several messages to the plan.
+/// </summary>
+/// <param name="messages">
+///   Messages to transmit.
+/// </param>
+/// <param name="times">
+///   Target times of the messages relative to the start of the plan.
+/// </param>
+/// <exception cref="ArgumentNullException">
+///   One of the arrays or messages was a null reference.
+/// </exception>
+/// <exception cref="ArgumentException">
+///   The arrays differ in length.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   A target time is negative or less than the previous one.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+void CanDelayedTransmitPlanner::Add( array<ICanMessage2^>^ messages
+                                   , array<TimeSpan>^      times )
+{
+  if (nullptr == messages)
+  {
+    throw gcnew ArgumentNullException("messages");
+  }
+  if (nullptr == times)
+  {
+    throw gcnew ArgumentNullException("times");
+  }
+  if (messages->Length != times->Length)
+  {
+    throw gcnew ArgumentException("Arrays differ in length.", "times");
+  }
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pTxFifo)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    for (int i = 0; i < messages->Length; i++)
+    {
+      Plan(messages[i], times[i]);
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Places as many pending entries as possible into the transmit FIFO.
+///   The entries are copied directly into the FIFO memory in batches of
+///   contiguous free entries.
+/// </summary>
+/// <returns>
+///   Number of entries placed into the transmit FIFO.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+int CanDelayedTransmitPlanner::Write(void)
+{
+  int iSum = 0;
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pTxFifo)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    while (m_iHead < m_iTail)
+    {
+      PCANMSG2 pDst  = nullptr;
+      UINT16   wFree = 0;
+
+      if ((VCI_OK != m_pTxFifo->AcquireWrite((PVOID*) &pDst, &wFree)) || (0 == wFree))
+      {
+        break;
+      }
+
+      int iCount = Math::Min((int) wFree, m_iTail - m_iHead);
+      pin_ptr<mgdCANMSG2> pSrc = &m_aPlan[m_iHead];
+      memcpy(pDst, pSrc, iCount * sizeof(CANMSG2));
+      m_pTxFifo->ReleaseWrite((UINT16) iCount);
+
+      m_iHead += iCount;
+      iSum    += iCount;
+    }
+
+    if (m_iHead == m_iTail)
+    {
+      m_iHead = 0;
+      m_iTail = 0;
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+
+  Interlocked::Add(m_qwTxCount, (Int64) iSum);
+
+  return( iSum );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Discards all pending entries and starts a new plan.
+/// </summary>
+//*****************************************************************************
+void CanDelayedTransmitPlanner::Clear(void)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    m_iHead       = 0;
+    m_iTail       = 0;
+    m_qwLastTime  = 0;
+    m_qwLastTicks = 0;
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+#pragma warning(default:4669) // 'type cast' : unsafe conversion
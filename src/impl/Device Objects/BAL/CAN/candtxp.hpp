@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the planner of delayed CAN transmissions.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+#include "canmsg2.hpp"
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+
+// initial number of plan entries
+#define DTX_INIT_ENTRIES      256
+
+//*****************************************************************************
+/// <summary>
+///   This class implements the planner of delayed transmissions. The plan
+///   is kept as contiguous array of native CAN messages with precomputed
+///   delays, so batches are copied into the transmit FIFO in one step.
+/// </summary>
+//*****************************************************************************
+private ref class CanDelayedTransmitPlanner : public ICanDelayedTransmitPlanner
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    ::IFifoWriter*      m_pTxFifo;     // pointer to the native transmit FIFO
+    ICanTimeConverter^  m_pTimeCnv;    // converter of the socket
+    UInt32              m_dwMaxTicks;  // maximum delay in ticks
+    Object^             m_pSync;       // guards the plan
+    array<mgdCANMSG2>^  m_aPlan;       // planned messages
+    int                 m_iHead;       // first pending entry of m_aPlan
+    int                 m_iTail;       // end of the pending entries
+    Int64               m_qwLastTime;  // target time of the last message
+    UInt64              m_qwLastTicks; // target time of the last message in ticks
+    ICanMessage2^       m_pGapMsg;     // gap message as set by the caller
+    mgdCANMSG2          m_sGapMsg;     // native copy of m_pGapMsg
+    Int64               m_qwTxCount;   // number of entries placed into the FIFO
+    Int64               m_qwGaps;      // number of inserted gap messages
+    Int64               m_qwClamped;   // number of clamped delays
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    void Cleanup ( void );
+    void Append  ( mgdCANMSG2   sMsg
+                 , UInt32       dwDelay );
+    void Plan    ( ICanMessage2^ message
+                 , TimeSpan      time );
+
+  internal:
+    CanDelayedTransmitPlanner  ( ::ICanChannel2*    pCanChn
+                               , ICanTimeConverter^ pTimeCnv
+                               , UInt32             dwMaxTicks );
+    ~CanDelayedTransmitPlanner ( );
+
+  //--------------------------------------------------------------------
+  // ICanDelayedTransmitPlanner implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual property ICanMessage2^ GapMessage    { ICanMessage2^ get(void);
+                                                   void          set(ICanMessage2^ value); };
+    virtual property int           PendingCount  { int           get(void); };
+    virtual property Int64         TransmitCount { Int64         get(void); };
+    virtual property Int64         GapCount      { Int64         get(void); };
+    virtual property Int64         ClampedCount  { Int64         get(void); };
+
+    virtual void Add   ( ICanMessage2^          message
+                       , TimeSpan               time );
+    virtual void Add   ( array<ICanMessage2^>^  messages
+                       , array<TimeSpan>^       times );
+    virtual int  Write ( void );
+    virtual void Clear ( void );
+};
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
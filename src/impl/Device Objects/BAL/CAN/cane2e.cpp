@@ -0,0 +1,681 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the host driven E2E protected CAN scheduler.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "cane2e.hpp"
+#include "canmsgwr.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+using namespace System::Diagnostics;
+
+#pragma warning(disable:4669) // 'type cast' : unsafe conversion
+
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for E2E message objects.
+/// </summary>
+/// <param name="pOwner">
+///   Scheduler the message is registered at.
+/// </param>
+/// <param name="iSlot">
+///   Index of the message within the native entry table of the scheduler.
+/// </param>
+/// <param name="tsCycle">
+///   Cycle time of the message.
+/// </param>
+/// <param name="sConfig">
+///   Protection parameters of the message.
+/// </param>
+//*****************************************************************************
+CanE2EMessage::CanE2EMessage( CanE2EScheduler^ pOwner
+                            , int              iSlot
+                            , TimeSpan         tsCycle
+                            , CanE2EConfig     sConfig )
+{
+  m_pOwner  = pOwner;
+  m_iSlot   = iSlot;
+  m_tsCycle = tsCycle;
+  m_sConfig = sConfig;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the cycle time of the message.
+/// </summary>
+//*****************************************************************************
+TimeSpan CanE2EMessage::CycleTime::get()
+{
+  return( m_tsCycle );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the protection parameters of the message.
+/// </summary>
+//*****************************************************************************
+CanE2EConfig CanE2EMessage::Config::get()
+{
+  return( m_sConfig );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the counter value of the last transmitted frame.
+/// </summary>
+/// <exception cref="ObjectDisposedException">
+///   The message was removed from the scheduler.
+/// </exception>
+//*****************************************************************************
+Byte CanE2EMessage::Counter::get()
+{
+  CanE2EScheduler^ pOwner = m_pOwner;
+  if (nullptr == pOwner)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  Byte bCounter = pOwner->LockEntry(m_iSlot)->bLastCounter;
+  pOwner->UnlockEntry();
+  return( bCounter );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of transmitted frames of this message.
+/// </summary>
+/// <exception cref="ObjectDisposedException">
+///   The message was removed from the scheduler.
+/// </exception>
+//*****************************************************************************
+Int64 CanE2EMessage::TransmitCount::get()
+{
+  CanE2EScheduler^ pOwner = m_pOwner;
+  if (nullptr == pOwner)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  Int64 qwCount = pOwner->LockEntry(m_iSlot)->qwTxCount;
+  pOwner->UnlockEntry();
+  return( qwCount );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of missed cycles of this message.
+/// </summary>
+/// <exception cref="ObjectDisposedException">
+///   The message was removed from the scheduler.
+/// </exception>
+//*****************************************************************************
+Int64 CanE2EMessage::MissedCount::get()
+{
+  CanE2EScheduler^ pOwner = m_pOwner;
+  if (nullptr == pOwner)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  Int64 qwCount = pOwner->LockEntry(m_iSlot)->qwMissed;
+  pOwner->UnlockEntry();
+  return( qwCount );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Updates the payload of the message. Counter and CRC are overwritten
+///   by the scheduler on every transmission.
+/// </summary>
+/// <param name="data">
+///   New payload.
+/// </param>
+/// <exception cref="ArgumentNullException">
+///   Parameter data was a null reference.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   The message was removed from the scheduler.
+/// </exception>
+//*****************************************************************************
+void CanE2EMessage::SetData(array<Byte>^ data)
+{
+  if (nullptr == data)
+  {
+    throw gcnew ArgumentNullException("data");
+  }
+
+  CanE2EScheduler^ pOwner = m_pOwner;
+  if (nullptr == pOwner)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  E2ETXENTRY* pEntry = pOwner->LockEntry(m_iSlot);
+  try
+  {
+    UINT32 dwLen = Math::Min((UINT32) data->Length, pEntry->dwDataLen);
+    if (dwLen > 0)
+    {
+      pin_ptr<Byte> pData = &data[0];
+      memcpy(pEntry->sCanMsg.abData, pData, dwLen);
+    }
+  }
+  finally
+  {
+    pOwner->UnlockEntry();
+  }
+}
+
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for E2E scheduler objects.
+/// </summary>
+/// <param name="pCanChn">
+///   Pointer to the native CAN channel the frames are transmitted on.
+///   This parameter must not be NULL.
+/// </param>
+/// <exception cref="VciException">
+///   Getting the transmit FIFO failed.
+/// </exception>
+//*****************************************************************************
+CanE2EScheduler::CanE2EScheduler(::ICanChannel2* pCanChn)
+{
+  PFIFOWRITER pTxFifo;
+
+  HRESULT hResult = pCanChn->GetWriter(&pTxFifo);
+  if (VCI_OK != hResult)
+  {
+    throw gcnew VciException(VciServerImpl::Instance(), hResult);
+  }
+
+  m_pTxFifo  = pTxFifo;
+  m_pEntries = new E2ETXENTRY[E2E_MAX_MSGS];
+  memset(m_pEntries, 0, sizeof(E2ETXENTRY) * E2E_MAX_MSGS);
+
+  m_aMsgs = gcnew array<CanE2EMessage^>(E2E_MAX_MSGS);
+  m_pSync = gcnew Object();
+  m_pWake = gcnew AutoResetEvent(false);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Destructor for E2E scheduler objects.
+/// </summary>
+//*****************************************************************************
+CanE2EScheduler::~CanE2EScheduler()
+{
+  Cleanup();
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method performs tasks associated with freeing, releasing, or
+///   resetting unmanaged resources.
+/// </summary>
+//*****************************************************************************
+void CanE2EScheduler::Cleanup(void)
+{
+  Stop();
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    for (int i = 0; i < E2E_MAX_MSGS; i++)
+    {
+      if (nullptr != m_aMsgs[i])
+      {
+        m_aMsgs[i]->m_pOwner = nullptr;
+        m_aMsgs[i] = nullptr;
+      }
+    }
+
+    if (nullptr != m_pEntries)
+    {
+      delete[] m_pEntries;
+      m_pEntries = nullptr;
+    }
+
+    if (nullptr != m_pTxFifo)
+    {
+      m_pTxFifo->Release();
+      m_pTxFifo = nullptr;
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Locks the entry table and returns the specified entry.
+///   The caller has to call <c>UnlockEntry</c> afterwards.
+/// </summary>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+E2ETXENTRY* CanE2EScheduler::LockEntry(int iSlot)
+{
+  Monitor::Enter(m_pSync);
+
+  if (nullptr == m_pEntries)
+  {
+    Monitor::Exit(m_pSync);
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  return( &m_pEntries[iSlot] );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Unlocks the entry table.
+/// </summary>
+//*****************************************************************************
+void CanE2EScheduler::UnlockEntry(void)
+{
+  Monitor::Exit(m_pSync);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets a value indicating whether the scheduler thread is running.
+/// </summary>
+//*****************************************************************************
+bool CanE2EScheduler::IsRunning::get()
+{
+  return( m_fRun );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the total number of frames placed into the transmit FIFO.
+/// </summary>
+//*****************************************************************************
+Int64 CanE2EScheduler::TransmitCount::get()
+{
+  return( Interlocked::Read(m_qwTxCount) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method adds a periodic message to the scheduler.
+/// </summary>
+/// <param name="message">
+///   Template of the message.
+/// </param>
+/// <param name="cycleTime">
+///   Cycle time of the message.
+/// </param>
+/// <param name="config">
+///   Protection parameters of the message.
+/// </param>
+/// <returns>
+///   Reference to the registered message.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   Parameter message was a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   The cycle time or an offset is out of range.
+/// </exception>
+/// <exception cref="ArgumentException">
+///   Invalid data ID list.
+/// </exception>
+/// <exception cref="IndexOutOfRangeException">
+///   The maximum number of messages is already registered.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+ICanE2EMessage^ CanE2EScheduler::AddMessage( ICanMessage2^ message
+                                           , TimeSpan      cycleTime
+                                           , CanE2EConfig  config )
+{
+  if (nullptr == message)
+  {
+    throw gcnew ArgumentNullException("message");
+  }
+
+  if (cycleTime.Ticks < 1000) // 100 us
+  {
+    throw gcnew ArgumentOutOfRangeException("cycleTime");
+  }
+
+  mgdCANMSG2 msg = ConvertToCANMSG2(message);
+  pin_ptr<mgdCANMSG2> pCanMsg = &msg;
+  UINT32 dwLen = can_dlc2len[((PCANMSG2) pCanMsg)->uMsgInfo.Bits.dlc];
+
+  E2ESTATE sE2E;
+  memset(&sE2E, 0, sizeof(sE2E));
+  sE2E.bProfile    = (UINT8) config.Profile;
+  sE2E.wCounterOfs = config.CounterOffset;
+  sE2E.wCrcOfs     = config.CrcOffset;
+  sE2E.wDataId     = config.DataId;
+
+  switch (config.Profile)
+  {
+    case CanE2EProfile::None:
+      break;
+
+    case CanE2EProfile::Crc8SaeJ1850:
+    case CanE2EProfile::Profile1:
+      if ( (config.CrcOffset & 7) || ((UINT32) (config.CrcOffset >> 3) >= dwLen) )
+      {
+        throw gcnew ArgumentOutOfRangeException("config", "CrcOffset");
+      }
+      if ( (config.CounterOffset & 3) || ((UINT32) (config.CounterOffset >> 3) >= dwLen)
+        || ((config.CounterOffset >> 3) == (config.CrcOffset >> 3)) )
+      {
+        throw gcnew ArgumentOutOfRangeException("config", "CounterOffset");
+      }
+      break;
+
+    case CanE2EProfile::Profile2:
+      if (dwLen < 2)
+      {
+        throw gcnew ArgumentOutOfRangeException("message", "DataLength");
+      }
+      if ((nullptr == config.DataIdList) || (config.DataIdList->Length != 16))
+      {
+        throw gcnew ArgumentException("DataIdList must contain 16 entries", "config");
+      }
+      for (int i = 0; i < 16; i++)
+      {
+        sE2E.abDataIdList[i] = config.DataIdList[i];
+      }
+      // take a private copy, the caller may modify the array afterwards
+      config.DataIdList = (array<Byte>^) config.DataIdList->Clone();
+      break;
+
+    default:
+      throw gcnew ArgumentOutOfRangeException("config", "Profile");
+  }
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pEntries)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    int iSlot = 0;
+    while ((iSlot < E2E_MAX_MSGS) && m_pEntries[iSlot].fInUse)
+    {
+      iSlot++;
+    }
+
+    if (iSlot >= E2E_MAX_MSGS)
+    {
+      throw gcnew IndexOutOfRangeException();
+    }
+
+    E2ETXENTRY* pEntry = &m_pEntries[iSlot];
+    memset(pEntry, 0, sizeof(E2ETXENTRY));
+    pEntry->sCanMsg   = *(PCANMSG2) pCanMsg;
+    pEntry->sE2E      = sE2E;
+    pEntry->dwDataLen = dwLen;
+    pEntry->qwPeriod  = (INT64) (cycleTime.TotalSeconds * Stopwatch::Frequency);
+    pEntry->qwDue     = Stopwatch::GetTimestamp();
+    pEntry->fInUse    = TRUE;
+
+    m_aMsgs[iSlot] = gcnew CanE2EMessage(this, iSlot, cycleTime, config);
+    m_pWake->Set();
+
+    return( m_aMsgs[iSlot] );
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method removes a message from the scheduler.
+/// </summary>
+/// <param name="message">
+///   The message to remove.
+/// </param>
+/// <returns>
+///   true if the message was registered at this scheduler, otherwise false.
+/// </returns>
+//*****************************************************************************
+bool CanE2EScheduler::RemoveMessage(ICanE2EMessage^ message)
+{
+  CanE2EMessage^ pMsg = dynamic_cast<CanE2EMessage^>(message);
+  bool           fResult = false;
+
+  if ((nullptr != pMsg) && (pMsg->m_pOwner == this))
+  {
+    Monitor::Enter(m_pSync);
+    try
+    {
+      if ((nullptr != m_pEntries) && (m_aMsgs[pMsg->m_iSlot] == pMsg))
+      {
+        m_pEntries[pMsg->m_iSlot].fInUse = FALSE;
+        m_aMsgs[pMsg->m_iSlot] = nullptr;
+        pMsg->m_pOwner = nullptr;
+        fResult = true;
+      }
+    }
+    finally
+    {
+      Monitor::Exit(m_pSync);
+    }
+  }
+
+  return( fResult );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method starts the scheduler thread.
+/// </summary>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+void CanE2EScheduler::Start(void)
+{
+  if (nullptr == m_pTxFifo)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  if (nullptr == m_pThread)
+  {
+    Monitor::Enter(m_pSync);
+    try
+    {
+      INT64 qwNow = Stopwatch::GetTimestamp();
+      for (int i = 0; i < E2E_MAX_MSGS; i++)
+      {
+        m_pEntries[i].qwDue = qwNow;
+      }
+    }
+    finally
+    {
+      Monitor::Exit(m_pSync);
+    }
+
+    m_fRun    = true;
+    m_pThread = gcnew Thread(gcnew ThreadStart(this, &CanE2EScheduler::ThreadProc));
+    m_pThread->Name         = "VCI E2E scheduler";
+    m_pThread->IsBackground = true;
+    m_pThread->Start();
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method stops the scheduler thread.
+/// </summary>
+//*****************************************************************************
+void CanE2EScheduler::Stop(void)
+{
+  if (nullptr != m_pThread)
+  {
+    m_fRun = false;
+    m_pWake->Set();
+    m_pThread->Join();
+    m_pThread = nullptr;
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Scheduler thread. Waits on the wake-up event until the next frame is
+///   due. Only the last E2E_SPIN_MICROSECONDS of a wait are spent spinning
+///   to keep the jitter low, so the thread never occupies a whole core.
+/// </summary>
+//*****************************************************************************
+void CanE2EScheduler::ThreadProc(void)
+{
+  INT64 qwFreq = Stopwatch::Frequency;
+  INT64 qwSpin = qwFreq * E2E_SPIN_MICROSECONDS / 1000000;
+
+  while (m_fRun)
+  {
+    INT64 qwNext = Int64::MaxValue;
+
+    Monitor::Enter(m_pSync);
+    try
+    {
+      if (nullptr != m_pEntries)
+      {
+        TransmitDue(Stopwatch::GetTimestamp(), &qwNext);
+      }
+    }
+    finally
+    {
+      Monitor::Exit(m_pSync);
+    }
+
+    if (Int64::MaxValue == qwNext)
+    {
+      m_pWake->WaitOne();
+    }
+    else
+    {
+      INT64 qwLeft = qwNext - Stopwatch::GetTimestamp();
+      INT64 qwWait = qwLeft * 1000 / qwFreq;
+      if (qwWait >= 2)
+      {
+        m_pWake->WaitOne((int) Math::Min(qwWait - 1, (INT64) Int32::MaxValue), false);
+      }
+      else if (qwLeft > qwSpin)
+      {
+        m_pWake->WaitOne(1, false);
+      }
+      else
+      {
+        while (m_fRun && (Stopwatch::GetTimestamp() < qwNext))
+        {
+          Thread::SpinWait(E2E_SPIN_ITERATIONS);
+        }
+      }
+    }
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Places all due frames into the transmit FIFO. The frames are written
+///   directly into the FIFO memory in batches of contiguous free entries.
+///   The caller must hold the entry table lock.
+/// </summary>
+/// <param name="qwNow">
+///   Current stopwatch timestamp.
+/// </param>
+/// <param name="pqwNext">
+///   Receives the due time of the next frame.
+/// </param>
+/// <returns>
+///   Number of frames placed into the transmit FIFO.
+/// </returns>
+//*****************************************************************************
+UINT32 CanE2EScheduler::TransmitDue(INT64 qwNow, INT64* pqwNext)
+{
+  PCANMSG2 pDst  = nullptr;
+  UINT16   wFree = 0;
+  UINT16   wUsed = 0;
+  UINT32   dwSum = 0;
+  bool     fFull = false;
+
+  for (int i = 0; i < E2E_MAX_MSGS; i++)
+  {
+    E2ETXENTRY* pEntry = &m_pEntries[i];
+    if (!pEntry->fInUse)
+    {
+      continue;
+    }
+
+    if (pEntry->qwDue <= qwNow)
+    {
+      if ((wUsed == wFree) && !fFull)
+      {
+        if (wUsed > 0)
+        {
+          m_pTxFifo->ReleaseWrite(wUsed);
+          dwSum += wUsed;
+        }
+
+        wUsed = 0;
+        if (VCI_OK != m_pTxFifo->AcquireWrite((PVOID*) &pDst, &wFree))
+        {
+          wFree = 0;
+        }
+        fFull = (0 == wFree);
+      }
+
+      if (wUsed < wFree)
+      {
+        pDst[wUsed] = pEntry->sCanMsg;
+        pEntry->bLastCounter = E2EProtect(&pEntry->sE2E, pDst[wUsed].abData, pEntry->dwDataLen);
+        pEntry->qwTxCount++;
+        wUsed++;
+      }
+      else
+      {
+        pEntry->qwMissed++;
+      }
+
+      pEntry->qwDue += pEntry->qwPeriod;
+      if (pEntry->qwDue <= qwNow)
+      {
+        // late by more than one cycle: skip lost cycles instead of bursting
+        INT64 qwLost = (qwNow - pEntry->qwDue) / pEntry->qwPeriod + 1;
+        pEntry->qwMissed += qwLost;
+        pEntry->qwDue    += qwLost * pEntry->qwPeriod;
+      }
+    }
+
+    if (pEntry->qwDue < *pqwNext)
+    {
+      *pqwNext = pEntry->qwDue;
+    }
+  }
+
+  if (wUsed > 0)
+  {
+    m_pTxFifo->ReleaseWrite(wUsed);
+    dwSum += wUsed;
+  }
+
+  Interlocked::Add(m_qwTxCount, (Int64) dwSum);
+
+  return( dwSum );
+}
+
+
+#pragma warning(default:4669) // 'type cast' : unsafe conversion
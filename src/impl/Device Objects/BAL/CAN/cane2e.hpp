@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the host driven E2E protected CAN scheduler.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+#include "e2ecrc.hpp"
+#include "canmsg2.hpp"
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+using namespace System::Threading;
+
+
+// maximum number of messages per E2E scheduler
+#define E2E_MAX_MSGS          256
+
+// the scheduler thread spins only for the last part of a wait, longer
+// waits are done on the wake-up event
+#define E2E_SPIN_MICROSECONDS 200
+#define E2E_SPIN_ITERATIONS   20
+
+//*****************************************************************************
+/// <summary>
+///   Native transmit entry of the E2E scheduler. All fields which are
+///   accessed per transmission are kept in one contiguous native table.
+/// </summary>
+//*****************************************************************************
+struct E2ETXENTRY
+{
+  CANMSG2  sCanMsg;       // frame template
+  E2ESTATE sE2E;          // protection state
+  UINT32   dwDataLen;     // data length in bytes
+  BOOL     fInUse;        // entry is registered
+  INT64    qwPeriod;      // cycle time in stopwatch ticks
+  INT64    qwDue;         // due time of the next frame in stopwatch ticks
+  INT64    qwTxCount;     // number of transmitted frames
+  INT64    qwMissed;      // number of missed cycles
+  UINT8    bLastCounter;  // counter value of the last transmitted frame
+};
+
+
+// forward decls
+ref class CanE2EScheduler;
+
+
+//*****************************************************************************
+/// <summary>
+///   This class represents a message registered at an E2E scheduler.
+/// </summary>
+//*****************************************************************************
+private ref class CanE2EMessage : public ICanE2EMessage
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  internal:
+    CanE2EScheduler^ m_pOwner;  // owning scheduler, null if removed
+    int              m_iSlot;   // index within the native entry table
+    TimeSpan         m_tsCycle; // cycle time
+    CanE2EConfig     m_sConfig; // protection parameters
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  internal:
+    CanE2EMessage ( CanE2EScheduler^ pOwner
+                  , int              iSlot
+                  , TimeSpan         tsCycle
+                  , CanE2EConfig     sConfig );
+
+  //--------------------------------------------------------------------
+  // ICanE2EMessage implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual property TimeSpan     CycleTime     { TimeSpan     get(void); };
+    virtual property CanE2EConfig Config        { CanE2EConfig get(void); };
+    virtual property Byte         Counter       { Byte         get(void); };
+    virtual property Int64        TransmitCount { Int64        get(void); };
+    virtual property Int64        MissedCount   { Int64        get(void); };
+
+    virtual void SetData(array<Byte>^ data);
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   This class implements the host driven E2E scheduler. A worker
+///   thread places due frames into the transmit FIFO of a CAN channel and
+///   updates alive counter and CRC natively for every transmission.
+/// </summary>
+//*****************************************************************************
+private ref class CanE2EScheduler : public ICanE2EScheduler
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    ::IFifoWriter*         m_pTxFifo;   // pointer to the native transmit FIFO
+    E2ETXENTRY*            m_pEntries;  // native transmit entry table
+    array<CanE2EMessage^>^ m_aMsgs;     // registered messages
+    Object^                m_pSync;     // guards the entry table
+    AutoResetEvent^        m_pWake;     // wakes up the scheduler thread
+    Thread^                m_pThread;   // scheduler thread
+    volatile bool          m_fRun;      // scheduler thread shall run
+    Int64                  m_qwTxCount; // total number of transmitted frames
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    void   Cleanup     ( void );
+    void   ThreadProc  ( void );
+    UINT32 TransmitDue ( INT64 qwNow, INT64* pqwNext );
+
+  internal:
+    CanE2EScheduler  ( ::ICanChannel2* pCanChn );
+    ~CanE2EScheduler ( );
+
+    E2ETXENTRY* LockEntry   ( int iSlot );
+    void        UnlockEntry ( void );
+
+  //--------------------------------------------------------------------
+  // ICanE2EScheduler implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual property bool  IsRunning     { bool  get(void); };
+    virtual property Int64 TransmitCount { Int64 get(void); };
+
+    virtual ICanE2EMessage^ AddMessage   ( ICanMessage2^  message
+                                         , TimeSpan       cycleTime
+                                         , CanE2EConfig   config );
+    virtual bool            RemoveMessage( ICanE2EMessage^ message );
+    virtual void            Start        ( void );
+    virtual void            Stop         ( void );
+};
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
@@ -0,0 +1,319 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the acceptance filter compiler which covers
+//            arbitrary sets of CAN identifiers with code/mask pairs.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "canfltc.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+
+#pragma warning(disable:4669) // 'type cast' : unsafe conversion
+
+
+//*****************************************************************************
+/// <summary>
+///   Gets the identifier mask of the specified filter selection.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Invalid filter selection.
+/// </exception>
+//*****************************************************************************
+UInt32 CanFilterCompiler::GetIdMask( CanFilter select )
+{
+  switch (select)
+  {
+    case CanFilter::Std: return( FLT_STD_ID_MASK );
+    case CanFilter::Ext: return( FLT_EXT_ID_MASK );
+  }
+
+  throw gcnew ArgumentOutOfRangeException("select");
+}
+
+//*****************************************************************************
+/// <summary>
+///   Compiles the specified identifier ranges to code/mask pairs.
+/// </summary>
+/// <param name="select">
+///   Filter selection.
+/// </param>
+/// <param name="aRanges">
+///   Identifier ranges to accept.
+/// </param>
+/// <param name="iMaxEntries">
+///   Maximum number of code/mask pairs.
+/// </param>
+/// <returns>
+///   The code/mask pairs in the format of AddFilterIds. The RTR bit is
+///   not relevant, i.e. data and remote frames are accepted.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   Parameter aRanges was a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   A range is invalid or iMaxEntries is less than 1.
+/// </exception>
+//*****************************************************************************
+array<CanFilterEntry>^ CanFilterCompiler::Compile( CanFilter          select
+                                                 , array<CanIdRange>^ aRanges
+                                                 , int                iMaxEntries )
+{
+  UInt32 dwIdMask = GetIdMask(select);
+
+  if (iMaxEntries < 1)
+  {
+    throw gcnew ArgumentOutOfRangeException("maxEntries");
+  }
+
+  List<FltPattern>^ pList = Normalize(aRanges, dwIdMask);
+
+  MergeExact(pList);
+
+  if (pList->Count > iMaxEntries)
+  {
+    MergeLossy(pList, dwIdMask, iMaxEntries);
+  }
+
+  pList->Sort(gcnew Comparison<FltPattern>(&CanFilterCompiler::Compare));
+
+  array<CanFilterEntry>^ aResult = gcnew array<CanFilterEntry>(pList->Count);
+  for (int i = 0; i < pList->Count; i++)
+  {
+    aResult[i] = CanFilterEntry(pList[i].dwCode << 1, pList[i].dwMask << 1);
+  }
+
+  return( aResult );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Merges overlapping and adjacent ranges and splits the result into
+///   aligned blocks, i.e. patterns where the irrelevant bits are the
+///   lowest bits of the identifier.
+/// </summary>
+//*****************************************************************************
+List<FltPattern>^ CanFilterCompiler::Normalize( array<CanIdRange>^ aRanges
+                                              , UInt32             dwIdMask )
+{
+  if (nullptr == aRanges)
+  {
+    throw gcnew ArgumentNullException("ranges");
+  }
+
+  // sort by first identifier
+  array<UInt64>^ aSorted = gcnew array<UInt64>(aRanges->Length);
+  for (int i = 0; i < aRanges->Length; i++)
+  {
+    if ((aRanges[i].First > aRanges[i].Last) || (aRanges[i].Last > dwIdMask))
+    {
+      throw gcnew ArgumentOutOfRangeException("ranges");
+    }
+    aSorted[i] = ((UInt64) aRanges[i].First << 32) | aRanges[i].Last;
+  }
+  Array::Sort(aSorted);
+
+  List<FltPattern>^ pList = gcnew List<FltPattern>();
+  int i = 0;
+
+  while (i < aSorted->Length)
+  {
+    UInt64 qwFirst = aSorted[i] >> 32;
+    UInt64 qwLast  = aSorted[i] & 0xFFFFFFFF;
+
+    for (i++; (i < aSorted->Length) && ((aSorted[i] >> 32) <= qwLast + 1); i++)
+    {
+      UInt64 qwNext = aSorted[i] & 0xFFFFFFFF;
+      if (qwNext > qwLast)
+      {
+        qwLast = qwNext;
+      }
+    }
+
+    // largest aligned block which starts at qwFirst and fits into the range
+    while (qwFirst <= qwLast)
+    {
+      UInt64 qwSize = (0 != qwFirst) ? (qwFirst & (~qwFirst + 1)) : ((UInt64) dwIdMask + 1);
+      while (qwFirst + qwSize - 1 > qwLast)
+      {
+        qwSize >>= 1;
+      }
+
+      FltPattern sPattern;
+      sPattern.dwCode = (UInt32) qwFirst;
+      sPattern.dwMask = dwIdMask & ~(UInt32) (qwSize - 1);
+      pList->Add(sPattern);
+
+      qwFirst += qwSize;
+    }
+  }
+
+  return( pList );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Merges pairs of patterns with equal masks whose codes differ in a
+///   single relevant bit. The merge is exact, i.e. no additional
+///   identifiers are accepted.
+/// </summary>
+//*****************************************************************************
+void CanFilterCompiler::MergeExact( List<FltPattern>^ pList )
+{
+  bool fChanged = true;
+
+  while (fChanged)
+  {
+    fChanged = false;
+
+    Dictionary<UInt64, int>^ pIndex = gcnew Dictionary<UInt64, int>(pList->Count);
+    for (int i = 0; i < pList->Count; i++)
+    {
+      pIndex[((UInt64) pList[i].dwMask << 32) | pList[i].dwCode] = i;
+    }
+
+    array<bool>^      aUsed = gcnew array<bool>(pList->Count);
+    List<FltPattern>^ pNext = gcnew List<FltPattern>(pList->Count);
+
+    for (int i = 0; i < pList->Count; i++)
+    {
+      if (aUsed[i])
+      {
+        continue;
+      }
+
+      FltPattern sPattern = pList[i];
+
+      for (UInt32 dwBit = 1; (0 != dwBit) && (dwBit <= sPattern.dwMask); dwBit <<= 1)
+      {
+        int j;
+
+        if ((0 != (sPattern.dwMask & dwBit)) &&
+            pIndex->TryGetValue(((UInt64) sPattern.dwMask << 32) | (sPattern.dwCode ^ dwBit), j) &&
+            !aUsed[j])
+        {
+          FltPattern sMerged;
+          sMerged.dwMask = sPattern.dwMask & ~dwBit;
+          sMerged.dwCode = sPattern.dwCode & ~dwBit;
+
+          aUsed[i] = true;
+          aUsed[j] = true;
+          pNext->Add(sMerged);
+          fChanged = true;
+          break;
+        }
+      }
+
+      if (!aUsed[i])
+      {
+        aUsed[i] = true;
+        pNext->Add(sPattern);
+      }
+    }
+
+    pList->Clear();
+    pList->AddRange(pNext);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Reduces the number of patterns to the specified maximum by merging
+///   neighbouring patterns. Each step chooses the merge which accepts
+///   the fewest additional identifiers.
+/// </summary>
+//*****************************************************************************
+void CanFilterCompiler::MergeLossy( List<FltPattern>^ pList
+                                  , UInt32            dwIdMask
+                                  , int               iMaxEntries )
+{
+  Comparison<FltPattern>^ pCompare = gcnew Comparison<FltPattern>(&CanFilterCompiler::Compare);
+
+  while (pList->Count > iMaxEntries)
+  {
+    pList->Sort(pCompare);
+
+    FltPattern sBest;
+    Int64      qwBestCost = Int64::MaxValue;
+
+    for (int i = 0; i + 1 < pList->Count; i++)
+    {
+      FltPattern sLeft  = pList[i];
+      FltPattern sRight = pList[i + 1];
+      FltPattern sMerged;
+
+      sMerged.dwMask = sLeft.dwMask & sRight.dwMask & ~(sLeft.dwCode ^ sRight.dwCode);
+      sMerged.dwCode = sLeft.dwCode & sMerged.dwMask;
+
+      Int64 qwCost = (Int64) Size(sMerged, dwIdMask)
+                   - (Int64) Size(sLeft, dwIdMask)
+                   - (Int64) Size(sRight, dwIdMask);
+
+      if (qwCost < qwBestCost)
+      {
+        qwBestCost = qwCost;
+        sBest      = sMerged;
+      }
+    }
+
+    // drop all patterns covered by the merged one
+    List<FltPattern>^ pNext = gcnew List<FltPattern>(pList->Count);
+    for (int i = 0; i < pList->Count; i++)
+    {
+      if (((pList[i].dwMask & sBest.dwMask) != sBest.dwMask) ||
+          ((pList[i].dwCode & sBest.dwMask) != sBest.dwCode))
+      {
+        pNext->Add(pList[i]);
+      }
+    }
+    pNext->Add(sBest);
+
+    pList->Clear();
+    pList->AddRange(pNext);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of identifiers accepted by the pattern.
+/// </summary>
+//*****************************************************************************
+UInt64 CanFilterCompiler::Size( FltPattern sPattern
+                              , UInt32     dwIdMask )
+{
+  UInt32 dwFree = dwIdMask & ~sPattern.dwMask;
+  int    iBits  = 0;
+
+  while (0 != dwFree)
+  {
+    dwFree &= dwFree - 1;
+    iBits++;
+  }
+
+  return( (UInt64) 1 << iBits );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Orders patterns by code and mask.
+/// </summary>
+//*****************************************************************************
+int CanFilterCompiler::Compare( FltPattern sLeft
+                              , FltPattern sRight )
+{
+  if (sLeft.dwCode != sRight.dwCode)
+  {
+    return( (sLeft.dwCode < sRight.dwCode) ? -1 : 1 );
+  }
+
+  if (sLeft.dwMask != sRight.dwMask)
+  {
+    return( (sLeft.dwMask < sRight.dwMask) ? -1 : 1 );
+  }
+
+  return( 0 );
+}
+
+#pragma warning(default:4669) // 'type cast' : unsafe conversion
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the acceptance filter compiler which covers
+//            arbitrary sets of CAN identifiers with code/mask pairs.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+using namespace System::Collections::Generic;
+
+
+// identifier masks of the filter selections
+#define FLT_STD_ID_MASK       0x000007FF
+#define FLT_EXT_ID_MASK       0x1FFFFFFF
+
+
+//*****************************************************************************
+/// <summary>
+///   Code/mask pair in identifier space, i.e. without the RTR bit.
+/// </summary>
+//*****************************************************************************
+private value struct FltPattern
+{
+  UInt32 dwCode;  // identifier bits, irrelevant bits are 0
+  UInt32 dwMask;  // relevant identifier bits
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   This class compiles sets of identifier ranges to a small number of
+///   code/mask pairs.
+/// </summary>
+/// <remarks>
+///   The ranges are split into aligned blocks and merged without loss
+///   as long as two patterns differ in a single relevant bit. If the
+///   result still exceeds the entry budget, neighbouring patterns are
+///   merged greedily, each time choosing the merge which accepts the
+///   fewest additional identifiers.
+/// </remarks>
+//*****************************************************************************
+private ref class CanFilterCompiler abstract sealed
+{
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    static List<FltPattern>^ Normalize  ( array<CanIdRange>^ aRanges
+                                        , UInt32             dwIdMask );
+    static void              MergeExact ( List<FltPattern>^  pList );
+    static void              MergeLossy ( List<FltPattern>^  pList
+                                        , UInt32             dwIdMask
+                                        , int                iMaxEntries );
+    static UInt64            Size       ( FltPattern         sPattern
+                                        , UInt32             dwIdMask );
+    static int               Compare    ( FltPattern         sLeft
+                                        , FltPattern         sRight );
+
+  internal:
+    static UInt32 GetIdMask ( CanFilter select );
+
+    static array<CanFilterEntry>^ Compile ( CanFilter          select
+                                          , array<CanIdRange>^ aRanges
+                                          , int                iMaxEntries );
+};
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the shadow copy of the CAN filter lists.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "canfltt.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+
+#pragma warning(disable:4669) // 'type cast' : unsafe conversion
+
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for an empty filter table.
+/// </summary>
+//*****************************************************************************
+CanFilterTable::CanFilterTable()
+{
+  m_pStd = gcnew Dictionary<UInt64, bool>();
+  m_pExt = gcnew Dictionary<UInt64, bool>();
+  m_pAcc = gcnew Dictionary<CanFilter, UInt64>();
+}
+
+//*****************************************************************************
+/// <summary>
+///   Removes all entries, e.g. after the filter lists are reset.
+/// </summary>
+//*****************************************************************************
+void CanFilterTable::Clear(void)
+{
+  m_pStd->Clear();
+  m_pExt->Clear();
+  m_pAcc->Clear();
+}
+
+//*****************************************************************************
+/// <summary>
+///   Records a code/mask pair registered at the specified filter list.
+/// </summary>
+//*****************************************************************************
+void CanFilterTable::Add( CanFilter select
+                        , UInt32    dwCode
+                        , UInt32    dwMask )
+{
+  GetList(select)[ToKey(dwCode, dwMask)] = false;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Records a code/mask pair removed from the specified filter list.
+///   Entries covered by the pair are removed as well, entries sharing
+///   only some identifiers with it are marked as stale.
+/// </summary>
+//*****************************************************************************
+void CanFilterTable::Remove( CanFilter select
+                           , UInt32    dwCode
+                           , UInt32    dwMask )
+{
+  Dictionary<UInt64, bool>^ pList = GetList(select);
+  UInt64 qwRemoved = ToKey(dwCode, dwMask);
+
+  List<UInt64>^ pKeys = gcnew List<UInt64>(pList->Keys);
+  for each (UInt64 qwKey in pKeys)
+  {
+    if (Covers(qwRemoved, qwKey))
+    {
+      pList->Remove(qwKey);
+    }
+    else if (Overlaps(qwRemoved, qwKey))
+    {
+      pList[qwKey] = true;
+    }
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the entries of the specified filter list ordered by code and mask.
+/// </summary>
+//*****************************************************************************
+array<CanFilterEntry>^ CanFilterTable::GetEntries( CanFilter select )
+{
+  Dictionary<UInt64, bool>^ pList = GetList(select);
+
+  array<UInt64>^ aKeys = gcnew array<UInt64>(pList->Count);
+  pList->Keys->CopyTo(aKeys, 0);
+  Array::Sort(aKeys);
+
+  array<CanFilterEntry>^ aResult = gcnew array<CanFilterEntry>(aKeys->Length);
+  for (int i = 0; i < aKeys->Length; i++)
+  {
+    aResult[i] = CanFilterEntry(KeyCode(aKeys[i]), KeyMask(aKeys[i]));
+  }
+
+  return( aResult );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Records the acceptance filter set at the specified filter list.
+/// </summary>
+//*****************************************************************************
+void CanFilterTable::SetAcc( CanFilter select
+                           , UInt32    dwCode
+                           , UInt32    dwMask )
+{
+  GetList(select); // validates the selection
+  m_pAcc[select] = ((UInt64) dwCode << 32) | dwMask;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the acceptance filter of the specified filter list.
+/// </summary>
+/// <returns>
+///   false if no acceptance filter was set since the last reset.
+/// </returns>
+//*****************************************************************************
+bool CanFilterTable::GetAcc( CanFilter       select
+                           , CanFilterEntry% rEntry )
+{
+  UInt64 qwValue;
+
+  if (!m_pAcc->TryGetValue(select, qwValue))
+  {
+    return( false );
+  }
+
+  rEntry = CanFilterEntry(KeyCode(qwValue), KeyMask(qwValue));
+  return( true );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Computes the requests which turn the specified filter list into the
+///   target list. The requests in <paramref name="pRemove"/> have to be
+///   executed before the requests in <paramref name="pAdd"/>.
+/// </summary>
+/// <exception cref="ArgumentNullException">
+///   Parameter aTarget was a null reference.
+/// </exception>
+//*****************************************************************************
+void CanFilterTable::Diff( CanFilter               select
+                         , array<CanFilterEntry>^  aTarget
+                         , List<CanFilterEntry>^   pRemove
+                         , List<CanFilterEntry>^   pAdd )
+{
+  Dictionary<UInt64, bool>^ pList = GetList(select);
+
+  if (nullptr == aTarget)
+  {
+    throw gcnew ArgumentNullException("entries");
+  }
+
+  List<UInt64>^ pWanted = gcnew List<UInt64>(aTarget->Length);
+  for (int i = 0; i < aTarget->Length; i++)
+  {
+    UInt64 qwKey = ToKey(aTarget[i].Code, aTarget[i].Mask);
+    if (!pWanted->Contains(qwKey))
+    {
+      pWanted->Add(qwKey);
+    }
+  }
+  pWanted->Sort();
+
+  array<UInt64>^ aCurrent = gcnew array<UInt64>(pList->Count);
+  pList->Keys->CopyTo(aCurrent, 0);
+  Array::Sort(aCurrent);
+
+  List<UInt64>^ pDropped = gcnew List<UInt64>();
+  for each (UInt64 qwKey in aCurrent)
+  {
+    if (pWanted->BinarySearch(qwKey) < 0)
+    {
+      pDropped->Add(qwKey);
+      pRemove->Add(CanFilterEntry(KeyCode(qwKey), KeyMask(qwKey)));
+    }
+  }
+
+  for each (UInt64 qwKey in pWanted)
+  {
+    bool fStale;
+    bool fAdd = !pList->TryGetValue(qwKey, fStale) || fStale;
+
+    // removing a dropped entry also removes the shared identifiers
+    for (int i = 0; !fAdd && (i < pDropped->Count); i++)
+    {
+      fAdd = Overlaps(pDropped[i], qwKey);
+    }
+
+    if (fAdd)
+    {
+      pAdd->Add(CanFilterEntry(KeyCode(qwKey), KeyMask(qwKey)));
+    }
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the entries of the specified filter list.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Invalid filter selection.
+/// </exception>
+//*****************************************************************************
+Dictionary<UInt64, bool>^ CanFilterTable::GetList( CanFilter select )
+{
+  switch (select)
+  {
+    case CanFilter::Std: return( m_pStd );
+    case CanFilter::Ext: return( m_pExt );
+  }
+
+  throw gcnew ArgumentOutOfRangeException("select");
+}
+
+//*****************************************************************************
+/// <summary>
+///   Builds the table key of a code/mask pair. Irrelevant code bits are
+///   cleared, so that equivalent pairs map to the same key and keys sort
+///   by code first.
+/// </summary>
+//*****************************************************************************
+UInt64 CanFilterTable::ToKey( UInt32 dwCode
+                            , UInt32 dwMask )
+{
+  return( ((UInt64) (dwCode & dwMask) << 32) | dwMask );
+}
+
+UInt32 CanFilterTable::KeyCode( UInt64 qwKey )
+{
+  return( (UInt32) (qwKey >> 32) );
+}
+
+UInt32 CanFilterTable::KeyMask( UInt64 qwKey )
+{
+  return( (UInt32) qwKey );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Determines whether two code/mask pairs share at least one identifier.
+/// </summary>
+//*****************************************************************************
+bool CanFilterTable::Overlaps( UInt64 qwLeft
+                             , UInt64 qwRight )
+{
+  UInt32 dwMask = KeyMask(qwLeft) & KeyMask(qwRight);
+  return( 0 == ((KeyCode(qwLeft) ^ KeyCode(qwRight)) & dwMask) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Determines whether all identifiers of the inner pair are accepted by
+///   the outer pair.
+/// </summary>
+//*****************************************************************************
+bool CanFilterTable::Covers( UInt64 qwOuter
+                           , UInt64 qwInner )
+{
+  UInt32 dwMask = KeyMask(qwOuter);
+  return( ((KeyMask(qwInner) & dwMask) == dwMask) &&
+          (0 == ((KeyCode(qwOuter) ^ KeyCode(qwInner)) & dwMask)) );
+}
+
+#pragma warning(default:4669) // 'type cast' : unsafe conversion
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the shadow copy of the CAN filter lists.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+using namespace System::Collections::Generic;
+
+
+//*****************************************************************************
+/// <summary>
+///   This class keeps a shadow copy of the code/mask pairs registered at
+///   the standard and extended filter list of a CAN socket.
+/// </summary>
+/// <remarks>
+///   The filter lists of the controller work on identifiers, i.e. removing
+///   a code/mask pair also removes the identifiers of all other pairs
+///   which share identifiers with it. Such pairs are kept in the table
+///   but marked as stale, so that a later update registers them again.
+///   The table also records the acceptance filters, so that the complete
+///   filter setup can be restored after the line was reset.
+/// </remarks>
+//*****************************************************************************
+private ref class CanFilterTable
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    Dictionary<UInt64, bool>^ m_pStd; // std entries, value is the stale flag
+    Dictionary<UInt64, bool>^ m_pExt; // ext entries, value is the stale flag
+    Dictionary<CanFilter, UInt64>^ m_pAcc; // acceptance filters set so far
+
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    Dictionary<UInt64, bool>^ GetList ( CanFilter select );
+
+    static UInt64 ToKey    ( UInt32 dwCode, UInt32 dwMask );
+    static UInt32 KeyCode  ( UInt64 qwKey );
+    static UInt32 KeyMask  ( UInt64 qwKey );
+    static bool   Overlaps ( UInt64 qwLeft, UInt64 qwRight );
+    static bool   Covers   ( UInt64 qwOuter, UInt64 qwInner );
+
+  internal:
+    CanFilterTable ( );
+
+    void Clear  ( void );
+    void Add    ( CanFilter select, UInt32 dwCode, UInt32 dwMask );
+    void Remove ( CanFilter select, UInt32 dwCode, UInt32 dwMask );
+
+    array<CanFilterEntry>^ GetEntries ( CanFilter select );
+
+    void SetAcc ( CanFilter select, UInt32 dwCode, UInt32 dwMask );
+    bool GetAcc ( CanFilter select, CanFilterEntry% rEntry );
+
+    void Diff ( CanFilter               select
+              , array<CanFilterEntry>^  aTarget
+              , List<CanFilterEntry>^   pRemove
+              , List<CanFilterEntry>^   pAdd );
+};
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
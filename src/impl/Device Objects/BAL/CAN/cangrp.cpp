@@ -0,0 +1,679 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of groups of CAN channels which are brought up
+//            concurrently.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "cangrp.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+using namespace System::Diagnostics;
+using namespace System::Threading;
+
+
+//*****************************************************************************
+/// <summary>
+///   Worker thread procedure. In the activate stage each worker takes
+///   one channel and waits at the gate until all workers are ready.
+///   In the other stages each worker picks the next unprocessed channel
+///   until all channels are done.
+/// </summary>
+//*****************************************************************************
+void CanChannelGroupJob::Run(void)
+{
+  int iChn;
+
+  if (CHG_STAGE_ACTIVATE == iStage)
+  {
+    iChn = Interlocked::Increment(iReady) - 1;
+
+    // spin instead of waiting for an event, the wake-up latency of the
+    // scheduler would add to the skew. SpinOnce yields the processor
+    // if there are more workers than processors.
+    SpinWait sSpin;
+    while (0 == Thread::VolatileRead(iGo))
+    {
+      sSpin.SpinOnce();
+    }
+
+    if (iChn < aError->Length)
+    {
+      pOwner->RunStage(this, iChn);
+    }
+  }
+  else
+  {
+    while ((iChn = Interlocked::Increment(iNext) - 1) < aError->Length)
+    {
+      pOwner->RunStage(this, iChn);
+    }
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for channel group objects.
+/// </summary>
+//*****************************************************************************
+CanChannelGroup::CanChannelGroup(void)
+{
+  m_pBals   = gcnew List<IBalObject^>();
+  m_pPorts  = gcnew List<Byte>();
+  m_iMaxPar = CHG_MAX_PARALLEL;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Destructor for channel group objects.
+/// </summary>
+//*****************************************************************************
+CanChannelGroup::~CanChannelGroup()
+{
+  Cleanup();
+  m_fDisposed = true;
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method closes the readers, writers and channels of the group.
+/// </summary>
+//*****************************************************************************
+void CanChannelGroup::Cleanup(void)
+{
+  if (nullptr == m_aChannels)
+  {
+    return;
+  }
+
+  for (int i = m_aChannels->Length - 1; i >= 0; i--)
+  {
+    delete m_aReaders[i];
+    delete m_aWriters[i];
+    delete m_aChannels[i];
+  }
+
+  m_aReaders  = nullptr;
+  m_aWriters  = nullptr;
+  m_aChannels = nullptr;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Checks that the group is open.
+/// </summary>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+/// <exception cref="InvalidOperationException">
+///   The group is not open.
+/// </exception>
+//*****************************************************************************
+void CanChannelGroup::CheckOpen(void)
+{
+  if (m_fDisposed)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  if (nullptr == m_aChannels)
+  {
+    throw gcnew InvalidOperationException("The channel group is not open.");
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Runs a startup stage for all channels of the group.
+/// </summary>
+/// <param name="iStage">
+///   The stage to run.
+/// </param>
+/// <param name="iThreads">
+///   Number of worker threads.
+/// </param>
+/// <param name="rElapsed">
+///   Returns the duration of the stage. For the activate stage the
+///   duration starts when the gate is opened.
+/// </param>
+/// <returns>
+///   The finished job with the errors and completion times per channel.
+/// </returns>
+//*****************************************************************************
+CanChannelGroupJob^ CanChannelGroup::Execute( int       iStage
+                                            , int       iThreads
+                                            , TimeSpan% rElapsed )
+{
+  int                 iCount  = m_pBals->Count;
+  CanChannelGroupJob^ pJob    = gcnew CanChannelGroupJob();
+  Int64               qwStart = Stopwatch::GetTimestamp();
+
+  pJob->pOwner = this;
+  pJob->iStage = iStage;
+  pJob->aError = gcnew array<Exception^>(iCount);
+  pJob->aDone  = gcnew array<Int64>(iCount);
+  pJob->iNext  = 0;
+  pJob->iReady = 0;
+  pJob->iGo    = 0;
+
+  if (iThreads <= 1)
+  {
+    pJob->iGo = 1;
+    pJob->Run();
+  }
+  else
+  {
+    array<Thread^>^ aThreads = gcnew array<Thread^>(iThreads);
+
+    for (int i = 0; i < iThreads; i++)
+    {
+      aThreads[i] = gcnew Thread(gcnew ThreadStart(pJob, &CanChannelGroupJob::Run));
+      aThreads[i]->Name         = "VCI channel group";
+      aThreads[i]->IsBackground = true;
+      aThreads[i]->Start();
+    }
+
+    if (CHG_STAGE_ACTIVATE == iStage)
+    {
+      // open the gate as soon as all workers are parked
+      SpinWait sSpin;
+      while (Thread::VolatileRead(pJob->iReady) < iThreads)
+      {
+        sSpin.SpinOnce();
+      }
+
+      qwStart = Stopwatch::GetTimestamp();
+      Interlocked::Exchange(pJob->iGo, 1);
+    }
+
+    for (int i = 0; i < iThreads; i++)
+    {
+      aThreads[i]->Join();
+    }
+  }
+
+  Int64 qwEnd = qwStart;
+  for (int i = 0; i < iCount; i++)
+  {
+    qwEnd = Math::Max(qwEnd, pJob->aDone[i]);
+  }
+
+  rElapsed = TimeSpan::FromTicks((qwEnd - qwStart) * TimeSpan::TicksPerSecond
+                                 / Stopwatch::Frequency);
+
+  return( pJob );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Runs the stage of a job for a single channel. The method is called
+///   by the worker threads and records all errors in the job.
+/// </summary>
+/// <param name="pJob">
+///   The running job.
+/// </param>
+/// <param name="iChn">
+///   Index of the channel within the group.
+/// </param>
+//*****************************************************************************
+void CanChannelGroup::RunStage( CanChannelGroupJob^ pJob
+                              , int                 iChn )
+{
+  try
+  {
+    switch (pJob->iStage)
+    {
+      case CHG_STAGE_OPEN:
+      {
+        ICanChannel2^ pChn = dynamic_cast<ICanChannel2^>(
+                               m_pBals[iChn]->OpenSocket(m_pPorts[iChn], ICanChannel2::typeid));
+        if (nullptr == pChn)
+        {
+          throw gcnew VciException(VciServerImpl::Instance(), E_NOINTERFACE);
+        }
+        m_aChannels[iChn] = pChn;
+        break;
+      }
+
+      case CHG_STAGE_INIT:
+      {
+        ICanChannel2^ pChn = m_aChannels[iChn];
+        pChn->Initialize(m_wRxSize, m_wTxSize, m_dwFltSize, m_eFltMode, m_fExclusive);
+        m_aReaders[iChn] = pChn->GetMessageReader();
+        m_aWriters[iChn] = pChn->GetMessageWriter();
+        break;
+      }
+
+      case CHG_STAGE_ACTIVATE:
+      {
+        m_aChannels[iChn]->Activate();
+        break;
+      }
+    }
+  }
+  catch (Exception^ e)
+  {
+    pJob->aError[iChn] = e;
+  }
+
+  pJob->aDone[iChn] = Stopwatch::GetTimestamp();
+}
+
+//*****************************************************************************
+/// <summary>
+///   Throws the errors of all failed channels, ordered by channel index.
+///   The errors were caught on the worker threads, so they are wrapped
+///   instead of rethrown to keep their stack traces.
+/// </summary>
+/// <param name="pJob">
+///   The finished job.
+/// </param>
+/// <exception cref="AggregateException">
+///   At least one channel failed.
+/// </exception>
+//*****************************************************************************
+void CanChannelGroup::Rethrow(CanChannelGroupJob^ pJob)
+{
+  List<Exception^>^ pErrors = gcnew List<Exception^>();
+
+  for (int i = 0; i < pJob->aError->Length; i++)
+  {
+    if (nullptr != pJob->aError[i])
+    {
+      pErrors->Add(pJob->aError[i]);
+    }
+  }
+
+  if (pErrors->Count > 0)
+  {
+    throw gcnew AggregateException("One or more channels of the group failed.", pErrors);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the maximum number of channels opened at the same time.
+/// </summary>
+//*****************************************************************************
+int CanChannelGroup::MaxParallel::get(void)
+{
+  return( m_iMaxPar );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Sets the maximum number of channels opened at the same time.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   The value is less than 1.
+/// </exception>
+//*****************************************************************************
+void CanChannelGroup::MaxParallel::set(int value)
+{
+  if (value < 1)
+  {
+    throw gcnew ArgumentOutOfRangeException("value");
+  }
+
+  m_iMaxPar = value;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of channels of the group.
+/// </summary>
+//*****************************************************************************
+int CanChannelGroup::ChannelCount::get(void)
+{
+  return( m_pBals->Count );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the duration of the startup stages run so far.
+/// </summary>
+//*****************************************************************************
+CanChannelGroupTiming CanChannelGroup::Timing::get(void)
+{
+  return( m_sTiming );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Adds a channel to the group.
+/// </summary>
+/// <param name="bal">
+///   The bus access layer the channel belongs to.
+/// </param>
+/// <param name="portNumber">
+///   Port number of the channel.
+/// </param>
+/// <exception cref="ArgumentNullException">
+///   Parameter bal was a null reference.
+/// </exception>
+/// <exception cref="InvalidOperationException">
+///   The group is already open.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+void CanChannelGroup::AddChannel( IBalObject^ bal
+                                , Byte        portNumber )
+{
+  if (m_fDisposed)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  if (nullptr == bal)
+  {
+    throw gcnew ArgumentNullException("bal");
+  }
+
+  if (nullptr != m_aChannels)
+  {
+    throw gcnew InvalidOperationException("The channel group is already open.");
+  }
+
+  m_pBals->Add(bal);
+  m_pPorts->Add(portNumber);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets a channel of the group.
+/// </summary>
+/// <param name="index">
+///   Index of the channel within the group.
+/// </param>
+/// <returns>
+///   The channel.
+/// </returns>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Parameter index is out of range.
+/// </exception>
+//*****************************************************************************
+ICanChannel2^ CanChannelGroup::GetChannel(int index)
+{
+  CheckOpen();
+
+  if ((index < 0) || (index >= m_aChannels->Length))
+  {
+    throw gcnew ArgumentOutOfRangeException("index");
+  }
+
+  return( m_aChannels[index] );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Opens and initializes all channels of the group concurrently.
+/// </summary>
+/// <param name="receiveFifoSize">
+///   Size of the receive buffer of each channel.
+/// </param>
+/// <param name="transmitFifoSize">
+///   Size of the transmit buffer of each channel.
+/// </param>
+/// <param name="filterSize">
+///   Size of the filter of each channel.
+/// </param>
+/// <param name="filterMode">
+///   Initial filter mode of each channel.
+/// </param>
+/// <param name="exclusive">
+///   If this parameter is set to true the channels take exclusive
+///   access to their controllers.
+/// </param>
+/// <exception cref="AggregateException">
+///   At least one channel failed.
+/// </exception>
+/// <exception cref="InvalidOperationException">
+///   The group is already open.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+void CanChannelGroup::Open( UInt16         receiveFifoSize
+                          , UInt16         transmitFifoSize
+                          , UInt32         filterSize
+                          , CanFilterModes filterMode
+                          , bool           exclusive )
+{
+  if (m_fDisposed)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  if (nullptr != m_aChannels)
+  {
+    throw gcnew InvalidOperationException("The channel group is already open.");
+  }
+
+  int      iCount   = m_pBals->Count;
+  int      iThreads = Math::Min(m_iMaxPar, iCount);
+  TimeSpan tsOpen;
+  TimeSpan tsInit;
+
+  m_wRxSize    = receiveFifoSize;
+  m_wTxSize    = transmitFifoSize;
+  m_dwFltSize  = filterSize;
+  m_eFltMode   = filterMode;
+  m_fExclusive = exclusive;
+
+  m_aChannels  = gcnew array<ICanChannel2^>(iCount);
+  m_aReaders   = gcnew array<ICanMessageReader^>(iCount);
+  m_aWriters   = gcnew array<ICanMessageWriter^>(iCount);
+  m_sTiming    = CanChannelGroupTiming();
+
+  CanChannelGroupJob^ pJob = Execute(CHG_STAGE_OPEN, iThreads, tsOpen);
+  m_sTiming = CanChannelGroupTiming(tsOpen, TimeSpan::Zero,
+                                    TimeSpan::Zero, TimeSpan::Zero);
+
+  try
+  {
+    Rethrow(pJob);
+
+    pJob = Execute(CHG_STAGE_INIT, iThreads, tsInit);
+    m_sTiming = CanChannelGroupTiming(tsOpen, tsInit,
+                                      TimeSpan::Zero, TimeSpan::Zero);
+
+    Rethrow(pJob);
+  }
+  catch (Exception^)
+  {
+    Cleanup();
+    throw;
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Activates all channels of the group at nearly the same time.
+/// </summary>
+/// <remarks>
+///   The skew is the spread of the completion times of the channels
+///   which were activated successfully. If a channel fails, the channels
+///   which were activated are deactivated again.
+/// </remarks>
+/// <exception cref="AggregateException">
+///   At least one channel failed.
+/// </exception>
+//*****************************************************************************
+void CanChannelGroup::Activate(void)
+{
+  CheckOpen();
+
+  TimeSpan            tsActivate;
+  CanChannelGroupJob^ pJob  = Execute(CHG_STAGE_ACTIVATE, m_aChannels->Length, tsActivate);
+  Int64               qwMin = Int64::MaxValue;
+  Int64               qwMax = Int64::MinValue;
+  int                 iFailed = 0;
+
+  for (int i = 0; i < pJob->aDone->Length; i++)
+  {
+    if (nullptr == pJob->aError[i])
+    {
+      qwMin = Math::Min(qwMin, pJob->aDone[i]);
+      qwMax = Math::Max(qwMax, pJob->aDone[i]);
+    }
+    else
+    {
+      iFailed++;
+    }
+  }
+
+  TimeSpan tsSkew = (qwMax > qwMin)
+                  ? TimeSpan::FromTicks((qwMax - qwMin) * TimeSpan::TicksPerSecond
+                                        / Stopwatch::Frequency)
+                  : TimeSpan::Zero;
+
+  m_sTiming = CanChannelGroupTiming(m_sTiming.Open, m_sTiming.Initialize,
+                                    tsActivate, tsSkew);
+
+  // don't leave a partially active group behind
+  if (iFailed > 0)
+  {
+    for (int i = 0; i < pJob->aError->Length; i++)
+    {
+      if (nullptr == pJob->aError[i])
+      {
+        try
+        {
+          m_aChannels[i]->Deactivate();
+        }
+        catch (Exception^)
+        {
+          // the activation errors are reported
+        }
+      }
+    }
+  }
+
+  Rethrow(pJob);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Deactivates all channels of the group. All channels are deactivated
+///   even if one of them fails, the first error is rethrown afterwards.
+/// </summary>
+//*****************************************************************************
+void CanChannelGroup::Deactivate(void)
+{
+  CheckOpen();
+
+  Exception^ pError = nullptr;
+
+  for (int i = 0; i < m_aChannels->Length; i++)
+  {
+    try
+    {
+      m_aChannels[i]->Deactivate();
+    }
+    catch (Exception^ e)
+    {
+      if (nullptr == pError)
+      {
+        pError = e;
+      }
+    }
+  }
+
+  if (nullptr != pError)
+  {
+    throw pError;
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Assigns an event to the receive buffers of all channels.
+/// </summary>
+/// <param name="fifoEvent">
+///   The event to assign.
+/// </param>
+//*****************************************************************************
+void CanChannelGroup::AssignEvent(AutoResetEvent^ fifoEvent)
+{
+  CheckOpen();
+
+  for (int i = 0; i < m_aReaders->Length; i++)
+  {
+    m_aReaders[i]->AssignEvent(fifoEvent);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Reads the messages available in the receive buffers of all channels.
+/// </summary>
+/// <param name="messages">
+///   Returns the received messages.
+/// </param>
+/// <param name="channels">
+///   Returns the index of the receiving channel for each message.
+/// </param>
+/// <returns>
+///   Number of received messages.
+/// </returns>
+//*****************************************************************************
+int CanChannelGroup::ReadMessages( array<ICanMessage2^>^% messages
+                                 , array<int>^%           channels )
+{
+  CheckOpen();
+
+  List<ICanMessage2^>^ pMsgs = gcnew List<ICanMessage2^>();
+  List<int>^           pChns = gcnew List<int>();
+
+  for (int i = 0; i < m_aReaders->Length; i++)
+  {
+    array<ICanMessage2^>^ aMsgs;
+    int                   iCount = m_aReaders[i]->ReadMessages(aMsgs);
+
+    for (int j = 0; j < iCount; j++)
+    {
+      pMsgs->Add(aMsgs[j]);
+      pChns->Add(i);
+    }
+  }
+
+  messages = pMsgs->ToArray();
+  channels = pChns->ToArray();
+
+  return( messages->Length );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Places a message into the transmit buffer of a channel.
+/// </summary>
+/// <param name="channel">
+///   Index of the transmitting channel within the group.
+/// </param>
+/// <param name="message">
+///   The message to transmit.
+/// </param>
+/// <returns>
+///   true on success, false if the transmit buffer is full.
+/// </returns>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Parameter channel is out of range.
+/// </exception>
+//*****************************************************************************
+bool CanChannelGroup::SendMessage( int           channel
+                                 , ICanMessage2^ message )
+{
+  CheckOpen();
+
+  if ((channel < 0) || (channel >= m_aWriters->Length))
+  {
+    throw gcnew ArgumentOutOfRangeException("channel");
+  }
+
+  return( m_aWriters[channel]->SendMessage(message) );
+}
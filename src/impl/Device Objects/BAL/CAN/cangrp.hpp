@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for groups of CAN channels which are brought up
+//            concurrently.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+using namespace System::Collections::Generic;
+using namespace System::Runtime::InteropServices;
+using namespace System::Threading;
+
+
+// default number of channels opened at the same time
+#define CHG_MAX_PARALLEL      8
+
+// startup stages
+#define CHG_STAGE_OPEN        0
+#define CHG_STAGE_INIT        1
+#define CHG_STAGE_ACTIVATE    2
+
+
+// forward decls
+ref class CanChannelGroup;
+
+
+//*****************************************************************************
+/// <summary>
+///   State of a single startup stage of CanChannelGroup which is shared
+///   by the worker threads.
+/// </summary>
+//*****************************************************************************
+private ref class CanChannelGroupJob
+{
+  internal:
+    CanChannelGroup^    pOwner;    // group which runs the job
+    int                 iStage;    // stage run by the job
+    array<Exception^>^  aError;    // error per channel
+    array<Int64>^       aDone;     // completion time stamp per channel
+    int                 iNext;     // next channel to process
+    int                 iReady;    // number of workers waiting at the gate
+    int                 iGo;       // non-zero as soon as the gate is open
+
+    void Run ( void );
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   This class implements a group of CAN channels.
+/// </summary>
+//*****************************************************************************
+private ref class CanChannelGroup : public ICanChannelGroup
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    List<IBalObject^>^         m_pBals;       // registered bus access layers
+    List<Byte>^                m_pPorts;      // registered port numbers
+    int                        m_iMaxPar;     // maximum number of worker threads
+    bool                       m_fDisposed;   // true if the group is disposed
+    array<ICanChannel2^>^      m_aChannels;   // channels, null until opened
+    array<ICanMessageReader^>^ m_aReaders;    // message reader per channel
+    array<ICanMessageWriter^>^ m_aWriters;    // message writer per channel
+    CanChannelGroupTiming      m_sTiming;     // startup timing
+
+    // parameters of the initialize stage
+    UInt16                     m_wRxSize;
+    UInt16                     m_wTxSize;
+    UInt32                     m_dwFltSize;
+    CanFilterModes             m_eFltMode;
+    bool                       m_fExclusive;
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    void                Cleanup    ( void );
+    void                CheckOpen  ( void );
+    CanChannelGroupJob^ Execute    ( int        iStage
+                                   , int        iThreads
+                                   , TimeSpan%  rElapsed );
+    static void         Rethrow    ( CanChannelGroupJob^ pJob );
+
+  internal:
+    CanChannelGroup  ( void );
+    ~CanChannelGroup ( );
+
+    void RunStage    ( CanChannelGroupJob^ pJob
+                     , int                 iChn );
+
+  //--------------------------------------------------------------------
+  // ICanChannelGroup implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual property int MaxParallel  { int  get(void);
+                                        void set(int value); };
+    virtual property int ChannelCount { int  get(void); };
+    virtual property CanChannelGroupTiming Timing
+                                      { CanChannelGroupTiming get(void); };
+
+    virtual void          AddChannel   ( IBalObject^              bal
+                                       , Byte                     portNumber );
+    virtual ICanChannel2^ GetChannel   ( int                      index );
+    virtual void          Open         ( UInt16                   receiveFifoSize
+                                       , UInt16                   transmitFifoSize
+                                       , UInt32                   filterSize
+                                       , CanFilterModes           filterMode
+                                       , bool                     exclusive );
+    virtual void          Activate     ( void );
+    virtual void          Deactivate   ( void );
+    virtual void          AssignEvent  ( AutoResetEvent^          fifoEvent );
+    virtual int           ReadMessages ( [Out] array<ICanMessage2^>^% messages
+                                       , [Out] array<int>^%           channels );
+    virtual bool          SendMessage  ( int                      channel
+                                       , ICanMessage2^            message );
+};
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
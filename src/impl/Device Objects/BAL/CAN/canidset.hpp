@@ -0,0 +1,294 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Native set of CAN identifiers used by the software filter of
+//            the message reader.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <new>
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+
+#define IDSET_STD_WORDS     (2048 / 32)   // bitmap of all 11-bit identifiers
+#define IDSET_BLOOM_WORDS   (8192 / 32)   // bloom filter of the 29-bit set
+#define IDSET_EMPTY         0xFFFFFFFF    // unused slot, no valid 29-bit ID
+#define IDSET_MIN_SLOTS     64
+
+
+//*****************************************************************************
+/// <summary>
+///   Set of 11-bit and 29-bit CAN identifiers.
+/// </summary>
+/// <remarks>
+///   11-bit identifiers are kept in a bitmap. 29-bit identifiers are kept
+///   in an open addressing hash table with linear probing, guarded by a
+///   bloom filter with two hash functions, so most unwanted identifiers
+///   are rejected with two bit tests and without probing the table.
+/// </remarks>
+//*****************************************************************************
+class CANIDSET
+{
+  private:
+    UINT32  m_adwStd[IDSET_STD_WORDS];      // 11-bit identifier bitmap
+    UINT32  m_adwBloom[IDSET_BLOOM_WORDS];  // bloom filter of m_pdwExt
+    UINT32* m_pdwExt;                       // hash table of 29-bit IDs
+    UINT32  m_dwSlots;                      // number of slots, power of 2
+    UINT32  m_dwShift;                      // 32 - log2(m_dwSlots)
+    UINT32  m_dwExtCount;                   // number of used slots
+    UINT32  m_dwStdCount;                   // number of set bitmap bits
+
+    static UINT32 Hash1( UINT32 dwId ) { return( dwId * 0x9E3779B1 ); }
+    static UINT32 Hash2( UINT32 dwId ) { return( (dwId ^ (dwId >> 15)) * 0x85EBCA6B ); }
+
+    // Fibonacci hashing: the low bits of the product only depend on the
+    // low bits of the identifier (i.e. the J1939 source address), so the
+    // slot is taken from the high bits
+    UINT32 Slot( UINT32 dwId ) const
+    {
+      return( Hash1(dwId) >> m_dwShift );
+    }
+
+    void SetBloom( UINT32 dwId )
+    {
+      UINT32 dwBit1 = Hash1(dwId) >> 19; // 13 bit
+      UINT32 dwBit2 = Hash2(dwId) >> 19;
+      m_adwBloom[dwBit1 >> 5] |= 1u << (dwBit1 & 31);
+      m_adwBloom[dwBit2 >> 5] |= 1u << (dwBit2 & 31);
+    }
+
+    bool TestBloom( UINT32 dwId ) const
+    {
+      UINT32 dwBit1 = Hash1(dwId) >> 19;
+      UINT32 dwBit2 = Hash2(dwId) >> 19;
+      return( (0 != (m_adwBloom[dwBit1 >> 5] & (1u << (dwBit1 & 31)))) &&
+              (0 != (m_adwBloom[dwBit2 >> 5] & (1u << (dwBit2 & 31)))) );
+    }
+
+    void RebuildBloom( void )
+    {
+      for (UINT32 i = 0; i < IDSET_BLOOM_WORDS; i++)
+      {
+        m_adwBloom[i] = 0;
+      }
+      for (UINT32 i = 0; i < m_dwSlots; i++)
+      {
+        if (IDSET_EMPTY != m_pdwExt[i])
+        {
+          SetBloom(m_pdwExt[i]);
+        }
+      }
+    }
+
+    bool Resize( UINT32 dwSlots )
+    {
+      UINT32* pdwOld   = m_pdwExt;
+      UINT32  dwOldCnt = m_dwSlots;
+
+      m_pdwExt = new (std::nothrow) UINT32[dwSlots];
+      if (nullptr == m_pdwExt)
+      {
+        m_pdwExt = pdwOld;
+        return( false );
+      }
+
+      m_dwSlots = dwSlots;
+      m_dwShift = 32;
+      for (UINT32 n = dwSlots; n > 1; n >>= 1)
+      {
+        m_dwShift--;
+      }
+      for (UINT32 i = 0; i < dwSlots; i++)
+      {
+        m_pdwExt[i] = IDSET_EMPTY;
+      }
+
+      for (UINT32 i = 0; i < dwOldCnt; i++)
+      {
+        if (IDSET_EMPTY != pdwOld[i])
+        {
+          UINT32 s = Slot(pdwOld[i]);
+          while (IDSET_EMPTY != m_pdwExt[s])
+          {
+            s = (s + 1) & (m_dwSlots - 1);
+          }
+          m_pdwExt[s] = pdwOld[i];
+        }
+      }
+
+      delete[] pdwOld;
+      return( true );
+    }
+
+    // returns the slot of the identifier or -1
+    int Find( UINT32 dwId ) const
+    {
+      if (0 != m_dwSlots)
+      {
+        for (UINT32 s = Slot(dwId); IDSET_EMPTY != m_pdwExt[s]; s = (s + 1) & (m_dwSlots - 1))
+        {
+          if (dwId == m_pdwExt[s])
+          {
+            return( (int) s );
+          }
+        }
+      }
+      return( -1 );
+    }
+
+  public:
+    CANIDSET( ) : m_pdwExt(nullptr), m_dwSlots(0), m_dwShift(32)
+    {
+      Clear();
+    }
+
+    ~CANIDSET( )
+    {
+      delete[] m_pdwExt;
+    }
+
+    CANIDSET( const CANIDSET& ) = delete;
+    CANIDSET& operator=( const CANIDSET& ) = delete;
+
+    void Clear( void )
+    {
+      for (UINT32 i = 0; i < IDSET_STD_WORDS; i++)
+      {
+        m_adwStd[i] = 0;
+      }
+      for (UINT32 i = 0; i < IDSET_BLOOM_WORDS; i++)
+      {
+        m_adwBloom[i] = 0;
+      }
+      for (UINT32 i = 0; i < m_dwSlots; i++)
+      {
+        m_pdwExt[i] = IDSET_EMPTY;
+      }
+      m_dwStdCount = 0;
+      m_dwExtCount = 0;
+    }
+
+    UINT32 StdCount( void ) const { return( m_dwStdCount ); }
+    UINT32 ExtCount( void ) const { return( m_dwExtCount ); }
+
+    void AddStd( UINT32 dwId )
+    {
+      UINT32 dwBit = 1u << (dwId & 31);
+      if (0 == (m_adwStd[(dwId >> 5) & (IDSET_STD_WORDS - 1)] & dwBit))
+      {
+        m_adwStd[(dwId >> 5) & (IDSET_STD_WORDS - 1)] |= dwBit;
+        m_dwStdCount++;
+      }
+    }
+
+    void RemoveStd( UINT32 dwId )
+    {
+      UINT32 dwBit = 1u << (dwId & 31);
+      if (0 != (m_adwStd[(dwId >> 5) & (IDSET_STD_WORDS - 1)] & dwBit))
+      {
+        m_adwStd[(dwId >> 5) & (IDSET_STD_WORDS - 1)] &= ~dwBit;
+        m_dwStdCount--;
+      }
+    }
+
+    bool ContainsStd( UINT32 dwId ) const
+    {
+      return( 0 != (m_adwStd[(dwId >> 5) & (IDSET_STD_WORDS - 1)] & (1u << (dwId & 31))) );
+    }
+
+    // returns false if the table could not be enlarged
+    bool AddExt( UINT32 dwId )
+    {
+      if (Find(dwId) >= 0)
+      {
+        return( true );
+      }
+
+      // keep the load factor at or below 50%
+      if ((m_dwExtCount + 1) * 2 > m_dwSlots)
+      {
+        if (!Resize((0 != m_dwSlots) ? m_dwSlots * 2 : IDSET_MIN_SLOTS))
+        {
+          return( false );
+        }
+      }
+
+      UINT32 s = Slot(dwId);
+      while (IDSET_EMPTY != m_pdwExt[s])
+      {
+        s = (s + 1) & (m_dwSlots - 1);
+      }
+      m_pdwExt[s] = dwId;
+      m_dwExtCount++;
+      SetBloom(dwId);
+      return( true );
+    }
+
+    void RemoveExt( UINT32 dwId )
+    {
+      int iSlot = Find(dwId);
+      if (iSlot < 0)
+      {
+        return;
+      }
+
+      // backward shift deletion keeps the probe sequences intact
+      UINT32 i = (UINT32) iSlot;
+      UINT32 j = i;
+      for (;;)
+      {
+        m_pdwExt[i] = IDSET_EMPTY;
+        for (;;)
+        {
+          j = (j + 1) & (m_dwSlots - 1);
+          if (IDSET_EMPTY == m_pdwExt[j])
+          {
+            m_dwExtCount--;
+            RebuildBloom();
+            return;
+          }
+          UINT32 k = Slot(m_pdwExt[j]);
+          // move the entry unless its home slot lies cyclically in (i, j]
+          if ((i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j)))
+          {
+            continue;
+          }
+          break;
+        }
+        m_pdwExt[i] = m_pdwExt[j];
+        i = j;
+      }
+    }
+
+    bool ContainsExt( UINT32 dwId ) const
+    {
+      return( TestBloom(dwId) && (Find(dwId) >= 0) );
+    }
+
+    //------------------------------------------------------------------
+    // Returns true if the message passes the filter. Only data frames
+    // are filtered, all other message types always pass.
+    //------------------------------------------------------------------
+    bool Pass( UINT8 bType, bool fExt, UINT32 dwId ) const
+    {
+      if (CAN_MSGTYPE_DATA != bType)
+      {
+        return( true );
+      }
+      return( fExt ? ContainsExt(dwId) : ContainsStd(dwId) );
+    }
+};
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
@@ -0,0 +1,490 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the CAN line status monitor.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "canlsm.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+
+#pragma warning(disable:4669) // 'type cast' : unsafe conversion
+
+
+// default sample interval in milliseconds
+#define LSM_DEFAULT_INTERVAL  20
+
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for CAN line status monitor objects.
+/// </summary>
+/// <param name="pBalObj">
+///   Pointer to the native BAL object.
+///   This parameter must not be NULL.
+/// </param>
+/// <param name="deviceId">
+///   Unique hardware id of the device.
+/// </param>
+/// <param name="portNumber">
+///   Port number of the bus socket to open.
+/// </param>
+/// <param name="busTypeIndex">
+///   Bus type related port number
+/// </param>
+/// <exception cref="VciException">
+///   Creation of socket failed.
+/// </exception>
+/// <exception cref="ArgumentNullException">
+///   Parameter pBalObj was a null reference.
+/// </exception>
+//*****************************************************************************
+CanLineStatusMonitor::CanLineStatusMonitor( ::IBalObject* pBalObj
+                                          , Guid          deviceId
+                                          , Byte          portNumber
+                                          , Byte          busTypeIndex)
+                    : CanSocket2(pBalObj, deviceId, portNumber, busTypeIndex)
+{
+  m_pNatSoc      = GetNativeSocket();
+  m_psLast       = new CANLINESTATUS2;
+  m_abThresholds = gcnew array<Byte>(0);
+  m_iInterval    = LSM_DEFAULT_INTERVAL;
+  m_pSync        = gcnew Object();
+  m_pCtrl        = gcnew Object();
+  m_fClosed      = false;
+  m_pWake        = gcnew AutoResetEvent(false);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Destructor for CAN line status monitor objects.
+/// </summary>
+//*****************************************************************************
+CanLineStatusMonitor::~CanLineStatusMonitor()
+{
+  Cleanup();
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method performs tasks associated with freeing, releasing, or
+///   resetting unmanaged resources.
+/// </summary>
+//*****************************************************************************
+void CanLineStatusMonitor::Cleanup(void)
+{
+  // no new thread can be started from here on
+  Monitor::Enter(m_pCtrl);
+  try
+  {
+    m_fClosed = true;
+  }
+  finally
+  {
+    Monitor::Exit(m_pCtrl);
+  }
+
+  // joins the monitor thread unless called by one of its event handlers,
+  // in which case the thread exits after the handler returned without
+  // sampling again
+  Stop();
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr != m_pNatSoc)
+    {
+      m_pNatSoc->Release();
+      m_pNatSoc = nullptr;
+    }
+
+    if (nullptr != m_psLast)
+    {
+      delete m_psLast;
+      m_psLast = nullptr;
+    }
+    m_fValid = false;
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Samples the line status. The native socket is used under the lock,
+///   so it cannot be released by Cleanup while the sample is taken.
+/// </summary>
+/// <param name="psStatus">
+///   Receives the line status.
+/// </param>
+/// <returns>
+///   VCI_OK if succeeded, otherwise a VCI error code.
+/// </returns>
+//*****************************************************************************
+HRESULT CanLineStatusMonitor::Sample( CANLINESTATUS2* psStatus )
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_pNatSoc)
+    {
+      return( VCI_E_UNEXPECTED );
+    }
+
+    return( m_pNatSoc->GetLineStatus(psStatus) );
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of bus load thresholds which are less than or equal
+///   to the specified bus load. The caller must hold the lock.
+/// </summary>
+//*****************************************************************************
+int CanLineStatusMonitor::GetLoadBand( UINT8 bBusLoad )
+{
+  int iBand = 0;
+
+  while ((iBand < m_abThresholds->Length) && (m_abThresholds[iBand] <= bBusLoad))
+  {
+    iBand++;
+  }
+
+  return( iBand );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Compares a new sample with the cached sample and replaces the cached
+///   sample. Managed status objects are only created if something changed.
+/// </summary>
+/// <param name="rStatus">
+///   The new sample.
+/// </param>
+/// <returns>
+///   The event data if the line status changed, otherwise a null reference.
+/// </returns>
+//*****************************************************************************
+CanLineStatusChangedEventArgs^ CanLineStatusMonitor::Update( const CANLINESTATUS2& rStatus )
+{
+  CanLineStatusChangedEventArgs^ pArgs = nullptr;
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr != m_psLast)
+    {
+      int iBand = GetLoadBand(rStatus.bBusLoad);
+
+      if (m_fValid)
+      {
+        CanLineStatusChanges eChanges = CanLineStatusChanges::None;
+        UINT32 dwDiff = m_psLast->dwStatus ^ rStatus.dwStatus;
+
+        if ((m_psLast->bOpMode != rStatus.bOpMode) ||
+            (m_psLast->bExMode != rStatus.bExMode))
+        {
+          eChanges = eChanges | CanLineStatusChanges::OperatingMode;
+        }
+        if (0 != (dwDiff & CAN_STATUS_ININIT))
+        {
+          eChanges = eChanges | CanLineStatusChanges::InitMode;
+        }
+        if (0 != (dwDiff & CAN_STATUS_ERRLIM))
+        {
+          eChanges = eChanges | CanLineStatusChanges::WarningLevel;
+        }
+        if (0 != (dwDiff & CAN_STATUS_BUSOFF))
+        {
+          eChanges = eChanges | CanLineStatusChanges::BusOff;
+        }
+        if (0 != (dwDiff & CAN_STATUS_OVRRUN))
+        {
+          eChanges = eChanges | CanLineStatusChanges::Overrun;
+        }
+        if (0 != (dwDiff & CAN_STATUS_BUSCERR))
+        {
+          eChanges = eChanges | CanLineStatusChanges::BusCouplingError;
+        }
+        if (m_iLoadBand != iBand)
+        {
+          eChanges = eChanges | CanLineStatusChanges::BusLoad;
+        }
+
+        if (CanLineStatusChanges::None != eChanges)
+        {
+          pArgs = gcnew CanLineStatusChangedEventArgs( ToLineStatus(*m_psLast)
+                                                     , ToLineStatus(rStatus)
+                                                     , eChanges );
+        }
+      }
+
+      *m_psLast   = rStatus;
+      m_fValid    = true;
+      m_iLoadBand = iBand;
+      m_qwSamples++;
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+
+  return( pArgs );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets or sets the interval between two samples of the line status.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   The interval is less than 1 millisecond or exceeds
+///   <c>Int32.MaxValue</c> milliseconds.
+/// </exception>
+//*****************************************************************************
+TimeSpan CanLineStatusMonitor::SampleInterval::get(void)
+{
+  return( TimeSpan::FromMilliseconds(m_iInterval) );
+}
+
+void CanLineStatusMonitor::SampleInterval::set(TimeSpan interval)
+{
+  if ((interval.TotalMilliseconds < 1) || (interval.TotalMilliseconds > Int32::MaxValue))
+  {
+    throw gcnew ArgumentOutOfRangeException("value");
+  }
+
+  m_iInterval = (int) interval.TotalMilliseconds;
+  m_pWake->Set();
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets or sets the bus load thresholds in percent.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   A threshold exceeds 100.
+/// </exception>
+//*****************************************************************************
+array<Byte>^ CanLineStatusMonitor::BusLoadThresholds::get(void)
+{
+  return( (array<Byte>^) m_abThresholds->Clone() );
+}
+
+void CanLineStatusMonitor::BusLoadThresholds::set(array<Byte>^ thresholds)
+{
+  array<Byte>^ abSorted;
+
+  if (nullptr != thresholds)
+  {
+    abSorted = (array<Byte>^) thresholds->Clone();
+    for (int i = 0; i < abSorted->Length; i++)
+    {
+      if (abSorted[i] > 100)
+      {
+        throw gcnew ArgumentOutOfRangeException("value");
+      }
+    }
+    Array::Sort(abSorted);
+  }
+  else
+  {
+    abSorted = gcnew array<Byte>(0);
+  }
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    // re-classify the cached sample, so that the new thresholds alone
+    // don't raise an event
+    m_abThresholds = abSorted;
+    if (m_fValid)
+    {
+      m_iLoadBand = GetLoadBand(m_psLast->bBusLoad);
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the line status of the most recent sample.
+/// </summary>
+/// <exception cref="InvalidOperationException">
+///   The monitor was never started.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+CanLineStatus2 CanLineStatusMonitor::CachedLineStatus::get(void)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (nullptr == m_psLast)
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    if (!m_fValid)
+    {
+      throw gcnew InvalidOperationException();
+    }
+
+    return( ToLineStatus(*m_psLast) );
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets a value indicating whether the monitor thread is running.
+/// </summary>
+//*****************************************************************************
+bool CanLineStatusMonitor::IsRunning::get(void)
+{
+  return( nullptr != m_pThread );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the total number of successful samples.
+/// </summary>
+//*****************************************************************************
+Int64 CanLineStatusMonitor::SampleCount::get(void)
+{
+  return( Interlocked::Read(m_qwSamples) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method takes the first sample and starts the monitor thread.
+/// </summary>
+/// <exception cref="VciException">
+///   Getting CAN line status failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+void CanLineStatusMonitor::Start(void)
+{
+  CanLineStatusChangedEventArgs^ pArgs = nullptr;
+
+  Monitor::Enter(m_pCtrl);
+  try
+  {
+    if (m_fClosed || (nullptr == m_pNatSoc))
+    {
+      throw gcnew ObjectDisposedException(this->GetType()->FullName);
+    }
+
+    if (nullptr == m_pThread)
+    {
+      CANLINESTATUS2 sStatus;
+
+      HRESULT hResult = Sample(&sStatus);
+      if (VCI_OK != hResult)
+      {
+        throw gcnew VciException(VciServerImpl::Instance(), hResult);
+      }
+
+      pArgs = Update(sStatus);
+
+      m_fRun    = true;
+      m_pThread = gcnew Thread(gcnew ThreadStart(this, &CanLineStatusMonitor::ThreadProc));
+      m_pThread->Name         = "VCI line status monitor";
+      m_pThread->IsBackground = true;
+      m_pThread->Priority     = ThreadPriority::AboveNormal;
+      m_pThread->Start();
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pCtrl);
+  }
+
+  if (nullptr != pArgs)
+  {
+    LineStatusChanged(this, pArgs);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method stops the monitor thread. If called by an event handler,
+///   the thread terminates after the handler returns.
+/// </summary>
+//*****************************************************************************
+void CanLineStatusMonitor::Stop(void)
+{
+  Thread^ pThread;
+
+  Monitor::Enter(m_pCtrl);
+  try
+  {
+    pThread = m_pThread;
+    if (nullptr != pThread)
+    {
+      m_fRun    = false;
+      m_pThread = nullptr;
+      m_pWake->Set();
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pCtrl);
+  }
+
+  // joined outside of the lock, so an event handler which calls Stop
+  // does not block the thread which waits here
+  if ((nullptr != pThread) && (Thread::CurrentThread != pThread))
+  {
+    pThread->Join();
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Monitor thread. Samples the line status into a native structure and
+///   raises <c>LineStatusChanged</c> outside of the lock if it changed.
+///   Failed samples are skipped.
+/// </summary>
+//*****************************************************************************
+void CanLineStatusMonitor::ThreadProc(void)
+{
+  CANLINESTATUS2 sStatus;
+
+  // a thread which was stopped by its own event handler must not keep
+  // running if Start created a new thread in the meantime
+  while (m_fRun && (Thread::CurrentThread == m_pThread))
+  {
+    m_pWake->WaitOne(m_iInterval, false);
+
+    if (m_fRun && (Thread::CurrentThread == m_pThread) && (VCI_OK == Sample(&sStatus)))
+    {
+      CanLineStatusChangedEventArgs^ pArgs = Update(sStatus);
+      if (nullptr != pArgs)
+      {
+        LineStatusChanged(this, pArgs);
+      }
+    }
+  }
+}
+
+#pragma warning(default:4669) // 'type cast' : unsafe conversion
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the CAN line status monitor.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+#include ".\cansoc2.hpp"
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+using namespace System::Threading;
+
+
+//*****************************************************************************
+/// <summary>
+///   This class implements a CAN socket which samples the line status on
+///   a background thread and reports changes.
+/// </summary>
+//*****************************************************************************
+private ref class CanLineStatusMonitor : public CanSocket2
+                                       , public ICanLineStatusMonitor
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    ::ICanSocket2*    m_pNatSoc;      // native socket used for sampling
+    PCANLINESTATUS2   m_psLast;       // most recent sample
+    bool              m_fValid;       // m_psLast holds a sample
+    int               m_iLoadBand;    // number of thresholds <= bus load
+    array<Byte>^      m_abThresholds; // sorted bus load thresholds
+    int               m_iInterval;    // sample interval in milliseconds
+    Int64             m_qwSamples;    // number of successful samples
+    Object^           m_pSync;        // guards the cached sample
+    Object^           m_pCtrl;        // serializes Start, Stop and Cleanup
+    Thread^           m_pThread;      // monitor thread
+    volatile bool     m_fRun;         // monitor thread keeps running
+    bool              m_fClosed;      // Cleanup was called
+    AutoResetEvent^   m_pWake;        // wakes the monitor thread
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    void    Cleanup    ( void );
+    void    ThreadProc ( void );
+    int     GetLoadBand( UINT8                  bBusLoad );
+    HRESULT Sample     ( CANLINESTATUS2*        psStatus );
+    CanLineStatusChangedEventArgs^
+            Update     ( const CANLINESTATUS2&  rStatus );
+
+  internal:
+    CanLineStatusMonitor ( ::IBalObject* pBalObj
+                         , Guid          deviceId
+                         , Byte          portNumber
+                         , Byte          busTypeIndex);
+   ~CanLineStatusMonitor ( );
+
+  //--------------------------------------------------------------------
+  // ICanLineStatusMonitor implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual property TimeSpan       SampleInterval    { TimeSpan       get(void);
+                                                        void           set(TimeSpan interval); };
+    virtual property array<Byte>^   BusLoadThresholds { array<Byte>^   get(void);
+                                                        void           set(array<Byte>^ thresholds); };
+    virtual property CanLineStatus2 CachedLineStatus  { CanLineStatus2 get(void); };
+    virtual property bool           IsRunning         { bool           get(void); };
+    virtual property Int64          SampleCount       { Int64          get(void); };
+
+    virtual event EventHandler<CanLineStatusChangedEventArgs^>^ LineStatusChanged;
+
+    virtual void Start( void );
+    virtual void Stop ( void );
+};
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
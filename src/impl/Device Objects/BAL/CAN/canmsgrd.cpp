@@ -28,6 +28,7 @@ using namespace Ixxat::Vci4::Bal::Can;
 CanMessageReader::CanMessageReader(::ICanChannel*   pCanChan)
 {
   m_isCanChannel2 = false;
+  m_pSwFilter     = gcnew CanSoftwareFilter();
   PFIFOREADER   pRxFifo;
   HRESULT hResult = pCanChan->GetReader(&pRxFifo);
   if (VCI_OK == hResult)
@@ -55,6 +56,7 @@ CanMessageReader::CanMessageReader(::ICanChannel*   pCanChan)
 CanMessageReader::CanMessageReader(::ICanChannel2*   pCanChan)
 {
   m_isCanChannel2 = true;
+  m_pSwFilter     = gcnew CanSoftwareFilter();
   ::IFifoReader*    pRxFifo;
   HRESULT hResult = pCanChan->GetReader(&pRxFifo);
   if (VCI_OK == hResult)
@@ -92,6 +94,38 @@ void CanMessageReader::Cleanup(void)
   }
 }
 
+//*****************************************************************************
+/// <summary>
+///   Gets the native receive FIFO. The caller has to release the returned
+///   interface pointer.
+/// </summary>
+/// <returns>
+///   Pointer to the native receive FIFO or NULL if the object is disposed.
+/// </returns>
+//*****************************************************************************
+PFIFOREADER CanMessageReader::GetNativeFifo(void)
+{
+  PFIFOREADER pRxFifo = m_pRxFifo;
+
+  if (nullptr != pRxFifo)
+  {
+    pRxFifo->AddRef();
+  }
+
+  return( pRxFifo );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets a value indicating whether the receive FIFO contains CANMSG2
+///   entries (true) or CANMSG entries (false).
+/// </summary>
+//*****************************************************************************
+bool CanMessageReader::IsCanMessage2(void)
+{
+  return( m_isCanChannel2 );
+}
+
 //*****************************************************************************
 /// <summary>
 ///   Gets the capacity of the receive FIFO in number of CAN messages.
@@ -182,20 +216,34 @@ UInt16 CanMessageReader::Threshold::get()
 //*****************************************************************************
 void CanMessageReader::Threshold::set(UInt16 threshold)
 {
-  HRESULT hResult;
+  VciResult sResult = TrySetThreshold(threshold);
 
-  if (nullptr != m_pRxFifo)
+  if (!sResult.Succeeded)
   {
-    hResult = m_pRxFifo->SetThreshold(threshold);
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Sets the threshold for the trigger event of the receive FIFO like
+///   <c>Threshold</c>, but reports a failure through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanMessageReader::TrySetThreshold(UInt16 threshold)
+{
+  if (nullptr == m_pRxFifo)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pRxFifo->SetThreshold(threshold)) );
 }
 
 //*****************************************************************************
@@ -213,18 +261,34 @@ void CanMessageReader::Threshold::set(UInt16 threshold)
 //*****************************************************************************
 void CanMessageReader::Lock()
 {
-  if (nullptr != m_pRxFifo)
+  VciResult sResult = TryLock();
+
+  if (!sResult.Succeeded)
   {
-    HRESULT hResult = m_pRxFifo->Lock();
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Locks the access to the FIFO like <c>Lock</c>, but reports a
+///   failure through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanMessageReader::TryLock()
+{
+  if (nullptr == m_pRxFifo)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pRxFifo->Lock()) );
 }
 
 //*****************************************************************************
@@ -242,18 +306,34 @@ void CanMessageReader::Lock()
 //*****************************************************************************
 void CanMessageReader::Unlock()
 {
-  if (nullptr != m_pRxFifo)
+  VciResult sResult = TryUnlock();
+
+  if (!sResult.Succeeded)
   {
-    HRESULT hResult = m_pRxFifo->Unlock();
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Releases the access to the FIFO like <c>Unlock</c>, but reports a
+///   failure through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanMessageReader::TryUnlock()
+{
+  if (nullptr == m_pRxFifo)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pRxFifo->Unlock()) );
 }
 
 //*****************************************************************************
@@ -344,6 +424,113 @@ void CanMessageReader::AssignEvent(ManualResetEvent^ fifoEvent)
   }
 }
 
+//*****************************************************************************
+/// <summary>
+///   Gets the software filter of the reader.
+/// </summary>
+/// <returns>
+///   The software filter of the reader.
+/// </returns>
+//*****************************************************************************
+ICanSoftwareFilter^ CanMessageReader::SoftwareFilter::get()
+{
+  return( m_pSwFilter );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the size of a receive FIFO entry in bytes.
+/// </summary>
+//*****************************************************************************
+UInt32 CanMessageReader::EntrySize(void)
+{
+  return( m_isCanChannel2 ? sizeof(CANMSG2) : sizeof(CANMSG) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Determines whether the specified receive FIFO entry passes the
+///   software filter.
+/// </summary>
+//*****************************************************************************
+bool CanMessageReader::Passes( CANIDSET* pSet
+                             , PUINT8    pbEntry )
+{
+  if (m_isCanChannel2)
+  {
+    PCANMSG2 pCanMsg = (PCANMSG2) pbEntry;
+    return( pSet->Pass(pCanMsg->uMsgInfo.Bytes.bType, 0 != pCanMsg->uMsgInfo.Bits.ext, pCanMsg->dwMsgId) );
+  }
+  else
+  {
+    PCANMSG pCanMsg = (PCANMSG) pbEntry;
+    return( pSet->Pass(pCanMsg->uMsgInfo.Bytes.bType, 0 != pCanMsg->uMsgInfo.Bits.ext, pCanMsg->dwMsgId) );
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Reads the first entry of the receive FIFO which passes the software
+///   filter. Dropped entries in front of it are removed from the FIFO
+///   without creating message objects.
+/// </summary>
+/// <param name="pEntry">
+///   Buffer which receives a copy of the entry. The buffer is large enough
+///   for CANMSG and CANMSG2 entries.
+/// </param>
+/// <returns>
+///   -1 if the software filter is disabled, 0 if no entry passed the
+///   filter or 1 if an entry is copied to <paramref name="pEntry"/>.
+/// </returns>
+//*****************************************************************************
+int CanMessageReader::ReadFiltered( PCANMSG2 pEntry )
+{
+  int iResult = 0;
+
+  m_pSwFilter->Lock();
+  try
+  {
+    CANIDSET* pSet = m_pSwFilter->GetSet();
+
+    if (nullptr == pSet)
+    {
+      iResult = -1;
+    }
+    else
+    {
+      UInt32 dwSize = EntrySize();
+      PUINT8 pbEntry;
+      UInt16 wCount;
+
+      while ((0 == iResult) &&
+             (m_pRxFifo->AcquireRead((PVOID*) &pbEntry, &wCount) == VCI_OK) && (wCount > 0))
+      {
+        UInt16 wUsed = 0;
+
+        while ((0 == iResult) && (wUsed < wCount))
+        {
+          if (Passes(pSet, pbEntry))
+          {
+            memcpy(pEntry, pbEntry, dwSize);
+            iResult = 1;
+          }
+          pbEntry += dwSize;
+          wUsed++;
+        }
+
+        m_pRxFifo->ReleaseRead(wUsed);
+        m_pSwFilter->Count(iResult, wUsed - iResult);
+      }
+    }
+  }
+  finally
+  {
+    m_pSwFilter->Unlock();
+  }
+
+  return( iResult );
+}
+
 //*****************************************************************************
 /// <summary>
 ///   This method reads a single CAN message from the front of the
@@ -355,6 +542,9 @@ void CanMessageReader::AssignEvent(ManualResetEvent^ fifoEvent)
 /// <returns>
 ///   true on success. false if no message is available to read.
 /// </returns>
+/// <remarks>
+///   If the software filter is enabled, dropped messages are skipped.
+/// </remarks>
 /// <exception cref="ObjectDisposedException">
 ///   Object is already disposed.
 /// </exception>
@@ -363,12 +553,35 @@ bool CanMessageReader::ReadMessage(ICanMessage^% message)
 {
   HRESULT       hResult;
   bool          fResult = false;
+  CANMSG2       sEntry;
+  int           iFiltered;
   
   if (nullptr == m_pRxFifo)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
 
+  iFiltered = ReadFiltered(&sEntry);
+  if (iFiltered >= 0)
+  {
+    if (iFiltered > 0)
+    {
+      if (m_isCanChannel2)
+      {
+        CanMessage2^ msg = gcnew CanMessage2();
+        msg->SetValue(*(mgdCANMSG2*)&sEntry);
+        message = msg;
+      }
+      else
+      {
+        CanMessage^ msg = gcnew CanMessage();
+        msg->SetValue(*(mgdCANMSG*)&sEntry);
+        message = msg;
+      }
+    }
+    return( iFiltered > 0 );
+  }
+
   if (m_isCanChannel2)
   {
     CanMessage2 msg;
@@ -407,6 +620,9 @@ bool CanMessageReader::ReadMessage(ICanMessage^% message)
 /// <returns>
 ///   true on success. false if no message is available to read.
 /// </returns>
+/// <remarks>
+///   If the software filter is enabled, dropped messages are skipped.
+/// </remarks>
 /// <exception cref="ObjectDisposedException">
 ///   Object is already disposed.
 /// </exception>
@@ -415,12 +631,35 @@ bool CanMessageReader::ReadMessage(ICanMessage2^% message)
 {
   HRESULT       hResult;
   bool          fResult = false;
+  CANMSG2       sEntry;
+  int           iFiltered;
   
   if (nullptr == m_pRxFifo)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
 
+  iFiltered = ReadFiltered(&sEntry);
+  if (iFiltered >= 0)
+  {
+    if (iFiltered > 0)
+    {
+      if (m_isCanChannel2)
+      {
+        CanMessage2^ msg = gcnew CanMessage2();
+        msg->SetValue(*(mgdCANMSG2*)&sEntry);
+        message = msg;
+      }
+      else
+      {
+        CanMessage^ msg = gcnew CanMessage();
+        msg->SetValue(*(mgdCANMSG*)&sEntry);
+        message = msg;
+      }
+    }
+    return( iFiltered > 0 );
+  }
+
   if (m_isCanChannel2)
   {
     CanMessage2 msg;
@@ -462,6 +701,11 @@ bool CanMessageReader::ReadMessage(ICanMessage2^% message)
 ///   The number of read messages if succeeded.
 ///   0 if no message is available to read.
 /// </returns>
+/// <remarks>
+///   If the software filter is enabled, dropped messages are removed from
+///   the FIFO without creating message objects. Blocks which contain
+///   dropped messages only are skipped.
+/// </remarks>
 /// <exception cref="ObjectDisposedException">
 ///   Object is already disposed.
 /// </exception>
@@ -469,40 +713,66 @@ bool CanMessageReader::ReadMessage(ICanMessage2^% message)
 int CanMessageReader::ReadMessages(array<ICanMessage^>^% messages)
 {
   UInt16  wCount = 0;
-  PCANMSG pCanMsg;
+  int     iCount = 0;
+  PUINT8  pbEntry;
 
   if (nullptr == m_pRxFifo)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
 
-  if (m_pRxFifo->AcquireRead((PVOID*) &pCanMsg, &wCount) == VCI_OK)
-  {
+  UInt32 dwSize = EntrySize();
 
-    messages = gcnew array< ICanMessage^ >(wCount);
+  m_pSwFilter->Lock();
+  try
+  {
+    CANIDSET* pSet = m_pSwFilter->GetSet();
 
-    for (UInt16 index = 0; index < wCount; index++)
+    while ((0 == iCount) && (m_pRxFifo->AcquireRead((PVOID*) &pbEntry, &wCount) == VCI_OK))
     {
-      if (m_isCanChannel2)
+      messages = gcnew array< ICanMessage^ >(wCount);
+
+      for (UInt16 index = 0; index < wCount; index++, pbEntry += dwSize)
       {
-        CanMessage2^ msg = gcnew CanMessage2();
-        msg->SetValue(*(mgdCANMSG2*)pCanMsg);
-        messages[index] = msg;
+        if ((nullptr != pSet) && !Passes(pSet, pbEntry))
+        {
+          continue;
+        }
+
+        if (m_isCanChannel2)
+        {
+          CanMessage2^ msg = gcnew CanMessage2();
+          msg->SetValue(*(mgdCANMSG2*)pbEntry);
+          messages[iCount++] = msg;
+        }
+        else
+        {
+          CanMessage^ msg = gcnew CanMessage();
+          msg->SetValue(*(mgdCANMSG*)pbEntry);
+          messages[iCount++] = msg;
+        }
       }
-      else
+
+      m_pRxFifo->ReleaseRead(wCount);
+
+      if ((nullptr == pSet) || (0 == wCount))
       {
-        CanMessage^ msg = gcnew CanMessage();
-        msg->SetValue(*(mgdCANMSG*)pCanMsg);
-        messages[index] = msg;
+        break;
       }
-
-      pCanMsg++;
+      m_pSwFilter->Count(iCount, wCount - iCount);
     }
+  }
+  finally
+  {
+    m_pSwFilter->Unlock();
+  }
 
-    m_pRxFifo->ReleaseRead(wCount);
+  if ((nullptr != messages) && (iCount < messages->Length))
+  {
+    Array::Resize<ICanMessage^>(messages, iCount);
   }
 
-  return( wCount );
+  return( iCount );
 }
 
 //*****************************************************************************
@@ -519,6 +789,11 @@ int CanMessageReader::ReadMessages(array<ICanMessage^>^% messages)
 ///   The number of read messages if succeeded.
 ///   0 if no message is available to read.
 /// </returns>
+/// <remarks>
+///   If the software filter is enabled, dropped messages are removed from
+///   the FIFO without creating message objects. Blocks which contain
+///   dropped messages only are skipped.
+/// </remarks>
 /// <exception cref="ObjectDisposedException">
 ///   Object is already disposed.
 /// </exception>
@@ -526,40 +801,66 @@ int CanMessageReader::ReadMessages(array<ICanMessage^>^% messages)
 int CanMessageReader::ReadMessages(array<ICanMessage2^>^% messages)
 {
   UInt16  wCount = 0;
-  PCANMSG2 pCanMsg;
+  int     iCount = 0;
+  PUINT8  pbEntry;
 
   if (nullptr == m_pRxFifo)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
 
-  if (m_pRxFifo->AcquireRead((PVOID*) &pCanMsg, &wCount) == VCI_OK)
+  UInt32 dwSize = EntrySize();
+
+  m_pSwFilter->Lock();
+  try
   {
+    CANIDSET* pSet = m_pSwFilter->GetSet();
 
-    messages = gcnew array< ICanMessage2^ >(wCount);
-    
-    for (UInt16 index = 0; index < wCount; index++)
+    while ((0 == iCount) && (m_pRxFifo->AcquireRead((PVOID*) &pbEntry, &wCount) == VCI_OK))
     {
-      if (m_isCanChannel2)
+      messages = gcnew array< ICanMessage2^ >(wCount);
+
+      for (UInt16 index = 0; index < wCount; index++, pbEntry += dwSize)
       {
-        CanMessage2^ msg = gcnew CanMessage2();
-        msg->SetValue(*(mgdCANMSG2*)pCanMsg);
-        messages[index] = msg;
+        if ((nullptr != pSet) && !Passes(pSet, pbEntry))
+        {
+          continue;
+        }
+
+        if (m_isCanChannel2)
+        {
+          CanMessage2^ msg = gcnew CanMessage2();
+          msg->SetValue(*(mgdCANMSG2*)pbEntry);
+          messages[iCount++] = msg;
+        }
+        else
+        {
+          CanMessage^ msg = gcnew CanMessage();
+          msg->SetValue(*(mgdCANMSG*)pbEntry);
+          messages[iCount++] = msg;
+        }
       }
-      else
+
+      m_pRxFifo->ReleaseRead(wCount);
+
+      if ((nullptr == pSet) || (0 == wCount))
       {
-        CanMessage^ msg = gcnew CanMessage();
-        msg->SetValue(*(mgdCANMSG*)pCanMsg);
-        messages[index] = msg;
+        break;
       }
-
-      pCanMsg++;
+      m_pSwFilter->Count(iCount, wCount - iCount);
     }
+  }
+  finally
+  {
+    m_pSwFilter->Unlock();
+  }
 
-    m_pRxFifo->ReleaseRead(wCount);
+  if ((nullptr != messages) && (iCount < messages->Length))
+  {
+    Array::Resize<ICanMessage2^>(messages, iCount);
   }
 
-  return( wCount );
+  return( iCount );
 }
 
 #pragma warning(default:4669) // 'type cast' : unsafe conversion
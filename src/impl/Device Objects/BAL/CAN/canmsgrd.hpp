@@ -10,6 +10,7 @@
 #include <vcisdk.h>
 #include "canmsg.hpp"
 #include "canmsg2.hpp"
+#include "canswflt.hpp"
 
 
 namespace Ixxat {
@@ -34,18 +35,25 @@ private ref class CanMessageReader : public ICanMessageReader
   private:
     bool          m_isCanChannel2;
     PFIFOREADER   m_pRxFifo; // pointer to the native receive FIFO
+    CanSoftwareFilter^ m_pSwFilter; // host side exact match filter
 
   //--------------------------------------------------------------------
   // member functions
   //--------------------------------------------------------------------
   private:
-    void Cleanup      ( void );
+    void   Cleanup      ( void );
+    UInt32 EntrySize    ( void );
+    bool   Passes       ( CANIDSET* pSet, PUINT8 pbEntry );
+    int    ReadFiltered ( PCANMSG2 pEntry );
 
   internal:
     CanMessageReader  ( ::ICanChannel*    pCanChan );
     CanMessageReader  ( ::ICanChannel2*   pCanChan );
     ~CanMessageReader ( );
 
+    PFIFOREADER GetNativeFifo ( void );
+    bool        IsCanMessage2 ( void );
+
   //--------------------------------------------------------------------
   // ICanMessageReader implementation
   //--------------------------------------------------------------------
@@ -54,9 +62,13 @@ private ref class CanMessageReader : public ICanMessageReader
     virtual property UInt16 FillCount { UInt16 get(void); };
     virtual property UInt16 Threshold { UInt16 get(void); 
                                         void   set(UInt16 threshold); };
+    virtual property ICanSoftwareFilter^ SoftwareFilter { ICanSoftwareFilter^ get(void); };
 
     virtual void Lock();
     virtual void Unlock();
+    virtual VciResult TrySetThreshold ( UInt16 threshold );
+    virtual VciResult TryLock         ( void );
+    virtual VciResult TryUnlock       ( void );
     virtual void AssignEvent ( AutoResetEvent^      fifoEvent );
     virtual void AssignEvent ( ManualResetEvent^    fifoEvent );
     virtual bool ReadMessage ( ICanMessage^%        message );
@@ -182,20 +182,34 @@ UInt16 CanMessageWriter::Threshold::get()
 //*****************************************************************************
 void CanMessageWriter::Threshold::set(UInt16 threshold)
 {
-  HRESULT hResult;
+  VciResult sResult = TrySetThreshold(threshold);
 
-  if (nullptr != m_pTxFifo)
+  if (!sResult.Succeeded)
   {
-    hResult = m_pTxFifo->SetThreshold(threshold);
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Sets the threshold for the trigger event of the transmit FIFO like
+///   <c>Threshold</c>, but reports a failure through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanMessageWriter::TrySetThreshold(UInt16 threshold)
+{
+  if (nullptr == m_pTxFifo)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pTxFifo->SetThreshold(threshold)) );
 }
 
 //*****************************************************************************
@@ -213,18 +227,34 @@ void CanMessageWriter::Threshold::set(UInt16 threshold)
 //*****************************************************************************
 void CanMessageWriter::Lock()
 {
-  if (nullptr != m_pTxFifo)
+  VciResult sResult = TryLock();
+
+  if (!sResult.Succeeded)
   {
-    HRESULT hResult = m_pTxFifo->Lock();
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Locks the access to the FIFO like <c>Lock</c>, but reports a
+///   failure through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanMessageWriter::TryLock()
+{
+  if (nullptr == m_pTxFifo)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pTxFifo->Lock()) );
 }
 
 //*****************************************************************************
@@ -241,18 +271,34 @@ void CanMessageWriter::Lock()
 /// </exception>//*****************************************************************************
 void CanMessageWriter::Unlock()
 {
-  if (nullptr != m_pTxFifo)
+  VciResult sResult = TryUnlock();
+
+  if (!sResult.Succeeded)
   {
-    HRESULT hResult = m_pTxFifo->Unlock();
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Releases the access to the FIFO like <c>Unlock</c>, but reports a
+///   failure through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanMessageWriter::TryUnlock()
+{
+  if (nullptr == m_pTxFifo)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pTxFifo->Unlock()) );
 }
 
 //*****************************************************************************
@@ -57,6 +57,9 @@ private ref class CanMessageWriter : public ICanMessageWriter
 
     virtual void Lock();
     virtual void Unlock();
+    virtual VciResult TrySetThreshold ( UInt16 threshold );
+    virtual VciResult TryLock         ( void );
+    virtual VciResult TryUnlock       ( void );
     virtual void AssignEvent ( AutoResetEvent^      fifoEvent );
     virtual void AssignEvent ( ManualResetEvent^    fifoEvent );
     virtual bool SendMessage ( ICanMessage^         message );
@@ -68,3 +71,7 @@ private ref class CanMessageWriter : public ICanMessageWriter
 } // end of namespace Bal
 } // end of namespace Vci4
 } // end of namespace Ixxat
+
+
+// converts a CanMessage or CanMessage2 into the native CANMSG2 layout
+Ixxat::Vci4::Bal::Can::mgdCANMSG2 ConvertToCANMSG2(System::Object^ message);
@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "canshd2.hpp"
+#include "canshdtr.hpp"
 #include "vcinet.hpp"
 
 
@@ -317,6 +318,9 @@ void CanCyclicTXMsg2::AutoIncrementIndex::set(Byte index)
 ///   Pointer to the native BAL object interface. 
 ///   This parameter must not be NULL.
 /// </param>
+/// <param name="deviceId">
+///   Unique hardware id of the device.
+/// </param>
 /// <param name="portNumber">
 ///   Port number of the bus socket to open.
 /// </param>
@@ -334,9 +338,10 @@ void CanCyclicTXMsg2::AutoIncrementIndex::set(Byte index)
 /// </exception>
 //*****************************************************************************
 CanScheduler2::CanScheduler2(::IBalObject*  pBalObj
+                          , Guid          deviceId
                           , Byte          portNumber
                           , Byte          busTypeIndex)
-            : CanSocket2(pBalObj, portNumber, busTypeIndex)
+            : CanSocket2(pBalObj, deviceId, portNumber, busTypeIndex)
 {
   HRESULT           hResult;
   ::ICanScheduler2*  pCanShd;
@@ -448,20 +453,34 @@ void CanScheduler2::Cleanup(void)
 //*****************************************************************************
 void CanScheduler2::Resume(void)
 {
-  HRESULT hResult;
+  VciResult sResult = TryResume();
 
-  if (nullptr != m_pCanShd)
+  if (!sResult.Succeeded)
   {
-    hResult = m_pCanShd->Resume();
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Resumes the scheduler like <c>Resume</c>, but reports a failure
+///   through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanScheduler2::TryResume(void)
+{
+  if (nullptr == m_pCanShd)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pCanShd->Resume()) );
 }
 
 //*****************************************************************************
@@ -478,20 +497,34 @@ void CanScheduler2::Resume(void)
 //*****************************************************************************
 void CanScheduler2::Suspend(void)
 {
-  HRESULT hResult;
+  VciResult sResult = TrySuspend();
 
-  if (nullptr != m_pCanShd)
+  if (!sResult.Succeeded)
   {
-    hResult = m_pCanShd->Suspend();
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Suspends the scheduler like <c>Suspend</c>, but reports a failure
+///   through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult CanScheduler2::TrySuspend(void)
+{
+  if (nullptr == m_pCanShd)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pCanShd->Suspend()) );
 }
 
 //*****************************************************************************
@@ -579,6 +612,85 @@ ICanCyclicTXMsg2^ CanScheduler2::AddMessage( void )
   return gcnew CanCyclicTXMsg2(this);
 }
 
+//*****************************************************************************
+/// <summary>
+///   This method creates an analyzer for the cyclic transmit messages
+///   currently registered at the scheduler.
+/// </summary>
+/// <returns>
+///   Reference to the analyzer.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+/// <exception cref="NotSupportedException">
+///   The socket does not provide the timer clock frequencies.
+/// </exception>
+//*****************************************************************************
+ICanCyclicAnalyzer^ CanScheduler2::CreateAnalyzer( void )
+{
+  if (nullptr == m_pCanShd)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  UInt32 dwTscFreq = TimeStampCounterClockFrequency;
+  UInt32 dwCmsFreq = CyclicMessageTimerClockFrequency;
+  if ((0 == dwTscFreq) || (0 == dwCmsFreq))
+  {
+    throw gcnew NotSupportedException();
+  }
+
+  CanCyclicAnalyzer^ pAnalyzer = gcnew CanCyclicAnalyzer(
+    (double) TimeStampCounterDivisor / dwTscFreq,
+    (double) CyclicMessageTimerDivisor / dwCmsFreq);
+
+  for (int i = 0; i < m_aCtxMsg->Length; i++)
+  {
+    if (nullptr != m_aCtxMsg[i])
+    {
+      pAnalyzer->AddMessage(m_aCtxMsg[i]);
+    }
+  }
+
+  return( pAnalyzer );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method creates a trace analyzer which derives cyclic transmit
+///   messages for this scheduler from recorded traffic.
+/// </summary>
+/// <returns>
+///   Reference to the trace analyzer.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+/// <exception cref="NotSupportedException">
+///   The socket does not provide the timer clock frequencies.
+/// </exception>
+//*****************************************************************************
+ICanTraceAnalyzer^ CanScheduler2::CreateTraceAnalyzer( void )
+{
+  if (nullptr == m_pCanShd)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  UInt32 dwTscFreq = TimeStampCounterClockFrequency;
+  UInt32 dwCmsFreq = CyclicMessageTimerClockFrequency;
+  if ((0 == dwTscFreq) || (0 == dwCmsFreq))
+  {
+    throw gcnew NotSupportedException();
+  }
+
+  return gcnew CanTraceAnalyzer( this
+                               , (double) TimeStampCounterDivisor / dwTscFreq
+                               , (double) CyclicMessageTimerDivisor / dwCmsFreq
+                               , MaxCyclicMessageTicks );
+}
+
 //*****************************************************************************
 /// <summary>
 ///   This method adds a new cyclic transmit message to the scheduler.
@@ -11,6 +11,7 @@
 #include "canshd2.hpp"
 #include "cansoc2.hpp"
 #include "canmsg2.hpp"
+#include "canshdan.hpp"
 
 
 namespace Ixxat {
@@ -759,6 +760,7 @@ private ref class CanScheduler2 : public CanSocket2
 
   internal:
     CanScheduler2    ( ::IBalObject* pBalObj
+                     , Guid          deviceId
                      , Byte          portNumber 
                      , Byte          busTypeIndex);
    ~CanScheduler2    ( void );
@@ -772,7 +774,11 @@ private ref class CanScheduler2 : public CanSocket2
     virtual void Resume      ( void );
     virtual void Reset       ( void );
     virtual void UpdateStatus( void );
+    virtual VciResult TrySuspend ( void );
+    virtual VciResult TryResume  ( void );
     virtual ICanCyclicTXMsg2^ AddMessage( void );
+    virtual ICanCyclicAnalyzer^ CreateAnalyzer( void );
+    virtual ICanTraceAnalyzer^  CreateTraceAnalyzer( void );
 
   internal:
     void InternalAddMessage( CanCyclicTXMsg2^ cyclicTXMessage );
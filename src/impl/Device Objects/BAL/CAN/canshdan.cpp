@@ -0,0 +1,379 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the cyclic message jitter and phase analyzer.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "canshdan.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+
+#pragma warning(disable:4669) // 'type cast' : unsafe conversion
+
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for cyclic message analyzer objects.
+/// </summary>
+/// <param name="dTickRes">
+///   Resolution of the receive timestamps in seconds
+///   (TimeStampCounterDivisor / TimeStampCounterClockFrequency).
+/// </param>
+/// <param name="dCycleRes">
+///   Resolution of the cycle ticks in seconds
+///   (CyclicMessageTimerDivisor / CyclicMessageTimerClockFrequency).
+/// </param>
+//*****************************************************************************
+CanCyclicAnalyzer::CanCyclicAnalyzer( double dTickRes
+                                    , double dCycleRes )
+{
+  m_dTickRes  = dTickRes;
+  m_dCycleRes = dCycleRes;
+  m_aKeys     = gcnew array<UInt32>(CYC_MAX_MSGS);
+  m_aStats    = gcnew array<CycStat>(CYC_MAX_MSGS);
+  m_pSync     = gcnew Object();
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of analyzed messages.
+/// </summary>
+//*****************************************************************************
+int CanCyclicAnalyzer::MessageCount::get()
+{
+  return( m_iCount );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method adds a cyclic transmit message to the set of analyzed
+///   messages. If the message is already analyzed its statistics are reset
+///   and the expected period is updated.
+/// </summary>
+/// <param name="message">
+///   The cyclic transmit message.
+/// </param>
+/// <exception cref="ArgumentNullException">
+///   Parameter message was a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   CycleTicks of the message is 0.
+/// </exception>
+/// <exception cref="IndexOutOfRangeException">
+///   The maximum number of analyzed messages is reached.
+/// </exception>
+//*****************************************************************************
+void CanCyclicAnalyzer::AddMessage(ICanCyclicTXMsg2^ message)
+{
+  if (nullptr == message)
+  {
+    throw gcnew ArgumentNullException("message");
+  }
+
+  if (0 == message->CycleTicks)
+  {
+    throw gcnew ArgumentOutOfRangeException("message", "CycleTicks");
+  }
+
+  UInt32 dwKey = message->Identifier | (message->ExtendedFrameFormat ? CYC_KEY_EXT : 0);
+
+  CycStat sStat;
+  sStat.dExpected = message->CycleTicks * m_dCycleRes;
+  sStat.dMin      = Double::MaxValue;
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    int i = Array::BinarySearch(m_aKeys, 0, m_iCount, dwKey);
+    if (i < 0)
+    {
+      if (m_iCount >= CYC_MAX_MSGS)
+      {
+        throw gcnew IndexOutOfRangeException();
+      }
+
+      // keep the keys sorted for the binary search in the receive path
+      i = ~i;
+      Array::Copy(m_aKeys,  i, m_aKeys,  i + 1, m_iCount - i);
+      Array::Copy(m_aStats, i, m_aStats, i + 1, m_iCount - i);
+      m_aKeys[i] = dwKey;
+      m_iCount++;
+    }
+
+    m_aStats[i] = sStat;
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Updates the statistics of the specified message with a new frame.
+///   The caller must hold the statistics lock.
+/// </summary>
+/// <param name="dwKey">
+///   Lookup key of the frame (identifier | CYC_KEY_EXT).
+/// </param>
+/// <param name="dwTime">
+///   Receive timestamp of the frame in ticks.
+/// </param>
+//*****************************************************************************
+void CanCyclicAnalyzer::Update(UInt32 dwKey, UInt32 dwTime)
+{
+  int i = Array::BinarySearch(m_aKeys, 0, m_iCount, dwKey);
+  if (i < 0)
+  {
+    return;
+  }
+
+  interior_ptr<CycStat> pStat = &m_aStats[i];
+
+  if (0 == pStat->qwFrames++)
+  {
+    pStat->dwLastTime = dwTime;
+    return;
+  }
+
+  // unsigned difference handles the wrap around of the 32-bit counter
+  double dPeriod = (UInt32) (dwTime - pStat->dwLastTime) * m_dTickRes;
+  pStat->dwLastTime = dwTime;
+  pStat->dElapsed  += dPeriod;
+
+  Int64 qwCycles = (Int64) Math::Floor(dPeriod / pStat->dExpected + 0.5);
+  if (qwCycles < 1)
+  {
+    qwCycles = 1;
+  }
+  pStat->qwCycles += qwCycles;
+
+  if (qwCycles > 1)
+  {
+    // intervals containing lost frames would distort the period statistics
+    pStat->qwMissed += qwCycles - 1;
+    return;
+  }
+
+  // Welford's online algorithm
+  pStat->qwSamples++;
+  double dDelta = dPeriod - pStat->dMean;
+  pStat->dMean += dDelta / pStat->qwSamples;
+  pStat->dM2   += dDelta * (dPeriod - pStat->dMean);
+
+  if (dPeriod < pStat->dMin)
+    pStat->dMin = dPeriod;
+  if (dPeriod > pStat->dMax)
+    pStat->dMax = dPeriod;
+
+  double dDev = Math::Abs(dPeriod - pStat->dExpected);
+  if (dDev > pStat->dMaxDev)
+    pStat->dMaxDev = dDev;
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method processes a single received frame.
+/// </summary>
+/// <param name="message">
+///   The received frame.
+/// </param>
+/// <exception cref="ArgumentNullException">
+///   Parameter message was a null reference.
+/// </exception>
+//*****************************************************************************
+void CanCyclicAnalyzer::Process(ICanMessage2^ message)
+{
+  if (nullptr == message)
+  {
+    throw gcnew ArgumentNullException("message");
+  }
+
+  if (CanMsgFrameType::Data == message->FrameType)
+  {
+    UInt32 dwKey = message->Identifier | (message->ExtendedFrameFormat ? CYC_KEY_EXT : 0);
+
+    Monitor::Enter(m_pSync);
+    try
+    {
+      Update(dwKey, message->TimeStamp);
+    }
+    finally
+    {
+      Monitor::Exit(m_pSync);
+    }
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method reads all frames currently available from the specified
+///   reader and processes them. Readers of this library are read directly
+///   from the native FIFO memory without creating managed message objects.
+/// </summary>
+/// <param name="reader">
+///   The message reader to read from.
+/// </param>
+/// <returns>
+///   The number of frames read.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   Parameter reader was a null reference.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   The reader is already disposed.
+/// </exception>
+//*****************************************************************************
+int CanCyclicAnalyzer::Process(ICanMessageReader^ reader)
+{
+  int iResult = 0;
+
+  if (nullptr == reader)
+  {
+    throw gcnew ArgumentNullException("reader");
+  }
+
+  CanMessageReader^ pReader = dynamic_cast<CanMessageReader^>(reader);
+  if (nullptr != pReader)
+  {
+    PFIFOREADER pRxFifo = pReader->GetNativeFifo();
+    if (nullptr == pRxFifo)
+    {
+      throw gcnew ObjectDisposedException(reader->GetType()->FullName);
+    }
+
+    bool fCanMsg2 = pReader->IsCanMessage2();
+
+    Monitor::Enter(m_pSync);
+    try
+    {
+      PVOID  pvEntry;
+      UInt16 wCount;
+
+      while ((VCI_OK == pRxFifo->AcquireRead(&pvEntry, &wCount)) && (wCount > 0))
+      {
+        if (fCanMsg2)
+        {
+          PCANMSG2 pCanMsg = (PCANMSG2) pvEntry;
+          for (UInt16 i = 0; i < wCount; i++, pCanMsg++)
+          {
+            if (CAN_MSGTYPE_DATA == pCanMsg->uMsgInfo.Bytes.bType)
+            {
+              Update(pCanMsg->dwMsgId | (pCanMsg->uMsgInfo.Bits.ext ? CYC_KEY_EXT : 0), pCanMsg->dwTime);
+            }
+          }
+        }
+        else
+        {
+          PCANMSG pCanMsg = (PCANMSG) pvEntry;
+          for (UInt16 i = 0; i < wCount; i++, pCanMsg++)
+          {
+            if (CAN_MSGTYPE_DATA == pCanMsg->uMsgInfo.Bytes.bType)
+            {
+              Update(pCanMsg->dwMsgId | (pCanMsg->uMsgInfo.Bits.ext ? CYC_KEY_EXT : 0), pCanMsg->dwTime);
+            }
+          }
+        }
+
+        pRxFifo->ReleaseRead(wCount);
+        iResult += wCount;
+      }
+    }
+    finally
+    {
+      Monitor::Exit(m_pSync);
+      pRxFifo->Release();
+    }
+  }
+  else
+  {
+    ICanMessage2^ message;
+    while (reader->ReadMessage(message))
+    {
+      Process(message);
+      iResult++;
+    }
+  }
+
+  return( iResult );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method returns the current statistics of all analyzed messages.
+/// </summary>
+/// <returns>
+///   Array with one entry per analyzed message.
+/// </returns>
+//*****************************************************************************
+array<CanCyclicStatistics>^ CanCyclicAnalyzer::GetStatistics(void)
+{
+  array<CanCyclicStatistics>^ aResult;
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    aResult = gcnew array<CanCyclicStatistics>(m_iCount);
+
+    for (int i = 0; i < m_iCount; i++)
+    {
+      CycStat sStat = m_aStats[i];
+
+      double dStdDev = (sStat.qwSamples > 1)
+                     ? Math::Sqrt(sStat.dM2 / (sStat.qwSamples - 1))
+                     : 0.0;
+      double dMin    = (sStat.qwSamples > 0) ? sStat.dMin : 0.0;
+      double dDrift  = sStat.dElapsed - sStat.qwCycles * sStat.dExpected;
+
+      TimeSpan tsExpected = TimeSpan::FromTicks(
+        (Int64) (sStat.dExpected * TimeSpan::TicksPerSecond + 0.5));
+
+      aResult[i] = CanCyclicStatistics( m_aKeys[i] & ~CYC_KEY_EXT
+                                      , (m_aKeys[i] & CYC_KEY_EXT) != 0
+                                      , tsExpected
+                                      , sStat.qwFrames
+                                      , sStat.qwMissed
+                                      , sStat.dMean
+                                      , dMin
+                                      , sStat.dMax
+                                      , dStdDev
+                                      , sStat.dMaxDev
+                                      , dDrift );
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+
+  return( aResult );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method resets the statistics of all analyzed messages.
+/// </summary>
+//*****************************************************************************
+void CanCyclicAnalyzer::Reset(void)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    for (int i = 0; i < m_iCount; i++)
+    {
+      CycStat sStat;
+      sStat.dExpected = m_aStats[i].dExpected;
+      sStat.dMin      = Double::MaxValue;
+      m_aStats[i]     = sStat;
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+
+#pragma warning(default:4669) // 'type cast' : unsafe conversion
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the cyclic message jitter and phase analyzer.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+#include "canmsgrd.hpp"
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+
+// maximum number of messages per analyzer
+#define CYC_MAX_MSGS          256
+
+// flag within the lookup key which marks extended frames
+#define CYC_KEY_EXT           0x80000000
+
+
+//*****************************************************************************
+/// <summary>
+///   Streaming statistics of a single periodic message.
+/// </summary>
+//*****************************************************************************
+private value struct CycStat
+{
+  double  dExpected;  // expected period in seconds
+  UInt32  dwLastTime; // timestamp of the last frame in ticks
+  Int64   qwFrames;   // number of observed frames
+  Int64   qwMissed;   // number of missed cycles
+  Int64   qwCycles;   // number of elapsed cycles since the first frame
+  Int64   qwSamples;  // number of period samples
+  double  dElapsed;   // time since the first frame in seconds
+  double  dMean;      // running mean of the period
+  double  dM2;        // running sum of squared differences (Welford)
+  double  dMin;       // minimum period
+  double  dMax;       // maximum period
+  double  dMaxDev;    // maximum deviation from the expected period
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   This class implements the cyclic message jitter and phase analyzer.
+/// </summary>
+//*****************************************************************************
+private ref class CanCyclicAnalyzer : public ICanCyclicAnalyzer
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    array<UInt32>^  m_aKeys;     // sorted lookup keys (identifier | CYC_KEY_EXT)
+    array<CycStat>^ m_aStats;    // statistics, parallel to m_aKeys
+    int             m_iCount;    // number of analyzed messages
+    double          m_dTickRes;  // resolution of receive timestamps in seconds
+    double          m_dCycleRes; // resolution of cycle ticks in seconds
+    Object^         m_pSync;     // guards the statistics
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    void Update ( UInt32 dwKey, UInt32 dwTime );
+
+  internal:
+    CanCyclicAnalyzer ( double dTickRes
+                      , double dCycleRes );
+
+  //--------------------------------------------------------------------
+  // ICanCyclicAnalyzer implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual property int MessageCount { int get(void); };
+
+    virtual void AddMessage ( ICanCyclicTXMsg2^  message );
+    virtual void Process    ( ICanMessage2^      message );
+    virtual int  Process    ( ICanMessageReader^ reader );
+    virtual array<CanCyclicStatistics>^ GetStatistics ( void );
+    virtual void Reset      ( void );
+};
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
@@ -0,0 +1,457 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the trace analyzer which derives a cyclic
+//            scheduler setup from recorded CAN traffic.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "canshdtr.hpp"
+#include "canshd2.hpp"
+#include "canmsgwr.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+
+#pragma warning(disable:4669) // 'type cast' : unsafe conversion
+
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for trace analyzer objects.
+/// </summary>
+/// <param name="pScheduler">
+///   Scheduler the cyclic transmit messages are created for.
+/// </param>
+/// <param name="dTickRes">
+///   Resolution of the receive timestamps in seconds.
+/// </param>
+/// <param name="dCycleRes">
+///   Resolution of the cycle ticks in seconds.
+/// </param>
+/// <param name="dwMaxTicks">
+///   Maximum number of cycle ticks supported by the scheduler.
+/// </param>
+//*****************************************************************************
+CanTraceAnalyzer::CanTraceAnalyzer( CanScheduler2^ pScheduler
+                                  , double         dTickRes
+                                  , double         dCycleRes
+                                  , UInt32         dwMaxTicks )
+{
+  m_pScheduler = pScheduler;
+  m_dTickRes   = dTickRes;
+  m_dCycleRes  = dCycleRes;
+  m_dwMaxTicks = ((0 == dwMaxTicks) || (dwMaxTicks > UInt16::MaxValue))
+               ? UInt16::MaxValue : dwMaxTicks;
+  m_iMinFrames = 5;
+  m_dMaxDisp   = 0.1;
+  m_pEntries   = gcnew Dictionary<UInt32, CanTraceEntry^>();
+  m_pSync      = gcnew Object();
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets or sets the minimum number of frames of a periodic identifier.
+/// </summary>
+//*****************************************************************************
+int CanTraceAnalyzer::MinimumFrames::get()
+{
+  return( m_iMinFrames );
+}
+
+void CanTraceAnalyzer::MinimumFrames::set(int value)
+{
+  if (value < 3)
+  {
+    throw gcnew ArgumentOutOfRangeException("value");
+  }
+  m_iMinFrames = value;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets or sets the maximum relative dispersion of a periodic identifier.
+/// </summary>
+//*****************************************************************************
+double CanTraceAnalyzer::MaximumDispersion::get()
+{
+  return( m_dMaxDisp );
+}
+
+void CanTraceAnalyzer::MaximumDispersion::set(double value)
+{
+  if (!(value > 0.0))
+  {
+    throw gcnew ArgumentOutOfRangeException("value");
+  }
+  m_dMaxDisp = value;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Updates the observation data of the identifier of the specified frame.
+///   The caller must hold the entry lock.
+/// </summary>
+/// <param name="pCanMsg">
+///   The observed frame.
+/// </param>
+//*****************************************************************************
+void CanTraceAnalyzer::Update(PCANMSG2 pCanMsg)
+{
+  if (CAN_MSGTYPE_DATA != pCanMsg->uMsgInfo.Bytes.bType)
+  {
+    return;
+  }
+
+  UInt32 dwKey = pCanMsg->dwMsgId | (pCanMsg->uMsgInfo.Bits.ext ? TRC_KEY_EXT : 0);
+
+  CanTraceEntry^ pEntry;
+  if (!m_pEntries->TryGetValue(dwKey, pEntry))
+  {
+    pEntry = gcnew CanTraceEntry();
+    m_pEntries->Add(dwKey, pEntry);
+  }
+
+  if (pEntry->qwFrames++ > 0)
+  {
+    // unsigned difference handles the wrap around of the 32-bit counter
+    pEntry->aIntervals[pEntry->iNext] = (UInt32) (pCanMsg->dwTime - pEntry->dwLastTime) * m_dTickRes;
+    pEntry->iNext = (pEntry->iNext + 1) % TRC_MAX_INTERVALS;
+    if (pEntry->iFill < TRC_MAX_INTERVALS)
+    {
+      pEntry->iFill++;
+    }
+  }
+
+  pEntry->dwLastTime = pCanMsg->dwTime;
+
+  pin_ptr<mgdCANMSG2> pLast = &pEntry->sLastMsg;
+  *(PCANMSG2) pLast = *pCanMsg;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Estimates the cycle time of an identifier. The estimation starts with
+///   the median of the observed intervals, which is not affected by single
+///   late or lost frames. The median absolute deviation (MAD) decides
+///   whether the identifier is periodic. The final period is the mean of
+///   all intervals within three MAD of the median.
+/// </summary>
+/// <param name="pEntry">
+///   Observation data of the identifier.
+/// </param>
+/// <param name="dPeriod">
+///   Receives the estimated period in seconds.
+/// </param>
+/// <param name="dDisp">
+///   Receives the MAD relative to the median.
+/// </param>
+/// <returns>
+///   true if the identifier is periodic, otherwise false.
+/// </returns>
+//*****************************************************************************
+bool CanTraceAnalyzer::Estimate( CanTraceEntry^ pEntry
+                               , double%        dPeriod
+                               , double%        dDisp )
+{
+  if ((pEntry->qwFrames < m_iMinFrames) || (pEntry->iFill < 2))
+  {
+    return( false );
+  }
+
+  int           iCount = pEntry->iFill;
+  array<double>^ aSort = gcnew array<double>(iCount);
+  Array::Copy(pEntry->aIntervals, aSort, iCount);
+  Array::Sort(aSort);
+
+  double dMedian = (iCount & 1) ? aSort[iCount / 2]
+                                : (aSort[iCount / 2 - 1] + aSort[iCount / 2]) / 2;
+  if (!(dMedian > 0.0))
+  {
+    return( false );
+  }
+
+  for (int i = 0; i < iCount; i++)
+  {
+    aSort[i] = Math::Abs(aSort[i] - dMedian);
+  }
+  Array::Sort(aSort);
+
+  double dMad = (iCount & 1) ? aSort[iCount / 2]
+                             : (aSort[iCount / 2 - 1] + aSort[iCount / 2]) / 2;
+
+  dDisp = dMad / dMedian;
+  if (dDisp > m_dMaxDisp)
+  {
+    return( false );
+  }
+
+  // refine by the mean of the inliers, at least +-1% around the median
+  double dLimit = Math::Max(3 * dMad, 0.01 * dMedian);
+  double dSum   = 0;
+  int    iUsed  = 0;
+  for (int i = 0; i < iCount; i++)
+  {
+    double dValue = pEntry->aIntervals[i];
+    if (Math::Abs(dValue - dMedian) <= dLimit)
+    {
+      dSum += dValue;
+      iUsed++;
+    }
+  }
+
+  dPeriod = (iUsed > 0) ? dSum / iUsed : dMedian;
+  return( true );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Returns the keys of all observed identifiers in ascending order.
+///   The caller must hold the entry lock.
+/// </summary>
+//*****************************************************************************
+array<UInt32>^ CanTraceAnalyzer::SortedKeys(void)
+{
+  array<UInt32>^ aKeys = gcnew array<UInt32>(m_pEntries->Count);
+  m_pEntries->Keys->CopyTo(aKeys, 0);
+  Array::Sort(aKeys);
+  return( aKeys );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method processes a single frame of the trace.
+/// </summary>
+/// <param name="message">
+///   The frame to process.
+/// </param>
+/// <exception cref="ArgumentNullException">
+///   Parameter message was a null reference.
+/// </exception>
+//*****************************************************************************
+void CanTraceAnalyzer::Process(ICanMessage2^ message)
+{
+  if (nullptr == message)
+  {
+    throw gcnew ArgumentNullException("message");
+  }
+
+  mgdCANMSG2 msg = ConvertToCANMSG2(message);
+  pin_ptr<mgdCANMSG2> pCanMsg = &msg;
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    Update((PCANMSG2) pCanMsg);
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method reads all frames currently available from the specified
+///   reader and processes them.
+/// </summary>
+/// <param name="reader">
+///   The message reader to read from.
+/// </param>
+/// <returns>
+///   The number of frames read.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   Parameter reader was a null reference.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   The reader is already disposed.
+/// </exception>
+//*****************************************************************************
+int CanTraceAnalyzer::Process(ICanMessageReader^ reader)
+{
+  int iResult = 0;
+
+  if (nullptr == reader)
+  {
+    throw gcnew ArgumentNullException("reader");
+  }
+
+  CanMessageReader^ pReader = dynamic_cast<CanMessageReader^>(reader);
+  if ((nullptr != pReader) && pReader->IsCanMessage2())
+  {
+    PFIFOREADER pRxFifo = pReader->GetNativeFifo();
+    if (nullptr == pRxFifo)
+    {
+      throw gcnew ObjectDisposedException(reader->GetType()->FullName);
+    }
+
+    Monitor::Enter(m_pSync);
+    try
+    {
+      PVOID  pvEntry;
+      UInt16 wCount;
+
+      while ((VCI_OK == pRxFifo->AcquireRead(&pvEntry, &wCount)) && (wCount > 0))
+      {
+        PCANMSG2 pCanMsg = (PCANMSG2) pvEntry;
+        for (UInt16 i = 0; i < wCount; i++)
+        {
+          Update(pCanMsg++);
+        }
+
+        pRxFifo->ReleaseRead(wCount);
+        iResult += wCount;
+      }
+    }
+    finally
+    {
+      Monitor::Exit(m_pSync);
+      pRxFifo->Release();
+    }
+  }
+  else
+  {
+    ICanMessage2^ message;
+    while (reader->ReadMessage(message))
+    {
+      Process(message);
+      iResult++;
+    }
+  }
+
+  return( iResult );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method returns the periodic messages detected so far.
+/// </summary>
+/// <returns>
+///   Array of detected periodic messages ordered by identifier.
+/// </returns>
+//*****************************************************************************
+array<CanPeriodicFrame>^ CanTraceAnalyzer::GetPeriodicFrames(void)
+{
+  List<CanPeriodicFrame>^ pResult = gcnew List<CanPeriodicFrame>();
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    for each (UInt32 dwKey in SortedKeys())
+    {
+      CanTraceEntry^ pEntry = m_pEntries[dwKey];
+      double         dPeriod;
+      double         dDisp;
+
+      if (Estimate(pEntry, dPeriod, dDisp))
+      {
+        double dTicks   = Math::Round(dPeriod / m_dCycleRes);
+        bool   fClamped = (dTicks < 1) || (dTicks > m_dwMaxTicks);
+        UInt16 wTicks   = (UInt16) Math::Max(1.0, Math::Min(dTicks, (double) m_dwMaxTicks));
+
+        pResult->Add(CanPeriodicFrame( dwKey & ~TRC_KEY_EXT
+                                     , (dwKey & TRC_KEY_EXT) != 0
+                                     , pEntry->qwFrames
+                                     , TimeSpan::FromTicks((Int64) (dPeriod * TimeSpan::TicksPerSecond + 0.5))
+                                     , dDisp
+                                     , wTicks
+                                     , fClamped ));
+      }
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+
+  return( pResult->ToArray() );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method creates one cyclic transmit message per detected periodic
+///   message. The payload of the last observed frame is taken over.
+/// </summary>
+/// <returns>
+///   Array of cyclic transmit messages.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   The scheduler is already disposed.
+/// </exception>
+//*****************************************************************************
+array<ICanCyclicTXMsg2^>^ CanTraceAnalyzer::CreateMessages(void)
+{
+  // the capability getters throw ObjectDisposedException if the
+  // scheduler is already disposed
+  if (0 == m_pScheduler->MaxCyclicMessageTicks)
+  {
+    throw gcnew NotSupportedException();
+  }
+
+  array<ICanCyclicTXMsg2^>^   aResult;
+
+  // the monitor is reentrant, detecting the frames and reading the last
+  // messages in one locked section keeps Reset from removing entries
+  // in between
+  Monitor::Enter(m_pSync);
+  try
+  {
+    array<CanPeriodicFrame>^ aFrames = GetPeriodicFrames();
+
+    aResult = gcnew array<ICanCyclicTXMsg2^>(aFrames->Length);
+    for (int i = 0; i < aFrames->Length; i++)
+    {
+      UInt32 dwKey = aFrames[i].Identifier | (aFrames[i].ExtendedFrameFormat ? TRC_KEY_EXT : 0);
+      CanTraceEntry^   pEntry = m_pEntries[dwKey];
+      CanCyclicTXMsg2^ pMsg   = gcnew CanCyclicTXMsg2(m_pScheduler);
+
+      pin_ptr<mgdCANCYCLICTXMSG2> pDst = &pMsg->m_CanMsg;
+      pin_ptr<mgdCANMSG2>         pSrc = &pEntry->sLastMsg;
+      PCANCYCLICTXMSG2 pCtxMsg = (PCANCYCLICTXMSG2) pDst;
+      PCANMSG2         pCanMsg = (PCANMSG2) pSrc;
+
+      // take over the frame format, but none of the receive status bits
+      pCtxMsg->wCycleTime           = aFrames[i].CycleTicks;
+      pCtxMsg->bIncrMode            = CAN_CTXMSG_INC_NO;
+      pCtxMsg->bByteIndex           = 0;
+      pCtxMsg->dwMsgId              = pCanMsg->dwMsgId;
+      pCtxMsg->uMsgInfo.Bytes.bType = CAN_MSGTYPE_DATA;
+      pCtxMsg->uMsgInfo.Bits.dlc    = pCanMsg->uMsgInfo.Bits.dlc;
+      pCtxMsg->uMsgInfo.Bits.rtr    = pCanMsg->uMsgInfo.Bits.rtr;
+      pCtxMsg->uMsgInfo.Bits.ext    = pCanMsg->uMsgInfo.Bits.ext;
+      pCtxMsg->uMsgInfo.Bits.edl    = pCanMsg->uMsgInfo.Bits.edl;
+      pCtxMsg->uMsgInfo.Bits.fdr    = pCanMsg->uMsgInfo.Bits.fdr;
+      memcpy(pCtxMsg->abData, pCanMsg->abData, sizeof(pCtxMsg->abData));
+
+      aResult[i] = pMsg;
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+
+  return( aResult );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method discards all collected data.
+/// </summary>
+//*****************************************************************************
+void CanTraceAnalyzer::Reset(void)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    m_pEntries->Clear();
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+
+#pragma warning(default:4669) // 'type cast' : unsafe conversion
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the trace analyzer which derives a cyclic
+//            scheduler setup from recorded CAN traffic.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+#include "canmsgrd.hpp"
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+using namespace System::Collections::Generic;
+
+
+// number of intervals per identifier used for the estimation
+#define TRC_MAX_INTERVALS     64
+
+// flag within the lookup key which marks extended frames
+#define TRC_KEY_EXT           0x80000000
+
+
+// forward decls
+ref class CanScheduler2;
+
+
+//*****************************************************************************
+/// <summary>
+///   Observation data of a single identifier. The memory per identifier
+///   is bounded by the interval ring buffer.
+/// </summary>
+//*****************************************************************************
+private ref class CanTraceEntry
+{
+  internal:
+    Int64           qwFrames;    // number of observed frames
+    UInt32          dwLastTime;  // timestamp of the last frame in ticks
+    array<double>^  aIntervals;  // ring buffer of the last intervals in seconds
+    int             iNext;       // next write position within aIntervals
+    int             iFill;       // number of valid intervals
+    mgdCANMSG2      sLastMsg;    // last observed frame
+
+    CanTraceEntry()
+    {
+      aIntervals = gcnew array<double>(TRC_MAX_INTERVALS);
+    }
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   This class implements the trace analyzer.
+/// </summary>
+//*****************************************************************************
+private ref class CanTraceAnalyzer : public ICanTraceAnalyzer
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    CanScheduler2^                      m_pScheduler; // scheduler to create messages for
+    Dictionary<UInt32, CanTraceEntry^>^ m_pEntries;   // observed identifiers
+    double                              m_dTickRes;   // resolution of timestamps in seconds
+    double                              m_dCycleRes;  // resolution of cycle ticks in seconds
+    UInt32                              m_dwMaxTicks; // maximum number of cycle ticks
+    int                                 m_iMinFrames; // minimum number of frames
+    double                              m_dMaxDisp;   // maximum relative dispersion
+    Object^                             m_pSync;      // guards the entries
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    void Update   ( PCANMSG2 pCanMsg );
+    bool Estimate ( CanTraceEntry^ pEntry
+                  , double%        dPeriod
+                  , double%        dDisp );
+    array<UInt32>^ SortedKeys ( void );
+
+  internal:
+    CanTraceAnalyzer ( CanScheduler2^ pScheduler
+                     , double         dTickRes
+                     , double         dCycleRes
+                     , UInt32         dwMaxTicks );
+
+  //--------------------------------------------------------------------
+  // ICanTraceAnalyzer implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual property int    MinimumFrames     { int    get(void);
+                                                void   set(int value); };
+    virtual property double MaximumDispersion { double get(void);
+                                                void   set(double value); };
+
+    virtual void Process ( ICanMessage2^      message );
+    virtual int  Process ( ICanMessageReader^ reader );
+    virtual array<CanPeriodicFrame>^ GetPeriodicFrames ( void );
+    virtual array<ICanCyclicTXMsg2^>^ CreateMessages   ( void );
+    virtual void Reset   ( void );
+};
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
@@ -7,6 +7,7 @@
 
 #include "cansoc.hpp"
 #include "vcinet.hpp"
+#include "..\balpool.hpp"
 
 using namespace Ixxat::Vci4::Bal::Can;
 
@@ -49,9 +50,11 @@ CanSocket::CanSocket( ::IBalObject* pBalObj
 
   if (nullptr != pBalObj)
   {
-    hResult = pBalObj->OpenSocket( portNumber
-                                 , IID_ICanSocket
-                                 , (PVOID*) &pSocket);
+    // shared with the other sockets of the port if pooling is enabled
+    hResult = BalSocketPool::OpenSocket( pBalObj
+                                       , portNumber
+                                       , IID_ICanSocket
+                                       , (PVOID*) &pSocket);
     if (hResult == VCI_OK)
     {
       try
@@ -7,6 +7,7 @@
 
 #include "cansoc2.hpp"
 #include "vcinet.hpp"
+#include "..\balpool.hpp"
 
 using namespace Ixxat::Vci4::Bal::Can;
 
@@ -20,6 +21,9 @@ using namespace Ixxat::Vci4::Bal::Can;
 ///   Pointer to the native BAL object interface. 
 ///   This parameter must not be NULL.
 /// </param>
+/// <param name="deviceId">
+///   Unique hardware id of the device.
+/// </param>
 /// <param name="portNumber">
 ///   Port number of the bus socket to open.
 /// </param>
@@ -37,6 +41,7 @@ using namespace Ixxat::Vci4::Bal::Can;
 /// </exception>
 //*****************************************************************************
 CanSocket2::CanSocket2( ::IBalObject* pBalObj
+                    , Guid          deviceId
                     , Byte          portNumber
                     , Byte          busTypeIndex)
          : BalResource(portNumber, VciBusType::Can, busTypeIndex)
@@ -46,17 +51,20 @@ CanSocket2::CanSocket2( ::IBalObject* pBalObj
 
   m_pSocket   = nullptr;
   m_psCanCap  = nullptr;
+  m_pTimeCnv  = nullptr;
 
   if (nullptr != pBalObj)
   {
-    hResult = pBalObj->OpenSocket( portNumber
-                                 , IID_ICanSocket2
-                                 , (PVOID*) &pSocket);
+    // shared with the other sockets of the port if pooling is enabled
+    hResult = BalSocketPool::OpenSocket( pBalObj
+                                       , portNumber
+                                       , IID_ICanSocket2
+                                       , (PVOID*) &pSocket);
     if (hResult == VCI_OK)
     {
       try
       {
-        hResult = InitNew(pSocket);
+        hResult = InitNew(pSocket, deviceId, portNumber);
       }
       finally
       {
@@ -93,6 +101,12 @@ CanSocket2::~CanSocket2()
 ///   Pointer to the native CAN socket object.
 ///   This parameter must not be NULL.
 /// </param>
+/// <param name="deviceId">
+///   Unique hardware id of the device.
+/// </param>
+/// <param name="portNumber">
+///   Port number of the socket.
+/// </param>
 /// <returns>
 ///   VCI_OK if succeeded, otherwise a VCI error code.
 /// </returns>
@@ -100,25 +114,24 @@ CanSocket2::~CanSocket2()
 ///   Memory allocation failed.
 /// </exception>
 //*****************************************************************************
-HRESULT CanSocket2::InitNew(::ICanSocket2* pSocket)
+HRESULT CanSocket2::InitNew( ::ICanSocket2* pSocket
+                           , Guid           deviceId
+                           , Byte           portNumber )
 {
-  HRESULT hResult;
+  HRESULT                  hResult;
+  const CANCAPABILITIES2*  psCanCap;
 
   Cleanup();
 
   if (nullptr != pSocket)
   {
-    // We have to dynamically allocate the native struct because
-    // native structs are no longer valid as member of managed classes !!
-    m_psCanCap = new CANCAPABILITIES2;
-    if (nullptr == m_psCanCap)
-    {
-      throw gcnew InsufficientMemoryException();
-    }
-
-    hResult = pSocket->GetCapabilities(m_psCanCap);
+    // The capabilities of a controller never change, so all sockets
+    // of the controller share the snapshot of the capability cache.
+    hResult = CanCapabilityCache::Get(deviceId, portNumber, pSocket, &psCanCap);
     if (hResult == VCI_OK)
     {
+      m_psCanCap = psCanCap;
+      m_pTimeCnv = gcnew CanTimeConverter(*psCanCap);
       m_pSocket = pSocket;
       m_pSocket->AddRef();
     }
@@ -145,11 +158,9 @@ void CanSocket2::Cleanup(void)
     m_pSocket = nullptr;
   }
 
-  if (nullptr != m_psCanCap)
-  {
-    delete m_psCanCap;
-    m_psCanCap = nullptr;
-  }
+  // the capabilities are owned by the capability cache
+  m_psCanCap = nullptr;
+  m_pTimeCnv = nullptr;
 }
 
 //*****************************************************************************
@@ -932,6 +943,27 @@ UInt32 CanSocket2::MaxDelayedTXTicks::get()
   return( m_psCanCap->dwDtxMaxTicks );
 }
 
+//*****************************************************************************
+/// <summary>
+///   Gets the converter for the timer ticks of the CAN controller.
+/// </summary>
+/// <returns>
+///   The tick converter of the socket.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+ICanTimeConverter^ CanSocket2::TimeConverter::get()
+{
+  if (nullptr == m_pTimeCnv)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  return( m_pTimeCnv );
+}
+
 //*****************************************************************************
 /// <summary>
 ///   Gets the current status of the CAN line.
@@ -959,19 +991,7 @@ CanLineStatus2 CanSocket2::LineStatus::get()
       throw gcnew VciException(VciServerImpl::Instance(), hResult);
     }
 
-    return CanLineStatus2((CanOperatingModes)sStatus.bOpMode, (CanExtendedOperatingModes)sStatus.bExMode, sStatus.bBusLoad, (CanCtrlStatus)sStatus.dwStatus, 
-      CanBitrate2((CanBitrateMode)sStatus.sBtpSdr.dwMode, 
-                  sStatus.sBtpSdr.dwBPS,
-                  sStatus.sBtpSdr.wTS1,
-                  sStatus.sBtpSdr.wTS2,
-                  sStatus.sBtpSdr.wSJW,
-                  sStatus.sBtpSdr.wTDO),
-      CanBitrate2((CanBitrateMode)sStatus.sBtpFdr.dwMode, 
-                  sStatus.sBtpFdr.dwBPS,
-                  sStatus.sBtpFdr.wTS1,
-                  sStatus.sBtpFdr.wTS2,
-                  sStatus.sBtpFdr.wSJW,
-                  sStatus.sBtpFdr.wTDO));
+    return( ToLineStatus(sStatus) );
   }
   else
   {
@@ -979,5 +999,236 @@ CanLineStatus2 CanSocket2::LineStatus::get()
   }
 }
 
+//*****************************************************************************
+/// <summary>
+///   Converts a native line status to a <c>CanLineStatus2</c>.
+/// </summary>
+//*****************************************************************************
+CanLineStatus2 CanSocket2::ToLineStatus( const CANLINESTATUS2& rStatus )
+{
+  return CanLineStatus2((CanOperatingModes)rStatus.bOpMode, (CanExtendedOperatingModes)rStatus.bExMode, rStatus.bBusLoad, (CanCtrlStatus)rStatus.dwStatus, 
+    CanBitrate2((CanBitrateMode)rStatus.sBtpSdr.dwMode, 
+                rStatus.sBtpSdr.dwBPS,
+                rStatus.sBtpSdr.wTS1,
+                rStatus.sBtpSdr.wTS2,
+                rStatus.sBtpSdr.wSJW,
+                rStatus.sBtpSdr.wTDO),
+    CanBitrate2((CanBitrateMode)rStatus.sBtpFdr.dwMode, 
+                rStatus.sBtpFdr.dwBPS,
+                rStatus.sBtpFdr.wTS1,
+                rStatus.sBtpFdr.wTS2,
+                rStatus.sBtpFdr.wSJW,
+                rStatus.sBtpFdr.wTDO));
+}
+
+//*****************************************************************************
+/// <summary>
+///   Fills the native timing ranges of the arbitration or data phase.
+/// </summary>
+/// <param name="fData">
+///   true for the data phase, false for the arbitration phase.
+/// </param>
+/// <param name="rRange">
+///   Receives the ranges.
+/// </param>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+void CanSocket2::GetTimingRange( bool      fData
+                               , BTCRANGE& rRange )
+{
+  if (nullptr == m_psCanCap)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  const CANBTP& rMin = fData ? m_psCanCap->sFdrRangeMin : m_psCanCap->sSdrRangeMin;
+  const CANBTP& rMax = fData ? m_psCanCap->sFdrRangeMax : m_psCanCap->sSdrRangeMax;
+
+  rRange.dwBrpMin = (rMin.dwBPS > 0) ? rMin.dwBPS : 1;
+  rRange.dwBrpMax = rMax.dwBPS;
+  rRange.wTs1Min  = rMin.wTS1;
+  rRange.wTs1Max  = rMax.wTS1;
+  rRange.wTs2Min  = rMin.wTS2;
+  rRange.wTs2Max  = rMax.wTS2;
+  rRange.wSjwMax  = rMax.wSJW;
+  rRange.wTdoMax  = rMax.wTDO;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts the sample point to the native representation.
+/// </summary>
+/// <param name="dSamplePoint">
+///   Sample point as fraction of the bit time or 0 for the default.
+/// </param>
+/// <param name="dwBitrate">
+///   Requested bit rate in bit/s.
+/// </param>
+/// <param name="fData">
+///   true for the data phase, false for the arbitration phase.
+/// </param>
+/// <returns>
+///   The sample point in 0.01%.
+/// </returns>
+/// <exception cref="ArgumentOutOfRangeException">
+///   The sample point is not within [0, 1).
+/// </exception>
+//*****************************************************************************
+UINT16 CanSocket2::GetSamplePoint( double dSamplePoint
+                                 , UInt32 dwBitrate
+                                 , bool   fData )
+{
+  if (0 == dSamplePoint)
+  {
+    return( BtcDefaultSamplePoint(dwBitrate, fData) );
+  }
+
+  if (!(dSamplePoint > 0) || !(dSamplePoint < 1))
+  {
+    throw gcnew ArgumentOutOfRangeException("samplePoint");
+  }
+
+  return( (UINT16) Math::Round(dSamplePoint * 10000) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts a native bit timing to a raw mode bit rate.
+/// </summary>
+//*****************************************************************************
+CanBitrate2 CanSocket2::ToBitrate( const BTCRESULT& rResult )
+{
+  return( CanBitrate2(CanBitrateMode::Raw, rResult.dwBrp, rResult.wTs1,
+                      rResult.wTs2, rResult.wSjw, rResult.wTdo) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Calculates the bit timing for the specified arbitration bit rate.
+/// </summary>
+/// <param name="bitrate">
+///   Requested bit rate in bit/s.
+/// </param>
+/// <param name="samplePoint">
+///   Requested sample point or 0 for the CiA 601-3 default.
+/// </param>
+/// <returns>
+///   Bit timing value in raw mode.
+/// </returns>
+/// <exception cref="ArgumentOutOfRangeException">
+///   No valid bit timing exists for the requested values.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+CanBitrate2 CanSocket2::CalculateArbitrationBitrate( UInt32 bitrate
+                                                   , double samplePoint )
+{
+  BTCRANGE  sRange;
+  BTCRESULT sResult;
+
+  GetTimingRange(false, sRange);
+
+  if (!BtcSolve(m_psCanCap->dwCanClkFreq, sRange, bitrate,
+                GetSamplePoint(samplePoint, bitrate, false), false, sResult))
+  {
+    throw gcnew ArgumentOutOfRangeException("bitrate");
+  }
+
+  return( ToBitrate(sResult) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Calculates the bit timing for the specified fast data bit rate.
+/// </summary>
+/// <param name="bitrate">
+///   Requested bit rate in bit/s.
+/// </param>
+/// <param name="samplePoint">
+///   Requested sample point or 0 for the CiA 601-3 default.
+/// </param>
+/// <returns>
+///   Bit timing value in raw mode.
+/// </returns>
+/// <exception cref="ArgumentOutOfRangeException">
+///   No valid bit timing exists for the requested values.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+CanBitrate2 CanSocket2::CalculateFastDataBitrate( UInt32 bitrate
+                                                , double samplePoint )
+{
+  BTCRANGE  sRange;
+  BTCRESULT sResult;
+
+  GetTimingRange(true, sRange);
+
+  if (!BtcSolve(m_psCanCap->dwCanClkFreq, sRange, bitrate,
+                GetSamplePoint(samplePoint, bitrate, true), true, sResult))
+  {
+    throw gcnew ArgumentOutOfRangeException("bitrate");
+  }
+
+  return( ToBitrate(sResult) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Calculates the bit timing of both phases of a CAN FD bit rate.
+/// </summary>
+/// <param name="arbitrationBitrate">
+///   Requested arbitration bit rate in bit/s.
+/// </param>
+/// <param name="arbitrationSamplePoint">
+///   Requested arbitration sample point or 0 for the default.
+/// </param>
+/// <param name="fastDataBitrate">
+///   Requested fast data bit rate in bit/s.
+/// </param>
+/// <param name="fastDataSamplePoint">
+///   Requested fast data sample point or 0 for the default.
+/// </param>
+/// <returns>
+///   Bit timing values of both phases in raw mode.
+/// </returns>
+/// <exception cref="ArgumentOutOfRangeException">
+///   No valid bit timing exists for the requested values.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+CanFdBitrate CanSocket2::CalculateBitrate( UInt32 arbitrationBitrate
+                                         , double arbitrationSamplePoint
+                                         , UInt32 fastDataBitrate
+                                         , double fastDataSamplePoint )
+{
+  BTCRANGE  sArbRange;
+  BTCRANGE  sDataRange;
+  BTCRESULT sArb;
+  BTCRESULT sData;
+
+  GetTimingRange(false, sArbRange);
+  GetTimingRange(true, sDataRange);
+
+  if (!BtcSolveFd(m_psCanCap->dwCanClkFreq,
+                  sArbRange, arbitrationBitrate,
+                  GetSamplePoint(arbitrationSamplePoint, arbitrationBitrate, false),
+                  sDataRange, fastDataBitrate,
+                  GetSamplePoint(fastDataSamplePoint, fastDataBitrate, true),
+                  sArb, sData))
+  {
+    throw gcnew ArgumentOutOfRangeException("fastDataBitrate");
+  }
+
+  return( CanFdBitrate(ToBitrate(sArb), ToBitrate(sData)) );
+}
+
 #pragma warning(default:4669) // 'type cast' : unsafe conversion
 
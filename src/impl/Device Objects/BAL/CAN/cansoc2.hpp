@@ -9,7 +9,10 @@
 
 #include <vcisdk.h>
 #include ".\cansoc.hpp"
+#include ".\canbtc.hpp"
 #include "..\balobj.hpp"
+#include ".\cancaps.hpp"
+#include ".\cantcv.hpp"
 
 
 namespace Ixxat {
@@ -29,21 +32,32 @@ private ref class CanSocket2 : public BalResource,
   // member variables
   //--------------------------------------------------------------------
   private:
-    ::ICanSocket2*     m_pSocket;  // pointer to the native socket object
-    PCANCAPABILITIES2  m_psCanCap; // CAN capabilities
+    ::ICanSocket2*          m_pSocket;  // pointer to the native socket object
+    const CANCAPABILITIES2* m_psCanCap; // shared CAN capabilities
+    CanTimeConverter^       m_pTimeCnv; // tick converter
 
   //--------------------------------------------------------------------
   // member functions
   //--------------------------------------------------------------------
   private:
-    HRESULT InitNew               ( ::ICanSocket2* pSocket );
+    HRESULT InitNew               ( ::ICanSocket2* pSocket
+                                  , Guid           deviceId
+                                  , Byte           portNumber );
     void Cleanup                  ( void );
+    void GetTimingRange           ( bool           fData
+                                  , BTCRANGE&      rRange );
+    static UINT16 GetSamplePoint  ( double         dSamplePoint
+                                  , UInt32         dwBitrate
+                                  , bool           fData );
+    static CanBitrate2 ToBitrate  ( const BTCRESULT& rResult );
 
   protected:
     ::ICanSocket2*                GetNativeSocket ( );
+    static CanLineStatus2         ToLineStatus    ( const CANLINESTATUS2& rStatus );
 
   internal:
     CanSocket2                    ( ::IBalObject* pBalObj
+                                  , Guid          deviceId
                                   , Byte          portNumber 
                                   , Byte          busTypeIndex);
     ~CanSocket2                   ( );
@@ -69,6 +83,7 @@ private ref class CanSocket2 : public BalResource,
     virtual property UInt32           DelayedTXTimerClockFrequency  { UInt32          get(void); };
     virtual property UInt32           DelayedTXTimerDivisor         { UInt32          get(void); };
     virtual property UInt32           MaxDelayedTXTicks             { UInt32          get(void); };
+    virtual property ICanTimeConverter^ TimeConverter             { ICanTimeConverter^ get(void); };
     virtual property CanLineStatus2   LineStatus                    { CanLineStatus2  get(void); };
     virtual property bool             SupportsStdOrExtFrames        { bool            get(void); };
     virtual property bool             SupportsStdAndExtFrames       { bool            get(void); };
@@ -88,6 +103,15 @@ private ref class CanSocket2 : public BalResource,
     virtual property bool             SupportsIsoCanFdFrames        { bool            get(void); };
     virtual property bool             SupportsNonIsoCanFdFrames     { bool            get(void); };
     virtual property bool             Supports64BitTimeStamps       { bool            get(void); };
+
+    virtual CanBitrate2  CalculateArbitrationBitrate( UInt32 bitrate
+                                                    , double samplePoint );
+    virtual CanBitrate2  CalculateFastDataBitrate   ( UInt32 bitrate
+                                                    , double samplePoint );
+    virtual CanFdBitrate CalculateBitrate           ( UInt32 arbitrationBitrate
+                                                    , double arbitrationSamplePoint
+                                                    , UInt32 fastDataBitrate
+                                                    , double fastDataSamplePoint );
 };
 
 } // end of namespace Can
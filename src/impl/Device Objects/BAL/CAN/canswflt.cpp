@@ -0,0 +1,385 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the software filter of the CAN message reader.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "canswflt.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+
+#pragma warning(disable:4669) // 'type cast' : unsafe conversion
+
+
+// maximum number of 29-bit identifiers added by a single range
+#define SWF_MAX_EXT_RANGE   0x10000
+
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for a disabled, empty software filter.
+/// </summary>
+//*****************************************************************************
+CanSoftwareFilter::CanSoftwareFilter(void)
+{
+  m_pSync = gcnew Object();
+  m_pSet  = new CANIDSET();
+}
+
+//*****************************************************************************
+/// <summary>
+///   Finalizer of the software filter. The filter is not disposable, since
+///   it's shared by the reader and the application, so the native set is
+///   released by the finalizer.
+/// </summary>
+//*****************************************************************************
+CanSoftwareFilter::!CanSoftwareFilter()
+{
+  delete m_pSet;
+  m_pSet = nullptr;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Checks the identifier against the identifier space of the selection.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Invalid filter selection or identifier.
+/// </exception>
+//*****************************************************************************
+void CanSoftwareFilter::CheckId( CanFilter select
+                               , UInt32    identifier )
+{
+  switch (select)
+  {
+    case CanFilter::Std:
+      if (identifier > 0x7FF)
+      {
+        throw gcnew ArgumentOutOfRangeException("identifier");
+      }
+      break;
+
+    case CanFilter::Ext:
+      if (identifier > 0x1FFFFFFF)
+      {
+        throw gcnew ArgumentOutOfRangeException("identifier");
+      }
+      break;
+
+    default:
+      throw gcnew ArgumentOutOfRangeException("select");
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Locks the identifier set for the read path.
+/// </summary>
+//*****************************************************************************
+void CanSoftwareFilter::Lock(void)
+{
+  Monitor::Enter(m_pSync);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Unlocks the identifier set.
+/// </summary>
+//*****************************************************************************
+void CanSoftwareFilter::Unlock(void)
+{
+  Monitor::Exit(m_pSync);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the native identifier set. Must be called between <c>Lock</c>
+///   and <c>Unlock</c>.
+/// </summary>
+/// <returns>
+///   The identifier set or NULL if the filter is disabled.
+/// </returns>
+//*****************************************************************************
+CANIDSET* CanSoftwareFilter::GetSet(void)
+{
+  return( m_fEnabled ? m_pSet : nullptr );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Adds the result of a filtered block of FIFO entries to the counters.
+/// </summary>
+//*****************************************************************************
+void CanSoftwareFilter::Count( UInt32 dwPassed
+                             , UInt32 dwDropped )
+{
+  if (0 != dwPassed)
+  {
+    Interlocked::Add(m_qwPassed, (Int64) dwPassed);
+  }
+  if (0 != dwDropped)
+  {
+    Interlocked::Add(m_qwDropped, (Int64) dwDropped);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets or sets a value indicating whether the filter is applied.
+/// </summary>
+//*****************************************************************************
+bool CanSoftwareFilter::Enabled::get(void)
+{
+  return( m_fEnabled );
+}
+
+void CanSoftwareFilter::Enabled::set(bool fEnabled)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    m_fEnabled = fEnabled;
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of 11-bit identifiers contained in the filter.
+/// </summary>
+//*****************************************************************************
+int CanSoftwareFilter::StdCount::get(void)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    return( (int) m_pSet->StdCount() );
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of 29-bit identifiers contained in the filter.
+/// </summary>
+//*****************************************************************************
+int CanSoftwareFilter::ExtCount::get(void)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    return( (int) m_pSet->ExtCount() );
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of messages which passed the enabled filter.
+/// </summary>
+//*****************************************************************************
+Int64 CanSoftwareFilter::PassedCount::get(void)
+{
+  return( Interlocked::Read(m_qwPassed) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of messages dropped by the enabled filter.
+/// </summary>
+//*****************************************************************************
+Int64 CanSoftwareFilter::DroppedCount::get(void)
+{
+  return( Interlocked::Read(m_qwDropped) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Adds the specified identifier to the filter.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Invalid filter selection or identifier.
+/// </exception>
+/// <exception cref="OutOfMemoryException">
+///   The 29-bit identifier set could not be enlarged.
+/// </exception>
+//*****************************************************************************
+void CanSoftwareFilter::Add( CanFilter select
+                           , UInt32    identifier )
+{
+  CheckId(select, identifier);
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (CanFilter::Std == select)
+    {
+      m_pSet->AddStd(identifier);
+    }
+    else if (!m_pSet->AddExt(identifier))
+    {
+      throw gcnew OutOfMemoryException();
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Adds all identifiers of the specified range to the filter.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Invalid filter selection or range.
+/// </exception>
+/// <exception cref="OutOfMemoryException">
+///   The 29-bit identifier set could not be enlarged.
+/// </exception>
+//*****************************************************************************
+void CanSoftwareFilter::Add( CanFilter  select
+                           , CanIdRange range )
+{
+  CheckId(select, range.Last);
+
+  if (range.First > range.Last)
+  {
+    throw gcnew ArgumentOutOfRangeException("range");
+  }
+
+  if ((CanFilter::Ext == select) && (range.Last - range.First >= SWF_MAX_EXT_RANGE))
+  {
+    throw gcnew ArgumentOutOfRangeException("range");
+  }
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    for (UInt32 dwId = range.First; dwId <= range.Last; dwId++)
+    {
+      if (CanFilter::Std == select)
+      {
+        m_pSet->AddStd(dwId);
+      }
+      else if (!m_pSet->AddExt(dwId))
+      {
+        throw gcnew OutOfMemoryException();
+      }
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Removes the specified identifier from the filter.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Invalid filter selection or identifier.
+/// </exception>
+//*****************************************************************************
+void CanSoftwareFilter::Remove( CanFilter select
+                              , UInt32    identifier )
+{
+  CheckId(select, identifier);
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    if (CanFilter::Std == select)
+    {
+      m_pSet->RemoveStd(identifier);
+    }
+    else
+    {
+      m_pSet->RemoveExt(identifier);
+    }
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Determines whether the filter contains the specified identifier.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   Invalid filter selection.
+/// </exception>
+//*****************************************************************************
+bool CanSoftwareFilter::Contains( CanFilter select
+                                , UInt32    identifier )
+{
+  switch (select)
+  {
+    case CanFilter::Std:
+    case CanFilter::Ext:
+      break;
+
+    default:
+      throw gcnew ArgumentOutOfRangeException("select");
+  }
+
+  if ((CanFilter::Std == select) && (identifier > 0x7FF))
+  {
+    return( false );
+  }
+
+  Monitor::Enter(m_pSync);
+  try
+  {
+    return( m_pSet->Pass(CAN_MSGTYPE_DATA, CanFilter::Ext == select, identifier) );
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Removes all identifiers from the filter.
+/// </summary>
+//*****************************************************************************
+void CanSoftwareFilter::Clear(void)
+{
+  Monitor::Enter(m_pSync);
+  try
+  {
+    m_pSet->Clear();
+  }
+  finally
+  {
+    Monitor::Exit(m_pSync);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Resets the passed and dropped counters.
+/// </summary>
+//*****************************************************************************
+void CanSoftwareFilter::ResetCounters(void)
+{
+  Interlocked::Exchange(m_qwPassed, (Int64) 0);
+  Interlocked::Exchange(m_qwDropped, (Int64) 0);
+}
+
+#pragma warning(default:4669) // 'type cast' : unsafe conversion
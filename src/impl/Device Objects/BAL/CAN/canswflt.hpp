@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the software filter of the CAN message reader.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+#include ".\canidset.hpp"
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+using namespace System::Threading;
+
+
+//*****************************************************************************
+/// <summary>
+///   This class implements the host side exact match filter of a CAN
+///   message reader.
+/// </summary>
+/// <remarks>
+///   The reader calls <c>Lock</c>, tests each received entry with
+///   <c>GetSet()->Pass()</c>, reports the result with <c>Count</c> and
+///   calls <c>Unlock</c>, once per block of FIFO entries.
+/// </remarks>
+//*****************************************************************************
+private ref class CanSoftwareFilter : public ICanSoftwareFilter
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    CANIDSET*     m_pSet;       // native identifier set
+    Object^       m_pSync;      // guards m_pSet
+    bool          m_fEnabled;   // filter is applied
+    Int64         m_qwPassed;   // number of passed messages
+    Int64         m_qwDropped;  // number of dropped messages
+
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    static void CheckId ( CanFilter select, UInt32 identifier );
+
+  internal:
+    CanSoftwareFilter  ( void );
+    !CanSoftwareFilter ( );
+
+    void      Lock     ( void );
+    void      Unlock   ( void );
+    CANIDSET* GetSet   ( void );
+    void      Count    ( UInt32 dwPassed, UInt32 dwDropped );
+
+
+  //--------------------------------------------------------------------
+  // ICanSoftwareFilter implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual property bool  Enabled      { bool  get(void);
+                                          void  set(bool fEnabled); };
+    virtual property int   StdCount     { int   get(void); };
+    virtual property int   ExtCount     { int   get(void); };
+    virtual property Int64 PassedCount  { Int64 get(void); };
+    virtual property Int64 DroppedCount { Int64 get(void); };
+
+    virtual void Add          ( CanFilter select, UInt32 identifier );
+    virtual void Add          ( CanFilter select, CanIdRange range );
+    virtual void Remove       ( CanFilter select, UInt32 identifier );
+    virtual bool Contains     ( CanFilter select, UInt32 identifier );
+    virtual void Clear        ( void );
+    virtual void ResetCounters( void );
+};
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
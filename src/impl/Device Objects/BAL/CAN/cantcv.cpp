@@ -0,0 +1,372 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the conversion of CAN timer ticks.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "cantcv.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal::Can;
+
+#pragma warning(disable:4669) // 'type cast' : unsafe conversion
+
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for tick converter objects.
+/// </summary>
+/// <param name="rCaps">
+///   Capabilities of the CAN controller.
+/// </param>
+//*****************************************************************************
+CanTimeConverter::CanTimeConverter(const CANCAPABILITIES2& rCaps)
+{
+  // tick period = divisor / clock frequency,
+  // tick rate   = clock frequency / divisor
+  m_sTscNs   = ToScale((UInt64) rCaps.dwTscDivisor * 1000000000, rCaps.dwTscClkFreq);
+  m_sTsc100  = ToScale((UInt64) rCaps.dwTscDivisor * 10000000,   rCaps.dwTscClkFreq);
+  m_sDtxNs   = ToScale((UInt64) rCaps.dwDtxDivisor * 1000000000, rCaps.dwDtxClkFreq);
+  m_sDtxRate = ToScale(rCaps.dwDtxClkFreq, (UInt64) rCaps.dwDtxDivisor * 1000000000);
+  m_sCmsNs   = ToScale((UInt64) rCaps.dwCmsDivisor * 1000000000, rCaps.dwCmsClkFreq);
+  m_sCmsRate = ToScale(rCaps.dwCmsClkFreq, (UInt64) rCaps.dwCmsDivisor * 1000000000);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Computes the fixed-point value of a fraction.
+/// </summary>
+/// <param name="qwNum">
+///   Numerator, less than 2^63.
+/// </param>
+/// <param name="qwDen">
+///   Denominator, less than 2^63.
+/// </param>
+/// <returns>
+///   The fixed-point value, or 0 if one of the parameters is 0.
+/// </returns>
+//*****************************************************************************
+TickScale CanTimeConverter::ToScale( UInt64 qwNum
+                                   , UInt64 qwDen )
+{
+  TickScale sScale;
+
+  sScale.qwInt  = 0;
+  sScale.qwFrac = 0;
+
+  if ((0 == qwNum) || (0 == qwDen))
+  {
+    return( sScale );
+  }
+
+  sScale.qwInt = qwNum / qwDen;
+
+  // binary long division of the remainder, which stays below 2^63
+  UInt64 qwRem = qwNum % qwDen;
+  for (int i = 0; i < 64; i++)
+  {
+    qwRem         <<= 1;
+    sScale.qwFrac <<= 1;
+    if (qwRem >= qwDen)
+    {
+      qwRem -= qwDen;
+      sScale.qwFrac |= 1;
+    }
+  }
+
+  // Rounding the fraction up makes the truncated results exact as long
+  // as the product of value and denominator stays below 2^64.
+  if (0 != qwRem)
+  {
+    if (0 == ++sScale.qwFrac)
+    {
+      sScale.qwInt++;
+    }
+  }
+
+  return( sScale );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Multiplies a value with a fixed-point factor.
+/// </summary>
+/// <param name="qwValue">
+///   Value to scale.
+/// </param>
+/// <param name="sScale">
+///   Fixed-point factor.
+/// </param>
+/// <returns>
+///   The truncated product.
+/// </returns>
+//*****************************************************************************
+UInt64 CanTimeConverter::Scale( UInt64    qwValue
+                              , TickScale sScale )
+{
+  UInt64 qwV0 = qwValue & 0xFFFFFFFF;
+  UInt64 qwV1 = qwValue >> 32;
+  UInt64 qwF0 = sScale.qwFrac & 0xFFFFFFFF;
+  UInt64 qwF1 = sScale.qwFrac >> 32;
+
+  // upper 64 bits of the 128-bit product qwValue * qwFrac
+  UInt64 qw01 = qwV0 * qwF1;
+  UInt64 qw10 = qwV1 * qwF0;
+  UInt64 qwMid = ((qwV0 * qwF0) >> 32) + (qw01 & 0xFFFFFFFF) + (qw10 & 0xFFFFFFFF);
+  UInt64 qwHigh = qwV1 * qwF1 + (qw01 >> 32) + (qw10 >> 32) + (qwMid >> 32);
+
+  return( qwValue * sScale.qwInt + qwHigh );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Checks whether a timer is available.
+/// </summary>
+/// <param name="sScale">
+///   Conversion factor of the timer.
+/// </param>
+/// <param name="pTimer">
+///   Name of the timer for the exception message.
+/// </param>
+/// <exception cref="NotSupportedException">
+///   The timer is not available.
+/// </exception>
+//*****************************************************************************
+void CanTimeConverter::CheckTimer( TickScale sScale
+                                 , String^   pTimer )
+{
+  if ((0 == sScale.qwInt) && (0 == sScale.qwFrac))
+  {
+    throw gcnew NotSupportedException(
+      String::Format("The controller provides no {0}.", pTimer));
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts a time stamp of a received message into nanoseconds.
+/// </summary>
+/// <param name="timeStamp">
+///   Time stamp in ticks of the time stamp counter.
+/// </param>
+/// <returns>
+///   Time stamp in nanoseconds.
+/// </returns>
+/// <exception cref="NotSupportedException">
+///   The controller has no time stamp counter.
+/// </exception>
+//*****************************************************************************
+UInt64 CanTimeConverter::TimeStampToNanoseconds(UInt64 timeStamp)
+{
+  CheckTimer(m_sTscNs, "time stamp counter");
+  return( Scale(timeStamp, m_sTscNs) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts a time stamp of a received message into a time span.
+/// </summary>
+/// <param name="timeStamp">
+///   Time stamp in ticks of the time stamp counter.
+/// </param>
+/// <returns>
+///   Time stamp as time span.
+/// </returns>
+/// <exception cref="NotSupportedException">
+///   The controller has no time stamp counter.
+/// </exception>
+//*****************************************************************************
+TimeSpan CanTimeConverter::TimeStampToTimeSpan(UInt64 timeStamp)
+{
+  CheckTimer(m_sTsc100, "time stamp counter");
+  return( TimeSpan((Int64) Scale(timeStamp, m_sTsc100)) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts an array of time stamps into nanoseconds.
+/// </summary>
+/// <param name="timeStamps">
+///   Time stamps in ticks of the time stamp counter.
+/// </param>
+/// <param name="nanoseconds">
+///   Receives the converted time stamps.
+/// </param>
+/// <exception cref="ArgumentNullException">
+///   One of the arrays is a null reference.
+/// </exception>
+/// <exception cref="ArgumentException">
+///   Parameter nanoseconds is too short.
+/// </exception>
+/// <exception cref="NotSupportedException">
+///   The controller has no time stamp counter.
+/// </exception>
+//*****************************************************************************
+void CanTimeConverter::TimeStampToNanoseconds( array<UInt64>^ timeStamps
+                                             , array<UInt64>^ nanoseconds )
+{
+  if (nullptr == timeStamps)
+  {
+    throw gcnew ArgumentNullException("timeStamps");
+  }
+  if (nullptr == nanoseconds)
+  {
+    throw gcnew ArgumentNullException("nanoseconds");
+  }
+  if (nanoseconds->Length < timeStamps->Length)
+  {
+    throw gcnew ArgumentException("Array is too short.", "nanoseconds");
+  }
+
+  CheckTimer(m_sTscNs, "time stamp counter");
+
+  int count = timeStamps->Length;
+  if (count > 0)
+  {
+    TickScale       sScale = m_sTscNs;
+    pin_ptr<UInt64> pSrc = &timeStamps[0];
+    pin_ptr<UInt64> pDst = &nanoseconds[0];
+
+    for (int i = 0; i < count; i++)
+    {
+      pDst[i] = Scale(pSrc[i], sScale);
+    }
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts an array of time stamps into time spans.
+/// </summary>
+/// <param name="timeStamps">
+///   Time stamps in ticks of the time stamp counter.
+/// </param>
+/// <param name="timeSpans">
+///   Receives the converted time stamps.
+/// </param>
+/// <exception cref="ArgumentNullException">
+///   One of the arrays is a null reference.
+/// </exception>
+/// <exception cref="ArgumentException">
+///   Parameter timeSpans is too short.
+/// </exception>
+/// <exception cref="NotSupportedException">
+///   The controller has no time stamp counter.
+/// </exception>
+//*****************************************************************************
+void CanTimeConverter::TimeStampToTimeSpan( array<UInt64>^   timeStamps
+                                          , array<TimeSpan>^ timeSpans )
+{
+  if (nullptr == timeStamps)
+  {
+    throw gcnew ArgumentNullException("timeStamps");
+  }
+  if (nullptr == timeSpans)
+  {
+    throw gcnew ArgumentNullException("timeSpans");
+  }
+  if (timeSpans->Length < timeStamps->Length)
+  {
+    throw gcnew ArgumentException("Array is too short.", "timeSpans");
+  }
+
+  CheckTimer(m_sTsc100, "time stamp counter");
+
+  int count = timeStamps->Length;
+  if (count > 0)
+  {
+    TickScale         sScale = m_sTsc100;
+    pin_ptr<UInt64>   pSrc = &timeStamps[0];
+    pin_ptr<TimeSpan> pDst = &timeSpans[0];
+
+    for (int i = 0; i < count; i++)
+    {
+      pDst[i] = TimeSpan((Int64) Scale(pSrc[i], sScale));
+    }
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts ticks of the delayed transmission timer into nanoseconds.
+/// </summary>
+/// <param name="ticks">
+///   Number of ticks of the delayed transmission timer.
+/// </param>
+/// <returns>
+///   Delay in nanoseconds.
+/// </returns>
+/// <exception cref="NotSupportedException">
+///   The controller does not support delayed transmission.
+/// </exception>
+//*****************************************************************************
+UInt64 CanTimeConverter::DelayedTXTicksToNanoseconds(UInt64 ticks)
+{
+  CheckTimer(m_sDtxNs, "delayed transmission timer");
+  return( Scale(ticks, m_sDtxNs) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts a delay in nanoseconds into ticks of the delayed
+///   transmission timer.
+/// </summary>
+/// <param name="nanoseconds">
+///   Delay in nanoseconds.
+/// </param>
+/// <returns>
+///   Number of ticks of the delayed transmission timer.
+/// </returns>
+/// <exception cref="NotSupportedException">
+///   The controller does not support delayed transmission.
+/// </exception>
+//*****************************************************************************
+UInt64 CanTimeConverter::NanosecondsToDelayedTXTicks(UInt64 nanoseconds)
+{
+  CheckTimer(m_sDtxRate, "delayed transmission timer");
+  return( Scale(nanoseconds, m_sDtxRate) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts ticks of the cyclic message scheduler into nanoseconds.
+/// </summary>
+/// <param name="ticks">
+///   Number of ticks of the cyclic message scheduler.
+/// </param>
+/// <returns>
+///   Time in nanoseconds.
+/// </returns>
+/// <exception cref="NotSupportedException">
+///   The controller has no cyclic message scheduler.
+/// </exception>
+//*****************************************************************************
+UInt64 CanTimeConverter::CyclicTicksToNanoseconds(UInt64 ticks)
+{
+  CheckTimer(m_sCmsNs, "cyclic message scheduler");
+  return( Scale(ticks, m_sCmsNs) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Converts a time in nanoseconds into ticks of the cyclic message
+///   scheduler.
+/// </summary>
+/// <param name="nanoseconds">
+///   Time in nanoseconds.
+/// </param>
+/// <returns>
+///   Number of ticks of the cyclic message scheduler.
+/// </returns>
+/// <exception cref="NotSupportedException">
+///   The controller has no cyclic message scheduler.
+/// </exception>
+//*****************************************************************************
+UInt64 CanTimeConverter::NanosecondsToCyclicTicks(UInt64 nanoseconds)
+{
+  CheckTimer(m_sCmsRate, "cyclic message scheduler");
+  return( Scale(nanoseconds, m_sCmsRate) );
+}
+
+#pragma warning(default:4669) // 'type cast' : unsafe conversion
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the conversion of CAN timer ticks.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+
+//*****************************************************************************
+/// <summary>
+///   Fixed-point conversion factor with a 64-bit integer part and a
+///   64-bit fraction. A factor of 0 marks a timer that is not available.
+/// </summary>
+//*****************************************************************************
+private value struct TickScale
+{
+  UInt64  qwInt;    // integer part
+  UInt64  qwFrac;   // fraction in units of 2^-64, rounded up
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   This class implements the tick converter of a CAN socket.
+/// </summary>
+//*****************************************************************************
+private ref class CanTimeConverter : public ICanTimeConverter
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    TickScale m_sTscNs;   // time stamp tick in ns
+    TickScale m_sTsc100;  // time stamp tick in 100 ns
+    TickScale m_sDtxNs;   // delayed tx tick in ns
+    TickScale m_sDtxRate; // delayed tx ticks per ns
+    TickScale m_sCmsNs;   // scheduler tick in ns
+    TickScale m_sCmsRate; // scheduler ticks per ns
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    static TickScale ToScale    ( UInt64    qwNum
+                                , UInt64    qwDen );
+    static UInt64    Scale      ( UInt64    qwValue
+                                , TickScale sScale );
+    static void      CheckTimer ( TickScale sScale
+                                , String^   pTimer );
+
+  internal:
+    CanTimeConverter            ( const CANCAPABILITIES2& rCaps );
+
+  //--------------------------------------------------------------------
+  // ICanTimeConverter implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual UInt64   TimeStampToNanoseconds     ( UInt64 timeStamp );
+    virtual TimeSpan TimeStampToTimeSpan        ( UInt64 timeStamp );
+    virtual void     TimeStampToNanoseconds     ( array<UInt64>^   timeStamps
+                                                , array<UInt64>^   nanoseconds );
+    virtual void     TimeStampToTimeSpan        ( array<UInt64>^   timeStamps
+                                                , array<TimeSpan>^ timeSpans );
+    virtual UInt64   DelayedTXTicksToNanoseconds( UInt64 ticks );
+    virtual UInt64   NanosecondsToDelayedTXTicks( UInt64 nanoseconds );
+    virtual UInt64   CyclicTicksToNanoseconds   ( UInt64 ticks );
+    virtual UInt64   NanosecondsToCyclicTicks   ( UInt64 nanoseconds );
+};
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
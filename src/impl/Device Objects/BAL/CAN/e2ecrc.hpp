@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Native CRC-8 kernels and E2E protection functions.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+      namespace Can {
+
+
+//*****************************************************************************
+/// <summary>
+///   Lookup table of a MSB-first CRC-8. The table is generated at compile
+///   time from the polynomial.
+/// </summary>
+//*****************************************************************************
+struct CRC8TABLE
+{
+  UINT8 abEntry[256];
+
+  constexpr CRC8TABLE(UINT8 bPoly) : abEntry()
+  {
+    for (unsigned i = 0; i < 256; i++)
+    {
+      unsigned crc = i;
+      for (int b = 0; b < 8; b++)
+      {
+        crc = (crc & 0x80) ? ((crc << 1) ^ bPoly) : (crc << 1);
+      }
+      abEntry[i] = (UINT8) (crc & 0xFF);
+    }
+  }
+};
+
+// CRC-8/SAE-J1850 (used by the plain alive counter mode and E2E profile 1)
+constexpr CRC8TABLE g_sCrc8SaeJ1850(0x1D);
+
+// CRC-8H2F (used by E2E profile 2)
+constexpr CRC8TABLE g_sCrc8H2F(0x2F);
+
+
+//*****************************************************************************
+/// <summary>
+///   Updates the CRC register with the specified data.
+/// </summary>
+/// <param name="rTable">
+///   Lookup table of the CRC polynomial.
+/// </param>
+/// <param name="bCrc">
+///   Current value of the CRC register.
+/// </param>
+/// <param name="pData">
+///   Data to process.
+/// </param>
+/// <param name="dwLen">
+///   Number of bytes to process.
+/// </param>
+/// <returns>
+///   New value of the CRC register.
+/// </returns>
+//*****************************************************************************
+constexpr UINT8 Crc8Update( const CRC8TABLE& rTable
+                          , UINT8            bCrc
+                          , const UINT8*     pData
+                          , UINT32           dwLen )
+{
+  const UINT8* t = rTable.abEntry;
+
+  // unrolled by 4, the loop is bound by the table lookup latency
+  while (dwLen >= 4)
+  {
+    bCrc = t[bCrc ^ pData[0]];
+    bCrc = t[bCrc ^ pData[1]];
+    bCrc = t[bCrc ^ pData[2]];
+    bCrc = t[bCrc ^ pData[3]];
+    pData += 4;
+    dwLen -= 4;
+  }
+
+  while (dwLen--)
+  {
+    bCrc = t[bCrc ^ *pData++];
+  }
+
+  return( bCrc );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Updates the CRC register with the specified data except the byte at
+///   index dwSkip.
+/// </summary>
+//*****************************************************************************
+constexpr UINT8 Crc8UpdateSkip( const CRC8TABLE& rTable
+                              , UINT8            bCrc
+                              , const UINT8*     pData
+                              , UINT32           dwLen
+                              , UINT32           dwSkip )
+{
+  if (dwSkip < dwLen)
+  {
+    bCrc = Crc8Update(rTable, bCrc, pData, dwSkip);
+    return( Crc8Update(rTable, bCrc, pData + dwSkip + 1, dwLen - dwSkip - 1) );
+  }
+
+  return( Crc8Update(rTable, bCrc, pData, dwLen) );
+}
+
+
+// protection profiles (values correspond to CanE2EProfile)
+#define E2E_PROFILE_NONE      0
+#define E2E_PROFILE_CRC8      1
+#define E2E_PROFILE_P01       2
+#define E2E_PROFILE_P02       3
+
+//*****************************************************************************
+/// <summary>
+///   E2E protection state of a single periodic message.
+/// </summary>
+//*****************************************************************************
+struct E2ESTATE
+{
+  UINT8  bProfile;          // protection profile (E2E_PROFILE_xxx)
+  UINT8  bCounter;          // counter value of the next frame
+  UINT16 wCounterOfs;       // bit offset of the 4-bit counter
+  UINT16 wCrcOfs;           // bit offset of the CRC byte
+  UINT16 wDataId;           // data ID of profile 1
+  UINT8  abDataIdList[16];  // data ID list of profile 2
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   Writes a 4-bit counter value into the data field.
+/// </summary>
+//*****************************************************************************
+constexpr void E2EPutNibble(UINT8* pData, UINT16 wBitOfs, UINT8 bValue)
+{
+  UINT8* p = pData + (wBitOfs >> 3);
+  if (wBitOfs & 4)
+    *p = (UINT8) ((*p & 0x0F) | (bValue << 4));
+  else
+    *p = (UINT8) ((*p & 0xF0) | (bValue & 0x0F));
+}
+
+//*****************************************************************************
+/// <summary>
+///   Applies the E2E protection to the data field of a frame, i.e. writes
+///   the current counter and the CRC and advances the counter.
+/// </summary>
+/// <param name="pState">
+///   Protection state of the message.
+/// </param>
+/// <param name="pData">
+///   Data field of the frame.
+/// </param>
+/// <param name="dwLen">
+///   Length of the data field in bytes.
+/// </param>
+/// <returns>
+///   The counter value written into the frame.
+/// </returns>
+/// <remarks>
+///   The offsets were validated when the message was registered, so
+///   this function does not perform any range checks.
+/// </remarks>
+//*****************************************************************************
+constexpr UINT8 E2EProtect(E2ESTATE* pState, UINT8* pData, UINT32 dwLen)
+{
+  UINT8 bCounter = pState->bCounter;
+  UINT8 bCrc     = 0;
+
+  switch (pState->bProfile)
+  {
+    case E2E_PROFILE_CRC8:
+    {
+      UINT32 dwCrcIdx = pState->wCrcOfs >> 3;
+      E2EPutNibble(pData, pState->wCounterOfs, bCounter);
+      bCrc = Crc8UpdateSkip(g_sCrc8SaeJ1850, 0xFF, pData, dwLen, dwCrcIdx);
+      pData[dwCrcIdx] = (UINT8) (bCrc ^ 0xFF);
+      pState->bCounter = (UINT8) ((bCounter + 1) & 0x0F);
+      break;
+    }
+
+    case E2E_PROFILE_P01:
+    {
+      // Profile 1 uses start value 0x00 and no final XOR once the
+      // inversions of the AUTOSAR CRC library calls are resolved.
+      UINT32 dwCrcIdx = pState->wCrcOfs >> 3;
+      UINT8  abId[2]  = { (UINT8) (pState->wDataId & 0xFF)
+                        , (UINT8) (pState->wDataId >> 8) };
+      E2EPutNibble(pData, pState->wCounterOfs, bCounter);
+      bCrc = Crc8Update(g_sCrc8SaeJ1850, 0x00, abId, 2);
+      bCrc = Crc8UpdateSkip(g_sCrc8SaeJ1850, bCrc, pData, dwLen, dwCrcIdx);
+      pData[dwCrcIdx] = bCrc;
+      pState->bCounter = (UINT8) ((bCounter >= 14) ? 0 : bCounter + 1);
+      break;
+    }
+
+    case E2E_PROFILE_P02:
+    {
+      E2EPutNibble(pData, 8, bCounter);
+      bCrc = Crc8Update(g_sCrc8H2F, 0xFF, pData + 1, dwLen - 1);
+      bCrc = Crc8Update(g_sCrc8H2F, bCrc, &pState->abDataIdList[bCounter], 1);
+      pData[0] = (UINT8) (bCrc ^ 0xFF);
+      pState->bCounter = (UINT8) ((bCounter + 1) & 0x0F);
+      break;
+    }
+
+    default:
+      break;
+  }
+
+  return( bCounter );
+}
+
+
+// compile time known-answer checks of the CRC kernels and profiles
+namespace E2ESelfTest {
+
+  // check value of a CRC-8 with start value and final XOR 0xFF
+  constexpr UINT8 Crc8Check( const CRC8TABLE& rTable )
+  {
+    const UINT8 abData[9] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    return( (UINT8) (Crc8Update(rTable, 0xFF, abData, 9) ^ 0xFF) );
+  }
+
+  // CRC byte of an 8 byte zero frame with the counter in the low nibble
+  // of byte 1 and the CRC in byte 0
+  constexpr UINT8 Protect( UINT8 bProfile, UINT8 bCounter )
+  {
+    E2ESTATE sState    = {};
+    UINT8    abData[8] = {};
+
+    sState.bProfile    = bProfile;
+    sState.bCounter    = bCounter;
+    sState.wCounterOfs = 8;
+    sState.wCrcOfs     = 0;
+    sState.wDataId     = 0x123;
+    for (UINT8 i = 0; i < 16; i++)
+    {
+      sState.abDataIdList[i] = i;
+    }
+
+    E2EProtect(&sState, abData, 8);
+    return( abData[0] );
+  }
+
+  static_assert(Crc8Check(g_sCrc8SaeJ1850) == 0x4B, "E2E self test");
+  static_assert(Crc8Check(g_sCrc8H2F)      == 0xDF, "E2E self test");
+
+  // AUTOSAR E2E profile 1 example: data ID 0x123 (mode BOTH)
+  static_assert(Protect(E2E_PROFILE_P01, 0) == 0xCC, "E2E self test");
+  static_assert(Protect(E2E_PROFILE_P01, 1) == 0x91, "E2E self test");
+
+  // E2E profile 2: data ID list 0x00..0x0F
+  static_assert(Protect(E2E_PROFILE_P02, 0) == 0x21, "E2E self test");
+  static_assert(Protect(E2E_PROFILE_P02, 1) == 0x6A, "E2E self test");
+
+} // end of namespace E2ESelfTest
+
+
+} // end of namespace Can
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
@@ -175,20 +175,34 @@ void LinControl::InitLine( LinInitLine initLine )
 //*****************************************************************************
 void LinControl::ResetLine(void)
 {
-  HRESULT hResult;
+  VciResult sResult = TryResetLine();
 
-  if (nullptr != m_pLinCtl)
+  if (!sResult.Succeeded)
   {
-    hResult = m_pLinCtl->ResetLine();
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Resets the LIN line like <c>ResetLine</c>, but reports a failure
+///   through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult LinControl::TryResetLine(void)
+{
+  if (nullptr == m_pLinCtl)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pLinCtl->ResetLine()) );
 }
 
 //*****************************************************************************
@@ -205,20 +219,34 @@ void LinControl::ResetLine(void)
 //*****************************************************************************
 void LinControl::StartLine(void)
 {
-  HRESULT hResult;
+  VciResult sResult = TryStartLine();
 
-  if (nullptr != m_pLinCtl)
+  if (!sResult.Succeeded)
   {
-    hResult = m_pLinCtl->StartLine();
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Starts the LIN line like <c>StartLine</c>, but reports a failure
+///   through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult LinControl::TryStartLine(void)
+{
+  if (nullptr == m_pLinCtl)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pLinCtl->StartLine()) );
 }
 
 //*****************************************************************************
@@ -237,20 +265,34 @@ void LinControl::StartLine(void)
 //*****************************************************************************
 void LinControl::StopLine(void)
 {
-  HRESULT hResult;
+  VciResult sResult = TryStopLine();
 
-  if (nullptr != m_pLinCtl)
+  if (!sResult.Succeeded)
   {
-    hResult = m_pLinCtl->StopLine();
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Stops the LIN line like <c>StopLine</c>, but reports a failure
+///   through the return value.
+/// </summary>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult LinControl::TryStopLine(void)
+{
+  if (nullptr == m_pLinCtl)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  return( VciResult(m_pLinCtl->StopLine()) );
 }
 
 mgdLINMSG ConvertToLINMSG(ILinMessage^ message)
@@ -292,21 +334,46 @@ mgdLINMSG ConvertToLINMSG(ILinMessage^ message)
 void LinControl::WriteMessage(bool         send, 
                               ILinMessage^ message)
 {
-  HRESULT hResult;
+  VciResult sResult = TryWriteMessage(send, message);
 
-  if (nullptr != m_pLinCtl)
+  if (!sResult.Succeeded)
   {
-    mgdLINMSG msg = ConvertToLINMSG(message);
-
-    pin_ptr<mgdLINMSG> pMsg = &msg;
-    hResult = m_pLinCtl->WriteMessage(send, (PLINMSG)pMsg);
-    if (hResult != VCI_OK)
-    {
-      throw gcnew VciException(VciServerImpl::Instance(), hResult);
-    }
+    throw gcnew VciException(VciServerImpl::Instance(), sResult.HResult);
   }
-  else
+}
+
+//*****************************************************************************
+/// <summary>
+///   Writes a message like <c>WriteMessage</c>, but reports a failure of
+///   the LIN controller through the return value.
+/// </summary>
+/// <param name="send">
+///   true to force sending the message directly or false to enter the message
+///   into the controller's response table.
+/// </param>
+/// <param name="message">
+///   The message to be transmitted.
+/// </param>
+/// <returns>
+///   The result of the operation.
+/// </returns>
+/// <exception cref="ArgumentException">
+///   message is not a LIN message created by the message factory.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+VciResult LinControl::TryWriteMessage(bool         send, 
+                                      ILinMessage^ message)
+{
+  if (nullptr == m_pLinCtl)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
+
+  mgdLINMSG msg = ConvertToLINMSG(message);
+
+  pin_ptr<mgdLINMSG> pMsg = &msg;
+  return( VciResult(m_pLinCtl->WriteMessage(send, (PLINMSG)pMsg)) );
 }
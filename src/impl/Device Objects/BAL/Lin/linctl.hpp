@@ -56,6 +56,11 @@ private ref class LinControl : public LinSocket
     virtual void StopLine    (void );
     virtual void WriteMessage(bool         send, 
                               ILinMessage^ message);
+    virtual VciResult TryResetLine   (void );
+    virtual VciResult TryStartLine   (void );
+    virtual VciResult TryStopLine    (void );
+    virtual VciResult TryWriteMessage(bool         send, 
+                                      ILinMessage^ message);
 };
 
 
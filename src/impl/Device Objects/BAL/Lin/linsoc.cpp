@@ -7,6 +7,7 @@
 
 #include "linsoc.hpp"
 #include "vcinet.hpp"
+#include "..\balpool.hpp"
 
 
 using namespace Ixxat::Vci4::Bal::Lin;
@@ -50,9 +51,11 @@ LinSocket::LinSocket( ::IBalObject* pBalObj
 
   if (nullptr != pBalObj)
   {
-    hResult = pBalObj->OpenSocket( portNumber
-                                 , IID_ILinSocket
-                                 , (PVOID*) &pSocket);
+    // shared with the other sockets of the port if pooling is enabled
+    hResult = BalSocketPool::OpenSocket( pBalObj
+                                       , portNumber
+                                       , IID_ILinSocket
+                                       , (PVOID*) &pSocket);
     if (hResult == VCI_OK)
     {
       try
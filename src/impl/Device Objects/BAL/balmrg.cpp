@@ -0,0 +1,536 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the time ordered merge of several message
+//            readers.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "balmrg.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal;
+
+
+//*****************************************************************************
+/// <summary>
+///   Extends a 32-bit time stamp of the source to 64 bits. A step back
+///   by more than half of the counter range is taken as overrun, smaller
+///   steps back (e.g. info messages) keep the current epoch.
+/// </summary>
+/// <param name="dwTimeStamp">
+///   Raw time stamp of the message.
+/// </param>
+/// <returns>
+///   The extended time stamp in ticks.
+/// </returns>
+//*****************************************************************************
+UInt64 MergeSource::Extend(UInt32 dwTimeStamp)
+{
+  if ((dwTimeStamp < dwLast) && (dwLast - dwTimeStamp >= 0x80000000))
+  {
+    qwEpoch += 0x100000000;
+  }
+
+  dwLast = dwTimeStamp;
+  return( qwEpoch + dwTimeStamp );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for message merger objects.
+/// </summary>
+//*****************************************************************************
+MessageMerger::MessageMerger(void)
+{
+  m_pSources = gcnew List<MergeSource^>();
+  m_aHeap    = gcnew array<int>(4);
+  m_qwWindow = MRG_DEF_WINDOW;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Destructor for message merger objects. The readers of the sources
+///   are not disposed.
+/// </summary>
+//*****************************************************************************
+MessageMerger::~MessageMerger()
+{
+  m_pSources->Clear();
+  m_iHeapLen  = 0;
+  m_iPending  = 0;
+  m_fDisposed = true;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Throws an ObjectDisposedException if the merger is disposed.
+/// </summary>
+//*****************************************************************************
+void MessageMerger::CheckDisposed(void)
+{
+  if (m_fDisposed)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the reorder window.
+/// </summary>
+//*****************************************************************************
+TimeSpan MessageMerger::ReorderWindow::get(void)
+{
+  return( TimeSpan::FromTicks((Int64) (m_qwWindow / 100)) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Sets the reorder window.
+/// </summary>
+/// <exception cref="ArgumentOutOfRangeException">
+///   The value is negative.
+/// </exception>
+//*****************************************************************************
+void MessageMerger::ReorderWindow::set(TimeSpan value)
+{
+  if (value.Ticks < 0)
+  {
+    throw gcnew ArgumentOutOfRangeException("value");
+  }
+
+  m_qwWindow = (UInt64) value.Ticks * 100;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of registered sources.
+/// </summary>
+//*****************************************************************************
+int MessageMerger::SourceCount::get(void)
+{
+  return( m_pSources->Count );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of buffered messages not yet released.
+/// </summary>
+//*****************************************************************************
+int MessageMerger::PendingCount::get(void)
+{
+  return( m_iPending );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of messages received outside of the reorder window.
+/// </summary>
+//*****************************************************************************
+Int64 MessageMerger::LateCount::get(void)
+{
+  return( m_qwLate );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Registers a CAN message reader.
+/// </summary>
+/// <param name="reader">
+///   The message reader.
+/// </param>
+/// <param name="socket">
+///   The socket the reader belongs to.
+/// </param>
+/// <returns>
+///   Index of the source.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   One of the parameters was a null reference.
+/// </exception>
+//*****************************************************************************
+int MessageMerger::AddSource( ICanMessageReader^ reader
+                            , ICanSocket2^       socket )
+{
+  CheckDisposed();
+
+  if (nullptr == reader)
+  {
+    throw gcnew ArgumentNullException("reader");
+  }
+  if (nullptr == socket)
+  {
+    throw gcnew ArgumentNullException("socket");
+  }
+
+  MergeSource^ pSource = gcnew MergeSource();
+  pSource->pCanRd   = reader;
+  pSource->pTimeCnv = socket->TimeConverter;
+
+  return( Register(pSource) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Registers a LIN message reader.
+/// </summary>
+/// <param name="reader">
+///   The message reader.
+/// </param>
+/// <param name="socket">
+///   The socket the reader belongs to.
+/// </param>
+/// <returns>
+///   Index of the source.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   One of the parameters was a null reference.
+/// </exception>
+/// <exception cref="ArgumentException">
+///   The socket reports no time stamp clock.
+/// </exception>
+//*****************************************************************************
+int MessageMerger::AddSource( ILinMessageReader^ reader
+                            , ILinSocket^        socket )
+{
+  CheckDisposed();
+
+  if (nullptr == reader)
+  {
+    throw gcnew ArgumentNullException("reader");
+  }
+  if (nullptr == socket)
+  {
+    throw gcnew ArgumentNullException("socket");
+  }
+
+  UInt32 dwClock   = socket->ClockFrequency;
+  UInt32 dwDivisor = socket->TimeStampCounterDivisor;
+
+  if ((0 == dwClock) || (0 == dwDivisor))
+  {
+    throw gcnew ArgumentException("The socket reports no time stamp clock.", "socket");
+  }
+
+  MergeSource^ pSource = gcnew MergeSource();
+  pSource->pLinRd   = reader;
+  pSource->qwLinNum = (UInt64) dwDivisor * 1000000000;
+  pSource->qwLinDen = dwClock;
+
+  return( Register(pSource) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Adds a source to the merge.
+/// </summary>
+/// <param name="pSource">
+///   The new source.
+/// </param>
+/// <returns>
+///   Index of the source.
+/// </returns>
+//*****************************************************************************
+int MessageMerger::Register(MergeSource^ pSource)
+{
+  pSource->pQueue = gcnew Queue<MergedMessage>();
+
+  m_pSources->Add(pSource);
+  if (m_aHeap->Length < m_pSources->Count)
+  {
+    Array::Resize(m_aHeap, m_aHeap->Length * 2);
+  }
+
+  return( m_pSources->Count - 1 );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Assigns an event to the readers of all registered sources.
+/// </summary>
+/// <param name="fifoEvent">
+///   The event to assign.
+/// </param>
+//*****************************************************************************
+void MessageMerger::AssignEvent(AutoResetEvent^ fifoEvent)
+{
+  CheckDisposed();
+
+  for (int i = 0; i < m_pSources->Count; i++)
+  {
+    MergeSource^ pSource = m_pSources[i];
+
+    if (nullptr != pSource->pCanRd)
+    {
+      pSource->pCanRd->AssignEvent(fifoEvent);
+    }
+    else
+    {
+      pSource->pLinRd->AssignEvent(fifoEvent);
+    }
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Reads the available messages of all sources and returns the
+///   released messages.
+/// </summary>
+/// <param name="messages">
+///   Returns the released messages in time stamp order.
+/// </param>
+/// <returns>
+///   Number of released messages.
+/// </returns>
+//*****************************************************************************
+int MessageMerger::ReadMessages(array<MergedMessage>^% messages)
+{
+  CheckDisposed();
+
+  List<MergedMessage>^ pOut = gcnew List<MergedMessage>();
+
+  Poll();
+  Release(pOut, false);
+
+  messages = pOut->ToArray();
+  return( messages->Length );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Reads the available messages of all sources and returns all
+///   buffered messages.
+/// </summary>
+/// <param name="messages">
+///   Returns the buffered messages in time stamp order.
+/// </param>
+/// <returns>
+///   Number of returned messages.
+/// </returns>
+//*****************************************************************************
+int MessageMerger::Flush(array<MergedMessage>^% messages)
+{
+  CheckDisposed();
+
+  List<MergedMessage>^ pOut = gcnew List<MergedMessage>(m_iPending);
+
+  Poll();
+  Release(pOut, true);
+
+  messages = pOut->ToArray();
+  return( messages->Length );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Moves the available messages of all readers into the buffers of
+///   the sources.
+/// </summary>
+//*****************************************************************************
+void MessageMerger::Poll(void)
+{
+  for (int i = 0; i < m_pSources->Count; i++)
+  {
+    MergeSource^ pSource = m_pSources[i];
+
+    if (nullptr != pSource->pCanRd)
+    {
+      array<ICanMessage2^>^ aMsgs;
+      int iCount = pSource->pCanRd->ReadMessages(aMsgs);
+
+      for (int j = 0; j < iCount; j++)
+      {
+        ICanMessage2^ pMsg = aMsgs[j];
+        UInt64 qwTime = pSource->pTimeCnv->TimeStampToNanoseconds(
+                          pSource->Extend(pMsg->TimeStamp));
+
+        Push(i, MergedMessage(i, VciBusType::Can, qwTime,
+                              pMsg->Identifier, pMsg->DataLength, pMsg));
+      }
+    }
+    else
+    {
+      array<ILinMessage^>^ aMsgs;
+      int iCount = pSource->pLinRd->ReadMessages(aMsgs);
+
+      for (int j = 0; j < iCount; j++)
+      {
+        ILinMessage^ pMsg = aMsgs[j];
+
+        // the product exceeds 64 bits after some hours, so use decimal
+        Decimal dTime = Decimal::Divide(
+                          Decimal::Multiply(Decimal(pSource->Extend(pMsg->TimeStamp)),
+                                            Decimal(pSource->qwLinNum)),
+                          Decimal(pSource->qwLinDen));
+
+        Push(i, MergedMessage(i, VciBusType::Lin, Decimal::ToUInt64(dTime),
+                              pMsg->ProtId, pMsg->DataLength, pMsg));
+      }
+    }
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Appends a message to the buffer of a source.
+/// </summary>
+/// <param name="iSrc">
+///   Index of the source.
+/// </param>
+/// <param name="sMsg">
+///   The message.
+/// </param>
+//*****************************************************************************
+void MessageMerger::Push( int           iSrc
+                        , MergedMessage sMsg )
+{
+  MergeSource^ pSource = m_pSources[iSrc];
+  UInt64       qwTime  = sMsg.TimeStamp;
+
+  if (qwTime < m_qwLastOut)
+  {
+    m_qwLate++;
+  }
+  if (qwTime > m_qwMaxSeen)
+  {
+    m_qwMaxSeen = qwTime;
+  }
+
+  pSource->pQueue->Enqueue(sMsg);
+  m_iPending++;
+
+  if (1 == pSource->pQueue->Count)
+  {
+    pSource->qwHead = qwTime;
+    m_aHeap[m_iHeapLen] = iSrc;
+    SiftUp(m_iHeapLen++);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Releases buffered messages in time stamp order. The oldest message
+///   is released if every source has buffered messages, because each
+///   source delivers its messages in order, or if it is older than the
+///   youngest received message by at least the reorder window.
+/// </summary>
+/// <param name="pOut">
+///   List receiving the released messages.
+/// </param>
+/// <param name="fAll">
+///   true to release all buffered messages.
+/// </param>
+//*****************************************************************************
+void MessageMerger::Release( List<MergedMessage>^ pOut
+                           , bool                 fAll )
+{
+  while (m_iHeapLen > 0)
+  {
+    MergeSource^ pSource = m_pSources[m_aHeap[0]];
+
+    if (!fAll && (m_iHeapLen < m_pSources->Count) &&
+        (m_qwMaxSeen - pSource->qwHead < m_qwWindow))
+    {
+      break;
+    }
+
+    MergedMessage sMsg = pSource->pQueue->Dequeue();
+    pOut->Add(sMsg);
+    m_iPending--;
+
+    if (sMsg.TimeStamp > m_qwLastOut)
+    {
+      m_qwLastOut = sMsg.TimeStamp;
+    }
+
+    if (pSource->pQueue->Count > 0)
+    {
+      pSource->qwHead = pSource->pQueue->Peek().TimeStamp;
+    }
+    else
+    {
+      m_aHeap[0] = m_aHeap[--m_iHeapLen];
+    }
+
+    SiftDown(0);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Compares the oldest buffered messages of two sources. Equal time
+///   stamps are ordered by the source index.
+/// </summary>
+//*****************************************************************************
+bool MessageMerger::IsLess( int iLeft
+                          , int iRight )
+{
+  UInt64 qwLeft  = m_pSources[iLeft]->qwHead;
+  UInt64 qwRight = m_pSources[iRight]->qwHead;
+
+  return( (qwLeft < qwRight) || ((qwLeft == qwRight) && (iLeft < iRight)) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Moves a heap entry up to its place.
+/// </summary>
+//*****************************************************************************
+void MessageMerger::SiftUp(int iPos)
+{
+  int iSrc = m_aHeap[iPos];
+
+  while (iPos > 0)
+  {
+    int iParent = (iPos - 1) / 2;
+
+    if (!IsLess(iSrc, m_aHeap[iParent]))
+    {
+      break;
+    }
+
+    m_aHeap[iPos] = m_aHeap[iParent];
+    iPos = iParent;
+  }
+
+  m_aHeap[iPos] = iSrc;
+}
+
+//*****************************************************************************
+/// <summary>
+///   Moves a heap entry down to its place.
+/// </summary>
+//*****************************************************************************
+void MessageMerger::SiftDown(int iPos)
+{
+  if (iPos >= m_iHeapLen)
+  {
+    return;
+  }
+
+  int iSrc = m_aHeap[iPos];
+
+  for (;;)
+  {
+    int iChild = 2 * iPos + 1;
+
+    if (iChild >= m_iHeapLen)
+    {
+      break;
+    }
+    if ((iChild + 1 < m_iHeapLen) && IsLess(m_aHeap[iChild + 1], m_aHeap[iChild]))
+    {
+      iChild++;
+    }
+    if (!IsLess(m_aHeap[iChild], iSrc))
+    {
+      break;
+    }
+
+    m_aHeap[iPos] = m_aHeap[iChild];
+    iPos = iChild;
+  }
+
+  m_aHeap[iPos] = iSrc;
+}
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the time ordered merge of several message
+//            readers.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Runtime::InteropServices;
+using namespace System::Threading;
+using namespace Ixxat::Vci4::Bal::Can;
+using namespace Ixxat::Vci4::Bal::Lin;
+
+
+// default reorder window in ns
+#define MRG_DEF_WINDOW        10000000
+
+
+//*****************************************************************************
+/// <summary>
+///   A single source of the merge with its message buffer.
+/// </summary>
+//*****************************************************************************
+private ref class MergeSource
+{
+  internal:
+    ICanMessageReader^    pCanRd;    // CAN reader or null
+    ILinMessageReader^    pLinRd;    // LIN reader or null
+    ICanTimeConverter^    pTimeCnv;  // converter of the CAN socket
+    UInt64                qwLinNum;  // LIN: ns = ticks * qwLinNum / qwLinDen
+    UInt64                qwLinDen;
+    UInt32                dwLast;    // last raw time stamp
+    UInt64                qwEpoch;   // counted overruns of the raw time stamp
+    Queue<MergedMessage>^ pQueue;    // buffered messages
+    UInt64                qwHead;    // time stamp of the oldest buffered message
+
+    UInt64 Extend ( UInt32 dwTimeStamp );
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   This class implements the time ordered merge of several message
+///   readers.
+/// </summary>
+//*****************************************************************************
+private ref class MessageMerger : public IMessageMerger
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    List<MergeSource^>^ m_pSources;   // registered sources
+    array<int>^         m_aHeap;      // min-heap of the non-empty sources
+    int                 m_iHeapLen;   // number of entries of m_aHeap
+    UInt64              m_qwWindow;   // reorder window in ns
+    UInt64              m_qwMaxSeen;  // youngest received time stamp
+    UInt64              m_qwLastOut;  // youngest released time stamp
+    int                 m_iPending;   // number of buffered messages
+    Int64               m_qwLate;     // number of late messages
+    bool                m_fDisposed;  // true if the merger is disposed
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    void CheckDisposed ( void );
+    int  Register      ( MergeSource^ pSource );
+    void Poll          ( void );
+    void Push          ( int            iSrc
+                       , MergedMessage  sMsg );
+    void Release       ( List<MergedMessage>^ pOut
+                       , bool                 fAll );
+    bool IsLess        ( int iLeft
+                       , int iRight );
+    void SiftUp        ( int iPos );
+    void SiftDown      ( int iPos );
+
+  internal:
+    MessageMerger  ( void );
+    ~MessageMerger ( );
+
+  //--------------------------------------------------------------------
+  // IMessageMerger implementation
+  //--------------------------------------------------------------------
+  public:
+    virtual property TimeSpan ReorderWindow { TimeSpan get(void);
+                                              void     set(TimeSpan value); };
+    virtual property int      SourceCount   { int      get(void); };
+    virtual property int      PendingCount  { int      get(void); };
+    virtual property Int64    LateCount     { Int64    get(void); };
+
+    virtual int  AddSource    ( ICanMessageReader^             reader
+                              , ICanSocket2^                   socket );
+    virtual int  AddSource    ( ILinMessageReader^             reader
+                              , ILinSocket^                    socket );
+    virtual void AssignEvent  ( AutoResetEvent^                fifoEvent );
+    virtual int  ReadMessages ( [Out] array<MergedMessage>^%   messages );
+    virtual int  Flush        ( [Out] array<MergedMessage>^%   messages );
+};
+
+
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
@@ -7,6 +7,7 @@
 
 #include "balobj.hpp"
 #include "vcinet.hpp"
+#include "balpool.hpp"
 
 #include ".\can\cansoc.hpp"
 #include ".\can\cansoc2.hpp"
@@ -16,6 +17,7 @@
 #include ".\can\canchn2.hpp"
 #include ".\can\canshd.hpp"
 #include ".\can\canshd2.hpp"
+#include ".\can\canlsm.hpp"
 
 #include ".\lin\linsoc.hpp"
 #include ".\lin\linctl.hpp"
@@ -43,12 +45,31 @@ BalObject::BalObject(::IVciDevice* pDevice)
 {
   HRESULT       hResult;
   ::IBalObject* pBalObj;
+  VCIDEVICEINFO sDevInfo;
 
   m_pBalObj = nullptr;
 
   if (nullptr != pDevice)
   {
-    hResult = pDevice->OpenComponent(CLSID_VCIBAL, IID_IBalObject, (PVOID*) &pBalObj);
+    // the unique hardware id identifies the device in the capability
+    // cache of the CAN sockets
+    hResult = pDevice->GetDeviceInfo(&sDevInfo);
+    if (hResult == VCI_OK)
+    {
+      m_deviceId = Guid( sDevInfo.UniqueHardwareId.AsGuid.Data1
+                       , sDevInfo.UniqueHardwareId.AsGuid.Data2
+                       , sDevInfo.UniqueHardwareId.AsGuid.Data3
+                       , sDevInfo.UniqueHardwareId.AsGuid.Data4[0]
+                       , sDevInfo.UniqueHardwareId.AsGuid.Data4[1]
+                       , sDevInfo.UniqueHardwareId.AsGuid.Data4[2]
+                       , sDevInfo.UniqueHardwareId.AsGuid.Data4[3]
+                       , sDevInfo.UniqueHardwareId.AsGuid.Data4[4]
+                       , sDevInfo.UniqueHardwareId.AsGuid.Data4[5]
+                       , sDevInfo.UniqueHardwareId.AsGuid.Data4[6]
+                       , sDevInfo.UniqueHardwareId.AsGuid.Data4[7] );
+
+      hResult = pDevice->OpenComponent(CLSID_VCIBAL, IID_IBalObject, (PVOID*) &pBalObj);
+    }
     if (hResult == VCI_OK)
     {
       hResult = InitNew(pBalObj);
@@ -148,6 +169,8 @@ void BalObject::Cleanup(void)
 
   if (nullptr != m_pBalObj)
   {
+    // the pool is keyed by the native BAL object, which may be reused
+    BalSocketPool::Disable(m_pBalObj);
     m_pBalObj->Release();
     m_pBalObj = nullptr;
   }
@@ -236,6 +259,111 @@ BalResourceCollection^ BalObject::Resources::get(void)
   //*****************************************************************************
 IBalResource^ BalObject::OpenSocket( Byte   portNumber
                                    , Type^  socketType)
+{
+  if (nullptr == socketType)
+  {
+    throw gcnew ArgumentNullException("socketType");
+  }
+
+  return( CreateSocket(portNumber, GetSocketKind(socketType)) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   This method opens the bus socket of the specified interface type.
+///   The socket class is resolved once per interface type.
+/// </summary>
+/// <param name="portNumber">
+///   Number of the bus socket to open. This parameter must be within the
+///   range of 0 to <c>Resources.Count</c> - 1.
+/// </param>
+/// <returns>
+///   The opened bus socket object.
+/// </returns>
+/// <exception cref="VciException">
+///   Opening socket failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   The specified port number is out of range.
+/// </exception>
+/// <exception cref="NotImplementedException">
+///   There's no implementation for the socket type T.
+/// </exception>
+//*****************************************************************************
+generic <typename T> where T : IBalResource
+T BalObject::OpenSocket(Byte portNumber)
+{
+  return( safe_cast<T>(CreateSocket(portNumber, BalSocketKindOf<T>::Kind)) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Creates the table of the socket kinds by socket interface type.
+/// </summary>
+//*****************************************************************************
+Dictionary<Type^, BalSocketKind>^ BalObject::CreateKindTable(void)
+{
+  Dictionary<Type^, BalSocketKind>^ pKinds = gcnew Dictionary<Type^, BalSocketKind>();
+
+  pKinds->Add(Ixxat::Vci4::Bal::Can::ICanSocket::typeid,            BalSocketKind::CanSocket);
+  pKinds->Add(Ixxat::Vci4::Bal::Can::ICanSocket2::typeid,           BalSocketKind::CanSocket2);
+  pKinds->Add(Ixxat::Vci4::Bal::Can::ICanControl::typeid,           BalSocketKind::CanControl);
+  pKinds->Add(Ixxat::Vci4::Bal::Can::ICanControl2::typeid,          BalSocketKind::CanControl2);
+  pKinds->Add(Ixxat::Vci4::Bal::Can::ICanChannel::typeid,           BalSocketKind::CanChannel);
+  pKinds->Add(Ixxat::Vci4::Bal::Can::ICanChannel2::typeid,          BalSocketKind::CanChannel2);
+  pKinds->Add(Ixxat::Vci4::Bal::Can::ICanScheduler::typeid,         BalSocketKind::CanScheduler);
+  pKinds->Add(Ixxat::Vci4::Bal::Can::ICanScheduler2::typeid,        BalSocketKind::CanScheduler2);
+  pKinds->Add(Ixxat::Vci4::Bal::Can::ICanLineStatusMonitor::typeid, BalSocketKind::CanLineStatusMonitor);
+  pKinds->Add(Ixxat::Vci4::Bal::Lin::ILinSocket::typeid,            BalSocketKind::LinSocket);
+  pKinds->Add(Ixxat::Vci4::Bal::Lin::ILinControl::typeid,           BalSocketKind::LinControl);
+  pKinds->Add(Ixxat::Vci4::Bal::Lin::ILinMonitor::typeid,           BalSocketKind::LinMonitor);
+
+  return( pKinds );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the socket kind of a socket interface type.
+/// </summary>
+/// <param name="socketType">
+///   Type of the socket interface.
+/// </param>
+/// <returns>
+///   The socket kind or <c>BalSocketKind::None</c> if there's no
+///   implementation for the type.
+/// </returns>
+//*****************************************************************************
+BalSocketKind BalObject::GetSocketKind(Type^ socketType)
+{
+  BalSocketKind kind;
+
+  if (!ms_pKinds->TryGetValue(socketType, kind))
+  {
+    kind = BalSocketKind::None;
+  }
+
+  return( kind );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Creates the socket object of the specified kind.
+/// </summary>
+/// <param name="portNumber">
+///   Number of the bus socket to open.
+/// </param>
+/// <param name="kind">
+///   Kind of the socket to open.
+/// </param>
+/// <returns>
+///   The opened bus socket object.
+/// </returns>
+//*****************************************************************************
+IBalResource^ BalObject::CreateSocket( Byte          portNumber
+                                     , BalSocketKind kind )
 {
   IBalResource^ pSocket = nullptr;
 
@@ -250,49 +378,37 @@ IBalResource^ BalObject::OpenSocket( Byte   portNumber
         case VCI_BUS_CAN:
         //----------------------------------------------------------------
         {
-          // ICanSocket
-          if (socketType->Equals(Ixxat::Vci4::Bal::Can::ICanSocket::typeid))
-          {
-            pSocket = gcnew CanSocket(m_pBalObj, portNumber, bBusTypeIndex);
-          }
-          // ICanSocket2
-          else if (socketType->Equals(Ixxat::Vci4::Bal::Can::ICanSocket2::typeid))
-          {
-            pSocket = gcnew CanSocket2(m_pBalObj, portNumber, bBusTypeIndex);
-          }
-          // ICanControl
-          else if (socketType->Equals(Ixxat::Vci4::Bal::Can::ICanControl::typeid))
-          {
-            pSocket = gcnew CanControl(m_pBalObj, portNumber, bBusTypeIndex);
-          }
-          // ICanControl2
-          else if (socketType->Equals(Ixxat::Vci4::Bal::Can::ICanControl2::typeid))
-          {
-            pSocket = gcnew CanControl2(m_pBalObj, portNumber, bBusTypeIndex);
-          }
-          // ICanChannel
-          else if (socketType->Equals(Ixxat::Vci4::Bal::Can::ICanChannel::typeid))
-          {
-            pSocket = gcnew CanChannel(m_pBalObj, portNumber, bBusTypeIndex);
-          }
-          // ICanChannel2
-          else if (socketType->Equals(Ixxat::Vci4::Bal::Can::ICanChannel2::typeid))
-          {
-            pSocket = gcnew CanChannel2(m_pBalObj, portNumber, bBusTypeIndex);
-          }
-          // ICanScheduler
-          else if (socketType->Equals(Ixxat::Vci4::Bal::Can::ICanScheduler::typeid))
-          {
-            pSocket = gcnew CanScheduler(m_pBalObj, portNumber, bBusTypeIndex);
-          }
-          // ICanScheduler2
-          else if (socketType->Equals(Ixxat::Vci4::Bal::Can::ICanScheduler2::typeid))
-          {
-            pSocket = gcnew CanScheduler2(m_pBalObj, portNumber, bBusTypeIndex);
-          }
-          else
+          switch (kind)
           {
-            throw gcnew NotImplementedException();
+            case BalSocketKind::CanSocket:
+              pSocket = gcnew CanSocket(m_pBalObj, portNumber, bBusTypeIndex);
+              break;
+            case BalSocketKind::CanSocket2:
+              pSocket = gcnew CanSocket2(m_pBalObj, m_deviceId, portNumber, bBusTypeIndex);
+              break;
+            case BalSocketKind::CanControl:
+              pSocket = gcnew CanControl(m_pBalObj, portNumber, bBusTypeIndex);
+              break;
+            case BalSocketKind::CanControl2:
+              pSocket = gcnew CanControl2(m_pBalObj, m_deviceId, portNumber, bBusTypeIndex);
+              break;
+            case BalSocketKind::CanChannel:
+              pSocket = gcnew CanChannel(m_pBalObj, portNumber, bBusTypeIndex);
+              break;
+            case BalSocketKind::CanChannel2:
+              pSocket = gcnew CanChannel2(m_pBalObj, m_deviceId, portNumber, bBusTypeIndex);
+              break;
+            case BalSocketKind::CanScheduler:
+              pSocket = gcnew CanScheduler(m_pBalObj, portNumber, bBusTypeIndex);
+              break;
+            case BalSocketKind::CanScheduler2:
+              pSocket = gcnew CanScheduler2(m_pBalObj, m_deviceId, portNumber, bBusTypeIndex);
+              break;
+            case BalSocketKind::CanLineStatusMonitor:
+              pSocket = gcnew CanLineStatusMonitor(m_pBalObj, m_deviceId, portNumber, bBusTypeIndex);
+              break;
+            default:
+              throw gcnew NotImplementedException();
           }
         } break;
 
@@ -300,20 +416,19 @@ IBalResource^ BalObject::OpenSocket( Byte   portNumber
         case VCI_BUS_LIN:
         //----------------------------------------------------------------
         {
-          // ILinSocket
-          if (socketType->Equals(Ixxat::Vci4::Bal::Lin::ILinSocket::typeid))
+          switch (kind)
           {
-            pSocket = gcnew LinSocket(m_pBalObj, portNumber, bBusTypeIndex);
-          }
-          // ILinControl
-          else if (socketType->Equals(Ixxat::Vci4::Bal::Lin::ILinControl::typeid))
-          {
-            pSocket = gcnew LinControl(m_pBalObj, portNumber, bBusTypeIndex);
-          }
-          // ILinMonitor
-          else if (socketType->Equals(Ixxat::Vci4::Bal::Lin::ILinMonitor::typeid))
-          {
-            pSocket = gcnew LinMonitor(m_pBalObj, portNumber, bBusTypeIndex);
+            case BalSocketKind::LinSocket:
+              pSocket = gcnew LinSocket(m_pBalObj, portNumber, bBusTypeIndex);
+              break;
+            case BalSocketKind::LinControl:
+              pSocket = gcnew LinControl(m_pBalObj, portNumber, bBusTypeIndex);
+              break;
+            case BalSocketKind::LinMonitor:
+              pSocket = gcnew LinMonitor(m_pBalObj, portNumber, bBusTypeIndex);
+              break;
+            default:
+              throw gcnew NotImplementedException();
           }
         } break;
 
@@ -344,6 +459,44 @@ IBalResource^ BalObject::OpenSocket( Byte   portNumber
   return( pSocket );
 }
 
+//*****************************************************************************
+/// <summary>
+///   Gets or sets whether the basic native sockets of the ports are
+///   pooled. With pooling all socket objects of a port share one native
+///   socket, which is kept open until pooling is disabled or the BAL
+///   object is disposed.
+/// </summary>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+bool BalObject::SocketPooling::get(void)
+{
+  if (nullptr == m_pBalObj)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  return( BalSocketPool::IsEnabled(m_pBalObj) );
+}
+
+void BalObject::SocketPooling::set(bool fEnable)
+{
+  if (nullptr == m_pBalObj)
+  {
+    throw gcnew ObjectDisposedException(this->GetType()->FullName);
+  }
+
+  if (fEnable)
+  {
+    BalSocketPool::Enable(m_pBalObj);
+  }
+  else
+  {
+    BalSocketPool::Disable(m_pBalObj);
+  }
+}
+
 //*****************************************************************************
 /// <summary>
 ///   Gets the firmware version.
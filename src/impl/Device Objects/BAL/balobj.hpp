@@ -18,6 +18,29 @@ namespace Ixxat {
   namespace Vci4 {
     namespace Bal {
 
+//*****************************************************************************
+/// <summary>
+///   Socket classes which can be opened by <c>BalObject.OpenSocket</c>.
+/// </summary>
+//*****************************************************************************
+private enum class BalSocketKind
+{
+  None = 0,
+  CanSocket,
+  CanSocket2,
+  CanControl,
+  CanControl2,
+  CanChannel,
+  CanChannel2,
+  CanScheduler,
+  CanScheduler2,
+  CanLineStatusMonitor,
+  LinSocket,
+  LinControl,
+  LinMonitor
+};
+
+
 //*****************************************************************************
 /// <summary>
 ///   This class implements the BAL object.
@@ -32,6 +55,10 @@ private ref class BalObject : public IBalObject
     ::IBalObject*           m_pBalObj;    // pointer to the native device object
     PBALFEATURES            m_psBalInf;   // BAL features
     BalResourceCollection^  m_pSocCol;    // collection of available sockets
+    Guid                    m_deviceId;   // unique hardware id of the device
+
+    // socket kinds by socket interface type
+    static Dictionary<Type^, BalSocketKind>^ ms_pKinds = CreateKindTable();
 
   //--------------------------------------------------------------------
   // member functions
@@ -40,19 +67,45 @@ private ref class BalObject : public IBalObject
     HRESULT InitNew( ::IBalObject* pBalObj );
     void    Cleanup( void );
 
+    IBalResource^ CreateSocket( Byte          portNumber
+                              , BalSocketKind kind );
+
+    static Dictionary<Type^, BalSocketKind>^ CreateKindTable( void );
+
   internal:
     BalObject ( ::IVciDevice* pDevice );
     ~BalObject();
 
+    static BalSocketKind GetSocketKind( Type^ socketType );
+
   //--------------------------------------------------------------------
   // IBalObject implementation
   //--------------------------------------------------------------------
   public:
     virtual property Version^               FirmwareVersion{ Version^               get(void); };
     virtual property BalResourceCollection^ Resources      { BalResourceCollection^ get(void); };
+    virtual property bool                   SocketPooling  { bool get(void); void set(bool fEnable); };
 
     virtual IBalResource^ OpenSocket( Byte  portNumber
                                     , Type^ socketType );
+
+    generic <typename T> where T : IBalResource
+    virtual T OpenSocket( Byte portNumber );
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   Resolves the socket kind of the socket interface T once per type,
+///   so <c>BalObject.OpenSocket&lt;T&gt;</c> does not search the kind
+///   table on each call.
+/// </summary>
+//*****************************************************************************
+generic <typename T>
+private ref class BalSocketKindOf abstract sealed
+{
+  internal:
+    static BalSocketKind Kind = BalObject::GetSocketKind(T::typeid);
 };
 
 } // end of namespace Bal
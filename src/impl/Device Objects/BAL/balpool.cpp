@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the pool of native BAL sockets.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "balpool.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4::Bal;
+using namespace System::Threading;
+
+
+//*****************************************************************************
+/// <summary>
+///   Gets the pool slot of a native socket interface.
+/// </summary>
+/// <param name="riid">
+///   Interface id of the native socket.
+/// </param>
+/// <returns>
+///   The slot of the socket or -1 if sockets of this type are not pooled.
+/// </returns>
+//*****************************************************************************
+int BalSocketPool::GetSlot(REFIID riid)
+{
+  if (riid == IID_ICanSocket)
+  {
+    return( 0 );
+  }
+  if (riid == IID_ICanSocket2)
+  {
+    return( 1 );
+  }
+  if (riid == IID_ILinSocket)
+  {
+    return( 2 );
+  }
+
+  return( -1 );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Enables socket pooling for a native BAL object.
+/// </summary>
+/// <param name="pBalObj">
+///   Pointer to the native BAL object.
+/// </param>
+//*****************************************************************************
+void BalSocketPool::Enable(::IBalObject* pBalObj)
+{
+  Monitor::Enter(ms_pLock);
+  try
+  {
+    if (!ms_pPools->ContainsKey(IntPtr(pBalObj)))
+    {
+      BalSocketPoolEntry^ pEntry = gcnew BalSocketPoolEntry();
+      pEntry->pSockets = gcnew Dictionary<Int32, IntPtr>();
+      ms_pPools->Add(IntPtr(pBalObj), pEntry);
+    }
+  }
+  finally
+  {
+    Monitor::Exit(ms_pLock);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Disables socket pooling for a native BAL object and releases the
+///   references of the pool. Sockets still used by socket objects stay
+///   open until these are disposed.
+/// </summary>
+/// <param name="pBalObj">
+///   Pointer to the native BAL object.
+/// </param>
+//*****************************************************************************
+void BalSocketPool::Disable(::IBalObject* pBalObj)
+{
+  BalSocketPoolEntry^ pEntry;
+
+  Monitor::Enter(ms_pLock);
+  try
+  {
+    if (ms_pPools->TryGetValue(IntPtr(pBalObj), pEntry))
+    {
+      ms_pPools->Remove(IntPtr(pBalObj));
+
+      for each (IntPtr pSocket in pEntry->pSockets->Values)
+      {
+        ((IUnknown*) pSocket.ToPointer())->Release();
+      }
+      pEntry->pSockets->Clear();
+    }
+  }
+  finally
+  {
+    Monitor::Exit(ms_pLock);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Checks whether socket pooling is enabled for a native BAL object.
+/// </summary>
+/// <param name="pBalObj">
+///   Pointer to the native BAL object.
+/// </param>
+//*****************************************************************************
+bool BalSocketPool::IsEnabled(::IBalObject* pBalObj)
+{
+  Monitor::Enter(ms_pLock);
+  try
+  {
+    return( ms_pPools->ContainsKey(IntPtr(pBalObj)) );
+  }
+  finally
+  {
+    Monitor::Exit(ms_pLock);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Opens a native socket of a BAL object. If pooling is enabled for
+///   the BAL object and the socket type is pooled, the socket already
+///   opened for the port is returned.
+/// </summary>
+/// <param name="pBalObj">
+///   Pointer to the native BAL object.
+/// </param>
+/// <param name="portNumber">
+///   Number of the bus socket to open.
+/// </param>
+/// <param name="riid">
+///   Interface id of the native socket.
+/// </param>
+/// <param name="ppv">
+///   Receives the native socket. The caller has to release the returned
+///   interface.
+/// </param>
+/// <returns>
+///   VCI_OK on success, otherwise the error code of the VCI.
+/// </returns>
+//*****************************************************************************
+HRESULT BalSocketPool::OpenSocket( ::IBalObject* pBalObj
+                                 , Byte          portNumber
+                                 , REFIID        riid
+                                 , PVOID*        ppv )
+{
+  HRESULT             hResult;
+  BalSocketPoolEntry^ pEntry;
+  IntPtr              pSocket;
+  int                 iSlot = GetSlot(riid);
+
+  if (0 <= iSlot)
+  {
+    Monitor::Enter(ms_pLock);
+    try
+    {
+      if (ms_pPools->TryGetValue(IntPtr(pBalObj), pEntry))
+      {
+        Int32 iKey = (portNumber << 2) | iSlot;
+
+        hResult = VCI_OK;
+        if (!pEntry->pSockets->TryGetValue(iKey, pSocket))
+        {
+          PVOID pv = nullptr;
+
+          hResult = pBalObj->OpenSocket(portNumber, riid, &pv);
+          if (hResult == VCI_OK)
+          {
+            pSocket = IntPtr(pv);
+            pEntry->pSockets->Add(iKey, pSocket);
+          }
+        }
+
+        if (hResult == VCI_OK)
+        {
+          ((IUnknown*) pSocket.ToPointer())->AddRef();
+          *ppv = pSocket.ToPointer();
+        }
+
+        return( hResult );
+      }
+    }
+    finally
+    {
+      Monitor::Exit(ms_pLock);
+    }
+  }
+
+  return( pBalObj->OpenSocket(portNumber, riid, ppv) );
+}
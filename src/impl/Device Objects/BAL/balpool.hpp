@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the pool of native BAL sockets.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+    namespace Bal {
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+
+//*****************************************************************************
+/// <summary>
+///   Pooled native sockets of one native BAL object.
+/// </summary>
+//*****************************************************************************
+private ref class BalSocketPoolEntry
+{
+  internal:
+    // native sockets by port number and socket slot, each holds one
+    // reference of the pool
+    Dictionary<Int32, IntPtr>^ pSockets;
+};
+
+
+//*****************************************************************************
+/// <summary>
+///   Process wide pool of the basic native sockets (ICanSocket,
+///   ICanSocket2 and ILinSocket) of the native BAL objects with enabled
+///   socket pooling. All socket classes open one of these sockets for
+///   each port in their constructor. With pooling the socket is opened
+///   once per port and shared by reference counting, the pool keeps
+///   one reference until pooling is disabled or the BAL is disposed.
+///   Other sockets like controls or channels hold exclusive driver
+///   resources and are never pooled.
+///   All methods are thread-safe.
+/// </summary>
+//*****************************************************************************
+private ref class BalSocketPool abstract sealed
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    static Object^                                  ms_pLock  = gcnew Object();
+    static Dictionary<IntPtr, BalSocketPoolEntry^>^ ms_pPools =
+      gcnew Dictionary<IntPtr, BalSocketPoolEntry^>();
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  private:
+    static int GetSlot ( REFIID riid );
+
+  internal:
+    static void    Enable     ( ::IBalObject* pBalObj );
+    static void    Disable    ( ::IBalObject* pBalObj );
+    static bool    IsEnabled  ( ::IBalObject* pBalObj );
+    static HRESULT OpenSocket ( ::IBalObject* pBalObj
+                              , Byte          portNumber
+                              , REFIID        riid
+                              , PVOID*        ppv );
+};
+
+
+} // end of namespace Bal
+} // end of namespace Vci4
+} // end of namespace Ixxat
@@ -9,27 +9,145 @@
 #include "vcinet.hpp"
 
 using namespace Ixxat::Vci4;
+using namespace System::Threading;
+
+
+/*##########################################################################*/
+/*### Methods for VciDeviceInfoArray class                               ###*/
+/*##########################################################################*/
 
 //*****************************************************************************
 /// <summary>
-///   Constructor for VCI device objects.
+///   Constructor for device information arrays. The constructor fetches
+///   the remaining records of the enumerator in blocks of DEV_ENUM_BLOCK
+///   records into one contiguous native array.
 /// </summary>
-/// <param name="rDevInfo">
-///   Reference to an initialized native VCI devcie info record.
+/// <param name="pEnuDev">
+///   Pointer to the native device enumerator.
 ///</param>
+/// <remarks>
+///   The new array has a reference count of 1.
+/// </remarks>
 //*****************************************************************************
-VciDevice::VciDevice(VCIDEVICEINFO& rDevInfo)
+VciDeviceInfoArray::VciDeviceInfoArray(::IVciEnumDevice* pEnuDev)
 {
-  m_pDevObj = nullptr;
+  int iSize = DEV_ENUM_BLOCK;
 
-  // We have to dynamically allocate the native struct because
+  // We have to dynamically allocate the native structs because
   // native structs are no longer valid as member of managed classes !!
-  m_psDevInf = new VCIDEVICEINFO;
-  if (nullptr == m_psDevInf)
+  m_pasInfo = new VCIDEVICEINFO[iSize];
+  if (nullptr == m_pasInfo)
   {
     throw gcnew InsufficientMemoryException();
   }
-  *m_psDevInf = rDevInfo;
+
+  m_iCount = 0;
+  m_iRefs  = 1;
+
+  for (;;)
+  {
+    ULONG dwFetched = 0;
+
+    if (m_iCount + DEV_ENUM_BLOCK > iSize)
+    {
+      PVCIDEVICEINFO pasNew = new VCIDEVICEINFO[iSize * 2];
+      if (nullptr == pasNew)
+      {
+        delete[] m_pasInfo;
+        throw gcnew InsufficientMemoryException();
+      }
+
+      memcpy(pasNew, m_pasInfo, m_iCount * sizeof(VCIDEVICEINFO));
+      delete[] m_pasInfo;
+      m_pasInfo = pasNew;
+      iSize    *= 2;
+    }
+
+    pEnuDev->Next(DEV_ENUM_BLOCK, &m_pasInfo[m_iCount], &dwFetched);
+    m_iCount += (int) dwFetched;
+
+    if (dwFetched < DEV_ENUM_BLOCK)
+    {
+      break;
+    }
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the number of records of the array.
+/// </summary>
+//*****************************************************************************
+int VciDeviceInfoArray::Count::get(void)
+{
+  return( m_iCount );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets a pointer to a record of the array. The pointer is valid as long
+///   as the caller holds a reference to the array.
+/// </summary>
+/// <param name="iIndex">
+///   Index of the record.
+///</param>
+//*****************************************************************************
+PVCIDEVICEINFO VciDeviceInfoArray::GetInfo(int iIndex)
+{
+  return( &m_pasInfo[iIndex] );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Increments the reference count of the array.
+/// </summary>
+//*****************************************************************************
+void VciDeviceInfoArray::AddRef(void)
+{
+  Interlocked::Increment(m_iRefs);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Decrements the reference count of the array and frees the native
+///   records as soon as the count drops to 0.
+/// </summary>
+//*****************************************************************************
+void VciDeviceInfoArray::Release(void)
+{
+  if (0 == Interlocked::Decrement(m_iRefs))
+  {
+    delete[] m_pasInfo;
+    m_pasInfo = nullptr;
+  }
+}
+
+
+/*##########################################################################*/
+/*### Methods for VciDevice class                                        ###*/
+/*##########################################################################*/
+
+//*****************************************************************************
+/// <summary>
+///   Constructor for VCI device objects. The device object is a view on
+///   a record of the shared device information array.
+/// </summary>
+/// <param name="pInfos">
+///   The device information array.
+///</param>
+/// <param name="iIndex">
+///   Index of the device within the array.
+///</param>
+//*****************************************************************************
+VciDevice::VciDevice( VciDeviceInfoArray^ pInfos
+                    , int                 iIndex )
+{
+  m_pDevObj  = nullptr;
+  m_pHwId    = nullptr;
+  m_pCtrls   = nullptr;
+  m_pInfos   = pInfos;
+  m_pInfos->AddRef();
+  m_psDevInf = pInfos->GetInfo(iIndex);
 }
 
 //*****************************************************************************
@@ -39,23 +157,28 @@ VciDevice::VciDevice(VCIDEVICEINFO& rDevInfo)
 //*****************************************************************************
 VciDevice::~VciDevice()
 {
+  m_pCtrls = nullptr;
+
   if (nullptr != m_pDevObj)
   {
     m_pDevObj->Release();
     m_pDevObj = nullptr;
+    VciDeviceCache::CloseDevice(m_psDevInf->VciObjectId.AsInt64);
   }
 
   if (nullptr != m_psDevInf)
   {
-    delete m_psDevInf;
     m_psDevInf = nullptr;
+    m_pInfos->Release();
+    m_pInfos   = nullptr;
   }
 }
 
 //*****************************************************************************
 /// <summary>
 ///   This method opens the VCI device object and retrieves a pointer
-///   to it's native IVciDevice interface.
+///   to it's native IVciDevice interface. The native device object is
+///   shared with all other VCI device objects of the same device.
 /// </summary>
 /// <returns>
 ///   A pointer to the native IVciDevice interface of the opened device.
@@ -67,23 +190,13 @@ VciDevice::~VciDevice()
 
   if (nullptr == m_pDevObj)
   {
-    HRESULT              hResult = E_NOTIMPL;
-    ::IVciDeviceManager *  pDevMan = nullptr;
+    HRESULT hResult;
 
-    if (VciGetDeviceManagerFunc)
+    hResult = VciDeviceCache::OpenDevice(m_psDevInf->VciObjectId.AsInt64, &pDevObj);
+    if (hResult == VCI_OK)
     {
-      hResult = VciGetDeviceManagerFunc(&pDevMan);
-      if (hResult == VCI_OK)
-      {
-        hResult = pDevMan->OpenDevice(m_psDevInf->VciObjectId, &pDevObj);
-        if (hResult == VCI_OK)
-        {
-          m_pDevObj = pDevObj;
-          m_pDevObj->AddRef();
-        }
-
-        pDevMan->Release();
-      }
+      m_pDevObj = pDevObj;
+      m_pDevObj->AddRef();
     }
 
     if (hResult != VCI_OK)
@@ -204,6 +317,31 @@ Version^ VciDevice::HardwareVersion::get()
                       , m_psDevInf->HardwareBuildVersion);
 }
 
+//*****************************************************************************
+/// <summary>
+///   Compares the raw unique hardware id with the one of another device
+///   object without decoding either of them.
+/// </summary>
+/// <param name="pOther">
+///   The device object to compare with.
+/// </param>
+/// <returns>
+///   true if both devices have the same hardware id, false if they differ
+///   or one of them is disposed.
+/// </returns>
+//*****************************************************************************
+bool VciDevice::IsSameHardware(VciDevice^ pOther)
+{
+  if ((nullptr == pOther) || (nullptr == m_psDevInf) || (nullptr == pOther->m_psDevInf))
+  {
+    return( false );
+  }
+
+  return( 0 == memcmp( &m_psDevInf->UniqueHardwareId
+                     , &pOther->m_psDevInf->UniqueHardwareId
+                     , sizeof(m_psDevInf->UniqueHardwareId)) );
+}
+
 //*****************************************************************************
 /// <summary>
 ///   Gets the unique ID of the adapter. Each adapter has a unique ID that can
@@ -221,6 +359,7 @@ Version^ VciDevice::HardwareVersion::get()
 ///       otherwise interpret the hardware ID string
 ///   Note that there is a chance that a hardware ID that is originally meant to be
 ///   GUID is interpreted as a string.
+///   The ID is decoded on the first call only.
 /// </summary>
 /// <returns>
 ///   Unique hardware id of the device.
@@ -238,6 +377,11 @@ Object^ VciDevice::UniqueHardwareId::get()
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
 
+  if (nullptr != m_pHwId)
+  {
+    return( m_pHwId );
+  }
+
   // find last non 0 character
   int lastidx;
   for (lastidx = ARRAYSIZE(m_psDevInf->UniqueHardwareId.AsChar) - 1; lastidx >= 0; --lastidx)
@@ -280,6 +424,7 @@ Object^ VciDevice::UniqueHardwareId::get()
                               , lastidx + 1);
   }
 
+  m_pHwId = rHardwareId;
   return rHardwareId;
 }
 
@@ -327,28 +472,34 @@ String^ VciDevice::Manufacturer::get()
 
 //*****************************************************************************
 /// <summary>
-///   Gets a description of the hardware equipment of the device.
+///   This method reads the device capabilities on the first call and
+///   keeps the decoded controller infos in m_pCtrls. The cache is
+///   dropped when the device object is disposed.
 /// </summary>
 /// <returns>
-///   The retrieved array contains a <c>VciCtrlInfo</c> for each 
-///   existing fieldbus controller.
+///   VCI_OK on success, otherwise the error code of GetDeviceCaps.
 /// </returns>
 /// <exception cref="ObjectDisposedException">
 ///   Object is already disposed.
 /// </exception>
 //*****************************************************************************
-array<IVciCtrlInfo^>^ VciDevice::Equipment::get(void)
+HRESULT VciDevice::LoadControllers()
 {
-  HRESULT              hResult;
-  ::IVciDevice*        pDevObj;
-  VCIDEVICECAPS        sDevCap;
-  array<VciCtrlInfo^>^  aCtrlInfos = nullptr;
+  HRESULT               hResult = VCI_OK;
+  ::IVciDevice*         pDevObj;
+  VCIDEVICECAPS         sDevCap;
+  array<IVciCtrlInfo^>^ aCtrlInfos;
 
   if (nullptr == m_psDevInf)
   {
     throw gcnew ObjectDisposedException(this->GetType()->FullName);
   }
 
+  if (nullptr != m_pCtrls)
+  {
+    return( hResult );
+  }
+
   pDevObj = OpenDevice();
 
   if (nullptr != pDevObj)
@@ -358,11 +509,15 @@ array<IVciCtrlInfo^>^ VciDevice::Equipment::get(void)
       hResult = pDevObj->GetDeviceCaps(&sDevCap);
       if (hResult == VCI_OK)
       {
-        aCtrlInfos = gcnew array<VciCtrlInfo^>(sDevCap.BusCtrlCount);
+        aCtrlInfos = gcnew array<IVciCtrlInfo^>(sDevCap.BusCtrlCount);
         for (UINT8 idx = 0; idx < sDevCap.BusCtrlCount; idx++)
         {
           aCtrlInfos[idx] = gcnew VciCtrlInfo(sDevCap.BusCtrlTypes[idx]);
         }
+
+        // concurrent callers may decode twice, but only one result is kept
+        Interlocked::CompareExchange<ReadOnlyCollection<IVciCtrlInfo^>^>(
+          m_pCtrls, gcnew ReadOnlyCollection<IVciCtrlInfo^>(aCtrlInfos), nullptr);
       }
     }
     finally
@@ -371,9 +526,65 @@ array<IVciCtrlInfo^>^ VciDevice::Equipment::get(void)
     }
   }
 
+  return( hResult );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets a description of the hardware equipment of the device.
+///   The device capabilities are read on the first call only, further
+///   calls return a copy of the cached controller infos.
+/// </summary>
+/// <returns>
+///   The retrieved array contains a <c>VciCtrlInfo</c> for each 
+///   existing fieldbus controller.
+/// </returns>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+array<IVciCtrlInfo^>^ VciDevice::Equipment::get(void)
+{
+  array<IVciCtrlInfo^>^ aCtrlInfos = nullptr;
+
+  if (VCI_OK == LoadControllers())
+  {
+    aCtrlInfos = gcnew array<IVciCtrlInfo^>(m_pCtrls->Count);
+    m_pCtrls->CopyTo(aCtrlInfos, 0);
+  }
+
   return( aCtrlInfos );
 }
 
+//*****************************************************************************
+/// <summary>
+///   Gets the cached, read-only list of the fieldbus controllers of the
+///   device. The device capabilities are read on the first call only,
+///   further calls return the same list without allocating.
+/// </summary>
+/// <returns>
+///   A read-only list with a <c>VciCtrlInfo</c> for each existing
+///   fieldbus controller.
+/// </returns>
+/// <exception cref="VciException">
+///   Reading the device capabilities failed.
+/// </exception>
+/// <exception cref="ObjectDisposedException">
+///   Object is already disposed.
+/// </exception>
+//*****************************************************************************
+IList<IVciCtrlInfo^>^ VciDevice::Controllers::get(void)
+{
+  HRESULT hResult = LoadControllers();
+
+  if (hResult != VCI_OK)
+  {
+    throw gcnew VciException(VciServerImpl::Instance(), hResult);
+  }
+
+  return( m_pCtrls );
+}
+
 //*****************************************************************************
 /// <summary>
 ///   This method is called to open the Bus Access Layer.
@@ -15,6 +15,42 @@
 namespace Ixxat {
   namespace Vci4 {
 
+using namespace System::Collections::Generic;
+using namespace System::Collections::ObjectModel;
+
+// number of device infos fetched per call of IVciEnumDevice::Next
+#define DEV_ENUM_BLOCK        16
+
+//*****************************************************************************
+/// <summary>
+///   Reference counted native array of VCI device information records.
+///   The array is filled in blocks by a native device enumerator and
+///   shared by all device objects created from it.
+/// </summary>
+//*****************************************************************************
+private ref class VciDeviceInfoArray
+{
+  //--------------------------------------------------------------------
+  // member variables
+  //--------------------------------------------------------------------
+  private:
+    PVCIDEVICEINFO  m_pasInfo;  // contiguous native records
+    int             m_iCount;   // number of valid records
+    int             m_iRefs;    // reference count
+
+  //--------------------------------------------------------------------
+  // member functions
+  //--------------------------------------------------------------------
+  internal:
+    VciDeviceInfoArray( ::IVciEnumDevice* pEnuDev );
+
+    property int    Count { int get(void); };
+
+    PVCIDEVICEINFO  GetInfo ( int iIndex );
+    void            AddRef  ( void );
+    void            Release ( void );
+};
+
 //*****************************************************************************
 /// <summary>
 ///   This class implements a VCI device object.
@@ -26,19 +62,26 @@ private ref class VciDevice : public IVciDevice
   // member variables
   //--------------------------------------------------------------------
   private:
-    ::IVciDevice*   m_pDevObj;  // pointer to the native device object
-    PVCIDEVICEINFO  m_psDevInf; // pointer to the native device information
+    ::IVciDevice*       m_pDevObj;  // pointer to the native device object
+    PVCIDEVICEINFO      m_psDevInf; // pointer to the native device information
+    VciDeviceInfoArray^ m_pInfos;   // array which holds m_psDevInf
+    Object^             m_pHwId;    // decoded hardware id or null
+    ReadOnlyCollection<IVciCtrlInfo^>^ m_pCtrls; // decoded controller infos or null
 
   //--------------------------------------------------------------------
   // member functions
   //--------------------------------------------------------------------
   private:
     ::IVciDevice* OpenDevice();
+    HRESULT       LoadControllers();
 
   internal:
-    VciDevice( VCIDEVICEINFO& rDevInfo );
+    VciDevice( VciDeviceInfoArray^ pInfos
+             , int                 iIndex );
     ~VciDevice();
 
+    bool IsSameHardware( VciDevice^ pOther );
+
   public:
     virtual String^ ToString() override;
 
@@ -54,6 +97,7 @@ private ref class VciDevice : public IVciDevice
     virtual property String^              Description       { String^             get(void); };
     virtual property String^              Manufacturer      { String^             get(void); };
     virtual property array<IVciCtrlInfo^>^ Equipment        { array<IVciCtrlInfo^>^ get(void); };
+    virtual property IList<IVciCtrlInfo^>^ Controllers      { IList<IVciCtrlInfo^>^ get(void); };
 
     virtual Ixxat::Vci4::Bal::IBalObject^ OpenBusAccessLayer();
 };
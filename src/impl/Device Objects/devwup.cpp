@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Implementation of the concurrent warm-up of VCI devices.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#include "devwup.hpp"
+#include "vcinet.hpp"
+
+using namespace Ixxat::Vci4;
+using namespace System::Diagnostics;
+
+
+//*****************************************************************************
+/// <summary>
+///   Converts a difference of Stopwatch time stamps into a time span.
+/// </summary>
+//*****************************************************************************
+static TimeSpan ElapsedTime(Int64 qwTicks)
+{
+  return( TimeSpan::FromTicks(qwTicks * TimeSpan::TicksPerSecond
+                              / Stopwatch::Frequency) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Worker thread procedure.
+/// </summary>
+//*****************************************************************************
+void VciWarmUpJob::Run(void)
+{
+  int iDev;
+
+  while ((iDev = Interlocked::Increment(iNext) - 1) < aDevices->Length)
+  {
+    WarmUp(iDev);
+  }
+}
+
+//*****************************************************************************
+/// <summary>
+///   Opens the native device, the BAL and the sockets of one device and
+///   stores the result. On failure all objects opened for the device are
+///   disposed again.
+/// </summary>
+/// <param name="iDev">
+///   Index of the device.
+/// </param>
+//*****************************************************************************
+void VciWarmUpJob::WarmUp(int iDev)
+{
+  IVciDevice^           pDev     = aDevices[iDev];
+  IBalObject^           pBal     = nullptr;
+  List<IBalResource^>^  pSockets = gcnew List<IBalResource^>();
+  Exception^            pError   = nullptr;
+  Int64                 qwDev    = 0;
+  Int64                 qwBal    = 0;
+  Int64                 qwSoc    = 0;
+  Int64                 qwMark   = Stopwatch::GetTimestamp();
+
+  try
+  {
+    // opens the native device and reads the cached capabilities
+    IList<IVciCtrlInfo^>^ pCtrls = pDev->Controllers;
+    GC::KeepAlive(pCtrls);
+    qwDev   = Stopwatch::GetTimestamp() - qwMark;
+    qwMark += qwDev;
+
+    pBal    = pDev->OpenBusAccessLayer();
+    qwBal   = Stopwatch::GetTimestamp() - qwMark;
+    qwMark += qwBal;
+
+    if (nullptr != aTypes)
+    {
+      for (int iPort = 0; iPort < pBal->Resources->Count; iPort++)
+      {
+        for (int iType = 0; iType < aTypes->Length; iType++)
+        {
+          try
+          {
+            pSockets->Add(pBal->OpenSocket((Byte) iPort, aTypes[iType]));
+          }
+          catch (NotImplementedException^)
+          {
+            // socket type does not fit the bus type of the port
+          }
+        }
+      }
+    }
+    qwSoc = Stopwatch::GetTimestamp() - qwMark;
+  }
+  catch (Exception^ pExc)
+  {
+    pError = pExc;
+
+    for (int i = pSockets->Count - 1; i >= 0; i--)
+    {
+      delete pSockets[i];
+    }
+    pSockets->Clear();
+
+    delete pBal;
+    pBal = nullptr;
+  }
+
+  aResult[iDev] = VciWarmUpResult(pDev, pBal, pSockets->ToArray(),
+                                  ElapsedTime(qwDev), ElapsedTime(qwBal),
+                                  ElapsedTime(qwSoc), pError);
+}
+
+//*****************************************************************************
+/// <summary>
+///   Warms up the specified devices on at most iMaxPar worker threads.
+/// </summary>
+/// <param name="aDevices">
+///   Devices to warm up.
+/// </param>
+/// <param name="aTypes">
+///   Socket types to open on every bus port or null.
+/// </param>
+/// <param name="iMaxPar">
+///   Maximum number of worker threads.
+/// </param>
+/// <returns>
+///   One result per device.
+/// </returns>
+//*****************************************************************************
+array<VciWarmUpResult>^ VciWarmUpJob::Execute( array<IVciDevice^>^ aDevices
+                                             , array<Type^>^       aTypes
+                                             , int                 iMaxPar )
+{
+  VciWarmUpJob^ pJob     = gcnew VciWarmUpJob();
+  int           iThreads = Math::Min(iMaxPar, aDevices->Length);
+
+  pJob->aDevices = aDevices;
+  pJob->aTypes   = aTypes;
+  pJob->aResult  = gcnew array<VciWarmUpResult>(aDevices->Length);
+  pJob->iNext    = 0;
+
+  if (iThreads <= 1)
+  {
+    pJob->Run();
+  }
+  else
+  {
+    array<Thread^>^ aThreads = gcnew array<Thread^>(iThreads);
+
+    for (int i = 0; i < iThreads; i++)
+    {
+      aThreads[i] = gcnew Thread(gcnew ThreadStart(pJob, &VciWarmUpJob::Run));
+      aThreads[i]->Name         = "VCI warm-up";
+      aThreads[i]->IsBackground = true;
+      aThreads[i]->Start();
+    }
+
+    for (int i = 0; i < iThreads; i++)
+    {
+      aThreads[i]->Join();
+    }
+  }
+
+  return( pJob->aResult );
+}
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: MIT
+//----------------------------------------------------------------------------
+// Summary  : Declarations for the concurrent warm-up of VCI devices.
+// Copyright: Copyright (C) 2016-2022 HMS Technology Center Ravensburg GmbH,
+//            all rights reserved
+//----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vcisdk.h>
+
+
+namespace Ixxat {
+  namespace Vci4 {
+
+using namespace Ixxat::Vci4::Bal;
+using namespace System::Collections::Generic;
+using namespace System::Threading;
+
+//*****************************************************************************
+/// <summary>
+///   State of a warm-up which is shared by the worker threads. Each
+///   worker picks the next unprocessed device until all devices are done.
+/// </summary>
+//*****************************************************************************
+private ref class VciWarmUpJob
+{
+  internal:
+    array<IVciDevice^>^      aDevices;  // devices to warm up
+    array<Type^>^            aTypes;    // socket types to open or null
+    array<VciWarmUpResult>^  aResult;   // result per device
+    int                      iNext;     // next device to process
+
+    void Run    ( void );
+    void WarmUp ( int iDev );
+
+    static array<VciWarmUpResult>^ Execute ( array<IVciDevice^>^ aDevices
+                                           , array<Type^>^       aTypes
+                                           , int                 iMaxPar );
+};
+
+
+} // end of namespace Vci4
+} // end of namespace Ixxat
@@ -7,8 +7,14 @@
 
 #include <windows.h>
 #include "vcinet.hpp"
+#include ".\Device Objects\BAL\CAN\canbrd.hpp"
+#include ".\Device Objects\BAL\CAN\cangrp.hpp"
+#include ".\Device Objects\BAL\balmrg.hpp"
+#include ".\Device Objects\devwup.hpp"
 
 using namespace Ixxat::Vci4;
+using namespace System::Collections::Generic;
+using namespace System::Diagnostics;
 using namespace System::IO;
 
 // function pointers for dynamically loaded VCI4 entry points
@@ -28,6 +34,8 @@ VciServerImpl::VciServerImpl()
 {
   // create the message factory
   m_msgFactory = gcnew Ixxat::Vci4::MsgFactory();
+  m_aTrace     = gcnew array<VciStartupStep>(0);
+  m_pErrMsgs   = gcnew System::Collections::Concurrent::ConcurrentDictionary<int, String^>();
 
   Initialize();
 }
@@ -67,6 +75,8 @@ Version^ VciServerImpl::Version::get(void)
 ///   Gets the reference to a new VCI device manager instance.
 ///   When no longer needed the VCI device manager object has to be disposed 
 ///   using the IDisposable interface. 
+///   All instances share one native device manager, which is requested
+///   from the VCI on the first call only.
 /// </summary>
 /// <returns>
 ///   A reference to the VCI device manager.
@@ -101,29 +111,172 @@ Ixxat::Vci4::IMessageFactory^ VciServerImpl::MsgFactory::get(void)
   return( m_msgFactory );
 }
 
+//*****************************************************************************
+/// <summary>
+///   Gets the steps of the server initialization and their duration.
+/// </summary>
+/// <returns>
+///   A copy of the startup trace.
+/// </returns>
+//*****************************************************************************
+array<VciStartupStep>^ VciServerImpl::StartupTrace::get(void)
+{
+  return( safe_cast<array<VciStartupStep>^>(m_aTrace->Clone()) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Gets the error text of a VCI error code. The text of each error code
+///   is formatted once and then taken from a cache.
+/// </summary>
+/// <param name="errorCode">
+///   The error code.
+/// </param>
+/// <returns>
+///   The error text.
+/// </returns>
+/// <exception cref="VciException">
+///   The VCI provides no function to format errors.
+/// </exception>
+//*****************************************************************************
 String^ VciServerImpl::GetErrorMsg(int errorCode)
 {
+  String^ pMsg;
+
+  if (m_pErrMsgs->TryGetValue(errorCode, pMsg))
+  {
+    return( pMsg );
+  }
+
   if (VciFormatErrorWFunc)
   {
     WCHAR szBuffer[1024] = {0};
     VciFormatErrorWFunc( errorCode, szBuffer, (sizeof(szBuffer)/sizeof(WCHAR))-1 );
-    return( gcnew String(szBuffer) );
+    return( m_pErrMsgs->GetOrAdd(errorCode, gcnew String(szBuffer)) );
   }
   else if (Vci3FormatErrorFunc)
   {
     CHAR szBuffer[1024] = {0};
     Vci3FormatErrorFunc( errorCode, szBuffer );
-    return( gcnew String(szBuffer) );
+    return( m_pErrMsgs->GetOrAdd(errorCode, gcnew String(szBuffer)) );
   }
 
   String^ errmsg = String::Format("Internal error: VCIFormatError not available. Thrown errorCode: 0x{0:X}", errorCode);
   throw gcnew VciException(errmsg);
 }
 
+//*****************************************************************************
+/// <summary>
+///   Creates a service which detects the bit rate of several CAN
+///   controllers concurrently.
+/// </summary>
+/// <returns>
+///   A new bit rate detector.
+/// </returns>
+//*****************************************************************************
+Ixxat::Vci4::Bal::Can::ICanBitrateDetector^ VciServerImpl::CreateBitrateDetector()
+{
+  return( gcnew Ixxat::Vci4::Bal::Can::CanBitrateDetector() );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Creates a group of CAN channels which are opened, initialized and
+///   activated together.
+/// </summary>
+/// <returns>
+///   A new, empty channel group.
+/// </returns>
+//*****************************************************************************
+Ixxat::Vci4::Bal::Can::ICanChannelGroup^ VciServerImpl::CreateChannelGroup()
+{
+  return( gcnew Ixxat::Vci4::Bal::Can::CanChannelGroup() );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Creates a merger which combines the messages of several CAN and LIN
+///   message readers into a single stream ordered by time stamp.
+/// </summary>
+/// <returns>
+///   A new message merger without sources.
+/// </returns>
+//*****************************************************************************
+Ixxat::Vci4::Bal::IMessageMerger^ VciServerImpl::CreateMessageMerger()
+{
+  return( gcnew Ixxat::Vci4::Bal::MessageMerger() );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Opens the native devices, the bus access layers and the requested
+///   sockets of several devices concurrently.
+/// </summary>
+/// <param name="devices">
+///   Devices to warm up.
+/// </param>
+/// <param name="socketTypes">
+///   Socket types to open on every bus port or a null reference.
+/// </param>
+/// <param name="maxParallel">
+///   Maximum number of devices processed at the same time.
+/// </param>
+/// <returns>
+///   One result per device in the order of devices.
+/// </returns>
+/// <exception cref="ArgumentNullException">
+///   devices is a null reference.
+/// </exception>
+/// <exception cref="ArgumentOutOfRangeException">
+///   maxParallel is less than 1.
+/// </exception>
+//*****************************************************************************
+array<VciWarmUpResult>^ VciServerImpl::WarmUp( array<IVciDevice^>^ devices
+                                             , array<Type^>^       socketTypes
+                                             , int                 maxParallel )
+{
+  if (nullptr == devices)
+  {
+    throw gcnew ArgumentNullException("devices");
+  }
+
+  if (maxParallel < 1)
+  {
+    throw gcnew ArgumentOutOfRangeException("maxParallel");
+  }
+
+  return( VciWarmUpJob::Execute(devices, socketTypes, maxParallel) );
+}
+
+//*****************************************************************************
+/// <summary>
+///   Appends a step to the startup trace and restarts the step timer.
+/// </summary>
+/// <param name="pTrace">
+///   The trace to append to.
+/// </param>
+/// <param name="pszName">
+///   Name of the finished step.
+/// </param>
+/// <param name="rqwMark">
+///   Stopwatch time stamp of the start of the step. Returns the time
+///   stamp of the end of the step.
+/// </param>
+//*****************************************************************************
+static void TraceStep(List<VciStartupStep>^ pTrace, String^ pszName, Int64% rqwMark)
+{
+  Int64 qwNow = Stopwatch::GetTimestamp();
+
+  pTrace->Add(VciStartupStep(pszName,
+    TimeSpan::FromTicks((qwNow - rqwMark) * TimeSpan::TicksPerSecond / Stopwatch::Frequency)));
+  rqwMark = qwNow;
+}
+
 //*****************************************************************************
 /// <summary>
 ///   The method initializes the vci server. It loads the vci dll dynamically
-///   and tries to call VciInitialize
+///   and tries to call VciInitialize. The duration of each step is recorded
+///   in the startup trace.
 /// </summary>
 //*****************************************************************************
 void VciServerImpl::Initialize()
@@ -136,6 +289,8 @@ void VciServerImpl::Initialize()
   BYTE* versionInfo;
   LPCWSTR szDllName = L"vciapi.dll";
   VS_FIXEDFILEINFO* vsfi = NULL;
+  List<VciStartupStep>^ pTrace = gcnew List<VciStartupStep>();
+  Int64 qwMark = Stopwatch::GetTimestamp();
 
   // try to access the shared library
   if (NULL == hVciLib)
@@ -145,6 +300,7 @@ void VciServerImpl::Initialize()
       FileLoadException^ e = gcnew FileLoadException();
       throw gcnew FileLoadException(e->Message, "vciapi.dll");
     }
+    TraceStep(pTrace, "LoadLibrary", qwMark);
 
     // read version information from shared library
     size = GetFileVersionInfoSize(szDllName, &handle);
@@ -174,6 +330,7 @@ void VciServerImpl::Initialize()
 
       delete[] versionInfo;
     }
+    TraceStep(pTrace, "GetFileVersionInfo", qwMark);
 
     VciInitializeFunc = (VciInitializeDyn)GetProcAddress((HMODULE)hVciLib, "VciInitialize");
 
@@ -192,12 +349,16 @@ void VciServerImpl::Initialize()
     VciFormatErrorWFunc   = (VciFormatErrorWDyn)GetProcAddress((HMODULE)hVciLib, "VciFormatErrorW");
     // try to load VciFormatError which is available on VCI3 only
     Vci3FormatErrorFunc   = (Vci3FormatErrorDyn)GetProcAddress((HMODULE)hVciLib, "VciFormatError");
+    TraceStep(pTrace, "GetProcAddress", qwMark);
 
     hResult = VciInitializeFunc();
+    TraceStep(pTrace, "VciInitialize", qwMark);
 
     if (hResult != VCI_OK)
     {
       throw gcnew VciException(VciServerImpl::Instance(), hResult);
     }
   }
+
+  m_aTrace = pTrace->ToArray();
 }
\ No newline at end of file
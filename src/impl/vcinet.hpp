@@ -38,19 +38,37 @@ public ref class VciServerImpl sealed : IVciServer
 {
   private:
     static VciServerImpl^ ms_instance = nullptr;
+    static Object^        ms_lock     = gcnew Object();
 
   public:
     static VciServerImpl^ Instance()
     {
-      if (nullptr == ms_instance)
+      // double-checked, concurrent first calls create the server once
+      VciServerImpl^ pInstance = System::Threading::Volatile::Read(ms_instance);
+
+      if (nullptr == pInstance)
       {
-        ms_instance = gcnew VciServerImpl();
+        System::Threading::Monitor::Enter(ms_lock);
+        try
+        {
+          if (nullptr == ms_instance)
+          {
+            System::Threading::Volatile::Write(ms_instance, gcnew VciServerImpl());
+          }
+          pInstance = ms_instance;
+        }
+        finally
+        {
+          System::Threading::Monitor::Exit(ms_lock);
+        }
       }
-      return ms_instance;
+      return pInstance;
     }
 
   private:
-    IMessageFactory^ m_msgFactory;
+    IMessageFactory^        m_msgFactory;
+    System::Collections::Concurrent::ConcurrentDictionary<int, String^>^ m_pErrMsgs; // formatted messages
+    array<VciStartupStep>^  m_aTrace;     // steps of Initialize()
 
   //--------------------------------------------------------------------
   // properties
@@ -73,8 +91,20 @@ public ref class VciServerImpl sealed : IVciServer
 
     virtual property IMessageFactory^   MsgFactory    { IMessageFactory^    get(void); };
 
+    virtual property array<VciStartupStep>^ StartupTrace { array<VciStartupStep>^ get(void); };
+
     virtual String^  GetErrorMsg(int errorCode);
 
+    virtual Bal::Can::ICanBitrateDetector^ CreateBitrateDetector();
+
+    virtual Bal::Can::ICanChannelGroup^    CreateChannelGroup();
+
+    virtual Bal::IMessageMerger^           CreateMessageMerger();
+
+    virtual array<VciWarmUpResult>^        WarmUp( array<IVciDevice^>^ devices
+                                                 , array<Type^>^       socketTypes
+                                                 , int                 maxParallel );
+
   //--------------------------------------------------------------------
   // member functions
   //--------------------------------------------------------------------
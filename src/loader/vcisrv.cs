@@ -11,6 +11,8 @@ namespace Ixxat.Vci4
   using System.IO;
   using System.Reflection;
   using System.Runtime.InteropServices;
+  using System.Threading;
+  using System.Threading.Tasks;
   using Ixxat.Vci4.Bal.Can;
   using Ixxat.Vci4.Bal.Lin;
 
@@ -28,7 +30,13 @@ namespace Ixxat.Vci4
     //--------------------------------------------------------------------
 
     // The singleton VciServer instance
-    private static IVciServer? ms_instance = null;
+    private static volatile IVciServer? ms_instance = null;
+
+    // serializes the loading of the server component
+    private static readonly object ms_lock = new object();
+
+    // time taken by LoadServer
+    private static TimeSpan ms_tsLoad = TimeSpan.Zero;
 
 
     private const int PROCESSOR_ARCHITECTURE_AMD64 = 9;
@@ -199,6 +207,8 @@ namespace Ixxat.Vci4
         }
       }
 
+      System.Diagnostics.Stopwatch watch = System.Diagnostics.Stopwatch.StartNew();
+
       Assembly assembly = System.Reflection.Assembly.LoadFile(archSpecificPath);
       Type? servimpl = assembly.GetType("Ixxat.Vci4.VciServerImpl");
       if (servimpl == null)
@@ -208,9 +218,12 @@ namespace Ixxat.Vci4
       if (instance == null)
         throw new InvalidOperationException("Native component error: function 'Ixxat.Vci4.VciServerImpl:Instance' not found.");
 
-      ms_instance = (IVciServer?)instance.Invoke(null, null);
-      if (ms_instance == null)
+      IVciServer? server = (IVciServer?)instance.Invoke(null, null);
+      if (server == null)
         throw new InvalidOperationException("Native component error: function 'Ixxat.Vci4.VciServerImpl:Instance' did not return a valid instance.");
+
+      ms_tsLoad   = watch.Elapsed;
+      ms_instance = server;
     }
 
     //*****************************************************************************
@@ -246,10 +259,93 @@ namespace Ixxat.Vci4
     {
       if (ms_instance == null)
       {
-        LoadServer(assemblyloadpath);
+        // double-checked, concurrent first calls load the server once
+        lock (ms_lock)
+        {
+          if (ms_instance == null)
+          {
+            LoadServer(assemblyloadpath);
+          }
+        }
       }
       return ms_instance;
     }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Loads and initializes the VCI server in the calling thread. Call
+    ///   this method at startup to keep the cost of the first access off
+    ///   latency sensitive threads.
+    /// </summary>
+    /// <remarks>
+    ///   Path to mixed assemblies is automatically determined from the 
+    ///   EXE or the Loader assembly.
+    /// </remarks>
+    /// <exception cref="InvalidOperationException">
+    ///   Loading server component failed.
+    /// </exception>
+    //*****************************************************************************
+    public static void Preload()
+    {
+      Instance("");
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Loads and initializes the VCI server in the calling thread.
+    /// </summary>
+    /// <param name="assemblyloadpath">
+    ///   specify path where to load the necessary mixed assemblies from 
+    ///   (vcinet.x64.dll, vcinet.x86.dll)
+    /// </param>
+    /// <exception cref="InvalidOperationException">
+    ///   Loading server component failed.
+    /// </exception>
+    //*****************************************************************************
+    public static void Preload(string assemblyloadpath)
+    {
+      Instance(assemblyloadpath);
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Loads and initializes the VCI server on a thread pool thread.
+    ///   Errors are reported through the returned task.
+    /// </summary>
+    /// <param name="assemblyloadpath">
+    ///   specify path where to load the necessary mixed assemblies from 
+    ///   (vcinet.x64.dll, vcinet.x86.dll)
+    /// </param>
+    /// <returns>
+    ///   A task which completes with the VCI server singleton.
+    /// </returns>
+    //*****************************************************************************
+    public static Task<IVciServer?> InitializeAsync(string assemblyloadpath = "")
+    {
+      // always use the thread pool, even if called from a task which runs
+      // on a UI or custom scheduler
+#if NET40
+      TaskCreationOptions eOptions = TaskCreationOptions.None;
+#else
+      TaskCreationOptions eOptions = TaskCreationOptions.DenyChildAttach;
+#endif
+      return Task.Factory.StartNew( () => Instance(assemblyloadpath)
+                                  , CancellationToken.None
+                                  , eOptions
+                                  , TaskScheduler.Default);
+    }
+
+    //*****************************************************************************
+    /// <summary>
+    ///   Gets the time taken to load the platform specific server assembly
+    ///   and to create the server singleton, including the steps reported
+    ///   by <c>IVciServer.StartupTrace</c>. Zero until the server is loaded.
+    /// </summary>
+    //*****************************************************************************
+    public static TimeSpan LoadTime
+    {
+      get { return ms_tsLoad; }
+    }
   };
 
 
@@ -332,6 +332,101 @@ namespace Vci4Tests
 
     #endregion
 
+    #region Generic OpenSocket Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   OpenSocket<T> returns a socket of the requested type
+    /// </summary>
+    public void OpenSocketGeneric()
+    {
+      Ixxat.Vci4.Bal.Can.ICanSocket socket = mBal!.OpenSocket<Ixxat.Vci4.Bal.Can.ICanSocket>(0);
+      Assert.IsNotNull(socket);
+      Assert.AreEqual(mBal!.Resources[0].BusType, socket.BusType);
+      socket.Dispose();
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   OpenSocket<T> with invalid socket type
+    /// </summary>
+    [ExpectedException(typeof(NotImplementedException))]
+    public void OpenSocketGenericWithInvalidSocketType()
+    {
+      IBalResource socket = mBal!.OpenSocket<IBalResource>(0);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   OpenSocket<T> must throw ObjectDisposedException.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void OpenSocketGenericMustThrowObjectDisposedException()
+    {
+      mBal!.Dispose();
+      Ixxat.Vci4.Bal.Can.ICanSocket socket = mBal!.OpenSocket<Ixxat.Vci4.Bal.Can.ICanSocket>(0);
+    }
+
+    #endregion
+
+    #region Property SocketPooling Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   Sockets opened with pooling work after the other sockets of the
+    ///   port were disposed
+    /// </summary>
+    public void SocketPoolingSharesPort()
+    {
+      Assert.IsFalse(mBal!.SocketPooling);
+      mBal!.SocketPooling = true;
+      Assert.IsTrue(mBal!.SocketPooling);
+
+      Ixxat.Vci4.Bal.Can.ICanSocket2 socket = mBal!.OpenSocket<Ixxat.Vci4.Bal.Can.ICanSocket2>(0);
+      Ixxat.Vci4.Bal.Can.ICanChannel2 channel1 = mBal!.OpenSocket<Ixxat.Vci4.Bal.Can.ICanChannel2>(0);
+      Ixxat.Vci4.Bal.Can.ICanChannel2 channel2 = mBal!.OpenSocket<Ixxat.Vci4.Bal.Can.ICanChannel2>(0);
+      Assert.AreNotSame(channel1, channel2);
+
+      uint frequency = socket.ClockFrequency;
+      socket.Dispose();
+      channel1.Dispose();
+      Assert.AreEqual(frequency, channel2.ClockFrequency);
+      channel2.Dispose();
+
+      mBal!.SocketPooling = false;
+      Assert.IsFalse(mBal!.SocketPooling);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Sockets stay usable after pooling was disabled
+    /// </summary>
+    public void SocketPoolingDisabledWhileOpen()
+    {
+      mBal!.SocketPooling = true;
+
+      Ixxat.Vci4.Bal.Can.ICanSocket socket = mBal!.OpenSocket<Ixxat.Vci4.Bal.Can.ICanSocket>(0);
+      uint frequency = socket.ClockFrequency;
+      mBal!.SocketPooling = false;
+
+      Assert.AreEqual(frequency, socket.ClockFrequency);
+      Assert.IsNotNull(socket.LineStatus.ToString());
+      socket.Dispose();
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   SocketPooling must throw ObjectDisposedException.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void SocketPoolingMustThrowObjectDisposedException()
+    {
+      mBal!.Dispose();
+      mBal!.SocketPooling = true;
+    }
+
+    #endregion
+
     #region Using Statement Test methods
 
     [TestMethod]
@@ -0,0 +1,122 @@
+using System;
+using System.Collections;
+using System.Text;
+using System.Threading;
+using Ixxat.Vci4;
+using Ixxat.Vci4.Bal;
+using Ixxat.Vci4.Bal.Can;
+
+namespace Vci4Tests
+{
+  [TestClass]
+  public class CanBitrateDetectorTest
+    : VciDeviceTestBase
+  {
+    #region Member variables
+
+    private Ixxat.Vci4.IVciDevice? mDevice;
+    private Ixxat.Vci4.Bal.Can.ICanBitrateDetector? mDetector;
+
+    #endregion
+
+    #region Test Initialize and Cleanup
+
+    [TestInitialize]
+    public void TestSetup()
+    {
+      mDevice = GetDevice();
+      if (null == mDevice)
+      {
+        Assert.Inconclusive();
+      }
+
+      mDetector = VciServer.Instance()!.CreateBitrateDetector();
+    }
+
+    [TestCleanup]
+    public void TestCleanup()
+    {
+      mDetector = null;
+
+      if (null != mDevice)
+      {
+        mDevice!.Dispose();
+        mDevice = null;
+      }
+    }
+
+    #endregion
+
+    #region Parameter Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   MaxParallel must throw ArgumentOutOfRangeException for values below 1.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void MaxParallelOutOfRange()
+    {
+      mDetector!.MaxParallel = 0;
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   AddController must throw ArgumentNullException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentNullException))]
+    public void AddControllerWithNullDevice()
+    {
+      mDetector!.AddController(null!, 0);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Detect without controllers must return an empty array.
+    /// </summary>
+    public void DetectWithoutControllers()
+    {
+      CanBitrateDetection[] results = mDetector!.Detect(CanOperatingModes.Standard,
+                                                        CanExtendedOperatingModes.Undefined,
+                                                        10, CanFdBitrate.CiaBitRates);
+      Assert.AreEqual(0, results.Length);
+    }
+
+    #endregion
+
+    #region Detect Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   Detect must return one result per controller with an index
+    ///   referring to the table of the caller.
+    /// </summary>
+    public void DetectReturnsGlobalIndex()
+    {
+      CanFdBitrate[] table = CanFdBitrate.CiaBitRates;
+
+      mDetector!.AddController(mDevice!, 0);
+      mDetector!.AddController(mDevice!, 0);
+
+      CanBitrateDetection[] results = mDetector!.Detect(CanOperatingModes.Standard,
+                                                        CanExtendedOperatingModes.Undefined,
+                                                        10, table);
+      Assert.AreEqual(2, results.Length);
+
+      foreach (CanBitrateDetection result in results)
+      {
+        Assert.AreEqual((byte)0, result.PortNumber);
+        Assert.IsTrue(result.Index >= -1 && result.Index < table.Length);
+        if (result.Index >= 0)
+        {
+          Assert.AreEqual(0, result.ErrorCode);
+        }
+        else
+        {
+          Assert.AreNotEqual(0, result.ErrorCode);
+        }
+      }
+    }
+
+    #endregion
+  }
+}
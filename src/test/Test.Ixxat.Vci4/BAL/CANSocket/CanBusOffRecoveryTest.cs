@@ -0,0 +1,201 @@
+using System;
+using System.Collections;
+using System.Text;
+using System.Threading;
+using Ixxat.Vci4;
+using Ixxat.Vci4.Bal;
+using Ixxat.Vci4.Bal.Can;
+
+
+namespace Vci4Tests
+{
+  [TestClass]
+  public class CanBusOffRecoveryTest
+    : VciDeviceTestBase
+  {
+    #region Member variables
+
+    private Ixxat.Vci4.Bal.Can.ICanControl2? mControl;
+    private Ixxat.Vci4.Bal.Can.ICanBusOffRecovery? mRecovery;
+    private Ixxat.Vci4.Bal.IBalObject? mBal;
+
+    #endregion
+
+    #region Test Initialize and Cleanup
+
+    [TestInitialize]
+    public void TestSetup()
+    {
+      Ixxat.Vci4.IVciDevice? device = GetDevice();
+      mBal = device!.OpenBusAccessLayer();
+
+      device!.Dispose();
+
+      mControl = mBal!.OpenSocket(0, typeof(Ixxat.Vci4.Bal.Can.ICanControl2)) as Ixxat.Vci4.Bal.Can.ICanControl2;
+      mRecovery = mControl!.CreateBusOffRecovery();
+    }
+
+    [TestCleanup]
+    public void TestCleanup()
+    {
+      if (null != mRecovery)
+      {
+        mRecovery!.Dispose();
+        mRecovery = null;
+      }
+      if (null != mControl)
+      {
+        mControl!.Dispose();
+        mControl = null;
+      }
+      if (null != mBal)
+      {
+        mBal!.Dispose();
+        mBal = null;
+      }
+    }
+
+    #endregion
+
+    #region Helper methods
+
+    private void InitLine()
+    {
+      mControl!.InitLine( CanOperatingModes.Standard
+                        , CanExtendedOperatingModes.Undefined
+                        , CanFilterModes.Pass
+                        , 2048
+                        , CanFilterModes.Pass
+                        , 2048
+                        , CanBitrate2.Cia1000KBit
+                        , CanBitrate2.Empty);
+    }
+
+    #endregion
+
+    #region Configuration Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   A new recovery is stopped, uses the default delays and has no statistics.
+    /// </summary>
+    public void DefaultConfiguration()
+    {
+      Assert.IsFalse(mRecovery!.IsRunning);
+      Assert.IsFalse(mRecovery!.IsBusOff);
+      Assert.AreEqual(TimeSpan.FromMilliseconds(10), mRecovery!.InitialDelay);
+      Assert.AreEqual(TimeSpan.FromSeconds(2), mRecovery!.MaximumDelay);
+      Assert.AreEqual(0, mRecovery!.MaxRetriesPerMinute);
+      Assert.AreEqual(0, mRecovery!.BusOffCount);
+      Assert.AreEqual(0, mRecovery!.AttemptCount);
+      Assert.AreEqual(0, mRecovery!.RecoveryCount);
+      Assert.AreEqual(TimeSpan.Zero, mRecovery!.TotalDowntime);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   A delay below 1 ms must throw ArgumentOutOfRangeException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void InitialDelayTooShort()
+    {
+      mRecovery!.InitialDelay = TimeSpan.Zero;
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   A negative retry limit must throw ArgumentOutOfRangeException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void NegativeRetryLimit()
+    {
+      mRecovery!.MaxRetriesPerMinute = -1;
+    }
+
+    #endregion
+
+    #region Start and Stop Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   Start must throw InvalidOperationException before InitLine.
+    /// </summary>
+    [ExpectedException(typeof(InvalidOperationException))]
+    public void StartBeforeInitLine()
+    {
+      mRecovery!.Start();
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   A running line must not trigger a recovery.
+    /// </summary>
+    public void StartOnRunningLine()
+    {
+      InitLine();
+      mControl!.StartLine();
+
+      mRecovery!.Start();
+      Assert.IsTrue(mRecovery!.IsRunning);
+
+      Thread.Sleep(100);
+      Assert.IsFalse(mRecovery!.IsBusOff);
+      Assert.AreEqual(0, mRecovery!.AttemptCount);
+
+      mRecovery!.Stop();
+      Assert.IsFalse(mRecovery!.IsRunning);
+
+      mControl!.ResetLine();
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   A recovery created after InitLine can be started.
+    /// </summary>
+    public void CreateAfterInitLine()
+    {
+      InitLine();
+      mControl!.StartLine();
+
+      using (ICanBusOffRecovery recovery = mControl!.CreateBusOffRecovery())
+      {
+        recovery.Start();
+        Assert.IsTrue(recovery.IsRunning);
+
+        recovery.Stop();
+        Assert.IsFalse(recovery.IsRunning);
+      }
+
+      mControl!.ResetLine();
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Disposing the control must stop a running recovery.
+    /// </summary>
+    public void DisposeControlStopsRecovery()
+    {
+      InitLine();
+      mControl!.StartLine();
+
+      mRecovery!.Start();
+      Assert.IsTrue(mRecovery!.IsRunning);
+
+      mControl!.Dispose();
+      Assert.IsFalse(mRecovery!.IsRunning);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   CreateBusOffRecovery must throw ObjectDisposedException after Dispose.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void CreateAfterDispose()
+    {
+      mControl!.Dispose();
+      mControl!.CreateBusOffRecovery();
+    }
+
+    #endregion
+  }
+}
@@ -0,0 +1,168 @@
+using System;
+using System.Collections;
+using System.Text;
+using System.Threading;
+using Ixxat.Vci4;
+using Ixxat.Vci4.Bal;
+using Ixxat.Vci4.Bal.Can;
+
+namespace Vci4Tests
+{
+  [TestClass]
+  public class CanChannelGroupTest
+    : VciDeviceTestBase
+  {
+    #region Member variables
+
+    private Ixxat.Vci4.Bal.IBalObject? mBal;
+    private Ixxat.Vci4.Bal.Can.ICanChannelGroup? mGroup;
+
+    #endregion
+
+    #region Test Initialize and Cleanup
+
+    [TestInitialize]
+    public void TestSetup()
+    {
+      Ixxat.Vci4.IVciDevice? device = GetDevice();
+      if (null == device)
+      {
+        Assert.Inconclusive();
+      }
+
+      mBal = device!.OpenBusAccessLayer();
+      device!.Dispose();
+
+      mGroup = VciServer.Instance()!.CreateChannelGroup();
+    }
+
+    [TestCleanup]
+    public void TestCleanup()
+    {
+      if (null != mGroup)
+      {
+        mGroup!.Dispose();
+        mGroup = null;
+      }
+      if (null != mBal)
+      {
+        mBal!.Dispose();
+        mBal = null;
+      }
+    }
+
+    #endregion
+
+    #region Parameter Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   MaxParallel must throw ArgumentOutOfRangeException for values below 1.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void MaxParallelOutOfRange()
+    {
+      mGroup!.MaxParallel = 0;
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   AddChannel must throw ArgumentNullException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentNullException))]
+    public void AddChannelWithNullBal()
+    {
+      mGroup!.AddChannel(null!, 0);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Activate before Open must throw InvalidOperationException.
+    /// </summary>
+    [ExpectedException(typeof(InvalidOperationException))]
+    public void ActivateBeforeOpen()
+    {
+      mGroup!.AddChannel(mBal!, 0);
+      mGroup!.Activate();
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Open must throw ObjectDisposedException after Dispose.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void OpenAfterDispose()
+    {
+      mGroup!.Dispose();
+      mGroup!.Open(100, 100, 1, CanFilterModes.Pass, false);
+    }
+
+    #endregion
+
+    #region Startup Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   Open and Activate bring up all channels and report the timing.
+    /// </summary>
+    public void OpenAndActivate()
+    {
+      for (byte port = 0; port < mBal!.Resources.Count; port++)
+      {
+        if (mBal!.Resources[port].BusType == VciBusType.Can)
+        {
+          mGroup!.AddChannel(mBal!, port);
+        }
+      }
+
+      mGroup!.MaxParallel = 2;
+      mGroup!.Open(100, 100, 1, CanFilterModes.Pass, false);
+      mGroup!.Activate();
+
+      Assert.IsTrue(mGroup!.ChannelCount > 0);
+      for (int i = 0; i < mGroup!.ChannelCount; i++)
+      {
+        Assert.IsNotNull(mGroup!.GetChannel(i));
+      }
+
+      Assert.IsTrue(mGroup!.Timing.ActivationSkew <= mGroup!.Timing.Activate);
+
+      ICanMessage2[] messages;
+      int[] channels;
+      int count = mGroup!.ReadMessages(out messages, out channels);
+      Assert.AreEqual(count, messages.Length);
+      Assert.AreEqual(count, channels.Length);
+
+      mGroup!.Deactivate();
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   AddChannel after Open must throw InvalidOperationException.
+    /// </summary>
+    [ExpectedException(typeof(InvalidOperationException))]
+    public void AddChannelAfterOpen()
+    {
+      mGroup!.AddChannel(mBal!, 0);
+      mGroup!.Open(100, 100, 1, CanFilterModes.Pass, false);
+      mGroup!.AddChannel(mBal!, 0);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   SendMessage must throw ArgumentOutOfRangeException for an unknown channel.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void SendMessageToUnknownChannel()
+    {
+      IMessageFactory factory = VciServer.Instance()!.MsgFactory;
+      ICanMessage2 message = (ICanMessage2)factory.CreateMsg(typeof(ICanMessage2));
+
+      mGroup!.AddChannel(mBal!, 0);
+      mGroup!.Open(100, 100, 1, CanFilterModes.Pass, false);
+      mGroup!.SendMessage(1, message);
+    }
+
+    #endregion
+  }
+}
@@ -212,6 +212,60 @@ namespace Vci4Tests
 
     #endregion
 
+    #region TryStartLine Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   TryStartLine after Init succeeds
+    /// </summary>
+    public void TryStartLineAfterInit()
+    {
+      mSocket!.InitLine( CanOperatingModes.Standard
+                      , CanExtendedOperatingModes.Undefined
+                      , CanFilterModes.Pass
+                      , 2048
+                      , CanFilterModes.Pass
+                      , 2048
+                      , CanBitrate2.Cia1000KBit
+                      , CanBitrate2.Empty);
+
+      Assert.IsTrue(mSocket!.TryStartLine().Succeeded);
+      Assert.IsTrue(mSocket!.TryStopLine().Succeeded);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   TryStartLine before Init returns the error StartLine throws
+    /// </summary>
+    public void TryStartLineBeforeInit()
+    {
+      VciResult result = mSocket!.TryStartLine();
+      Assert.IsFalse(result.Succeeded);
+
+      try
+      {
+        mSocket!.StartLine();
+        Assert.Fail();
+      }
+      catch (VciException exc)
+      {
+        Assert.AreEqual(exc.HResult, result.HResult);
+      }
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   TryStartLine must throw ObjectDisposedException.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void TryStartLineMustThrowObjectDisposedException()
+    {
+      mSocket!.Dispose();
+      mSocket!.TryStartLine();
+    }
+
+    #endregion
+
     #region StopLine Test methods
 
     [TestMethod]
@@ -402,6 +456,244 @@ namespace Vci4Tests
 
     #endregion
 
+    #region Identifier range and filter table Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   AddFilterIds with ranges must accept all identifiers of the ranges
+    ///   and nothing else if the budget is large enough.
+    /// </summary>
+    public void AddFilterIdRangesExact()
+    {
+      mSocket!.InitLine( CanOperatingModes.Standard
+                      , CanExtendedOperatingModes.Undefined
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanBitrate2.Cia1000KBit
+                      , CanBitrate2.Empty);
+
+      CanIdRange[] ranges = new CanIdRange[] { new CanIdRange(0x100, 0x17F)
+                                             , new CanIdRange(0x180, 0x1FF)
+                                             , new CanIdRange(0x301)
+                                             , new CanIdRange(0x303) };
+
+      CanFilterEntry[] entries = mSocket!.AddFilterIds(CanFilter.Std, ranges, 16);
+      Assert.AreEqual(2, entries.Length);
+
+      for (uint id = 0; id <= 0x7FF; id++)
+      {
+        bool expected = (id >= 0x100 && id <= 0x1FF) || (id == 0x301) || (id == 0x303);
+        bool accepted = false;
+        foreach (CanFilterEntry entry in entries)
+        {
+          accepted |= entry.Accepts(id, false) && entry.Accepts(id, true);
+        }
+        Assert.AreEqual(expected, accepted);
+      }
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   AddFilterIds with ranges must cover all identifiers of the ranges
+    ///   within the specified budget.
+    /// </summary>
+    public void AddFilterIdRangesWithBudget()
+    {
+      mSocket!.InitLine( CanOperatingModes.Extended
+                      , CanExtendedOperatingModes.Undefined
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanBitrate2.Cia1000KBit
+                      , CanBitrate2.Empty);
+
+      CanIdRange[] ranges = new CanIdRange[] { new CanIdRange(0x18FF0010, 0x18FF0123)
+                                             , new CanIdRange(0x0CF00400)
+                                             , new CanIdRange(0x0CF00401) };
+
+      CanFilterEntry[] entries = mSocket!.AddFilterIds(CanFilter.Ext, ranges, 2);
+      Assert.IsTrue(entries.Length <= 2);
+
+      foreach (CanIdRange range in ranges)
+      {
+        for (uint id = range.First; id <= range.Last; id++)
+        {
+          bool accepted = false;
+          foreach (CanFilterEntry entry in entries)
+          {
+            accepted |= entry.Accepts(id, false);
+          }
+          Assert.IsTrue(accepted);
+        }
+      }
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   SetAccFilter with ranges must return a single entry covering all
+    ///   identifiers of the ranges.
+    /// </summary>
+    public void SetAccFilterIdRanges()
+    {
+      mSocket!.InitLine( CanOperatingModes.Standard
+                      , CanExtendedOperatingModes.Undefined
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanBitrate2.Cia1000KBit
+                      , CanBitrate2.Empty);
+
+      CanFilterEntry entry = mSocket!.SetAccFilter(CanFilter.Std,
+        new CanIdRange[] { new CanIdRange(0x200, 0x20F), new CanIdRange(0x210) });
+
+      for (uint id = 0x200; id <= 0x210; id++)
+      {
+        Assert.IsTrue(entry.Accepts(id, false));
+      }
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   AddFilterIds with an invalid range must throw ArgumentOutOfRangeException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void AddFilterIdRangesOutOfRange()
+    {
+      mSocket!.AddFilterIds(CanFilter.Std, new CanIdRange[] { new CanIdRange(0x700, 0x800) }, 4);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   AddFilterIds with ranges must throw ArgumentNullException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentNullException))]
+    public void AddFilterIdRangesWithNull()
+    {
+      mSocket!.AddFilterIds(CanFilter.Std, null!, 4);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   GetFilterIds must return the entries registered by AddFilterIds.
+    /// </summary>
+    public void GetFilterIdsAfterAdd()
+    {
+      mSocket!.InitLine( CanOperatingModes.Standard
+                      , CanExtendedOperatingModes.Undefined
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanBitrate2.Cia1000KBit
+                      , CanBitrate2.Empty);
+
+      mSocket!.AddFilterIds(CanFilter.Std, 0x200 << 1, 0xFFE);
+      mSocket!.AddFilterIds(CanFilter.Std, 0x100 << 1, 0xFFE);
+
+      CanFilterEntry[] entries = mSocket!.GetFilterIds(CanFilter.Std);
+      Assert.AreEqual(2, entries.Length);
+      Assert.AreEqual((uint)(0x100 << 1), entries[0].Code);
+      Assert.AreEqual((uint)(0x200 << 1), entries[1].Code);
+
+      mSocket!.RemFilterIds(CanFilter.Std, 0x100 << 1, 0xFFE);
+      Assert.AreEqual(1, mSocket!.GetFilterIds(CanFilter.Std).Length);
+
+      mSocket!.ResetLine();
+      Assert.AreEqual(0, mSocket!.GetFilterIds(CanFilter.Std).Length);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   SetFilterIds must only transfer the difference to the current table.
+    /// </summary>
+    public void SetFilterIdsAppliesDelta()
+    {
+      mSocket!.InitLine( CanOperatingModes.Standard
+                      , CanExtendedOperatingModes.Undefined
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanBitrate2.Cia1000KBit
+                      , CanBitrate2.Empty);
+
+      CanFilterEntry a = new CanFilterEntry(0x100 << 1, 0xFFE);
+      CanFilterEntry b = new CanFilterEntry(0x200 << 1, 0xFFE);
+      CanFilterEntry c = new CanFilterEntry(0x300 << 1, 0xFFE);
+
+      Assert.AreEqual(2, mSocket!.SetFilterIds(CanFilter.Std, new CanFilterEntry[] { a, b }));
+      Assert.AreEqual(0, mSocket!.SetFilterIds(CanFilter.Std, new CanFilterEntry[] { b, a }));
+      Assert.AreEqual(2, mSocket!.SetFilterIds(CanFilter.Std, new CanFilterEntry[] { b, c }));
+
+      CanFilterEntry[] entries = mSocket!.GetFilterIds(CanFilter.Std);
+      Assert.AreEqual(2, entries.Length);
+      Assert.AreEqual(b.Code, entries[0].Code);
+      Assert.AreEqual(c.Code, entries[1].Code);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   SetFilterIds must register kept entries again if a removed entry
+    ///   shares identifiers with them.
+    /// </summary>
+    public void SetFilterIdsReAddsOverlappingEntries()
+    {
+      mSocket!.InitLine( CanOperatingModes.Standard
+                      , CanExtendedOperatingModes.Undefined
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanBitrate2.Cia1000KBit
+                      , CanBitrate2.Empty);
+
+      CanFilterEntry wide   = new CanFilterEntry(0x100 << 1, 0xF00);
+      CanFilterEntry narrow = new CanFilterEntry(0x123 << 1, 0xFFE);
+
+      mSocket!.SetFilterIds(CanFilter.Std, new CanFilterEntry[] { wide, narrow });
+
+      // removes 'wide', then registers 'narrow' again
+      Assert.AreEqual(2, mSocket!.SetFilterIds(CanFilter.Std, new CanFilterEntry[] { narrow }));
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   SetFilterIds with ranges must return the resulting table.
+    /// </summary>
+    public void SetFilterIdRanges()
+    {
+      mSocket!.InitLine( CanOperatingModes.Extended
+                      , CanExtendedOperatingModes.Undefined
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanFilterModes.Inclusive
+                      , 2048
+                      , CanBitrate2.Cia1000KBit
+                      , CanBitrate2.Empty);
+
+      CanFilterEntry[] entries = mSocket!.SetFilterIds(CanFilter.Ext,
+        new CanIdRange[] { new CanIdRange(0x18FF0000, 0x18FF00FF) }, 4);
+
+      Assert.AreEqual(1, entries.Length);
+      Assert.AreEqual(entries.Length, mSocket!.GetFilterIds(CanFilter.Ext).Length);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   SetFilterIds must throw ArgumentNullException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentNullException))]
+    public void SetFilterIdsWithNull()
+    {
+      mSocket!.SetFilterIds(CanFilter.Std, (CanFilterEntry[])null!);
+    }
+
+    #endregion
+
     #region RemFilterIds Test methods
 
     [TestMethod]
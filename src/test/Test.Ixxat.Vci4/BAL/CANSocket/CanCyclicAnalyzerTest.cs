@@ -0,0 +1,149 @@
+using System;
+using System.Collections;
+using System.Text;
+using System.Threading;
+using Ixxat.Vci4;
+using Ixxat.Vci4.Bal;
+using Ixxat.Vci4.Bal.Can;
+
+namespace Vci4Tests
+{
+  [TestClass]
+  public class CanCyclicAnalyzerTest
+    : VciDeviceTestBase
+  {
+    #region Member variables
+
+    private Ixxat.Vci4.Bal.Can.ICanControl2?   mControl;
+    private Ixxat.Vci4.Bal.Can.ICanScheduler2? mScheduler;
+    private Ixxat.Vci4.Bal.IBalObject? mBal;
+
+    #endregion
+
+    #region Test Initialize and Cleanup
+
+    [TestInitialize]
+    public void TestSetup()
+    {
+      Ixxat.Vci4.IVciDevice? device = GetDevice();
+
+      try
+      {
+        mBal = device!.OpenBusAccessLayer();
+
+        mScheduler = mBal!.OpenSocket(0, typeof(Ixxat.Vci4.Bal.Can.ICanScheduler2)) as Ixxat.Vci4.Bal.Can.ICanScheduler2;
+        if (null == mScheduler)
+        {
+          Assert.Inconclusive();
+        }
+
+        mControl = mBal!.OpenSocket(0, typeof(Ixxat.Vci4.Bal.Can.ICanControl2)) as Ixxat.Vci4.Bal.Can.ICanControl2;
+        mControl!.InitLine(CanOperatingModes.Standard
+                         , CanExtendedOperatingModes.Undefined
+                         , CanFilterModes.Pass
+                         , 2048
+                         , CanFilterModes.Pass
+                         , 2048
+                         , CanBitrate2.Cia125KBit
+                         , CanBitrate2.Empty);
+      }
+      catch (Exception)
+      {
+        // ICanScheduler2 is not supported !
+        Assert.Inconclusive();
+      }
+      finally
+      {
+        device!.Dispose();
+      }
+    }
+
+    [TestCleanup]
+    public void TestCleanup()
+    {
+      if (null != mScheduler)
+      {
+        mScheduler!.Dispose();
+        mScheduler = null;
+      }
+
+      if (null != mControl)
+      {
+        mControl.Dispose();
+        mControl = null;
+      }
+
+      if (null != mBal)
+      {
+        mBal!.Dispose();
+        mBal = null;
+      }
+    }
+
+    #endregion
+
+    #region CreateAnalyzer Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   CreateAnalyzer must take over the registered messages.
+    /// </summary>
+    public void CreateAnalyzerTakesRegisteredMessages()
+    {
+      ICanCyclicTXMsg2 message = mScheduler!.AddMessage();
+      message.Identifier = 0x100;
+      message.CycleTicks = 10;
+      message.Start(0);
+
+      ICanCyclicAnalyzer analyzer = mScheduler!.CreateAnalyzer();
+      Assert.AreEqual(1, analyzer.MessageCount);
+
+      message.Stop();
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   AddMessage must throw ArgumentOutOfRangeException for CycleTicks = 0.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void AddMessageZeroCycleTicks()
+    {
+      ICanCyclicAnalyzer analyzer = mScheduler!.CreateAnalyzer();
+      ICanCyclicTXMsg2 message = mScheduler!.AddMessage();
+      analyzer.AddMessage(message);
+    }
+
+    #endregion
+
+    #region Process Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   Frames of an analyzed message must be counted, others ignored.
+    /// </summary>
+    public void ProcessCountsMatchingFrames()
+    {
+      ICanCyclicAnalyzer analyzer = mScheduler!.CreateAnalyzer();
+      ICanCyclicTXMsg2 cyclic = mScheduler!.AddMessage();
+      cyclic.Identifier = 0x100;
+      cyclic.CycleTicks = 10;
+      analyzer.AddMessage(cyclic);
+
+      IMessageFactory factory = VciServer.Instance()!.MsgFactory;
+      ICanMessage2 frame = (ICanMessage2)factory.CreateMsg(typeof(ICanMessage2));
+      frame.Identifier = 0x100;
+      analyzer.Process(frame);
+      frame.Identifier = 0x101;
+      analyzer.Process(frame);
+
+      CanCyclicStatistics[] stats = analyzer.GetStatistics();
+      Assert.AreEqual(1, stats.Length);
+      Assert.AreEqual(1, stats[0].FrameCount);
+
+      analyzer.Reset();
+      Assert.AreEqual(0, analyzer.GetStatistics()[0].FrameCount);
+    }
+
+    #endregion
+  }
+}
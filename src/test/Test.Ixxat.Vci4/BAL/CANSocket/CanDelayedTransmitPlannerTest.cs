@@ -0,0 +1,210 @@
+using System;
+using System.Collections;
+using System.Text;
+using Ixxat.Vci4;
+using Ixxat.Vci4.Bal;
+using Ixxat.Vci4.Bal.Can;
+
+
+namespace Vci4Tests
+{
+  [TestClass]
+  public class CanDelayedTransmitPlannerTest
+    : VciDeviceTestBase
+  {
+    #region Member variables
+
+    private Ixxat.Vci4.Bal.Can.ICanChannel2? mChannel;
+    private Ixxat.Vci4.Bal.Can.ICanDelayedTransmitPlanner? mPlanner;
+    private Ixxat.Vci4.Bal.IBalObject? mBal;
+
+    #endregion
+
+    #region Test Initialize and Cleanup
+
+    [TestInitialize]
+    public void TestSetup()
+    {
+      Ixxat.Vci4.IVciDevice? device = GetDevice();
+      mBal = device!.OpenBusAccessLayer();
+
+      device!.Dispose();
+
+      mChannel = mBal!.OpenSocket(0, typeof(Ixxat.Vci4.Bal.Can.ICanChannel2)) as Ixxat.Vci4.Bal.Can.ICanChannel2;
+      mChannel!.Initialize(100, 100, 1, CanFilterModes.Pass, false);
+
+      // the tests using the planner are skipped on controllers
+      // without delayed transmission
+      if (mChannel!.SupportsDelayedTransmission)
+      {
+        mPlanner = mChannel!.CreateDelayedTransmitPlanner();
+      }
+    }
+
+    [TestCleanup]
+    public void TestCleanup()
+    {
+      if (null != mPlanner)
+      {
+        mPlanner!.Dispose();
+        mPlanner = null;
+      }
+      if (null != mChannel)
+      {
+        mChannel!.Dispose();
+        mChannel = null;
+      }
+      if (null != mBal)
+      {
+        mBal!.Dispose();
+        mBal = null;
+      }
+    }
+
+    #endregion
+
+    #region Helper methods
+
+    private ICanMessage2 CreateMessage(uint identifier)
+    {
+      IMessageFactory factory = VciServer.Instance()!.MsgFactory;
+      ICanMessage2 message = (ICanMessage2)factory.CreateMsg(typeof(ICanMessage2));
+
+      message.Identifier = identifier;
+      message.DataLength = 8;
+      return message;
+    }
+
+    private TimeSpan MaxDelay()
+    {
+      ulong ns = mChannel!.TimeConverter.DelayedTXTicksToNanoseconds(mChannel!.MaxDelayedTXTicks);
+      return TimeSpan.FromTicks((long) (ns / 100));
+    }
+
+    #endregion
+
+    #region CreateDelayedTransmitPlanner Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   CreateDelayedTransmitPlanner must throw ObjectDisposedException after Dispose.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void CreateAfterDispose()
+    {
+      mChannel!.Dispose();
+      mChannel!.CreateDelayedTransmitPlanner();
+    }
+
+    #endregion
+
+    #region Planning Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   Every added message becomes one pending entry.
+    /// </summary>
+    public void AddPlansMessages()
+    {
+      if (null == mPlanner)
+        return;
+
+      ICanMessage2[] messages = new ICanMessage2[] { CreateMessage(0x100), CreateMessage(0x101), CreateMessage(0x102) };
+      TimeSpan[] times = new TimeSpan[] { TimeSpan.Zero, TimeSpan.FromMilliseconds(1), TimeSpan.FromMilliseconds(2) };
+
+      mPlanner!.Add(messages, times);
+      Assert.AreEqual(3, mPlanner!.PendingCount);
+
+      mPlanner!.Clear();
+      Assert.AreEqual(0, mPlanner!.PendingCount);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   A target time before the previous one must throw ArgumentOutOfRangeException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void AddDescendingTime()
+    {
+      if (null == mPlanner)
+        throw new ArgumentOutOfRangeException();
+
+      mPlanner!.Add(CreateMessage(0x100), TimeSpan.FromMilliseconds(2));
+      mPlanner!.Add(CreateMessage(0x101), TimeSpan.FromMilliseconds(1));
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Without gap message a long gap is clamped.
+    /// </summary>
+    public void LongGapIsClamped()
+    {
+      if (null == mPlanner)
+        return;
+
+      mPlanner!.Add(CreateMessage(0x100), TimeSpan.Zero);
+      mPlanner!.Add(CreateMessage(0x101), MaxDelay() + MaxDelay());
+
+      Assert.AreEqual(2, mPlanner!.PendingCount);
+      Assert.AreEqual(1, mPlanner!.ClampedCount);
+      Assert.AreEqual(0, mPlanner!.GapCount);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   With gap message a long gap is split.
+    /// </summary>
+    public void LongGapIsSplit()
+    {
+      if (null == mPlanner)
+        return;
+
+      mPlanner!.GapMessage = CreateMessage(0x7FF);
+      mPlanner!.Add(CreateMessage(0x100), TimeSpan.Zero);
+      mPlanner!.Add(CreateMessage(0x101), MaxDelay() + MaxDelay() + MaxDelay());
+
+      Assert.IsTrue(mPlanner!.GapCount >= 2);
+      Assert.AreEqual(2 + mPlanner!.GapCount, mPlanner!.PendingCount);
+      Assert.AreEqual(0, mPlanner!.ClampedCount);
+    }
+
+    #endregion
+
+    #region Write Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   Write places the pending entries into the transmit buffer.
+    /// </summary>
+    public void WriteTransmitsEntries()
+    {
+      if (null == mPlanner)
+        return;
+
+      for (int i = 0; i < 10; i++)
+      {
+        mPlanner!.Add(CreateMessage((uint) (0x100 + i)), TimeSpan.FromMilliseconds(i));
+      }
+
+      Assert.AreEqual(10, mPlanner!.Write());
+      Assert.AreEqual(0, mPlanner!.PendingCount);
+      Assert.AreEqual(10, mPlanner!.TransmitCount);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Write must throw ObjectDisposedException after Dispose.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void WriteAfterDispose()
+    {
+      if (null == mPlanner)
+        throw new ObjectDisposedException("planner");
+
+      mPlanner!.Dispose();
+      mPlanner!.Write();
+    }
+
+    #endregion
+  }
+}
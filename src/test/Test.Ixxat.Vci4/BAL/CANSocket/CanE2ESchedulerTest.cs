@@ -0,0 +1,201 @@
+using System;
+using System.Collections;
+using System.Text;
+using System.Threading;
+using Ixxat.Vci4;
+using Ixxat.Vci4.Bal;
+using Ixxat.Vci4.Bal.Can;
+
+
+namespace Vci4Tests
+{
+  [TestClass]
+  public class CanE2ESchedulerTest
+    : VciDeviceTestBase
+  {
+    #region Member variables
+
+    private Ixxat.Vci4.Bal.Can.ICanChannel2? mChannel;
+    private Ixxat.Vci4.Bal.Can.ICanE2EScheduler? mScheduler;
+    private Ixxat.Vci4.Bal.IBalObject? mBal;
+
+    #endregion
+
+    #region Test Initialize and Cleanup
+
+    [TestInitialize]
+    public void TestSetup()
+    {
+      Ixxat.Vci4.IVciDevice? device = GetDevice();
+      mBal = device!.OpenBusAccessLayer();
+
+      device!.Dispose();
+
+      mChannel = mBal!.OpenSocket(0, typeof(Ixxat.Vci4.Bal.Can.ICanChannel2)) as Ixxat.Vci4.Bal.Can.ICanChannel2;
+      mChannel!.Initialize(100, 100, 1, CanFilterModes.Pass, false);
+      mScheduler = mChannel!.CreateE2EScheduler();
+    }
+
+    [TestCleanup]
+    public void TestCleanup()
+    {
+      if (null != mScheduler)
+      {
+        mScheduler!.Dispose();
+        mScheduler = null;
+      }
+      if (null != mChannel)
+      {
+        mChannel!.Dispose();
+        mChannel = null;
+      }
+      if (null != mBal)
+      {
+        mBal!.Dispose();
+        mBal = null;
+      }
+    }
+
+    #endregion
+
+    #region Helper methods
+
+    private ICanMessage2 CreateMessage(byte length)
+    {
+      IMessageFactory factory = VciServer.Instance()!.MsgFactory;
+      ICanMessage2 message = (ICanMessage2)factory.CreateMsg(typeof(ICanMessage2));
+
+      message.Identifier = 0x100;
+      message.DataLength = length;
+      return message;
+    }
+
+    #endregion
+
+    #region CreateE2EScheduler Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   CreateE2EScheduler must throw ObjectDisposedException before initialization.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void CreateE2ESchedulerBeforeInit()
+    {
+      ICanChannel2? channel = mBal!.OpenSocket(0, typeof(Ixxat.Vci4.Bal.Can.ICanChannel2)) as Ixxat.Vci4.Bal.Can.ICanChannel2;
+      try
+      {
+        channel!.CreateE2EScheduler();
+      }
+      finally
+      {
+        channel!.Dispose();
+      }
+    }
+
+    #endregion
+
+    #region AddMessage Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   AddMessage must not throw an exception for a valid profile 1 call.
+    /// </summary>
+    public void AddMessageValidProfile1()
+    {
+      CanE2EConfig config = new CanE2EConfig();
+      config.Profile = CanE2EProfile.Profile1;
+      config.CrcOffset = 0;
+      config.CounterOffset = 8;
+      config.DataId = 0x123;
+
+      ICanE2EMessage message = mScheduler!.AddMessage(CreateMessage(8), TimeSpan.FromMilliseconds(10), config);
+      Assert.AreEqual(TimeSpan.FromMilliseconds(10), message.CycleTime);
+      Assert.AreEqual(0, message.TransmitCount);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   AddMessage must throw ArgumentOutOfRangeException if counter and CRC overlap.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void AddMessageOverlappingOffsets()
+    {
+      CanE2EConfig config = new CanE2EConfig();
+      config.Profile = CanE2EProfile.Crc8SaeJ1850;
+      config.CrcOffset = 8;
+      config.CounterOffset = 12;
+
+      mScheduler!.AddMessage(CreateMessage(8), TimeSpan.FromMilliseconds(10), config);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   AddMessage must throw ArgumentException for profile 2 without data ID list.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentException))]
+    public void AddMessageProfile2WithoutDataIdList()
+    {
+      CanE2EConfig config = new CanE2EConfig();
+      config.Profile = CanE2EProfile.Profile2;
+
+      mScheduler!.AddMessage(CreateMessage(8), TimeSpan.FromMilliseconds(10), config);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   AddMessage must throw ArgumentOutOfRangeException for a too short cycle time.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void AddMessageCycleTimeTooShort()
+    {
+      CanE2EConfig config = new CanE2EConfig();
+      mScheduler!.AddMessage(CreateMessage(8), TimeSpan.FromTicks(10), config);
+    }
+
+    #endregion
+
+    #region Start/Stop Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   A started scheduler must transmit frames and advance the counter.
+    /// </summary>
+    public void StartTransmitsFrames()
+    {
+      CanE2EConfig config = new CanE2EConfig();
+      config.Profile = CanE2EProfile.Crc8SaeJ1850;
+      config.CrcOffset = 56;
+      config.CounterOffset = 0;
+
+      mChannel!.Activate();
+
+      ICanE2EMessage message = mScheduler!.AddMessage(CreateMessage(8), TimeSpan.FromMilliseconds(5), config);
+      mScheduler!.Start();
+      Assert.IsTrue(mScheduler!.IsRunning);
+
+      Thread.Sleep(100);
+      mScheduler!.Stop();
+
+      Assert.IsFalse(mScheduler!.IsRunning);
+      Assert.IsTrue(message.TransmitCount + message.MissedCount > 1);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   A removed message must throw ObjectDisposedException.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void RemovedMessageThrows()
+    {
+      CanE2EConfig config = new CanE2EConfig();
+      ICanE2EMessage message = mScheduler!.AddMessage(CreateMessage(8), TimeSpan.FromMilliseconds(10), config);
+
+      Assert.IsTrue(mScheduler!.RemoveMessage(message));
+      Assert.IsFalse(mScheduler!.RemoveMessage(message));
+
+      message.SetData(new byte[8]);
+    }
+
+    #endregion
+  }
+}
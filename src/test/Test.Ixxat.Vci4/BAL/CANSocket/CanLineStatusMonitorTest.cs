@@ -0,0 +1,195 @@
+using System;
+using System.Collections;
+using System.Text;
+using System.Threading;
+using Ixxat.Vci4;
+using Ixxat.Vci4.Bal;
+using Ixxat.Vci4.Bal.Can;
+
+
+namespace Vci4Tests
+{
+  [TestClass]
+  public class CanLineStatusMonitorTest
+    : VciDeviceTestBase
+  {
+    #region Member variables
+
+    private Ixxat.Vci4.Bal.Can.ICanLineStatusMonitor? mMonitor;
+    private Ixxat.Vci4.Bal.Can.ICanControl2? mControl;
+    private Ixxat.Vci4.Bal.IBalObject? mBal;
+
+    #endregion
+
+    #region Test Initialize and Cleanup
+
+    [TestInitialize]
+    public void TestSetup()
+    {
+      Ixxat.Vci4.IVciDevice? device = GetDevice();
+      mBal = device!.OpenBusAccessLayer();
+
+      device!.Dispose();
+
+      mControl = mBal!.OpenSocket(0, typeof(Ixxat.Vci4.Bal.Can.ICanControl2)) as Ixxat.Vci4.Bal.Can.ICanControl2;
+      mMonitor = mBal!.OpenSocket(0, typeof(Ixxat.Vci4.Bal.Can.ICanLineStatusMonitor)) as Ixxat.Vci4.Bal.Can.ICanLineStatusMonitor;
+    }
+
+    [TestCleanup]
+    public void TestCleanup()
+    {
+      if (null != mMonitor)
+      {
+        mMonitor!.Dispose();
+        mMonitor = null;
+      }
+      if (null != mControl)
+      {
+        mControl!.Dispose();
+        mControl = null;
+      }
+      if (null != mBal)
+      {
+        mBal!.Dispose();
+        mBal = null;
+      }
+    }
+
+    #endregion
+
+    #region Configuration Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   A new monitor is stopped and uses the default interval.
+    /// </summary>
+    public void DefaultConfiguration()
+    {
+      Assert.IsFalse(mMonitor!.IsRunning);
+      Assert.AreEqual(0, mMonitor!.SampleCount);
+      Assert.AreEqual(TimeSpan.FromMilliseconds(20), mMonitor!.SampleInterval);
+      Assert.AreEqual(0, mMonitor!.BusLoadThresholds.Length);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   An interval below 1 ms must throw ArgumentOutOfRangeException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void SampleIntervalTooShort()
+    {
+      mMonitor!.SampleInterval = TimeSpan.Zero;
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Thresholds are kept as sorted copy.
+    /// </summary>
+    public void BusLoadThresholdsAreSorted()
+    {
+      byte[] thresholds = new byte[] { 80, 20, 50 };
+      mMonitor!.BusLoadThresholds = thresholds;
+      thresholds[0] = 0;
+
+      CollectionAssert.AreEqual(new byte[] { 20, 50, 80 }, mMonitor!.BusLoadThresholds);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   A threshold above 100 percent must throw ArgumentOutOfRangeException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void BusLoadThresholdOutOfRange()
+    {
+      mMonitor!.BusLoadThresholds = new byte[] { 50, 101 };
+    }
+
+    #endregion
+
+    #region Sampling Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   CachedLineStatus must throw InvalidOperationException before Start.
+    /// </summary>
+    [ExpectedException(typeof(InvalidOperationException))]
+    public void CachedLineStatusBeforeStart()
+    {
+      CanLineStatus2 status = mMonitor!.CachedLineStatus;
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Start takes a sample immediately and the thread keeps sampling.
+    /// </summary>
+    public void StartAndStop()
+    {
+      mMonitor!.SampleInterval = TimeSpan.FromMilliseconds(5);
+      mMonitor!.Start();
+      Assert.IsTrue(mMonitor!.IsRunning);
+      Assert.IsTrue(mMonitor!.SampleCount >= 1);
+
+      Thread.Sleep(100);
+      mMonitor!.Stop();
+
+      Assert.IsFalse(mMonitor!.IsRunning);
+      Assert.IsTrue(mMonitor!.SampleCount > 1);
+
+      CanLineStatus2 cached = mMonitor!.CachedLineStatus;
+      Assert.AreEqual(mMonitor!.LineStatus.IsInInitMode, cached.IsInInitMode);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Starting the controller must be reported as a change.
+    /// </summary>
+    public void StartLineRaisesEvent()
+    {
+      CanLineStatusChangedEventArgs? args = null;
+      ManualResetEvent raised = new ManualResetEvent(false);
+
+      mControl!.InitLine( CanOperatingModes.Standard
+                        , CanExtendedOperatingModes.Undefined
+                        , CanFilterModes.Pass
+                        , 2048
+                        , CanFilterModes.Pass
+                        , 2048
+                        , CanBitrate2.Cia1000KBit
+                        , CanBitrate2.Empty);
+
+      mMonitor!.SampleInterval = TimeSpan.FromMilliseconds(5);
+      mMonitor!.LineStatusChanged += (sender, e) =>
+      {
+        if (null == args)
+        {
+          args = e;
+          raised.Set();
+        }
+      };
+      mMonitor!.Start();
+
+      mControl!.StartLine();
+      Assert.IsTrue(raised.WaitOne(1000));
+      mMonitor!.Stop();
+
+      Assert.IsTrue(0 != (args!.Changes & CanLineStatusChanges.InitMode));
+      Assert.IsTrue(args!.Previous.IsInInitMode);
+      Assert.IsFalse(args!.Current.IsInInitMode);
+
+      mControl!.StopLine();
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Start after Dispose must throw ObjectDisposedException.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void StartAfterDispose()
+    {
+      mMonitor!.Dispose();
+      mMonitor!.Start();
+    }
+
+    #endregion
+  }
+}
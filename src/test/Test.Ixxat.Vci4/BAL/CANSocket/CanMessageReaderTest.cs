@@ -285,6 +285,107 @@ namespace Vci4Tests
 
     #endregion
 
+    #region SoftwareFilter Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   The software filter is disabled and empty by default.
+    /// </summary>
+    public void SoftwareFilterDefaults()
+    {
+      mReader = mSocket!.GetMessageReader();
+      ICanSoftwareFilter filter = mReader!.SoftwareFilter;
+
+      Assert.IsFalse(filter.Enabled);
+      Assert.AreEqual(0, filter.StdCount);
+      Assert.AreEqual(0, filter.ExtCount);
+      Assert.AreEqual(0L, filter.PassedCount);
+      Assert.AreEqual(0L, filter.DroppedCount);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Add, Remove and Contains of 11-bit and 29-bit identifiers.
+    /// </summary>
+    public void SoftwareFilterAddRemove()
+    {
+      mReader = mSocket!.GetMessageReader();
+      ICanSoftwareFilter filter = mReader!.SoftwareFilter;
+
+      filter.Add(CanFilter.Std, new CanIdRange(0x100, 0x10F));
+      filter.Add(CanFilter.Std, 0x7FF);
+      for (uint id = 0; id < 1000; id++)
+      {
+        filter.Add(CanFilter.Ext, 0x18FF0000 + id * 3);
+      }
+
+      Assert.AreEqual(17, filter.StdCount);
+      Assert.AreEqual(1000, filter.ExtCount);
+      Assert.IsTrue(filter.Contains(CanFilter.Std, 0x105));
+      Assert.IsFalse(filter.Contains(CanFilter.Std, 0x110));
+      Assert.IsFalse(filter.Contains(CanFilter.Ext, 0x105));
+      Assert.IsTrue(filter.Contains(CanFilter.Ext, 0x18FF0000 + 999 * 3));
+      Assert.IsFalse(filter.Contains(CanFilter.Ext, 0x18FF0001));
+
+      for (uint id = 0; id < 1000; id += 2)
+      {
+        filter.Remove(CanFilter.Ext, 0x18FF0000 + id * 3);
+      }
+      Assert.AreEqual(500, filter.ExtCount);
+      for (uint id = 0; id < 1000; id++)
+      {
+        Assert.AreEqual(1 == (id & 1), filter.Contains(CanFilter.Ext, 0x18FF0000 + id * 3));
+      }
+
+      filter.Clear();
+      Assert.AreEqual(0, filter.StdCount);
+      Assert.AreEqual(0, filter.ExtCount);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Add must throw ArgumentOutOfRangeException for identifiers out of range.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void SoftwareFilterStdIdOutOfRange()
+    {
+      mReader = mSocket!.GetMessageReader();
+      mReader!.SoftwareFilter.Add(CanFilter.Std, 0x800);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Add must throw ArgumentOutOfRangeException for too wide 29-bit ranges.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void SoftwareFilterExtRangeTooWide()
+    {
+      mReader = mSocket!.GetMessageReader();
+      mReader!.SoftwareFilter.Add(CanFilter.Ext, new CanIdRange(0, 0x10000));
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   An enabled, empty filter must not return data frames.
+    /// </summary>
+    public void SoftwareFilterDropsDataFrames()
+    {
+      mReader = mSocket!.GetMessageReader();
+      mReader!.SoftwareFilter.Enabled = true;
+
+      ICanMessage[] messages;
+      mReader!.ReadMessages(out messages);
+      if (null != messages)
+      {
+        foreach (ICanMessage message in messages)
+        {
+          Assert.AreNotEqual(CanMsgFrameType.Data, message.FrameType);
+        }
+      }
+    }
+
+    #endregion
+
     #region Using Statement Test methods
 
     [TestMethod]
@@ -130,6 +130,25 @@ namespace Vci4Tests
       CanFeatures refValue = mSocket!.Features;
     }
 
+    [TestMethod]
+    /// <summary>
+    ///   Sockets of the same controller share their capabilities, which
+    ///   remain valid after another socket was disposed.
+    /// </summary>
+    public void FeaturesAreSharedBetweenSockets()
+    {
+      CanFeatures refValue = mSocket!.Features;
+      uint refClock = mSocket!.CanClockFrequency;
+
+      ICanSocket2? socket = mBal!.OpenSocket(0, typeof(Ixxat.Vci4.Bal.Can.ICanControl2)) as Ixxat.Vci4.Bal.Can.ICanSocket2;
+      Assert.IsTrue(refValue == socket!.Features);
+      Assert.AreEqual(refClock, socket!.CanClockFrequency);
+
+      mSocket!.Dispose();
+      Assert.IsTrue(refValue == socket!.Features);
+      socket!.Dispose();
+    }
+
     #endregion
 
     #region Property CanClockFrequency Test methods
@@ -996,6 +1015,68 @@ namespace Vci4Tests
 
     #endregion
 
+    #region Bit timing calculation Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   CalculateArbitrationBitrate must return a timing which matches the
+    ///   requested bit rate and lies within the controller ranges.
+    /// </summary>
+    public void CalculateArbitrationBitrateMatchesBitrate()
+    {
+      CanBitrate2 min = mSocket!.MinimumArbitrationBitrate;
+      CanBitrate2 max = mSocket!.MaximumArbitrationBitrate;
+      CanBitrate2 bitrate = mSocket!.CalculateArbitrationBitrate(500000, 0.875);
+
+      Assert.AreEqual(CanBitrateMode.Raw, bitrate.Mode);
+      Assert.IsTrue(bitrate.Prescaler >= min.Prescaler && bitrate.Prescaler <= max.Prescaler);
+      Assert.IsTrue(bitrate.TimeSegment1 >= min.TimeSegment1 && bitrate.TimeSegment1 <= max.TimeSegment1);
+      Assert.IsTrue(bitrate.TimeSegment2 >= min.TimeSegment2 && bitrate.TimeSegment2 <= max.TimeSegment2);
+
+      uint quanta = 1u + bitrate.TimeSegment1 + bitrate.TimeSegment2;
+      double actual = (double)mSocket!.CanClockFrequency / (bitrate.Prescaler * quanta);
+      Assert.AreEqual(500000, actual, 500000 * 0.005);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   CalculateArbitrationBitrate must throw ArgumentOutOfRangeException
+    ///   for an invalid sample point.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void CalculateArbitrationBitrateInvalidSamplePoint()
+    {
+      mSocket!.CalculateArbitrationBitrate(500000, 1.5);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   CalculateBitrate must prefer equal prescalers for both phases.
+    /// </summary>
+    public void CalculateBitrateUsesCommonPrescaler()
+    {
+      if (!mSocket!.SupportsFastDataRate)
+      {
+        Assert.Inconclusive();
+      }
+
+      CanFdBitrate bitrate = mSocket!.CalculateBitrate(500000, 0, 2000000, 0);
+      Assert.AreEqual(bitrate.StdBitrate.Prescaler, bitrate.FastBitrate.Prescaler);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   CalculateArbitrationBitrate must throw ObjectDisposedException.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void CalculateArbitrationBitrateMustThrowObjectDisposedException()
+    {
+      mSocket!.Dispose();
+      mSocket!.CalculateArbitrationBitrate(500000, 0);
+    }
+
+    #endregion
+
     #region Using Statement Test methods
 
     [TestMethod]
@@ -0,0 +1,193 @@
+using System;
+using System.Collections;
+using System.Text;
+using Ixxat.Vci4;
+using Ixxat.Vci4.Bal;
+using Ixxat.Vci4.Bal.Can;
+
+
+namespace Vci4Tests
+{
+  [TestClass]
+  public class CanTimeConverterTest
+    : VciDeviceTestBase
+  {
+    #region Member variables
+
+    private Ixxat.Vci4.Bal.Can.ICanSocket2? mSocket;
+    private Ixxat.Vci4.Bal.Can.ICanTimeConverter? mConverter;
+    private Ixxat.Vci4.Bal.IBalObject? mBal;
+
+    #endregion
+
+    #region Test Initialize and Cleanup
+
+    [TestInitialize]
+    public void TestSetup()
+    {
+      Ixxat.Vci4.IVciDevice? device = GetDevice();
+      mBal = device!.OpenBusAccessLayer();
+
+      device!.Dispose();
+
+      mSocket = mBal!.OpenSocket(0, typeof(Ixxat.Vci4.Bal.Can.ICanSocket2)) as Ixxat.Vci4.Bal.Can.ICanSocket2;
+      mConverter = mSocket!.TimeConverter;
+    }
+
+    [TestCleanup]
+    public void TestCleanup()
+    {
+      if (null != mSocket)
+      {
+        mSocket!.Dispose();
+        mSocket = null;
+      }
+      if (null != mBal)
+      {
+        mBal!.Dispose();
+        mBal = null;
+      }
+    }
+
+    #endregion
+
+    #region Property TimeConverter Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   TimeConverter returns the same object on every call.
+    /// </summary>
+    public void TimeConverterIsConstant()
+    {
+      Assert.AreSame(mConverter, mSocket!.TimeConverter);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   TimeConverter must throw ObjectDisposedException.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void TimeConverterMustThrowObjectDisposedException()
+    {
+      mSocket!.Dispose();
+      ICanTimeConverter converter = mSocket!.TimeConverter;
+    }
+
+    #endregion
+
+    #region Time stamp Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   One second worth of time stamp ticks converts to exactly one second.
+    /// </summary>
+    public void TimeStampOfOneSecond()
+    {
+      uint frequency = mSocket!.TimeStampCounterClockFrequency;
+      uint divisor   = mSocket!.TimeStampCounterDivisor;
+
+      // skip controllers with a tick rate that is no whole number
+      if (0 == divisor || 0 != frequency % divisor)
+        return;
+
+      ulong ticks = frequency / divisor;
+      Assert.AreEqual(1000000000UL, mConverter!.TimeStampToNanoseconds(ticks));
+      Assert.AreEqual(TimeSpan.FromSeconds(1), mConverter!.TimeStampToTimeSpan(ticks));
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   The batch conversion returns the same values as single conversions.
+    /// </summary>
+    public void BatchMatchesSingleConversion()
+    {
+      ulong[] ticks = new ulong[] { 0, 1, 4711, 0xFFFFFFFF, 0x123456789AB };
+      ulong[] nanoseconds = new ulong[ticks.Length];
+      TimeSpan[] timeSpans = new TimeSpan[ticks.Length];
+
+      mConverter!.TimeStampToNanoseconds(ticks, nanoseconds);
+      mConverter!.TimeStampToTimeSpan(ticks, timeSpans);
+
+      for (int i = 0; i < ticks.Length; i++)
+      {
+        Assert.AreEqual(mConverter!.TimeStampToNanoseconds(ticks[i]), nanoseconds[i]);
+        Assert.AreEqual(mConverter!.TimeStampToTimeSpan(ticks[i]), timeSpans[i]);
+      }
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   A too short target array must throw ArgumentException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentException))]
+    public void BatchTargetTooShort()
+    {
+      mConverter!.TimeStampToNanoseconds(new ulong[4], new ulong[3]);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   A null array must throw ArgumentNullException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentNullException))]
+    public void BatchNullArray()
+    {
+      mConverter!.TimeStampToTimeSpan(null!, new TimeSpan[1]);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   The converter remains usable after the socket was disposed.
+    /// </summary>
+    public void UsableAfterDispose()
+    {
+      ulong refValue = mConverter!.TimeStampToNanoseconds(1000);
+      mSocket!.Dispose();
+      Assert.AreEqual(refValue, mConverter!.TimeStampToNanoseconds(1000));
+    }
+
+    #endregion
+
+    #region Delayed transmission Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   Delayed TX ticks survive the conversion to nanoseconds and back.
+    /// </summary>
+    public void DelayedTXRoundTrip()
+    {
+      if (!mSocket!.SupportsDelayedTransmission)
+        return;
+
+      ulong[] ticks = new ulong[] { 0, 1, 1000, mSocket!.MaxDelayedTXTicks };
+      foreach (ulong value in ticks)
+      {
+        ulong nanoseconds = mConverter!.DelayedTXTicksToNanoseconds(value);
+        ulong roundTrip = mConverter!.NanosecondsToDelayedTXTicks(nanoseconds);
+        Assert.IsTrue(roundTrip == value || roundTrip + 1 == value);
+      }
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Without delayed transmission the conversion must throw
+    ///   NotSupportedException.
+    /// </summary>
+    public void DelayedTXNotSupported()
+    {
+      if (0 != mSocket!.DelayedTXTimerDivisor)
+        return;
+
+      try
+      {
+        mConverter!.NanosecondsToDelayedTXTicks(1000);
+        Assert.Fail("NotSupportedException expected");
+      }
+      catch (NotSupportedException)
+      {
+      }
+    }
+
+    #endregion
+  }
+}
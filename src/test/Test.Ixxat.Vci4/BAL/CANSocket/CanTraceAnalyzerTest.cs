@@ -0,0 +1,161 @@
+using System;
+using System.Collections;
+using System.Text;
+using System.Threading;
+using Ixxat.Vci4;
+using Ixxat.Vci4.Bal;
+using Ixxat.Vci4.Bal.Can;
+
+namespace Vci4Tests
+{
+  [TestClass]
+  public class CanTraceAnalyzerTest
+    : VciDeviceTestBase
+  {
+    #region Member variables
+
+    private Ixxat.Vci4.Bal.Can.ICanScheduler2? mScheduler;
+    private Ixxat.Vci4.Bal.IBalObject? mBal;
+
+    #endregion
+
+    #region Test Initialize and Cleanup
+
+    [TestInitialize]
+    public void TestSetup()
+    {
+      Ixxat.Vci4.IVciDevice? device = GetDevice();
+
+      try
+      {
+        mBal = device!.OpenBusAccessLayer();
+
+        mScheduler = mBal!.OpenSocket(0, typeof(Ixxat.Vci4.Bal.Can.ICanScheduler2)) as Ixxat.Vci4.Bal.Can.ICanScheduler2;
+        if (null == mScheduler)
+        {
+          Assert.Inconclusive();
+        }
+      }
+      catch (Exception)
+      {
+        // ICanScheduler2 is not supported !
+        Assert.Inconclusive();
+      }
+      finally
+      {
+        device!.Dispose();
+      }
+    }
+
+    [TestCleanup]
+    public void TestCleanup()
+    {
+      if (null != mScheduler)
+      {
+        mScheduler!.Dispose();
+        mScheduler = null;
+      }
+
+      if (null != mBal)
+      {
+        mBal!.Dispose();
+        mBal = null;
+      }
+    }
+
+    #endregion
+
+    #region Helper methods
+
+    /// <summary>
+    ///   Feeds a synthetic trace with the specified period into the analyzer.
+    ///   Every 7th frame is dropped to emulate lost frames.
+    /// </summary>
+    private void FeedTrace(ICanTraceAnalyzer analyzer, uint id, double period, int count)
+    {
+      double tickRes = (double)mScheduler!.TimeStampCounterDivisor / mScheduler!.TimeStampCounterClockFrequency;
+
+      IMessageFactory factory = VciServer.Instance()!.MsgFactory;
+      ICanMessage2 frame = (ICanMessage2)factory.CreateMsg(typeof(ICanMessage2));
+      frame.Identifier = id;
+      frame.DataLength = 2;
+      frame[0] = 0x12;
+      frame[1] = 0x34;
+
+      for (int i = 0; i < count; i++)
+      {
+        if (6 == (i % 7))
+        {
+          continue;
+        }
+        frame.TimeStamp = (uint)(i * period / tickRes);
+        analyzer.Process(frame);
+      }
+    }
+
+    #endregion
+
+    #region GetPeriodicFrames Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   A periodic identifier must be detected despite lost frames.
+    /// </summary>
+    public void DetectsPeriodicIdentifier()
+    {
+      ICanTraceAnalyzer analyzer = mScheduler!.CreateTraceAnalyzer();
+      FeedTrace(analyzer, 0x123, 0.010, 50);
+
+      CanPeriodicFrame[] frames = analyzer.GetPeriodicFrames();
+      Assert.AreEqual(1, frames.Length);
+      Assert.AreEqual(0x123u, frames[0].Identifier);
+      Assert.AreEqual(0.010, frames[0].Period.TotalSeconds, 0.0005);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   An identifier with too few frames must not be reported.
+    /// </summary>
+    public void IgnoresRareIdentifier()
+    {
+      ICanTraceAnalyzer analyzer = mScheduler!.CreateTraceAnalyzer();
+      FeedTrace(analyzer, 0x123, 0.010, 3);
+
+      Assert.AreEqual(0, analyzer.GetPeriodicFrames().Length);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   MinimumFrames must throw ArgumentOutOfRangeException for values below 3.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void MinimumFramesOutOfRange()
+    {
+      ICanTraceAnalyzer analyzer = mScheduler!.CreateTraceAnalyzer();
+      analyzer.MinimumFrames = 2;
+    }
+
+    #endregion
+
+    #region CreateMessages Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   CreateMessages must take over identifier and payload.
+    /// </summary>
+    public void CreateMessagesTakesOverPayload()
+    {
+      ICanTraceAnalyzer analyzer = mScheduler!.CreateTraceAnalyzer();
+      FeedTrace(analyzer, 0x123, 0.010, 50);
+
+      ICanCyclicTXMsg2[] messages = analyzer.CreateMessages();
+      Assert.AreEqual(1, messages.Length);
+      Assert.AreEqual(0x123u, messages[0].Identifier);
+      Assert.AreEqual(2, messages[0].DataLength);
+      Assert.AreEqual(0x34, messages[0][1]);
+      Assert.IsTrue(messages[0].CycleTicks > 0);
+    }
+
+    #endregion
+  }
+}
@@ -0,0 +1,141 @@
+using System;
+using System.Collections;
+using System.Text;
+using System.Threading;
+using Ixxat.Vci4;
+using Ixxat.Vci4.Bal;
+using Ixxat.Vci4.Bal.Can;
+
+namespace Vci4Tests
+{
+  [TestClass]
+  public class MessageMergerTest
+    : VciDeviceTestBase
+  {
+    #region Member variables
+
+    private Ixxat.Vci4.Bal.IBalObject? mBal;
+    private Ixxat.Vci4.Bal.IMessageMerger? mMerger;
+
+    #endregion
+
+    #region Test Initialize and Cleanup
+
+    [TestInitialize]
+    public void TestSetup()
+    {
+      Ixxat.Vci4.IVciDevice? device = GetDevice();
+      if (null == device)
+      {
+        Assert.Inconclusive();
+      }
+
+      mBal = device!.OpenBusAccessLayer();
+      device!.Dispose();
+
+      mMerger = VciServer.Instance()!.CreateMessageMerger();
+    }
+
+    [TestCleanup]
+    public void TestCleanup()
+    {
+      if (null != mMerger)
+      {
+        mMerger!.Dispose();
+        mMerger = null;
+      }
+      if (null != mBal)
+      {
+        mBal!.Dispose();
+        mBal = null;
+      }
+    }
+
+    #endregion
+
+    #region Parameter Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   ReorderWindow must throw ArgumentOutOfRangeException for negative values.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void ReorderWindowOutOfRange()
+    {
+      mMerger!.ReorderWindow = TimeSpan.FromMilliseconds(-1);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   AddSource must throw ArgumentNullException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentNullException))]
+    public void AddSourceWithNullReader()
+    {
+      mMerger!.AddSource((ICanMessageReader) null!, null!);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   ReadMessages must throw ObjectDisposedException after Dispose.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void ReadAfterDispose()
+    {
+      MergedMessage[] messages;
+
+      mMerger!.Dispose();
+      mMerger!.ReadMessages(out messages);
+    }
+
+    #endregion
+
+    #region Merge Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   Without sources nothing is returned.
+    /// </summary>
+    public void ReadWithoutSources()
+    {
+      MergedMessage[] messages;
+
+      Assert.AreEqual(0, mMerger!.ReadMessages(out messages));
+      Assert.AreEqual(0, mMerger!.Flush(out messages));
+      Assert.AreEqual(0, mMerger!.PendingCount);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   The merged stream of a CAN channel is ordered by time stamp.
+    /// </summary>
+    public void MergeIsOrdered()
+    {
+      ICanChannel2? channel = mBal!.OpenSocket(0, typeof(ICanChannel2)) as ICanChannel2;
+      channel!.Initialize(100, 100, 1, CanFilterModes.Pass, false);
+      channel!.Activate();
+
+      ICanMessageReader reader = channel!.GetMessageReader();
+      Assert.AreEqual(0, mMerger!.AddSource(reader, channel!));
+      Assert.AreEqual(1, mMerger!.SourceCount);
+
+      Thread.Sleep(100);
+
+      MergedMessage[] messages;
+      mMerger!.ReadMessages(out messages);
+      mMerger!.Flush(out messages);
+      Assert.AreEqual(0, mMerger!.PendingCount);
+
+      for (int i = 1; i < messages.Length; i++)
+      {
+        Assert.IsTrue(messages[i - 1].TimeStamp <= messages[i].TimeStamp);
+        Assert.AreEqual(VciBusType.Can, messages[i].BusType);
+      }
+
+      reader.Dispose();
+      channel!.Dispose();
+    }
+
+    #endregion
+  }
+}
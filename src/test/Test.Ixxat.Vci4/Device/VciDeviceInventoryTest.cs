@@ -0,0 +1,153 @@
+using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.Text;
+using Ixxat.Vci4;
+
+
+namespace Vci4Tests
+{
+  [TestClass]
+  public class VciDeviceInventoryTest
+  {
+    #region Member variables
+
+    private IVciDeviceInventory? mInventory;
+
+    #endregion
+
+    #region Test Fixture SetUp and TearDown
+
+    [TestInitialize]
+    public void TestSetup()
+    {
+      IVciDeviceManager manager = VciServer.Instance()!.DeviceManager;
+      mInventory = manager!.GetDeviceInventory();
+      manager!.Dispose();
+    }
+
+    [TestCleanup]
+    public void TestCleanup()
+    {
+      if (null != mInventory)
+      {
+        mInventory.Dispose();
+        mInventory = null;
+      }
+    }
+
+    #endregion
+
+    #region Snapshot Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   The inventory contains the same devices as the device list.
+    /// </summary>
+    public void DevicesMatchDeviceList()
+    {
+      int count = 0;
+
+      using (IVciDeviceManager manager = VciServer.Instance()!.DeviceManager)
+      using (IVciDeviceList list = manager.GetDeviceList())
+      {
+        foreach (IVciDevice device in list)
+        {
+          Assert.IsNotNull(mInventory!.FindDevice(device.VciObjectId));
+          device.Dispose();
+          count++;
+        }
+      }
+
+      Assert.AreEqual(count, mInventory!.Devices.Count);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Rescan without changes keeps the device objects.
+    /// </summary>
+    public void RescanKeepsUnchangedDevices()
+    {
+      IList<IVciDevice> before = mInventory!.Devices;
+      long scans = mInventory!.ScanCount;
+
+      mInventory!.Rescan();
+
+      IList<IVciDevice> after = mInventory!.Devices;
+      Assert.AreEqual(scans + 1, mInventory!.ScanCount);
+      Assert.AreEqual(before.Count, after.Count);
+      for (int i = 0; i < before.Count; i++)
+      {
+        Assert.AreSame(before[i], after[i]);
+      }
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   FindDevice returns null for an unknown object id.
+    /// </summary>
+    public void FindUnknownDevice()
+    {
+      Assert.IsNull(mInventory!.FindDevice(-1));
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Every device is found by its hardware id, also with changed case
+    ///   and surrounding blanks.
+    /// </summary>
+    public void FindByHardwareId()
+    {
+      foreach (IVciDevice device in mInventory!.Devices)
+      {
+        object hwid = device.UniqueHardwareId;
+
+        Assert.AreSame(device, mInventory!.FindDeviceByHardwareId(hwid));
+        Assert.AreSame(device, mInventory!.FindDeviceByHardwareId(" " + hwid.ToString()!.ToLowerInvariant() + " "));
+      }
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   FindDeviceByHardwareId returns null for an unknown hardware id.
+    /// </summary>
+    public void FindUnknownHardwareId()
+    {
+      Assert.IsNull(mInventory!.FindDeviceByHardwareId("no such device"));
+      Assert.IsNull(mInventory!.FindDeviceByHardwareId(""));
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   FindDeviceByHardwareId must throw ArgumentNullException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentNullException))]
+    public void FindNullHardwareId()
+    {
+      mInventory!.FindDeviceByHardwareId(null!);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   The returned device list is read-only.
+    /// </summary>
+    [ExpectedException(typeof(NotSupportedException))]
+    public void DevicesAreReadOnly()
+    {
+      mInventory!.Devices.Clear();
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   FindDevice must throw ObjectDisposedException after Dispose.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void FindAfterDispose()
+    {
+      mInventory!.Dispose();
+      mInventory!.FindDevice(0);
+    }
+
+    #endregion
+  }
+}
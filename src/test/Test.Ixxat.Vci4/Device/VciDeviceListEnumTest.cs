@@ -219,5 +219,46 @@ namespace Vci4Tests
     }
 
     #endregion
+
+    #region Snapshot Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   A second enumerator used at the same time returns the same devices.
+    /// </summary>
+    public void ConcurrentEnumeratorsReturnSameDevices()
+    {
+      IEnumerator second = mList!.GetEnumerator();
+
+      while (mEnumerator!.MoveNext())
+      {
+        Assert.IsTrue(second.MoveNext());
+        Assert.AreEqual((mEnumerator!.Current as IVciDevice)!.VciObjectId,
+                        (second.Current as IVciDevice)!.VciObjectId);
+      }
+      Assert.IsFalse(second.MoveNext());
+
+      (second as IDisposable)!.Dispose();
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   A device stays valid after its enumerator is disposed.
+    /// </summary>
+    public void DeviceValidAfterEnumeratorDisposed()
+    {
+      if (!mEnumerator!.MoveNext())
+      {
+        Assert.Inconclusive();
+      }
+
+      IVciDevice device = (mEnumerator!.Current as IVciDevice)!;
+      (mEnumerator as IDisposable)!.Dispose();
+
+      Assert.IsNotNull(device.Description);
+      device.Dispose();
+    }
+
+    #endregion
   }
 }
@@ -235,6 +235,36 @@ namespace Vci4Tests
       IVciCtrlInfo[] refValue = mDevice!.Equipment;
     }
 
+    [TestMethod]
+    /// <summary>
+    ///   Controllers returns the same cached list as Equipment for multiple calls.
+    /// </summary>
+    public void ControllersAreCached()
+    {
+      System.Collections.Generic.IList<IVciCtrlInfo> refValue = mDevice!.Controllers;
+      Assert.IsNotNull(refValue);
+      Assert.IsTrue(refValue.IsReadOnly);
+      Assert.AreSame(refValue, mDevice!.Controllers);
+
+      IVciCtrlInfo[] equipment = mDevice!.Equipment;
+      Assert.AreEqual(equipment.Length, refValue.Count);
+      for (int i = 0; i < equipment.Length; i++)
+      {
+        Assert.AreSame(refValue[i], equipment[i]);
+      }
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Controllers must throw ObjectDisposedException.
+    /// </summary>
+    [ExpectedException(typeof(ObjectDisposedException))]
+    public void ControllersMustThrowObjectDisposedException()
+    {
+      mDevice!.Dispose();
+      System.Collections.Generic.IList<IVciCtrlInfo> refValue = mDevice!.Controllers;
+    }
+
     [TestMethod]
     /// <summary>
     ///   OpenBusAccessLayer returns valid reference.
@@ -257,6 +287,28 @@ namespace Vci4Tests
       Ixxat.Vci4.Bal.IBalObject bal = mDevice!.OpenBusAccessLayer();
     }
 
+    [TestMethod]
+    /// <summary>
+    ///   Two device objects of the same device share the native device,
+    ///   disposing one of them must not affect the other one.
+    /// </summary>
+    public void OpenBusAccessLayerWithSharedDevice()
+    {
+      IVciDevice? other = GetDevice();
+      Assert.AreEqual(mDevice!.VciObjectId, other!.VciObjectId);
+
+      Ixxat.Vci4.Bal.IBalObject bal1 = mDevice!.OpenBusAccessLayer();
+      Ixxat.Vci4.Bal.IBalObject bal2 = other!.OpenBusAccessLayer();
+      other!.Dispose();
+      bal2.Dispose();
+
+      Assert.IsNotNull(mDevice!.Equipment);
+      Ixxat.Vci4.Bal.IBalObject bal3 = mDevice!.OpenBusAccessLayer();
+      Assert.IsNotNull(bal3);
+      bal3.Dispose();
+      bal1.Dispose();
+    }
+
     [TestMethod]
     /// <summary>
     ///   Tests compilation and functionality of using statement
@@ -0,0 +1,102 @@
+using System;
+using System.Collections;
+using Ixxat.Vci4;
+using Ixxat.Vci4.Bal;
+using Ixxat.Vci4.Bal.Can;
+
+namespace Vci4Tests
+{
+  [TestClass]
+  public class VciWarmUpTest
+    : VciDeviceTestBase
+  {
+    #region Member variables
+
+    private IVciDevice? mDevice;
+
+    #endregion
+
+    #region Test Initialize and Cleanup
+
+    [TestInitialize]
+    public void TestSetup()
+    {
+      mDevice = GetDevice();
+      if (null == mDevice)
+      {
+        Assert.Inconclusive();
+      }
+    }
+
+    [TestCleanup]
+    public void TestCleanup()
+    {
+      if (null != mDevice)
+      {
+        mDevice!.Dispose();
+        mDevice = null;
+      }
+    }
+
+    #endregion
+
+    #region Parameter Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   WarmUp must throw ArgumentNullException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentNullException))]
+    public void WarmUpWithNullDevices()
+    {
+      VciServer.Instance()!.WarmUp(null!, null, 1);
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   WarmUp must throw ArgumentOutOfRangeException.
+    /// </summary>
+    [ExpectedException(typeof(ArgumentOutOfRangeException))]
+    public void WarmUpWithoutParallelism()
+    {
+      VciServer.Instance()!.WarmUp(new IVciDevice[] { mDevice! }, null, 0);
+    }
+
+    #endregion
+
+    #region WarmUp Test methods
+
+    [TestMethod]
+    /// <summary>
+    ///   WarmUp opens the BAL and a control socket per CAN port.
+    /// </summary>
+    public void WarmUpOpensBalAndSockets()
+    {
+      VciWarmUpResult[] results = VciServer.Instance()!.WarmUp(
+        new IVciDevice[] { mDevice! }, new Type[] { typeof(ICanSocket) }, 4);
+
+      Assert.AreEqual(1, results.Length);
+      Assert.IsNull(results[0].Error);
+      Assert.AreSame(mDevice, results[0].Device);
+      Assert.IsNotNull(results[0].Bal);
+
+      int canPorts = 0;
+      foreach (IBalResource resource in results[0].Bal!.Resources)
+      {
+        if (VciBusType.Can == resource.BusType)
+        {
+          canPorts++;
+        }
+      }
+      Assert.AreEqual(canPorts, results[0].Sockets.Length);
+
+      foreach (IBalResource socket in results[0].Sockets)
+      {
+        socket.Dispose();
+      }
+      results[0].Bal!.Dispose();
+    }
+
+    #endregion
+  }
+}
@@ -1,3 +1,4 @@
+using System.Runtime.Serialization;
 using Ixxat.Vci4;
 using Ixxat.Vci4.Bal.Can;
 
@@ -18,6 +19,78 @@ namespace Vci4Tests
       Assert.AreEqual(vciVersion.Minor, 0);
     }
 
+    [TestMethod]
+    /// <summary>
+    ///   Concurrent initialization returns the same singleton and records
+    ///   the startup trace.
+    /// </summary>
+    public void TestInitializeAsync()
+    {
+      System.Threading.Tasks.Task<IVciServer?> task1 = VciServer.InitializeAsync();
+      System.Threading.Tasks.Task<IVciServer?> task2 = VciServer.InitializeAsync();
+      VciServer.Preload();
+
+      Assert.AreSame(VciServer.Instance(), task1.Result);
+      Assert.AreSame(VciServer.Instance(), task2.Result);
+      Assert.IsTrue(TimeSpan.Zero < VciServer.LoadTime);
+
+      VciStartupStep[] trace = VciServer.Instance()!.StartupTrace;
+      Assert.IsNotNull(trace);
+      foreach (VciStartupStep step in trace)
+      {
+        Assert.IsTrue(TimeSpan.Zero <= step.Duration);
+        Assert.IsTrue(step.Duration <= VciServer.LoadTime);
+      }
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   Error messages are cached per error code and VciException formats
+    ///   its message on demand.
+    /// </summary>
+    public void TestErrorMessageCache()
+    {
+      IVciServer server = VciServer.Instance()!;
+      int errorCode = unchecked((int)0xE0010001);
+
+      string msg = server.GetErrorMsg(errorCode);
+      Assert.AreSame(msg, server.GetErrorMsg(errorCode));
+
+      VciException exc = new VciException(server, " (appended)", errorCode);
+      Assert.AreEqual(errorCode, exc.HResult);
+      Assert.AreEqual(msg + " (appended)", exc.Message);
+      Assert.AreSame(exc.Message, exc.Message);
+    }
+
+#pragma warning disable SYSLIB0050, SYSLIB0051 // legacy serialization
+    private class DeserializedVciException : VciException
+    {
+      public DeserializedVciException(SerializationInfo info, StreamingContext context)
+        : base(info, context)
+      {
+      }
+    }
+
+    [TestMethod]
+    /// <summary>
+    ///   The formatted message of a VciException survives serialization.
+    /// </summary>
+    public void TestExceptionSerialization()
+    {
+      IVciServer server = VciServer.Instance()!;
+      int errorCode = unchecked((int)0xE0010001);
+
+      VciException exc = new VciException(server, " (appended)", errorCode);
+      SerializationInfo info = new SerializationInfo(typeof(VciException), new FormatterConverter());
+      StreamingContext context = new StreamingContext(StreamingContextStates.All);
+      exc.GetObjectData(info, context);
+
+      VciException copy = new DeserializedVciException(info, context);
+      Assert.AreEqual(server.GetErrorMsg(errorCode) + " (appended)", copy.Message);
+      Assert.AreEqual(errorCode, copy.HResult);
+    }
+#pragma warning restore SYSLIB0050, SYSLIB0051
+
     [TestMethod]
     /// <summary>
     ///   Test getting the VCI device manager